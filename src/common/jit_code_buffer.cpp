@@ -19,17 +19,29 @@ JitCodeBuffer::JitCodeBuffer(size_t size)
   m_free_code_ptr = m_code_ptr;
   m_code_size = size;
   m_code_used = 0;
+  m_allocation_size = size;
+  m_owns_memory = true;
 
   if (!m_code_ptr)
     Panic("Failed to allocate code space.");
 }
 
+JitCodeBuffer::JitCodeBuffer(void* code_ptr, size_t size)
+  : m_code_ptr(code_ptr), m_free_code_ptr(code_ptr), m_code_size(size), m_code_used(0), m_allocation_size(0),
+    m_owns_memory(false)
+{
+}
+
 JitCodeBuffer::~JitCodeBuffer()
 {
+  if (!m_owns_memory)
+    return;
+
 #if defined(Y_PLATFORM_WINDOWS)
-  VirtualFree(m_code_ptr, m_code_size, MEM_RELEASE);
+  // Releases the whole allocation, including any split off buffers.
+  VirtualFree(m_code_ptr, 0, MEM_RELEASE);
 #elif defined(Y_PLATFORM_LINUX) || defined(Y_PLATFORM_ANDROID)
-  munmap(m_code_ptr, m_code_size);
+  munmap(m_code_ptr, m_allocation_size);
 #endif
 }
 
@@ -68,3 +80,10 @@ void JitCodeBuffer::Align(u32 alignment, u8 padding_value)
   m_free_code_ptr = reinterpret_cast<char*>(m_free_code_ptr) + num_padding_bytes;
   m_code_used += num_padding_bytes;
 }
+
+std::unique_ptr<JitCodeBuffer> JitCodeBuffer::SplitBuffer(size_t size)
+{
+  Assert(size <= GetFreeCodeSpace());
+  m_code_size -= size;
+  return std::unique_ptr<JitCodeBuffer>(new JitCodeBuffer(reinterpret_cast<char*>(m_code_ptr) + m_code_size, size));
+}
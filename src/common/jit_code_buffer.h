@@ -1,5 +1,6 @@
 #pragma once
 #include "types.h"
+#include <memory>
 
 class JitCodeBuffer
 {
@@ -9,6 +10,7 @@ public:
 
   void* GetFreeCodePointer() const { return m_free_code_ptr; }
   size_t GetFreeCodeSpace() const { return (m_code_size - m_code_used); }
+  size_t GetUsedCodeSpace() const { return m_code_used; }
   void CommitCode(size_t length);
   void Reset();
 
@@ -16,10 +18,20 @@ public:
   /// Assumes alignment is a power-of-two.
   void Align(u32 alignment, u8 padding_value);
 
+  /// Removes size bytes from the end of this buffer, and returns a new buffer which uses them. Code in both buffers is
+  /// within rel32 range of each other. The returned buffer does not own its memory, so this buffer must outlive it.
+  std::unique_ptr<JitCodeBuffer> SplitBuffer(size_t size);
+
 private:
+  JitCodeBuffer(void* code_ptr, size_t size);
+
   void* m_code_ptr;
   void* m_free_code_ptr;
   size_t m_code_size;
   size_t m_code_used;
+
+  // Size of the mapping, which stays the same when the end of the buffer is split off.
+  size_t m_allocation_size;
+  bool m_owns_memory;
 };
 
@@ -509,6 +509,8 @@ void SDLHostInterface::RenderMainMenuBar()
         SetCPUBackend(CPU::BackendType::CachedInterpreter);
       if (ImGui::MenuItem("Recompiler", nullptr, current_backend == CPU::BackendType::Recompiler))
         SetCPUBackend(CPU::BackendType::Recompiler);
+      if (ImGui::MenuItem("Tiered", nullptr, current_backend == CPU::BackendType::Tiered))
+        SetCPUBackend(CPU::BackendType::Tiered);
 
       ImGui::EndMenu();
     }
@@ -683,9 +685,33 @@ void SDLHostInterface::RenderStatsWindow()
                      NUM_STATS_HISTORY_VALUES, m_stats.history_position, nullptr, 0.0f, FLT_MAX, HISTORY_GRAPH_SIZE);
     ImGui::NewLine();
 
-    ImGui::Text("Code Block Count: %" PRIu64, stats.cpu_stats.num_code_cache_blocks);
+    ImGui::Text("Code Block Count: %" PRIu64 " (%" PRIu64 " bytes/block)", stats.cpu_stats.num_code_cache_blocks,
+                (stats.cpu_stats.num_code_cache_blocks > 0) ?
+                  (stats.cpu_stats.code_cache_block_memory / stats.cpu_stats.num_code_cache_blocks) :
+                  0);
+    ImGui::Text("Code Segment Evictions: %" PRIu64 " (%" PRIu64 " KB reclaimed, %" PRIu64 " recompiles)",
+                stats.cpu_stats.code_cache_segment_evictions, stats.cpu_stats.code_cache_bytes_reclaimed / 1024,
+                stats.cpu_stats.code_cache_eviction_recompiles);
+    ImGui::Text("Code Invalidations Avoided: %" PRIu64, stats.cpu_stats.code_invalidations_avoided);
+    ImGui::Text("Idle Cycles Skipped: %" PRIu64, stats.cpu_stats.idle_cycles_skipped);
+    ImGui::Text("Events Dispatched: %.0f/s", stats.events_dispatched_per_second);
+    ImGui::Text("TLB Hits: %" PRIu64 ", Misses: %" PRIu64 ", Flushes: %" PRIu64 ", PDE Cache Hits: %" PRIu64,
+                stats.cpu_stats.tlb_hits, stats.cpu_stats.tlb_misses, stats.cpu_stats.tlb_flushes,
+                stats.cpu_stats.pde_cache_hits);
+    {
+      const u64 predictions = stats.cpu_stats.branch_prediction_hits + stats.cpu_stats.branch_prediction_misses;
+      ImGui::Text("Indirect Branch Prediction: %" PRIu64 " hits, %" PRIu64 " misses (%.2f%%)",
+                  stats.cpu_stats.branch_prediction_hits, stats.cpu_stats.branch_prediction_misses,
+                  (predictions > 0) ? (static_cast<double>(stats.cpu_stats.branch_prediction_hits) * 100.0 /
+                                       static_cast<double>(predictions)) :
+                                      0.0);
+    }
+    ImGui::Text("Traces Formed: %" PRIu64 " (%" PRIu64 " side exits)", stats.cpu_stats.code_cache_traces_formed,
+                stats.cpu_stats.code_cache_trace_side_exits);
     ImGui::Text("Blocks Executed: %" PRIu64, stats.cpu_delta_code_cache_blocks_executed);
     ImGui::Text("Cached Instructions Executed: %" PRIu64, stats.cpu_delta_code_cache_instructions_executed);
+    ImGui::Text("  Cached Interpreter: %" PRIu64, stats.cpu_delta_cached_interpreter_instructions_executed);
+    ImGui::Text("  Recompiled: %" PRIu64, stats.cpu_delta_recompiled_instructions_executed);
     ImGui::Text("Instructions Interpreted: %" PRIu64, stats.cpu_delta_instructions_interpreted);
     ImGui::PlotLines("##stats_instructions_executed", m_stats.instructions_executed_history.data(),
                      NUM_STATS_HISTORY_VALUES, m_stats.history_position, nullptr, FLT_MIN, FLT_MAX, HISTORY_GRAPH_SIZE);
@@ -0,0 +1,265 @@
+#include "YBaseLib/Log.h"
+#include "YBaseLib/Timer.h"
+#include "pce/bus.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+Log_SetChannel(BusIOPort);
+
+namespace {
+
+// Matches the IO port dispatch used before the flat table was introduced: a list of connections per port, walked on
+// every access, with word accesses to ports without word handlers recursing into byte lookups.
+class LinkedIOPorts
+{
+public:
+  struct Connection
+  {
+    const void* owner;
+    Bus::IOPortReadByteHandler read_byte_handler;
+    Bus::IOPortReadWordHandler read_word_handler;
+    Bus::IOPortWriteByteHandler write_byte_handler;
+  };
+
+  LinkedIOPorts() : m_ports(Bus::NUM_IOPORTS) {}
+
+  Connection& GetConnection(u16 port, const void* owner)
+  {
+    for (Connection& conn : m_ports[port])
+    {
+      if (conn.owner == owner)
+        return conn;
+    }
+
+    m_ports[port].push_back(Connection{owner});
+    return m_ports[port].back();
+  }
+
+  u8 ReadByte(u16 port) const
+  {
+    for (const Connection& conn : m_ports[port])
+    {
+      if (conn.read_byte_handler)
+        return conn.read_byte_handler(port);
+    }
+
+    return 0xFF;
+  }
+
+  u16 ReadWord(u16 port) const
+  {
+    for (const Connection& conn : m_ports[port])
+    {
+      if (conn.read_word_handler)
+        return conn.read_word_handler(port);
+    }
+
+    return ZeroExtend16(ReadByte(port)) | (ZeroExtend16(ReadByte(port + 1)) << 8);
+  }
+
+  void WriteByte(u16 port, u8 value) const
+  {
+    for (const Connection& conn : m_ports[port])
+    {
+      if (conn.write_byte_handler)
+        conn.write_byte_handler(port, value);
+    }
+  }
+
+private:
+  std::vector<std::vector<Connection>> m_ports;
+};
+
+// Roughly the ports a DOS game polls: an ATA data port, VGA sequencer index/data, the PIT and system control port A.
+struct IOPortDevices
+{
+  static constexpr u16 ATA_DATA_PORT = 0x01F0;
+  static constexpr u16 VGA_INDEX_PORT = 0x03C4;
+  static constexpr u16 VGA_DATA_PORT = 0x03C5;
+  static constexpr u16 PIT_COUNTER_PORT = 0x0040;
+  static constexpr u16 CONTROL_PORT = 0x0092;
+
+  u16 ata_data = 0x1234;
+  u8 vga_index = 0;
+  std::array<u8, 8> vga_registers = {};
+  u8 pit_counter = 0;
+  u8 control_port = 0x02;
+};
+
+void ConnectDevices(Bus* bus, IOPortDevices* devices)
+{
+  bus->ConnectIOPortReadWord(IOPortDevices::ATA_DATA_PORT, devices, [devices](u16) { return devices->ata_data++; });
+  bus->ConnectIOPortRead(IOPortDevices::VGA_INDEX_PORT, devices, [devices](u16) { return devices->vga_index; });
+  bus->ConnectIOPortWrite(IOPortDevices::VGA_INDEX_PORT, devices,
+                          [devices](u16, u8 value) { devices->vga_index = value & 7; });
+  bus->ConnectIOPortRead(IOPortDevices::VGA_DATA_PORT, devices,
+                         [devices](u16) { return devices->vga_registers[devices->vga_index]; });
+  bus->ConnectIOPortWrite(IOPortDevices::VGA_DATA_PORT, devices,
+                          [devices](u16, u8 value) { devices->vga_registers[devices->vga_index] = value; });
+  bus->ConnectIOPortRead(IOPortDevices::PIT_COUNTER_PORT, devices, [devices](u16) { return devices->pit_counter--; });
+  bus->ConnectIOPortReadToPointer(IOPortDevices::CONTROL_PORT, devices, &devices->control_port);
+  bus->ConnectIOPortWriteToPointer(IOPortDevices::CONTROL_PORT, devices, &devices->control_port);
+}
+
+void ConnectDevices(LinkedIOPorts* ports, IOPortDevices* devices)
+{
+  ports->GetConnection(IOPortDevices::ATA_DATA_PORT, devices).read_word_handler = [devices](u16) {
+    return devices->ata_data++;
+  };
+  LinkedIOPorts::Connection& vga_index = ports->GetConnection(IOPortDevices::VGA_INDEX_PORT, devices);
+  vga_index.read_byte_handler = [devices](u16) { return devices->vga_index; };
+  vga_index.write_byte_handler = [devices](u16, u8 value) { devices->vga_index = value & 7; };
+  LinkedIOPorts::Connection& vga_data = ports->GetConnection(IOPortDevices::VGA_DATA_PORT, devices);
+  vga_data.read_byte_handler = [devices](u16) { return devices->vga_registers[devices->vga_index]; };
+  vga_data.write_byte_handler = [devices](u16, u8 value) { devices->vga_registers[devices->vga_index] = value; };
+  ports->GetConnection(IOPortDevices::PIT_COUNTER_PORT, devices).read_byte_handler = [devices](u16) {
+    return devices->pit_counter--;
+  };
+  LinkedIOPorts::Connection& control = ports->GetConnection(IOPortDevices::CONTROL_PORT, devices);
+  control.read_byte_handler = [devices](u16) { return devices->control_port; };
+  control.write_byte_handler = [devices](u16, u8 value) { devices->control_port = value; };
+}
+
+// One round of accesses, returning a sum of the values read so the accesses can't be optimized away.
+template<typename ReadByte, typename ReadWord, typename WriteByte>
+u32 RunIOPortRound(u32 round, const ReadByte& read_byte, const ReadWord& read_word, const WriteByte& write_byte)
+{
+  u32 sum = 0;
+  for (u32 i = 0; i < 16; i++)
+    sum += read_word(IOPortDevices::ATA_DATA_PORT);
+
+  write_byte(IOPortDevices::VGA_INDEX_PORT, Truncate8(round));
+  write_byte(IOPortDevices::VGA_DATA_PORT, Truncate8(round >> 3));
+  sum += read_byte(IOPortDevices::VGA_DATA_PORT);
+  sum += read_word(IOPortDevices::VGA_INDEX_PORT);
+  sum += read_byte(IOPortDevices::PIT_COUNTER_PORT);
+  sum += read_byte(IOPortDevices::PIT_COUNTER_PORT);
+  write_byte(IOPortDevices::CONTROL_PORT, Truncate8(round) | 0x02);
+  sum += read_byte(IOPortDevices::CONTROL_PORT);
+  return sum;
+}
+
+constexpr u32 IOPORT_OPS_PER_ROUND = 24;
+
+} // namespace
+
+TEST(BusIOPort, Dispatch)
+{
+  std::unique_ptr<Bus> bus = std::make_unique<Bus>(20);
+  const int owner_a = 0;
+  const int owner_b = 0;
+
+  // Unconnected ports read as all ones, and wide accesses are split down to the byte ports.
+  EXPECT_EQ(bus->ReadIOPortByte(0x0300), 0xFF);
+  EXPECT_EQ(bus->ReadIOPortDWord(0x0300), 0xFFFFFFFFu);
+
+  u8 low = 0x34;
+  u8 high = 0x12;
+  bus->ConnectIOPortReadToPointer(0x0300, &owner_a, &low);
+  bus->ConnectIOPortReadToPointer(0x0301, &owner_a, &high);
+  EXPECT_EQ(bus->ReadIOPortWord(0x0300), 0x1234);
+  EXPECT_EQ(bus->ReadIOPortDWord(0x0300), 0xFFFF1234u);
+
+  // A word handler at the upper half turns the dword split into words.
+  bus->ConnectIOPortReadWord(0x0302, &owner_a, [](u16) { return u16(0x5678); });
+  EXPECT_EQ(bus->ReadIOPortDWord(0x0300), 0x56781234u);
+  bus->ConnectIOPortReadDWord(0x0300, &owner_b, [](u16) { return u32(0xCAFEF00D); });
+  EXPECT_EQ(bus->ReadIOPortDWord(0x0300), 0xCAFEF00Du);
+
+  // Every connection sees byte writes.
+  u8 written_a = 0;
+  u8 written_b = 0;
+  bus->ConnectIOPortWriteToPointer(0x0304, &owner_a, &written_a);
+  bus->ConnectIOPortWrite(0x0304, &owner_b, [&written_b](u16, u8 value) { written_b = value; });
+  bus->WriteIOPortWord(0x0304, 0x00AB);
+  EXPECT_EQ(written_a, 0xAB);
+  EXPECT_EQ(written_b, 0xAB);
+
+  // Disconnecting restores the split and unconnected paths.
+  bus->DisconnectIOPorts(&owner_b);
+  EXPECT_EQ(bus->ReadIOPortDWord(0x0300), 0x56781234u);
+  bus->WriteIOPortByte(0x0304, 0xCD);
+  EXPECT_EQ(written_a, 0xCD);
+  EXPECT_EQ(written_b, 0xAB);
+  bus->DisconnectIOPorts(&owner_a);
+  EXPECT_EQ(bus->ReadIOPortDWord(0x0300), 0xFFFFFFFFu);
+}
+
+TEST(BusIOPort, BlockTransfers)
+{
+  std::unique_ptr<Bus> bus = std::make_unique<Bus>(20);
+  const int owner_a = 0;
+  const int owner_b = 0;
+
+  // A device with four words left in its buffer.
+  std::array<u16, 4> device_buffer = {0x1111, 0x2222, 0x3333, 0x4444};
+  u32 device_position = 0;
+  bus->ConnectIOPortReadWord(0x01F0, &owner_a, [&](u16) { return device_buffer[device_position++ % 4]; });
+  bus->ConnectIOPortReadBlock(0x01F0, &owner_a, [&](u16, u32 size, u32 count, void* destination) {
+    const u32 transfer_count = std::min(count, static_cast<u32>(device_buffer.size()) - device_position);
+    std::memcpy(destination, &device_buffer[device_position], transfer_count * size);
+    device_position += transfer_count;
+    return transfer_count;
+  });
+
+  // Transfers stop where the device says.
+  std::array<u16, 8> words = {};
+  EXPECT_EQ(bus->ReadIOPortBlock(0x01F0, sizeof(u16), 2, words.data()), 2u);
+  EXPECT_EQ(words[1], 0x2222);
+  EXPECT_EQ(bus->ReadIOPortBlock(0x01F0, sizeof(u16), 8, words.data()), 2u);
+  EXPECT_EQ(words[0], 0x3333);
+  EXPECT_EQ(words[1], 0x4444);
+
+  // Ports without block handlers, or with more than one connection, use the per-element handlers.
+  EXPECT_EQ(bus->ReadIOPortBlock(0x0170, sizeof(u16), 8, words.data()), 0u);
+  EXPECT_EQ(bus->WriteIOPortBlock(0x01F0, sizeof(u16), 8, words.data()), 0u);
+  device_position = 0;
+  bus->ConnectIOPortWrite(0x01F0, &owner_b, [](u16, u8) {});
+  EXPECT_EQ(bus->ReadIOPortBlock(0x01F0, sizeof(u16), 2, words.data()), 0u);
+  bus->DisconnectIOPorts(&owner_b);
+  EXPECT_EQ(bus->ReadIOPortBlock(0x01F0, sizeof(u16), 2, words.data()), 2u);
+}
+
+TEST(BusIOPort, Benchmark)
+{
+  static constexpr u32 NUM_ROUNDS = 1024 * 1024;
+
+  IOPortDevices linked_devices;
+  LinkedIOPorts linked_ports;
+  ConnectDevices(&linked_ports, &linked_devices);
+
+  IOPortDevices table_devices;
+  std::unique_ptr<Bus> bus = std::make_unique<Bus>(20);
+  ConnectDevices(bus.get(), &table_devices);
+
+  u32 linked_sum = 0;
+  Timer linked_timer;
+  for (u32 round = 0; round < NUM_ROUNDS; round++)
+  {
+    linked_sum += RunIOPortRound(round, [&linked_ports](u16 port) { return linked_ports.ReadByte(port); },
+                                 [&linked_ports](u16 port) { return linked_ports.ReadWord(port); },
+                                 [&linked_ports](u16 port, u8 value) { linked_ports.WriteByte(port, value); });
+  }
+  const double linked_time = linked_timer.GetTimeNanoseconds();
+
+  Bus* const table_bus = bus.get();
+  u32 table_sum = 0;
+  Timer table_timer;
+  for (u32 round = 0; round < NUM_ROUNDS; round++)
+  {
+    table_sum += RunIOPortRound(round, [table_bus](u16 port) { return table_bus->ReadIOPortByte(port); },
+                                [table_bus](u16 port) { return table_bus->ReadIOPortWord(port); },
+                                [table_bus](u16 port, u8 value) { table_bus->WriteIOPortByte(port, value); });
+  }
+  const double table_time = table_timer.GetTimeNanoseconds();
+
+  ASSERT_EQ(linked_sum, table_sum);
+
+  const double num_ops = static_cast<double>(NUM_ROUNDS) * IOPORT_OPS_PER_ROUND;
+  Log_InfoPrintf("%u IO ops: connection lists %.2f M ops/sec, dispatch table %.2f M ops/sec",
+                 static_cast<u32>(num_ops), num_ops * 1000.0 / linked_time, num_ops * 1000.0 / table_time);
+}
@@ -0,0 +1,39 @@
+#include "pce/bus.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+TEST(Bus, CodeChunks)
+{
+  std::unique_ptr<Bus> bus = std::make_unique<Bus>(20);
+  bus->AllocateRAM(65536);
+  bus->CreateRAMRegion(0, 0xFFFF);
+
+  std::vector<std::pair<PhysicalMemoryAddress, u32>> invalidations;
+  bus->SetCodeInvalidationCallback(
+    [&invalidations](PhysicalMemoryAddress address, u32 size) { invalidations.emplace_back(address, size); });
+
+  // Code in the last chunk of the page. The page stays in the RAM pointer index for everything else.
+  bus->MarkPageAsCode(0x1FC0, 64);
+  EXPECT_NE(bus->GetRAMPagePointer(0x1000), nullptr);
+  EXPECT_FALSE(bus->IsCodeInRange(0x1000, 4));
+  EXPECT_FALSE(bus->IsCodeInRange(0x1FBC, 4));
+  EXPECT_TRUE(bus->IsCodeInRange(0x1FBE, 4));
+  EXPECT_TRUE(bus->IsCodeInRange(0x1FFF, 1));
+
+  // Writes to other chunks don't invalidate anything.
+  bus->WriteMemoryDWord(0x1000, 0x12345678);
+  EXPECT_TRUE(invalidations.empty());
+  EXPECT_EQ(bus->GetCodeInvalidationsAvoided(), 1u);
+
+  // A write running off the end of the page is clamped to its last chunk.
+  bus->WriteMemoryDWord(0x1FFD, 0x12345678);
+  ASSERT_EQ(invalidations.size(), 1u);
+  EXPECT_EQ(invalidations[0].first, 0x1FFDu);
+
+  // Unmarking leaves the pointer in place.
+  bus->UnmarkPageAsCode(0x1000);
+  EXPECT_NE(bus->GetRAMPagePointer(0x1000), nullptr);
+  EXPECT_FALSE(bus->IsCodeInRange(0x1FC0, 64));
+}
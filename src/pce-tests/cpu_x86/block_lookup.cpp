@@ -0,0 +1,125 @@
+#include "YBaseLib/Log.h"
+#include "YBaseLib/Timer.h"
+#include "pce/cpu_x86/code_cache_types.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+Log_SetChannel(CPU_X86_BlockLookup);
+
+using namespace CPU_X86;
+
+namespace {
+
+// Matches the block map used before the lookup table was introduced.
+struct IdentityBlockKeyHash
+{
+  size_t operator()(const BlockKey& key) const { return std::hash<u64>()(key.qword); }
+};
+
+struct BlockPopulation
+{
+  std::vector<std::unique_ptr<BlockBase>> blocks;
+  std::vector<BlockKey> lookups;
+};
+
+// Roughly what a protected-mode guest looks like: a few thousand blocks packed into a few hundred code pages,
+// with most transitions landing in a small hot set of loops.
+BlockPopulation CreateBlockPopulation()
+{
+  static constexpr u32 NUM_PAGES = 256;
+  static constexpr u32 NUM_BLOCKS = 8192;
+  static constexpr u32 NUM_HOT_BLOCKS = 512;
+  static constexpr u32 NUM_LOOKUPS = 4 * 1024 * 1024;
+
+  BlockPopulation population;
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<u32> page_dist(0, NUM_PAGES - 1);
+  std::uniform_int_distribution<u32> offset_dist(0, CPU_X86::CPU::PAGE_SIZE - 1);
+  std::unordered_map<u64, bool> used_keys;
+  while (population.blocks.size() < NUM_BLOCKS)
+  {
+    BlockKey key = {};
+    key.eip_physical_address = 0x100000 + page_dist(rng) * CPU_X86::CPU::PAGE_SIZE + offset_dist(rng);
+    key.cs_size = (population.blocks.size() % 8) != 0;
+    key.ss_size = key.cs_size;
+    if (!used_keys.emplace(key.qword, true).second)
+      continue;
+
+    population.blocks.push_back(std::make_unique<BlockBase>(key));
+  }
+
+  std::uniform_int_distribution<u32> hot_dist(0, NUM_HOT_BLOCKS - 1);
+  std::uniform_int_distribution<u32> cold_dist(0, NUM_BLOCKS - 1);
+  std::uniform_int_distribution<u32> miss_dist(0, 99);
+  population.lookups.reserve(NUM_LOOKUPS);
+  for (u32 i = 0; i < NUM_LOOKUPS; i++)
+  {
+    const u32 roll = miss_dist(rng);
+    const u32 index = (roll < 90) ? hot_dist(rng) : cold_dist(rng);
+    population.lookups.push_back(population.blocks[index]->key);
+  }
+
+  return population;
+}
+
+} // namespace
+
+TEST(CPU_X86_BlockLookup, MatchesMap)
+{
+  BlockPopulation population = CreateBlockPopulation();
+  BlockLookupTable table;
+  for (const auto& block : population.blocks)
+    table.Insert(block.get());
+  ASSERT_EQ(table.GetCount(), population.blocks.size());
+
+  for (const auto& block : population.blocks)
+    ASSERT_EQ(table.Lookup(block->key), block.get());
+
+  // Removed blocks must not be returned from the direct-mapped table.
+  for (size_t i = 0; i < population.blocks.size(); i += 2)
+    ASSERT_TRUE(table.Remove(population.blocks[i].get()));
+  for (size_t i = 0; i < population.blocks.size(); i++)
+  {
+    BlockBase* expected = (i % 2) ? population.blocks[i].get() : nullptr;
+    ASSERT_EQ(table.Lookup(population.blocks[i]->key), expected);
+  }
+
+  table.Clear();
+  ASSERT_EQ(table.GetCount(), 0u);
+  ASSERT_EQ(table.Lookup(population.blocks[1]->key), nullptr);
+}
+
+TEST(CPU_X86_BlockLookup, Benchmark)
+{
+  BlockPopulation population = CreateBlockPopulation();
+
+  std::unordered_map<BlockKey, BlockBase*, IdentityBlockKeyHash> map;
+  BlockLookupTable table;
+  for (const auto& block : population.blocks)
+  {
+    map.emplace(block->key, block.get());
+    table.Insert(block.get());
+  }
+
+  // Sum the pointers so the lookups can't be optimized away.
+  uintptr_t map_sum = 0;
+  Timer map_timer;
+  for (const BlockKey& key : population.lookups)
+    map_sum += reinterpret_cast<uintptr_t>(map.find(key)->second);
+  const double map_time = map_timer.GetTimeNanoseconds();
+
+  uintptr_t table_sum = 0;
+  Timer table_timer;
+  for (const BlockKey& key : population.lookups)
+    table_sum += reinterpret_cast<uintptr_t>(table.Lookup(key));
+  const double table_time = table_timer.GetTimeNanoseconds();
+
+  ASSERT_EQ(map_sum, table_sum);
+
+  const double num_lookups = static_cast<double>(population.lookups.size());
+  Log_InfoPrintf("%u blocks, %u lookups: unordered_map %.2f ns/lookup, lookup table %.2f ns/lookup",
+                 static_cast<u32>(population.blocks.size()), static_cast<u32>(population.lookups.size()),
+                 map_time / num_lookups, table_time / num_lookups);
+}
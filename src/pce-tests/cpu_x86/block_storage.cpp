@@ -0,0 +1,239 @@
+#include "../stub_host_interface.h"
+#include "pce/cpu_x86/code_cache_types.h"
+#include "pce/cpu_x86/recompiler_backend.h"
+#include "system.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace CPU_X86;
+
+namespace {
+
+// Gives the tests access to the recompiler's block storage. It runs on the CPU of a test system which has halted, and
+// compiles blocks from wherever the CPU stopped.
+class BlockStorageTestBackend : public Recompiler::Backend
+{
+public:
+  BlockStorageTestBackend(CPU_X86::CPU* cpu) : Backend(cpu, TierThresholds{}) {}
+
+  // Decodes the block at the current EIP, replaying the given trace branch directions.
+  Block* DecodeCurrentBlock(u8 trace_branch_count, u8 trace_branch_taken)
+  {
+    BlockKey key;
+    if (!GetBlockKeyForCurrentState(&key))
+      return nullptr;
+
+    Block* block = static_cast<Block*>(AllocateBlock(key));
+    block->trace_branch_count = trace_branch_count;
+    block->trace_branch_taken = trace_branch_taken;
+    if (!CompileBlock(block))
+    {
+      DestroyBlock(block);
+      return nullptr;
+    }
+
+    return block;
+  }
+
+  // Compiles the block on the compile thread, and installs its code.
+  void InstallBlockCode(Block* block)
+  {
+    QueueBackgroundCompile(block);
+    while (!m_compiled_blocks_pending.load())
+      std::this_thread::yield();
+    InstallBackgroundCompiledBlocks();
+  }
+
+  using Backend::Block;
+  using Backend::DestroyBlock;
+  using Backend::EvictCodeSegment;
+  using Backend::RebuildBlockInstructions;
+};
+
+struct DecodedInstruction
+{
+  VirtualMemoryAddress address;
+  Operation operation;
+  u32 length;
+
+  bool operator==(const DecodedInstruction& rhs) const
+  {
+    return (address == rhs.address && operation == rhs.operation && length == rhs.length);
+  }
+};
+
+std::vector<DecodedInstruction> GetDecodedInstructions(const BlockBase* block)
+{
+  std::vector<DecodedInstruction> instructions;
+  for (const Instruction& instruction : block->instructions)
+    instructions.push_back({instruction.address, instruction.operation, instruction.length});
+  return instructions;
+}
+
+} // namespace
+
+TEST(CPU_X86_BlockArena, LeftoverChunkSpace)
+{
+  BlockArena arena;
+
+  // Fill the first chunk up to 24 KiB from its end, which is too small for another 32 KiB allocation.
+  u8* chunk = static_cast<u8*>(arena.Allocate(32 * 1024));
+  for (u32 i = 1; i < 7; i++)
+    EXPECT_EQ(arena.Allocate(32 * 1024), chunk + i * 32 * 1024);
+  EXPECT_EQ(arena.Allocate(8 * 1024), chunk + 224 * 1024);
+  EXPECT_EQ(arena.GetReservedSize(), BlockArena::CHUNK_SIZE);
+
+  // The next 32 KiB comes from a new chunk, and the leftover is split into 16 KiB and 8 KiB pieces.
+  u8* next_chunk = static_cast<u8*>(arena.Allocate(32 * 1024));
+  EXPECT_TRUE(next_chunk < chunk || next_chunk >= (chunk + BlockArena::CHUNK_SIZE));
+  EXPECT_EQ(arena.GetReservedSize(), 2 * BlockArena::CHUNK_SIZE);
+  EXPECT_EQ(arena.Allocate(16 * 1024), chunk + 232 * 1024);
+  EXPECT_EQ(arena.Allocate(8 * 1024), chunk + 248 * 1024);
+
+  // Only now does the second chunk hand out smaller pieces.
+  EXPECT_EQ(arena.Allocate(8 * 1024), next_chunk + 32 * 1024);
+  EXPECT_EQ(arena.GetUsedSize(), size_t(8 * 32 + 8 + 16 + 8 + 8) * 1024);
+}
+
+TEST(CPU_X86_BlockArena, SizeClassRoundTrip)
+{
+  BlockArena arena;
+
+  // Sizes are rounded up to their class, and freed allocations are reused by any size in the same class.
+  void* ptr = arena.Allocate(100);
+  EXPECT_EQ(arena.GetUsedSize(), 128u);
+  arena.Free(ptr, 100);
+  EXPECT_EQ(arena.GetUsedSize(), 0u);
+  EXPECT_EQ(arena.Allocate(65), ptr);
+  EXPECT_EQ(arena.GetUsedSize(), 128u);
+
+  // Other classes don't take from the free list.
+  arena.Free(ptr, 128);
+  void* small = arena.Allocate(64);
+  EXPECT_NE(small, ptr);
+  EXPECT_EQ(arena.Allocate(128), ptr);
+  EXPECT_EQ(arena.GetUsedSize(), 192u);
+}
+
+TEST(CPU_X86_BlockArena, HeapFallback)
+{
+  BlockArena arena;
+
+  // Allocations above the largest class don't reserve a chunk, and are counted at their exact size.
+  void* large = arena.Allocate(32 * 1024 + 1);
+  ASSERT_NE(large, nullptr);
+  std::memset(large, 0xCC, 32 * 1024 + 1);
+  EXPECT_EQ(arena.GetReservedSize(), 0u);
+  EXPECT_EQ(arena.GetUsedSize(), 32u * 1024 + 1);
+  arena.Free(large, 32 * 1024 + 1);
+  EXPECT_EQ(arena.GetUsedSize(), 0u);
+
+  arena.Allocate(32 * 1024);
+  EXPECT_EQ(arena.GetReservedSize(), BlockArena::CHUNK_SIZE);
+}
+
+TEST(CPU_X86_BlockLinkList, GrowAndErase)
+{
+  std::vector<std::unique_ptr<BlockBase>> blocks;
+  for (u32 i = 0; i < 10; i++)
+    blocks.push_back(std::make_unique<BlockBase>(BlockKey{}));
+
+  BlockLinkList list;
+  auto IsInline = [&list]() {
+    const u8* data = reinterpret_cast<const u8*>(list.begin());
+    const u8* object = reinterpret_cast<const u8*>(&list);
+    return (data >= object && data < object + sizeof(list));
+  };
+
+  for (u32 i = 0; i < BlockLinkList::INLINE_CAPACITY; i++)
+    list.push_back(blocks[i].get());
+  EXPECT_TRUE(IsInline());
+
+  // Growing past the inline entries moves the list to the heap, keeping the order.
+  for (u32 i = BlockLinkList::INLINE_CAPACITY; i < blocks.size(); i++)
+    list.push_back(blocks[i].get());
+  EXPECT_FALSE(IsInline());
+  ASSERT_EQ(list.size(), blocks.size());
+  for (u32 i = 0; i < blocks.size(); i++)
+    EXPECT_EQ(list.begin()[i], blocks[i].get());
+
+  // Erasing shifts the later entries down, and returns the position of the next one.
+  BlockBase** next = list.erase(list.begin() + 2);
+  EXPECT_EQ(*next, blocks[3].get());
+  next = list.erase(list.end() - 1);
+  EXPECT_EQ(next, list.end());
+  const std::vector<BlockBase*> expected = {blocks[0].get(), blocks[1].get(), blocks[3].get(), blocks[4].get(),
+                                            blocks[5].get(), blocks[6].get(), blocks[7].get(), blocks[8].get()};
+  EXPECT_EQ(std::vector<BlockBase*>(list.begin(), list.end()), expected);
+  EXPECT_EQ(list.front(), blocks[0].get());
+
+  list.clear();
+  EXPECT_TRUE(list.empty());
+  EXPECT_TRUE(IsInline());
+  list.push_back(blocks[9].get());
+  EXPECT_EQ(list.front(), blocks[9].get());
+}
+
+TEST(CPU_X86_BlockStorage, RebuildAfterEviction)
+{
+  // The CPU halts at F000:0001, where the test blocks start.
+  const std::vector<u8> code = {
+    0xF4,       // hlt
+    0x84, 0xC0, // test al, al
+    0x74, 0x02, // jz $+4
+    0x40,       // inc ax
+    0x40,       // inc ax
+    0x43,       // inc bx
+    0xEB, 0xFE  // jmp $
+  };
+  StubSystemPointer<CPU_X86_TestSystem> system = RunROM(code, ::CPU::BackendType::Interpreter);
+  ASSERT_TRUE(system->GetX86CPU()->IsHalted());
+
+  // A plain block ending at the branch, and traces continuing past it in either direction. The taken trace skips the
+  // two increments, but they're still part of its code.
+  struct TestCase
+  {
+    u8 trace_branch_count;
+    u8 trace_branch_taken;
+    u32 instruction_count;
+    u32 code_length;
+  };
+  static constexpr TestCase test_cases[] = {{0, 0, 2, 4}, {1, 0, 6, 9}, {1, 1, 4, 9}};
+
+  BlockStorageTestBackend backend(system->GetX86CPU());
+  for (const TestCase& test_case : test_cases)
+  {
+    SCOPED_TRACE(testing::Message() << "trace branches " << u32(test_case.trace_branch_count) << " taken "
+                                    << u32(test_case.trace_branch_taken));
+
+    BlockStorageTestBackend::Block* block =
+      backend.DecodeCurrentBlock(test_case.trace_branch_count, test_case.trace_branch_taken);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(block->instruction_count, test_case.instruction_count);
+    EXPECT_EQ(block->code_length, test_case.code_length);
+    EXPECT_EQ(block->trace_branch_count, test_case.trace_branch_count);
+    EXPECT_EQ(block->trace_branch_taken, test_case.trace_branch_taken);
+    const std::vector<DecodedInstruction> decoded = GetDecodedInstructions(block);
+
+    // Installing the code releases the instructions, and evicting it leaves the block with neither.
+    backend.InstallBlockCode(block);
+    ASSERT_NE(block->code_pointer, nullptr);
+    EXPECT_TRUE(block->instructions.empty());
+    backend.EvictCodeSegment(block->code_segment);
+    EXPECT_EQ(block->code_pointer, nullptr);
+    EXPECT_TRUE(block->code_evicted);
+
+    // Rebuilding has to replay the trace, or the instructions won't match the code length and hash.
+    ASSERT_TRUE(backend.RebuildBlockInstructions(block));
+    EXPECT_EQ(GetDecodedInstructions(block), decoded);
+    EXPECT_EQ(block->instruction_count, test_case.instruction_count);
+    EXPECT_EQ(block->code_length, test_case.code_length);
+    EXPECT_EQ(block->trace_branch_count, test_case.trace_branch_count);
+    EXPECT_EQ(block->trace_branch_taken, test_case.trace_branch_taken);
+
+    backend.DestroyBlock(block);
+  }
+}
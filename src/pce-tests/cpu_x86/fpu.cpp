@@ -0,0 +1,90 @@
+#include "../stub_host_interface.h"
+#include "common/object_type_info.h"
+#include "common/property.h"
+#include "pce/bus.h"
+#include "system.h"
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <vector>
+
+namespace {
+
+constexpr double OPERAND_A = 1.5;
+constexpr double OPERAND_B = 2.25;
+constexpr double OPERAND_C = 3.1;
+constexpr double OPERAND_D = 0.7;
+constexpr PhysicalMemoryAddress RESULT_ADDRESS = 0x500;
+
+// Computes sqrt((a + b) * c / d) with the given control word, storing the double result at 0000:0500.
+u64 RunFPUProgram(CPU::BackendType backend, bool fast_fpu, u16 control_word)
+{
+  std::vector<u8> code = {
+    0x31, 0xC0,                   // xor ax, ax
+    0x8E, 0xD8,                   // mov ds, ax
+    0xDB, 0xE3,                   // fninit
+    0x2E, 0xD9, 0x2E, 0x00, 0x01, // fldcw cs:[0100h]
+    0x2E, 0xDD, 0x06, 0x08, 0x01, // fld qword cs:[0108h]
+    0x2E, 0xDC, 0x06, 0x10, 0x01, // fadd qword cs:[0110h]
+    0x2E, 0xDC, 0x0E, 0x18, 0x01, // fmul qword cs:[0118h]
+    0x2E, 0xDC, 0x36, 0x20, 0x01, // fdiv qword cs:[0120h]
+    0xD9, 0xFA,                   // fsqrt
+    0xDD, 0x1E, 0x00, 0x05,       // fstp qword [0500h]
+    0xF4                          // hlt
+  };
+  code.resize(0x0128);
+  std::memcpy(&code[0x0100], &control_word, sizeof(control_word));
+  std::memcpy(&code[0x0108], &OPERAND_A, sizeof(OPERAND_A));
+  std::memcpy(&code[0x0110], &OPERAND_B, sizeof(OPERAND_B));
+  std::memcpy(&code[0x0118], &OPERAND_C, sizeof(OPERAND_C));
+  std::memcpy(&code[0x0120], &OPERAND_D, sizeof(OPERAND_D));
+
+  StubSystemPointer<CPU_X86_TestSystem> system = CreateROMTestSystem(code, backend);
+
+  // The test runner doesn't register types, which is what builds the property table.
+  CPU_X86::CPU::StaticMutableTypeInfo()->RegisterType();
+  CPU_X86::CPU* cpu = system->GetX86CPU();
+  const PROPERTY_DECLARATION* property = cpu->GetTypeInfo()->GetPropertyDeclarationByName("FastFPU");
+  EXPECT_NE(property, nullptr);
+  if (!property || !SetPropertyValueFromString(cpu, property, fast_fpu ? "true" : "false"))
+    return 0;
+
+  EXPECT_TRUE(system->Execute(SecondsToSimulationTime(1))) << "system did not initialize or execution timed out";
+  EXPECT_TRUE(cpu->IsHalted()) << "CPU is not halted indicating the test did not finish";
+  return system->GetBus()->ReadMemoryQWord(RESULT_ADDRESS);
+}
+
+void TestFPUPrecision(CPU::BackendType backend)
+{
+  // Round to nearest with all exceptions masked, at 24-bit, 53-bit and 64-bit precision. The fast path only handles
+  // the first two, and has to give exactly the same results as softfloat there. At 24 bits it can only take operands
+  // which are floats, the double operands here fall back to softfloat. 64-bit precision always runs on softfloat.
+  for (const u16 control_word : {u16(0x007F), u16(0x027F), u16(0x037F)})
+  {
+    const u64 soft_result = RunFPUProgram(backend, false, control_word);
+    const u64 fast_result = RunFPUProgram(backend, true, control_word);
+    EXPECT_EQ(soft_result, fast_result) << "control word " << control_word;
+  }
+
+  // At 53-bit precision each step rounds the same way as host doubles.
+  const double expected = std::sqrt((OPERAND_A + OPERAND_B) * OPERAND_C / OPERAND_D);
+  u64 expected_bits;
+  std::memcpy(&expected_bits, &expected, sizeof(expected_bits));
+  EXPECT_EQ(RunFPUProgram(backend, true, 0x027F), expected_bits);
+}
+
+} // namespace
+
+TEST(CPU_X86_FPU, FastFPU_Interpreter)
+{
+  TestFPUPrecision(CPU::BackendType::Interpreter);
+}
+TEST(CPU_X86_FPU, FastFPU_CachedInterpreter)
+{
+  TestFPUPrecision(CPU::BackendType::CachedInterpreter);
+}
+TEST(CPU_X86_FPU, FastFPU_Recompiler)
+{
+  TestFPUPrecision(CPU::BackendType::Recompiler);
+}
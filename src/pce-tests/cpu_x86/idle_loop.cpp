@@ -0,0 +1,201 @@
+#include "../stub_host_interface.h"
+#include "pce/bus.h"
+#include "pce/cpu_x86/code_cache_types.h"
+#include "pce/cpu_x86/decoder.h"
+#include "pce/mmio.h"
+#include "system.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+using namespace CPU_X86;
+
+namespace {
+
+// Decodes 16-bit code at 0100h into a block, as CompileBlockBase would.
+bool DecodeBlock(std::initializer_list<u8> code, std::vector<Instruction>* instructions, BlockBase* block)
+{
+  const std::vector<u8> bytes(code);
+  size_t pos = 0;
+  auto fetch = [&bytes, &pos](void* val, size_t size) {
+    if ((pos + size) > bytes.size())
+      return false;
+
+    std::memcpy(val, &bytes[pos], size);
+    pos += size;
+    return true;
+  };
+  auto fetchb = [&fetch](u8* val) { return fetch(val, sizeof(*val)); };
+  auto fetchw = [&fetch](u16* val) { return fetch(val, sizeof(*val)); };
+  auto fetchd = [&fetch](u32* val) { return fetch(val, sizeof(*val)); };
+
+  VirtualMemoryAddress eip = 0x100;
+  instructions->clear();
+  instructions->reserve(bytes.size());
+  while (pos < bytes.size())
+  {
+    instructions->emplace_back();
+    Instruction* instruction = &instructions->back();
+    if (!Decoder::DecodeInstruction(instruction, AddressSize_16, OperandSize_16, eip, fetchb, fetchw, fetchd))
+      return false;
+
+    eip += instruction->length;
+  }
+
+  block->instructions.ptr = instructions->data();
+  block->instructions.count = static_cast<u32>(instructions->size());
+  return true;
+}
+
+bool IsIdleLoop(std::initializer_list<u8> code)
+{
+  std::vector<Instruction> instructions;
+  BlockBase block(BlockKey{});
+  return DecodeBlock(code, &instructions, &block) && IsIdleLoopBlock(&block, &block.idle_loop_reads);
+}
+
+// Runs a ROM which sets up its segments and spins in the given loop, returning the number of cycles skipped.
+u64 RunIdleLoop(std::initializer_list<u8> loop, ::CPU::BackendType backend, MMIO* mmio = nullptr)
+{
+  // xor ax, ax / mov ds, ax / mov es, ax
+  std::vector<u8> code = {0x31, 0xC0, 0x8E, 0xD8, 0x8E, 0xC0};
+  code.insert(code.end(), loop.begin(), loop.end());
+
+  StubSystemPointer<CPU_X86_TestSystem> system = CreateROMTestSystem(code, backend);
+  if (mmio)
+    system->GetBus()->ConnectMMIO(mmio);
+
+  // The loop never exits, so this always times out.
+  system->Execute(MillisecondsToSimulationTime(10));
+
+  ::CPU::ExecutionStats stats;
+  system->GetX86CPU()->GetExecutionStats(&stats);
+  return stats.idle_cycles_skipped;
+}
+
+void TestIdleLoopSkipping(::CPU::BackendType backend)
+{
+  // mov al, [0500h] / jmp $-3: RAM only changes when an event runs.
+  EXPECT_NE(RunIdleLoop({0xA0, 0x00, 0x05, 0xEB, 0xFB}, backend), 0u);
+
+  // in al, 21h / jmp $-2: the PIC isn't event-driven. The block's instructions have been released by the time the loop
+  // runs, so this also checks the port is recorded when the block is compiled.
+  EXPECT_EQ(RunIdleLoop({0xE4, 0x21, 0xEB, 0xFC}, backend), 0u);
+
+  // mov al, es:[di] / jmp $-3, with ES:DI pointing at MMIO.
+  MMIO::Handlers handlers;
+  handlers.IgnoreReads();
+  handlers.IgnoreWrites();
+  MMIO* mmio = MMIO::CreateComplex(0xA0000, 0x1000, std::move(handlers), false);
+  EXPECT_EQ(RunIdleLoop({0xB8, 0x00, 0xA0, 0x8E, 0xC0, 0x31, 0xFF, 0x26, 0x8A, 0x05, 0xEB, 0xFB}, backend, mmio), 0u);
+  mmio->Release();
+}
+
+} // namespace
+
+TEST(CPU_X86_IdleLoop, PollLoops)
+{
+  // in al, 60h / test al, 1 / jz $-4
+  EXPECT_TRUE(IsIdleLoop({0xE4, 0x60, 0xA8, 0x01, 0x74, 0xFA}));
+
+  // in al, 64h / and al, 2 / jnz $-4
+  EXPECT_TRUE(IsIdleLoop({0xE4, 0x64, 0x24, 0x02, 0x75, 0xFA}));
+
+  // mov ax, [046Ch] / cmp ax, bx / jz $-5
+  EXPECT_TRUE(IsIdleLoop({0xA1, 0x6C, 0x04, 0x3B, 0xC3, 0x74, 0xF9}));
+
+  // mov al, [bx] / cmp al, 0 / jz $-4
+  EXPECT_TRUE(IsIdleLoop({0x8A, 0x07, 0x3C, 0x00, 0x74, 0xFA}));
+
+  // jmp $
+  EXPECT_TRUE(IsIdleLoop({0xEB, 0xFE}));
+}
+
+TEST(CPU_X86_IdleLoop, BusyLoops)
+{
+  // add ax, 1 / cmp ax, 1000h / jnz $-6: the counter is carried between iterations.
+  EXPECT_FALSE(IsIdleLoop({0x05, 0x01, 0x00, 0x3D, 0x00, 0x10, 0x75, 0xF8}));
+
+  // mov al, [bx] / mov bl, 0 / jz $-4: the address depends on the previous iteration.
+  EXPECT_FALSE(IsIdleLoop({0x8A, 0x07, 0xB3, 0x00, 0x74, 0xFA}));
+
+  // mov [0500h], al / jmp $-3: writes memory.
+  EXPECT_FALSE(IsIdleLoop({0xA2, 0x00, 0x05, 0xEB, 0xFB}));
+
+  // out 80h, al / jmp $-2: writes a port.
+  EXPECT_FALSE(IsIdleLoop({0xE6, 0x80, 0xEB, 0xFC}));
+
+  // in al, 60h / test al, 1 / jz $+4: doesn't branch back to the start.
+  EXPECT_FALSE(IsIdleLoop({0xE4, 0x60, 0xA8, 0x01, 0x74, 0x02}));
+
+  // loop $: decrements CX.
+  EXPECT_FALSE(IsIdleLoop({0xE2, 0xFE}));
+}
+
+TEST(CPU_X86_IdleLoop, TimeDerivedPorts)
+{
+  std::unique_ptr<Bus> bus = std::make_unique<Bus>(20);
+  const int vga = 0, keyboard = 0;
+  bus->ConnectIOPortRead(0x3DA, &vga, [](u16) { return u8(0x00); });
+  bus->ConnectIOPortRead(0x64, &keyboard, [](u16) { return u8(0x00); });
+  bus->MarkIOPortReadEventDriven(0x64, &keyboard);
+
+  // in al, dx / test al, 8 / jz $-3: polling for vertical retrace, which comes from the current time not an event.
+  std::vector<Instruction> instructions;
+  BlockBase block(BlockKey{});
+  ASSERT_TRUE(DecodeBlock({0xEC, 0xA8, 0x08, 0x74, 0xFB}, &instructions, &block));
+  EXPECT_TRUE(IsIdleLoopBlock(&block, &block.idle_loop_reads));
+  EXPECT_FALSE(IsIdleLoopPortReadEventDriven(&block, bus.get(), 0x3DA));
+
+  // The same loop polling the keyboard controller status, or an unconnected port, can skip ahead.
+  EXPECT_TRUE(IsIdleLoopPortReadEventDriven(&block, bus.get(), 0x64));
+  EXPECT_TRUE(IsIdleLoopPortReadEventDriven(&block, bus.get(), 0x2F8));
+
+  // in al, 40h / test al, 1 / jz $-4: polling a PIT counter.
+  ASSERT_TRUE(DecodeBlock({0xE4, 0x40, 0xA8, 0x01, 0x74, 0xFA}, &instructions, &block));
+  EXPECT_TRUE(IsIdleLoopBlock(&block, &block.idle_loop_reads));
+  bus->ConnectIOPortRead(0x40, &vga, [](u16) { return u8(0x00); });
+  EXPECT_FALSE(IsIdleLoopPortReadEventDriven(&block, bus.get(), 0));
+
+  // mov dx, 3DAh / in al, dx / test al, 8 / jz $-8: DX is written in the loop, so the dispatcher can't rely on it.
+  EXPECT_FALSE(IsIdleLoop({0xBA, 0xDA, 0x03, 0xEC, 0xA8, 0x08, 0x74, 0xF8}));
+}
+
+TEST(CPU_X86_IdleLoop, RecordedReads)
+{
+  std::vector<Instruction> instructions;
+  BlockBase block(BlockKey{});
+
+  // in ax, 60h / cmp ax, [si+4] / jz $-6
+  ASSERT_TRUE(DecodeBlock({0xE5, 0x60, 0x3B, 0x44, 0x04, 0x74, 0xF9}, &instructions, &block));
+  IdleLoopReads reads;
+  ASSERT_TRUE(IsIdleLoopBlock(&block, &reads));
+  ASSERT_EQ(reads.count, 2u);
+  EXPECT_EQ(reads.reads[0].type, IdleLoopRead::Type::Port);
+  EXPECT_EQ(reads.reads[0].offset, 0x60u);
+  EXPECT_EQ(reads.reads[0].length, 2u);
+  EXPECT_EQ(reads.reads[1].type, IdleLoopRead::Type::Memory);
+  EXPECT_EQ(reads.reads[1].segment, Segment_DS);
+  EXPECT_EQ(reads.reads[1].offset, 4u);
+  EXPECT_EQ(reads.reads[1].base_register, static_cast<u8>(Reg16_SI));
+  EXPECT_EQ(reads.reads[1].index_register, IdleLoopRead::NO_REGISTER);
+  EXPECT_EQ(reads.reads[1].length, 2u);
+
+  // mov bx, [0500h] / mov al, [bx] / test al, al / jz $-8: the address is loaded in the loop, so it can't be checked
+  // with the register values when the loop is skipped.
+  EXPECT_FALSE(IsIdleLoop({0x8B, 0x1E, 0x00, 0x05, 0x8A, 0x07, 0x84, 0xC0, 0x74, 0xF6}));
+
+  // in al, 60h / in al, 61h / in al, 64h / jmp $-6: too many reads to record.
+  EXPECT_FALSE(IsIdleLoop({0xE4, 0x60, 0xE4, 0x61, 0xE4, 0x64, 0xEB, 0xF8}));
+}
+
+TEST(CPU_X86_IdleLoop, Skipping_CachedInterpreter)
+{
+  TestIdleLoopSkipping(::CPU::BackendType::CachedInterpreter);
+}
+TEST(CPU_X86_IdleLoop, Skipping_Recompiler)
+{
+  TestIdleLoopSkipping(::CPU::BackendType::Recompiler);
+}
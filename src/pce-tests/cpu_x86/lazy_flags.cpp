@@ -0,0 +1,151 @@
+#include "../stub_host_interface.h"
+#include "pce/bus.h"
+#include "system.h"
+#include <array>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+constexpr PhysicalMemoryAddress RESULTS_ADDRESS = 0x500;
+constexpr u32 RESULTS_SIZE = 0x31;
+constexpr u16 STATUS_FLAGS = 0x8D5; // OF/SF/ZF/AF/PF/CF
+
+// Every flag consumer the interpreter's dispatcher handles differently: PUSHF and LAHF write the recorded flags out,
+// INC/DEC carry CF over from the recorded operation, and SETcc/Jcc evaluate conditions from it. Results are stored from
+// 0000:0500.
+const std::vector<u8> FLAGS_PROGRAM = {
+  0x31, 0xC0,                         // xor ax, ax
+  0x8E, 0xD0,                         // mov ss, ax
+  0x8E, 0xD8,                         // mov ds, ax
+  0x8E, 0xC0,                         // mov es, ax
+  0xBC, 0x00, 0x7C,                   // mov sp, 7C00h
+  0xBF, 0x00, 0x05,                   // mov di, 0500h
+  0xFC,                               // cld
+  0xB0, 0x7F,                         // mov al, 7Fh
+  0x04, 0x01,                         // add al, 1
+  0x9C, 0x58, 0xAB,                   // pushf / pop ax / stosw
+  0xB8, 0x01, 0x00,                   // mov ax, 1
+  0x2D, 0x02, 0x00,                   // sub ax, 2
+  0x9C, 0x58, 0xAB,                   // pushf / pop ax / stosw
+  0xF9,                               // stc
+  0xB8, 0x00, 0x80,                   // mov ax, 8000h
+  0x48,                               // dec ax
+  0x9C, 0x58, 0xAB,                   // pushf / pop ax / stosw
+  0xBB, 0x05, 0x00,                   // mov bx, 5
+  0x83, 0xFB, 0x07,                   // cmp bx, 7
+  0x43,                               // inc bx
+  0x9C, 0x58, 0xAB,                   // pushf / pop ax / stosw
+  0xB1, 0xFF,                         // mov cl, 0FFh
+  0xFE, 0xC1,                         // inc cl
+  0x9C, 0x58, 0xAB,                   // pushf / pop ax / stosw
+  0x31, 0xD2,                         // xor dx, dx
+  0x81, 0xCA, 0x00, 0x80,             // or dx, 8000h
+  0x9C, 0x58, 0xAB,                   // pushf / pop ax / stosw
+  0x66, 0xB8, 0x00, 0x00, 0x00, 0x80, // mov eax, 80000000h
+  0x66, 0x01, 0xC0,                   // add eax, eax
+  0x9C, 0x58, 0xAB,                   // pushf / pop ax / stosw
+  0xB0, 0x0F,                         // mov al, 0Fh
+  0xA8, 0xF0,                         // test al, 0F0h
+  0x9F,                               // lahf
+  0x88, 0xE0,                         // mov al, ah
+  0xAA,                               // stosb
+  0xB8, 0x00, 0x80,                   // mov ax, 8000h
+  0x3D, 0x01, 0x00,                   // cmp ax, 1
+  0x0F, 0x90, 0x45, 0x00,             // seto [di+0]
+  0x0F, 0x91, 0x45, 0x01,             // setno [di+1]
+  0x0F, 0x92, 0x45, 0x02,             // setb [di+2]
+  0x0F, 0x93, 0x45, 0x03,             // setae [di+3]
+  0x0F, 0x94, 0x45, 0x04,             // sete [di+4]
+  0x0F, 0x95, 0x45, 0x05,             // setne [di+5]
+  0x0F, 0x96, 0x45, 0x06,             // setbe [di+6]
+  0x0F, 0x97, 0x45, 0x07,             // seta [di+7]
+  0x0F, 0x98, 0x45, 0x08,             // sets [di+8]
+  0x0F, 0x99, 0x45, 0x09,             // setns [di+9]
+  0x0F, 0x9A, 0x45, 0x0A,             // setp [di+10]
+  0x0F, 0x9B, 0x45, 0x0B,             // setnp [di+11]
+  0x0F, 0x9C, 0x45, 0x0C,             // setl [di+12]
+  0x0F, 0x9D, 0x45, 0x0D,             // setge [di+13]
+  0x0F, 0x9E, 0x45, 0x0E,             // setle [di+14]
+  0x0F, 0x9F, 0x45, 0x0F,             // setg [di+15]
+  0x83, 0xC7, 0x10,                   // add di, 16
+  0xB0, 0x01,                         // mov al, 1
+  0x2C, 0x02,                         // sub al, 2
+  0xB0, 0x01,                         // mov al, 1
+  0xFE, 0xC8,                         // dec al
+  0x0F, 0x90, 0x45, 0x00,             // seto [di+0]
+  0x0F, 0x91, 0x45, 0x01,             // setno [di+1]
+  0x0F, 0x92, 0x45, 0x02,             // setb [di+2]
+  0x0F, 0x93, 0x45, 0x03,             // setae [di+3]
+  0x0F, 0x94, 0x45, 0x04,             // sete [di+4]
+  0x0F, 0x95, 0x45, 0x05,             // setne [di+5]
+  0x0F, 0x96, 0x45, 0x06,             // setbe [di+6]
+  0x0F, 0x97, 0x45, 0x07,             // seta [di+7]
+  0x0F, 0x98, 0x45, 0x08,             // sets [di+8]
+  0x0F, 0x99, 0x45, 0x09,             // setns [di+9]
+  0x0F, 0x9A, 0x45, 0x0A,             // setp [di+10]
+  0x0F, 0x9B, 0x45, 0x0B,             // setnp [di+11]
+  0x0F, 0x9C, 0x45, 0x0C,             // setl [di+12]
+  0x0F, 0x9D, 0x45, 0x0D,             // setge [di+13]
+  0x0F, 0x9E, 0x45, 0x0E,             // setle [di+14]
+  0x0F, 0x9F, 0x45, 0x0F,             // setg [di+15]
+  0x83, 0xC7, 0x10,                   // add di, 16
+  0xB9, 0x0A, 0x00,                   // mov cx, 10
+  0x31, 0xC0,                         // xor ax, ax
+  0x01, 0xC8,                         // loop: add ax, cx
+  0x49,                               // dec cx
+  0x75, 0xFB,                         // jnz loop
+  0xAB,                               // stosw
+  0xF4                                // hlt
+};
+
+std::array<u8, RESULTS_SIZE> RunFlagsProgram(CPU::BackendType backend)
+{
+  StubSystemPointer<CPU_X86_TestSystem> system = RunROM(FLAGS_PROGRAM, backend);
+
+  std::array<u8, RESULTS_SIZE> results;
+  for (u32 i = 0; i < RESULTS_SIZE; i++)
+    results[i] = system->GetBus()->ReadMemoryByte(RESULTS_ADDRESS + i);
+  return results;
+}
+
+u16 ReadResultWord(const std::array<u8, RESULTS_SIZE>& results, u32 offset)
+{
+  return static_cast<u16>(results[offset] | (results[offset + 1] << 8));
+}
+
+} // namespace
+
+TEST(CPU_X86_LazyFlags, Interpreter)
+{
+  const std::array<u8, RESULTS_SIZE> results = RunFlagsProgram(CPU::BackendType::Interpreter);
+
+  // add al, 1 from 7Fh sets OF/SF/AF.
+  EXPECT_EQ(ReadResultWord(results, 0x00) & STATUS_FLAGS, 0x890);
+
+  // inc bx keeps the carry from cmp bx, 7, and 6 has even parity.
+  EXPECT_EQ(ReadResultWord(results, 0x06) & STATUS_FLAGS, 0x005);
+
+  // lahf after test al, 0F0h: ZF/PF and the reserved bit.
+  EXPECT_EQ(results[0x0E], 0x46);
+
+  // cmp 8000h, 1 overflows without borrowing. The result 7FFFh has even parity in the low byte.
+  static constexpr u8 cmp_conditions[16] = {1, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 0, 1, 0};
+  for (u32 i = 0; i < 16; i++)
+    EXPECT_EQ(results[0x0F + i], cmp_conditions[i]) << "condition " << i << " after cmp";
+
+  // dec al to zero keeps the carry from sub al, 2 across the mov in between.
+  static constexpr u8 dec_conditions[16] = {0, 1, 1, 0, 1, 0, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0};
+  for (u32 i = 0; i < 16; i++)
+    EXPECT_EQ(results[0x1F + i], dec_conditions[i]) << "condition " << i << " after dec";
+
+  EXPECT_EQ(ReadResultWord(results, 0x2F), 55);
+}
+
+TEST(CPU_X86_LazyFlags, MatchesEagerBackends)
+{
+  // The cached interpreter and recompiler always compute flags eagerly.
+  const std::array<u8, RESULTS_SIZE> lazy = RunFlagsProgram(CPU::BackendType::Interpreter);
+  EXPECT_EQ(lazy, RunFlagsProgram(CPU::BackendType::CachedInterpreter));
+  EXPECT_EQ(lazy, RunFlagsProgram(CPU::BackendType::Recompiler));
+}
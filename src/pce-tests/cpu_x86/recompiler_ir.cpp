@@ -0,0 +1,151 @@
+#include "pce/cpu_x86/decoder.h"
+#include "pce/cpu_x86/recompiler_ir.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <initializer_list>
+#include <vector>
+
+using namespace CPU_X86;
+using namespace CPU_X86::Recompiler;
+
+namespace {
+
+// Decodes 16-bit code at 0100h and runs the IR passes over it.
+class OptimizedIR
+{
+public:
+  OptimizedIR(std::initializer_list<u8> code)
+  {
+    const std::vector<u8> bytes(code);
+    size_t pos = 0;
+    auto fetch = [&bytes, &pos](void* val, size_t size) {
+      if ((pos + size) > bytes.size())
+        return false;
+
+      std::memcpy(val, &bytes[pos], size);
+      pos += size;
+      return true;
+    };
+    auto fetchb = [&fetch](u8* val) { return fetch(val, sizeof(*val)); };
+    auto fetchw = [&fetch](u16* val) { return fetch(val, sizeof(*val)); };
+    auto fetchd = [&fetch](u32* val) { return fetch(val, sizeof(*val)); };
+
+    VirtualMemoryAddress eip = 0x100;
+    while (pos < bytes.size())
+    {
+      m_instructions.emplace_back();
+      Instruction* instruction = &m_instructions.back();
+      if (!Decoder::DecodeInstruction(instruction, AddressSize_16, OperandSize_16, eip, fetchb, fetchw, fetchd))
+      {
+        m_instructions.pop_back();
+        break;
+      }
+
+      eip += instruction->length;
+    }
+
+    m_ir.Build(m_instructions.data(), m_instructions.size());
+    m_ir.Optimize();
+  }
+
+  size_t size() const { return m_ir.GetSize(); }
+  const IRInstruction& operator[](size_t index) const { return m_ir.begin()[index]; }
+
+private:
+  std::vector<Instruction> m_instructions;
+  IRBlock m_ir;
+};
+
+} // namespace
+
+TEST(CPU_X86_RecompilerIR, ConstantPropagation)
+{
+  // mov ax, 1234h / add ax, 1 / mov bx, ax / xor dx, dx / cmp ax, bx
+  const OptimizedIR ir({0xB8, 0x34, 0x12, 0x05, 0x01, 0x00, 0x89, 0xC3, 0x31, 0xD2, 0x39, 0xD8});
+  ASSERT_EQ(ir.size(), 5u);
+
+  // The add's flags are overwritten by the xor, so the result is folded.
+  EXPECT_TRUE(ir[1].HasConstantResult());
+  EXPECT_EQ(ir[1].result_value, 0x1235u);
+
+  EXPECT_TRUE(ir[2].HasConstantSource());
+  EXPECT_EQ(ir[2].source_value, 0x1235u);
+
+  EXPECT_TRUE(ir[3].HasConstantResult());
+  EXPECT_EQ(ir[3].result_value, 0u);
+
+  // Flags are live at the end of the block, but the source is still known.
+  EXPECT_FALSE(ir[4].HasConstantResult());
+  EXPECT_TRUE(ir[4].HasConstantSource());
+  EXPECT_EQ(ir[4].source_value, 0x1235u);
+}
+
+TEST(CPU_X86_RecompilerIR, DeadRegisterWrites)
+{
+  // mov ax, bx / mov ax, cx / cmp ax, cx / sub ax, ax
+  const OptimizedIR ir({0x89, 0xD8, 0x89, 0xC8, 0x39, 0xC8, 0x29, 0xC0});
+  ASSERT_EQ(ir.size(), 4u);
+  EXPECT_TRUE(ir[0].IsDeadResult());
+  EXPECT_FALSE(ir[1].IsDeadResult());
+  EXPECT_TRUE(ir[2].IsDeadResult());
+  EXPECT_FALSE(ir[3].IsDeadResult());
+  EXPECT_FALSE(ir[3].HasConstantResult());
+
+  // mov ax, bx / mov cx, [si] / mov ax, cx: the load can fault, and the fault has to see the first write.
+  const OptimizedIR faulting({0x89, 0xD8, 0x8B, 0x0C, 0x89, 0xC8});
+  ASSERT_EQ(faulting.size(), 3u);
+  EXPECT_FALSE(faulting[0].IsDeadResult());
+
+  // mov ax, bx / jz $+4 / mov ax, cx: the branch can be a side exit of a trace, which has to see the first write.
+  const OptimizedIR side_exit({0x89, 0xD8, 0x74, 0x02, 0x89, 0xC8});
+  ASSERT_EQ(side_exit.size(), 3u);
+  EXPECT_FALSE(side_exit[0].IsDeadResult());
+}
+
+TEST(CPU_X86_RecompilerIR, FlagLiveness)
+{
+  constexpr u32 all_flags = IRBlock::StatusFlagsMask;
+
+  // add ax, bx / inc cx / adc dx, si / sub ax, cx / clc / inc ax
+  const OptimizedIR ir({0x01, 0xD8, 0x41, 0x11, 0xF2, 0x29, 0xC8, 0xF8, 0x40});
+  ASSERT_EQ(ir.size(), 6u);
+
+  // Everything is live at the block end. The final inc leaves CF alone, and clc writes it, so none of the sub's flags
+  // are read.
+  EXPECT_EQ(ir[5].live_flags_after, all_flags);
+  EXPECT_EQ(ir[4].live_flags_after, u32(Flag_CF));
+  EXPECT_EQ(ir[3].live_flags_after, 0u);
+  EXPECT_EQ(ir[2].live_flags_after, 0u);
+
+  // adc reads the carry of the add, through the inc which leaves it alone.
+  EXPECT_EQ(ir[1].live_flags_after, u32(Flag_CF));
+  EXPECT_EQ(ir[0].live_flags_after, u32(Flag_CF));
+
+  // add ax, bx / mov cx, [si] / sub ax, ax: the load can fault, and the fault has to see the add's flags.
+  const OptimizedIR faulting({0x01, 0xD8, 0x8B, 0x0C, 0x29, 0xC0});
+  ASSERT_EQ(faulting.size(), 3u);
+  EXPECT_EQ(faulting[0].live_flags_after, all_flags);
+  EXPECT_EQ(faulting[1].live_flags_after, 0u);
+}
+
+TEST(CPU_X86_RecompilerIR, StackRuns)
+{
+  // push ax / push bx / push cx / push dx / pop si
+  const OptimizedIR ir({0x50, 0x53, 0x51, 0x52, 0x5E});
+  ASSERT_EQ(ir.size(), 5u);
+  EXPECT_TRUE(ir[0].IsStackRunStart());
+  EXPECT_EQ(GetStackRunCount(ir[0].stack_run), 4u);
+  EXPECT_EQ(GetStackRunRegister(ir[0].stack_run, 0), static_cast<u32>(Reg16_AX));
+  EXPECT_EQ(GetStackRunRegister(ir[0].stack_run, 3), static_cast<u32>(Reg16_DX));
+  EXPECT_EQ(GetStackRunInstructionLength(ir[0].stack_run), 1u);
+  for (size_t i = 1; i < 4; i++)
+    EXPECT_TRUE(ir[i].IsStackRunMember());
+  EXPECT_FALSE(ir[4].IsStackRunStart());
+  EXPECT_FALSE(ir[4].IsStackRunMember());
+
+  // push ax / push sp / push bx: pushing SP splits the run, leaving nothing to merge.
+  const OptimizedIR split({0x50, 0x54, 0x53});
+  ASSERT_EQ(split.size(), 3u);
+  for (size_t i = 0; i < split.size(); i++)
+    EXPECT_FALSE(split[i].IsStackRunStart() || split[i].IsStackRunMember());
+}
@@ -0,0 +1,49 @@
+#include "../stub_host_interface.h"
+#include "pce/bus.h"
+#include "system.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+constexpr u32 NUM_CALL_SITES = 8;
+constexpr u16 NUM_ITERATIONS = 1000;
+
+// Calls the same function from more sites than an indirect branch keeps linked targets for, so returns are only
+// predicted well if every call pushes the shadow return stack.
+CPU::ExecutionStats RunCallLoop(CPU::BackendType backend)
+{
+  std::vector<u8> code = {
+    0x31, 0xC0,      // xor ax, ax
+    0x8E, 0xD0,      // mov ss, ax
+    0xBC, 0x00, 0x7C // mov sp, 7C00h
+  };
+
+  // function: ret
+  EmitCallSiteLoop(&code, NUM_CALL_SITES, NUM_ITERATIONS, {0xC3});
+
+  StubSystemPointer<CPU_X86_TestSystem> system = RunROM(code, backend, CPU_X86::MODEL_486, 10000000.0f);
+
+  CPU::ExecutionStats stats;
+  system->GetX86CPU()->GetExecutionStats(&stats);
+  return stats;
+}
+
+void TestReturnPrediction(CPU::BackendType backend)
+{
+  // Only the first few returns, before their blocks are cached, can miss.
+  const CPU::ExecutionStats stats = RunCallLoop(backend);
+  EXPECT_GE(stats.branch_prediction_hits, u64(NUM_CALL_SITES) * (NUM_ITERATIONS - 10));
+  EXPECT_LE(stats.branch_prediction_misses, u64(NUM_CALL_SITES) * 10);
+}
+
+} // namespace
+
+TEST(CPU_X86_ReturnStack, CachedInterpreter)
+{
+  TestReturnPrediction(CPU::BackendType::CachedInterpreter);
+}
+TEST(CPU_X86_ReturnStack, Recompiler)
+{
+  TestReturnPrediction(CPU::BackendType::Recompiler);
+}
@@ -0,0 +1,97 @@
+#include "../stub_host_interface.h"
+#include "pce/bus.h"
+#include "system.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// Times each REP string operation with RDTSC, storing the cycle counts at 0000:0500. The first of each pair goes
+// through the bulk path, crossing a page boundary, and the second through the per-element path: MOVS because the copy
+// overlaps its source, and STOS because it runs backwards. It's repeated so the recompiler has compiled the code by
+// the last pass.
+const std::vector<u8> STRING_OPS_PROGRAM = {
+  0x31, 0xC0,                         // xor ax, ax
+  0x8E, 0xD8,                         // mov ds, ax
+  0x8E, 0xC0,                         // mov es, ax
+  0xFC,                               // cld
+  0xBD, 0x10, 0x00,                   // mov bp, 10h
+  0xBE, 0x80, 0x1F,                   // loop: mov si, 1F80h
+  0xBF, 0x80, 0x3F,                   // mov di, 3F80h
+  0xB9, 0x00, 0x01,                   // mov cx, 100h
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0xA3, 0x00, 0x05,             // mov [0500h], eax
+  0xF3, 0xA4,                         // rep movsb
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0x2B, 0x06, 0x00, 0x05,       // sub eax, [0500h]
+  0x66, 0xA3, 0x00, 0x05,             // mov [0500h], eax
+  0xBE, 0x80, 0x1F,                   // mov si, 1F80h
+  0xBF, 0x81, 0x1F,                   // mov di, 1F81h
+  0xB9, 0x00, 0x01,                   // mov cx, 100h
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0xA3, 0x04, 0x05,             // mov [0504h], eax
+  0xF3, 0xA4,                         // rep movsb
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0x2B, 0x06, 0x04, 0x05,       // sub eax, [0504h]
+  0x66, 0xA3, 0x04, 0x05,             // mov [0504h], eax
+  0xBF, 0x80, 0x3F,                   // mov di, 3F80h
+  0xB9, 0x00, 0x01,                   // mov cx, 100h
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0xA3, 0x08, 0x05,             // mov [0508h], eax
+  0xB0, 0xAA,                         // mov al, 0AAh
+  0xF3, 0xAA,                         // rep stosb
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0x2B, 0x06, 0x08, 0x05,       // sub eax, [0508h]
+  0x66, 0xA3, 0x08, 0x05,             // mov [0508h], eax
+  0xFD,                               // std
+  0xBF, 0x7F, 0x40,                   // mov di, 407Fh
+  0xB9, 0x00, 0x01,                   // mov cx, 100h
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0xA3, 0x0C, 0x05,             // mov [050Ch], eax
+  0xB0, 0xAA,                         // mov al, 0AAh
+  0xF3, 0xAA,                         // rep stosb
+  0x0F, 0x31,                         // rdtsc
+  0x66, 0x2B, 0x06, 0x0C, 0x05,       // sub eax, [050Ch]
+  0x66, 0xA3, 0x0C, 0x05,             // mov [050Ch], eax
+  0xFC,                               // cld
+  0x4D,                               // dec bp
+  0x75, 0x8D,                         // jnz loop
+  0xF4                                // hlt
+};
+
+void TestStringOpCycles(CPU::BackendType backend)
+{
+  // RDTSC needs a Pentium.
+  StubSystemPointer<CPU_X86_TestSystem> system = RunROM(STRING_OPS_PROGRAM, backend, CPU_X86::MODEL_PENTIUM);
+
+  const u32 bulk_movs_cycles = system->GetBus()->ReadMemoryDWord(0x500);
+  const u32 element_movs_cycles = system->GetBus()->ReadMemoryDWord(0x504);
+  const u32 bulk_stos_cycles = system->GetBus()->ReadMemoryDWord(0x508);
+  const u32 element_stos_cycles = system->GetBus()->ReadMemoryDWord(0x50C);
+  EXPECT_NE(bulk_movs_cycles, 0u);
+  EXPECT_EQ(bulk_movs_cycles, element_movs_cycles);
+  EXPECT_NE(bulk_stos_cycles, 0u);
+  EXPECT_EQ(bulk_stos_cycles, element_stos_cycles);
+
+  // Both copies and both fills did the same thing.
+  for (u32 i = 0; i < 0x100; i++)
+  {
+    EXPECT_EQ(system->GetBus()->ReadMemoryByte(0x3F80 + i), 0xAA) << "offset " << i;
+    EXPECT_EQ(system->GetBus()->ReadMemoryByte(0x1F80 + i), 0x00) << "offset " << i;
+  }
+}
+
+} // namespace
+
+TEST(CPU_X86_StringOps, BulkCycles_Interpreter)
+{
+  TestStringOpCycles(CPU::BackendType::Interpreter);
+}
+TEST(CPU_X86_StringOps, BulkCycles_CachedInterpreter)
+{
+  TestStringOpCycles(CPU::BackendType::CachedInterpreter);
+}
+TEST(CPU_X86_StringOps, BulkCycles_Recompiler)
+{
+  TestStringOpCycles(CPU::BackendType::Recompiler);
+}
@@ -2,6 +2,9 @@
 #include "YBaseLib/Log.h"
 #include "pce/bus.h"
 #include "pce/mmio.h"
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
 Log_SetChannel(CPU_X86_TestSystem);
 
 DEFINE_OBJECT_TYPE_INFO(CPU_X86_TestSystem);
@@ -38,6 +41,15 @@ bool CPU_X86_TestSystem::Initialize()
     }
   }
 
+  for (const ROMBuffer& rom : m_rom_buffers)
+  {
+    if (!m_bus->CreateROMRegionFromBuffer(rom.data.data(), static_cast<u32>(rom.data.size()), rom.load_address))
+    {
+      Log_ErrorPrintf("Failed to create ROM region at 0x%08X.", rom.load_address);
+      return false;
+    }
+  }
+
   // Mirror top 64KB.
   m_bus->MirrorRegion(UINT32_C(0xF0000), 0x10000, UINT32_C(0xFFFF0000));
   return true;
@@ -48,6 +60,12 @@ void CPU_X86_TestSystem::AddROMFile(const char* filename, PhysicalMemoryAddress
   m_rom_files.push_back({filename, load_address, expected_size});
 }
 
+void CPU_X86_TestSystem::AddROMBuffer(const void* data, u32 size, PhysicalMemoryAddress load_address)
+{
+  const u8* bytes = static_cast<const u8*>(data);
+  m_rom_buffers.push_back({std::vector<u8>(bytes, bytes + size), load_address});
+}
+
 bool CPU_X86_TestSystem::Execute(SimulationTime timeout /* = SecondsToSimulationTime(60) */)
 {
   if (!Initialize())
@@ -81,3 +99,48 @@ void CPU_X86_TestSystem::AddComponents()
 {
   m_interrupt_controller = CreateComponent<HW::i8259_PIC>("InterruptController");
 }
+
+StubSystemPointer<CPU_X86_TestSystem> CreateROMTestSystem(const std::vector<u8>& code, CPU::BackendType backend,
+                                                          CPU_X86::Model cpu_model /* = CPU_X86::MODEL_486 */,
+                                                          float cpu_frequency /* = 1000000.0f */)
+{
+  std::array<u8, CPU_X86_TestSystem::BIOS_ROM_SIZE> rom = {};
+  static constexpr u8 reset_vector[] = {0xEA, 0x00, 0x00, 0x00, 0xF0}; // jmp f000:0000
+  std::memcpy(&rom[0x0000], code.data(), code.size());
+  std::memcpy(&rom[0xFFF0], reset_vector, sizeof(reset_vector));
+
+  StubSystemPointer<CPU_X86_TestSystem> system =
+    StubHostInterface::CreateSystem<CPU_X86_TestSystem>(cpu_model, cpu_frequency, backend, 1024 * 1024);
+  system->AddROMBuffer(rom.data(), static_cast<u32>(rom.size()), CPU_X86_TestSystem::BIOS_ROM_ADDRESS);
+  return system;
+}
+
+StubSystemPointer<CPU_X86_TestSystem> RunROM(const std::vector<u8>& code, CPU::BackendType backend,
+                                             CPU_X86::Model cpu_model /* = CPU_X86::MODEL_486 */,
+                                             float cpu_frequency /* = 1000000.0f */,
+                                             SimulationTime timeout /* = SecondsToSimulationTime(1) */)
+{
+  StubSystemPointer<CPU_X86_TestSystem> system = CreateROMTestSystem(code, backend, cpu_model, cpu_frequency);
+  EXPECT_TRUE(system->Execute(timeout)) << "system did not initialize or execution timed out";
+  EXPECT_TRUE(system->GetX86CPU()->IsHalted()) << "CPU is not halted indicating the test did not finish";
+  return system;
+}
+
+void EmitCallSiteLoop(std::vector<u8>* code, u32 num_call_sites, u16 num_iterations, const std::vector<u8>& function)
+{
+  // mov cx, num_iterations
+  code->insert(code->end(), {0xB9, u8(num_iterations & 0xFF), u8(num_iterations >> 8)});
+
+  const size_t loop_start = code->size();
+  const size_t function_address = loop_start + (num_call_sites * 3) + 4;
+  for (u32 i = 0; i < num_call_sites; i++)
+  {
+    // call function
+    const u16 displacement = static_cast<u16>(function_address - (code->size() + 3));
+    code->insert(code->end(), {0xE8, u8(displacement & 0xFF), u8(displacement >> 8)});
+  }
+
+  // dec cx / jnz loop_start / hlt
+  code->insert(code->end(), {0x49, 0x75, u8(loop_start - (code->size() + 3)), 0xF4});
+  code->insert(code->end(), function.begin(), function.end());
+}
@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 
+#include "../stub_host_interface.h"
 #include "pce/cpu_x86/cpu_x86.h"
 #include "pce/hw/i8259_pic.h"
 #include "pce/system.h"
@@ -27,6 +28,7 @@ public:
   CPU_X86::CPU* GetX86CPU() const { return static_cast<CPU_X86::CPU*>(m_cpu); }
 
   void AddROMFile(const char* filename, PhysicalMemoryAddress load_address, u32 expected_size = 0);
+  void AddROMBuffer(const void* data, u32 size, PhysicalMemoryAddress load_address);
 
   bool Execute(SimulationTime timeout = SecondsToSimulationTime(60));
 
@@ -44,4 +46,27 @@ private:
     u32 expected_size;
   };
   std::vector<ROMFile> m_rom_files;
+
+  struct ROMBuffer
+  {
+    std::vector<u8> data;
+    PhysicalMemoryAddress load_address;
+  };
+  std::vector<ROMBuffer> m_rom_buffers;
 };
+
+// Creates a test system which runs code from F000:0000, at the start of the BIOS ROM. The rest of the ROM is zero,
+// apart from the reset vector jumping to the code.
+StubSystemPointer<CPU_X86_TestSystem> CreateROMTestSystem(const std::vector<u8>& code, CPU::BackendType backend,
+                                                          CPU_X86::Model cpu_model = CPU_X86::MODEL_486,
+                                                          float cpu_frequency = 1000000.0f);
+
+// Creates a test system for the code, and runs it until it halts.
+StubSystemPointer<CPU_X86_TestSystem> RunROM(const std::vector<u8>& code, CPU::BackendType backend,
+                                             CPU_X86::Model cpu_model = CPU_X86::MODEL_486,
+                                             float cpu_frequency = 1000000.0f,
+                                             SimulationTime timeout = SecondsToSimulationTime(1));
+
+// Appends 16-bit code calling function from num_call_sites sites in a loop, num_iterations times, then halting. The
+// function follows the loop, and CX is the loop counter.
+void EmitCallSiteLoop(std::vector<u8>* code, u32 num_call_sites, u16 num_iterations, const std::vector<u8>& function);
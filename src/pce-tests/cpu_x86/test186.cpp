@@ -82,6 +82,10 @@ static bool RunTest(CPU::BackendType backend, const char* code_file, const char*
   TEST(CPU_X86_Test186_Recompiler, name)                                                                               \
   {                                                                                                                    \
     EXPECT_TRUE(RunTest(CPU::BackendType::Recompiler, code_file, results_file));                                       \
+  }                                                                                                                    \
+  TEST(CPU_X86_Test186_Tiered, name)                                                                                   \
+  {                                                                                                                    \
+    EXPECT_TRUE(RunTest(CPU::BackendType::Tiered, code_file, results_file));                                           \
   }
 
 MAKE_TEST(add, "test186/add.bin", "test186/res_add.bin")
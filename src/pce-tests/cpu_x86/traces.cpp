@@ -0,0 +1,92 @@
+#include "../stub_host_interface.h"
+#include "pce/bus.h"
+#include "system.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+constexpr u32 NUM_CALL_SITES = 8;
+constexpr u16 NUM_ITERATIONS = 1000;
+constexpr u16 RARE_PATH_ITERATIONS = 199;
+
+struct TraceTestResult
+{
+  CPU::ExecutionStats stats;
+  u16 counters[3];
+};
+
+// Calls an outer function from more sites than an indirect branch keeps linked targets for, which calls the given
+// inner function, so the outer function's return is only predicted well if the shadow return stack stays balanced.
+// The inner function increments word counters at 0000:0500, 0000:0502 and 0000:0504.
+TraceTestResult RunTraceLoop(const std::vector<u8>& inner_function)
+{
+  std::vector<u8> code = {
+    0x31, 0xC0,      // xor ax, ax
+    0x8E, 0xD0,      // mov ss, ax
+    0x8E, 0xD8,      // mov ds, ax
+    0xBC, 0x00, 0x7C // mov sp, 7C00h
+  };
+
+  // outer_function: call inner_function / ret
+  std::vector<u8> outer_function = {0xE8, 0x01, 0x00, 0xC3};
+  outer_function.insert(outer_function.end(), inner_function.begin(), inner_function.end());
+  EmitCallSiteLoop(&code, NUM_CALL_SITES, NUM_ITERATIONS, outer_function);
+
+  // Traces are only formed by the tiered backend, which profiles branches in the cached interpreter first.
+  StubSystemPointer<CPU_X86_TestSystem> system =
+    RunROM(code, CPU::BackendType::Tiered, CPU_X86::MODEL_486, 10000000.0f);
+
+  TraceTestResult result;
+  system->GetX86CPU()->GetExecutionStats(&result.stats);
+  for (u32 i = 0; i < 3; i++)
+    result.counters[i] = system->GetBus()->ReadMemoryWord(0x500 + (i * 2));
+  return result;
+}
+
+} // namespace
+
+TEST(CPU_X86_Traces, SideExit)
+{
+  // The branch is not taken long enough for the trace to continue past it, then taken for the rest of the loop.
+  const TraceTestResult result = RunTraceLoop({
+    0x81, 0xF9, u8(RARE_PATH_ITERATIONS + 1), 0x00, // cmp cx, RARE_PATH_ITERATIONS + 1
+    0x72, 0x05,                                     // jb rare_path
+    0xFF, 0x06, 0x00, 0x05,                         // inc word [0500h]
+    0xC3,                                           // ret
+    0xFF, 0x06, 0x02, 0x05,                         // rare_path: inc word [0502h]
+    0xC3                                            // ret
+  });
+
+  EXPECT_EQ(result.counters[0], u16(NUM_CALL_SITES * (NUM_ITERATIONS - RARE_PATH_ITERATIONS)));
+  EXPECT_EQ(result.counters[1], u16(NUM_CALL_SITES * RARE_PATH_ITERATIONS));
+  EXPECT_GE(result.stats.code_cache_traces_formed, 1u);
+  EXPECT_EQ(result.stats.code_cache_trace_side_exits, u64(NUM_CALL_SITES) * RARE_PATH_ITERATIONS);
+
+  // Leaving the trace early skips its return, so it mustn't pop the return stack or link the rare path as the
+  // return's successor. Otherwise every side exit mispredicts the outer function's return.
+  EXPECT_LE(result.stats.branch_prediction_misses, u64(NUM_CALL_SITES) * 10);
+}
+
+TEST(CPU_X86_Traces, RecordedDirections)
+{
+  // The trace follows the first branch not taken and the second taken, which every iteration agrees with.
+  const TraceTestResult result = RunTraceLoop({
+    0x83, 0xF9, 0x00,       // cmp cx, 0
+    0x74, 0x12,             // je done
+    0xFF, 0x06, 0x00, 0x05, // inc word [0500h]
+    0x83, 0xF9, 0x00,       // cmp cx, 0
+    0x75, 0x04,             // jne skip
+    0xFF, 0x06, 0x04, 0x05, // inc word [0504h]
+    0xFF, 0x06, 0x02, 0x05, // skip: inc word [0502h]
+    0xC3,                   // ret
+    0xC3                    // done: ret
+  });
+
+  EXPECT_EQ(result.counters[0], u16(NUM_CALL_SITES * NUM_ITERATIONS));
+  EXPECT_EQ(result.counters[1], u16(NUM_CALL_SITES * NUM_ITERATIONS));
+  EXPECT_EQ(result.counters[2], 0u);
+  EXPECT_GE(result.stats.code_cache_traces_formed, 1u);
+  EXPECT_EQ(result.stats.code_cache_trace_side_exits, 0u);
+  EXPECT_LE(result.stats.branch_prediction_misses, u64(NUM_CALL_SITES) * 10);
+}
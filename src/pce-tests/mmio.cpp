@@ -0,0 +1,92 @@
+#include "pce/bus.h"
+#include "pce/mmio.h"
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace {
+
+// Byte-wide registers, like a device which only decodes single bytes.
+class ByteDevice
+{
+public:
+  u8 ReadByte(u32 offset)
+  {
+    byte_reads++;
+    return data[offset];
+  }
+  void WriteByte(u32 offset, u8 value)
+  {
+    byte_writes++;
+    data[offset] = value;
+  }
+  void WriteBlock(u32 offset, u32 length, const void* source)
+  {
+    block_writes++;
+    std::memcpy(&data[offset], source, length);
+  }
+
+  std::array<u8, 4096> data = {};
+  u32 byte_reads = 0;
+  u32 byte_writes = 0;
+  u32 block_writes = 0;
+};
+
+} // namespace
+
+TEST(MMIO, BoundHandlers)
+{
+  ByteDevice device;
+  MMIO::Handlers handlers;
+  handlers.Bind<&ByteDevice::ReadByte>(&device);
+  handlers.Bind<&ByteDevice::WriteByte>(&device);
+  MMIO* mmio = MMIO::CreateComplex(0xA0000, 4096, std::move(handlers));
+
+  // Wider accesses are split down to the bound byte handlers.
+  mmio->WriteQWord(0xA0010, UINT64_C(0x0123456789ABCDEF));
+  EXPECT_EQ(device.byte_writes, 8u);
+  EXPECT_EQ(mmio->ReadDWord(0xA0014), 0x01234567u);
+  EXPECT_EQ(mmio->ReadByte(0xA0010), 0xEF);
+  EXPECT_EQ(device.byte_reads, 5u);
+  EXPECT_EQ(mmio->GetAccessCount(), 3u);
+
+  // Without a block handler, blocks are split too, and the region isn't used for string operations.
+  EXPECT_FALSE(mmio->HasReadBlockHandler());
+  EXPECT_FALSE(mmio->HasWriteBlockHandler());
+  std::array<u8, 8> block;
+  mmio->ReadBlock(0xA0010, 8, block.data());
+  EXPECT_EQ(std::memcmp(block.data(), &device.data[0x10], block.size()), 0);
+
+  // Mirrors call the same handlers.
+  MMIO* mirror = MMIO::CreateMirror(0xB0000, 4096, mmio);
+  EXPECT_EQ(mirror->ReadWord(0xB0016), 0x0123);
+  mirror->Release();
+  mmio->Release();
+}
+
+TEST(MMIO, BusBlockTransfers)
+{
+  std::unique_ptr<Bus> bus = std::make_unique<Bus>(20);
+  ByteDevice device;
+  MMIO::Handlers handlers;
+  handlers.Bind<&ByteDevice::ReadByte>(&device);
+  handlers.Bind<&ByteDevice::WriteByte>(&device);
+  handlers.Bind<&ByteDevice::WriteBlock>(&device);
+  MMIO* mmio = MMIO::CreateComplex(0xA0000, 4096, std::move(handlers));
+  bus->ConnectMMIO(mmio);
+
+  const std::array<u8, 16> source = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+  EXPECT_TRUE(bus->WriteMMIOBlock(0xA0100, static_cast<u32>(source.size()), source.data()));
+  EXPECT_EQ(device.block_writes, 1u);
+  EXPECT_EQ(device.byte_writes, 0u);
+  EXPECT_EQ(std::memcmp(&device.data[0x100], source.data(), source.size()), 0);
+
+  // Reads have no block handler, and unmapped pages aren't MMIO.
+  std::array<u8, 16> destination;
+  EXPECT_FALSE(bus->ReadMMIOBlock(0xA0100, static_cast<u32>(destination.size()), destination.data()));
+  EXPECT_FALSE(bus->WriteMMIOBlock(0xB0000, static_cast<u32>(source.size()), source.data()));
+
+  bus->DisconnectMMIO(mmio);
+  mmio->Release();
+}
@@ -0,0 +1,50 @@
+#include "cpu_x86/system.h"
+#include "pce/timing_event.h"
+#include <array>
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+TEST(TimingEvent, DispatchOrder)
+{
+  CPU_X86_TestSystem system;
+
+  // Each event tracks the time it has seen through its cycles, with 1ns cycles.
+  std::vector<std::pair<char, SimulationTime>> dispatched;
+  std::array<SimulationTime, 3> event_time = {};
+  auto make_callback = [&dispatched, &event_time](char name) {
+    return [&dispatched, &event_time, name](TimingEvent*, CycleCount cycles, CycleCount) {
+      event_time[name - 'A'] += cycles;
+      dispatched.emplace_back(name, event_time[name - 'A']);
+    };
+  };
+  std::unique_ptr<TimingEvent> a = system.CreateNanosecondEvent("A", 100, make_callback('A'), true);
+  std::unique_ptr<TimingEvent> b = system.CreateNanosecondEvent("B", 250, make_callback('B'), true);
+  std::unique_ptr<TimingEvent> c = system.CreateNanosecondEvent("C", 30, make_callback('C'), true);
+
+  // Removing an event from the middle of the heap leaves the others in order.
+  c->Deactivate();
+
+  system.AddSimulationTime(1000);
+  system.RunEvents();
+  ASSERT_EQ(dispatched.size(), 14u);
+  EXPECT_EQ(system.GetEventsDispatched(), 14u);
+  EXPECT_EQ(event_time[0], 1000);
+  EXPECT_EQ(event_time[1], 1000);
+  EXPECT_EQ(event_time[2], 0);
+  for (size_t i = 1; i < dispatched.size(); i++)
+    EXPECT_LE(dispatched[i - 1].second, dispatched[i].second);
+
+  // Rescheduling outside a callback counts from the current time, keeping the cycles since the last run.
+  system.AddSimulationTime(40);
+  EXPECT_EQ(a->GetTimeSinceLastExecution(), 40);
+  a->Reschedule(10);
+  EXPECT_EQ(a->GetTimeUntilNextExecution(), 10);
+  dispatched.clear();
+  system.AddSimulationTime(10);
+  system.RunEvents();
+  ASSERT_EQ(dispatched.size(), 1u);
+  EXPECT_EQ(dispatched[0].first, 'A');
+  EXPECT_EQ(event_time[0], 1050);
+}
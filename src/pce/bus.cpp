@@ -25,6 +25,10 @@ Bus::Bus(u32 memory_address_bits, const ObjectTypeInfo* type_info /* = &s_type_i
   AllocateMemoryPages(memory_address_bits);
   m_ioport_handlers = new IOPortConnection*[NUM_IOPORTS];
   std::memset(m_ioport_handlers, 0, sizeof(IOPortConnection*) * NUM_IOPORTS);
+  m_ioport_dispatch = std::make_unique<IOPortDispatch[]>(NUM_IOPORTS);
+  for (u32 i = 0; i < NUM_IOPORTS; i++)
+    UpdateIOPortDispatch(Truncate16(i));
+  ClearPageTableWriteCallback();
 }
 
 Bus::~Bus()
@@ -181,6 +185,240 @@ void Bus::RemoveIOPortConnection(u16 port, const void* owner)
     conn = conn->next;
     delete temp;
   }
+
+  UpdateIOPortDispatch(port);
+}
+
+static u8 ReadUnconnectedIOPort(void* context, u16 port)
+{
+  Log_DebugPrintf("Unknown IO port 0x%04X (read)", port);
+  return 0xFF;
+}
+
+static void WriteUnconnectedIOPort(void* context, u16 port, u8 value)
+{
+  Log_DebugPrintf("Unknown IO port 0x%04X (write), value = %04X", port, value);
+}
+
+template<typename T>
+static void WriteIgnoredIOPort(void* context, u16 port, T value)
+{
+}
+
+template<typename T>
+static T ReadIOPortHandler(void* context, u16 port)
+{
+  return (*static_cast<const std::function<T(u16)>*>(context))(port);
+}
+
+template<typename T>
+static void WriteIOPortHandler(void* context, u16 port, T value)
+{
+  (*static_cast<const std::function<void(u16, T)>*>(context))(port, value);
+}
+
+static u8 ReadIOPortPointer(void* context, u16 port)
+{
+  return *static_cast<const u8*>(context);
+}
+
+static void WriteIOPortPointer(void* context, u16 port, u8 value)
+{
+  *static_cast<u8*>(context) = value;
+}
+
+// Ports which do not support 16-bit IO are accessed as two 8-bit ports.
+static u16 ReadIOPortWordAsBytes(void* context, u16 port)
+{
+  Bus* bus = static_cast<Bus*>(context);
+  const u8 b0 = bus->ReadIOPortByte(port + 0);
+  const u8 b1 = bus->ReadIOPortByte(port + 1);
+  return ZeroExtend16(b0) | (ZeroExtend16(b1) << 8);
+}
+
+static void WriteIOPortWordAsBytes(void* context, u16 port, u16 value)
+{
+  Bus* bus = static_cast<Bus*>(context);
+  bus->WriteIOPortByte(port + 0, Truncate8(value >> 0));
+  bus->WriteIOPortByte(port + 1, Truncate8(value >> 8));
+}
+
+// Ports which do not support 32-bit IO are accessed as two 16-bit ports. If neither of those supports 16-bit IO
+// either, the access goes straight to the four 8-bit ports.
+static u32 ReadIOPortDWordAsWords(void* context, u16 port)
+{
+  Bus* bus = static_cast<Bus*>(context);
+  const u16 b0 = bus->ReadIOPortWord(port + 0);
+  const u16 b1 = bus->ReadIOPortWord(port + 2);
+  return ZeroExtend32(b0) | (ZeroExtend32(b1) << 16);
+}
+
+static void WriteIOPortDWordAsWords(void* context, u16 port, u32 value)
+{
+  Bus* bus = static_cast<Bus*>(context);
+  bus->WriteIOPortWord(port + 0, Truncate16(value >> 0));
+  bus->WriteIOPortWord(port + 2, Truncate16(value >> 16));
+}
+
+static u32 ReadIOPortDWordAsBytes(void* context, u16 port)
+{
+  Bus* bus = static_cast<Bus*>(context);
+  const u8 b0 = bus->ReadIOPortByte(port + 0);
+  const u8 b1 = bus->ReadIOPortByte(port + 1);
+  const u8 b2 = bus->ReadIOPortByte(port + 2);
+  const u8 b3 = bus->ReadIOPortByte(port + 3);
+  return ZeroExtend32(b0) | (ZeroExtend32(b1) << 8) | (ZeroExtend32(b2) << 16) | (ZeroExtend32(b3) << 24);
+}
+
+static void WriteIOPortDWordAsBytes(void* context, u16 port, u32 value)
+{
+  Bus* bus = static_cast<Bus*>(context);
+  bus->WriteIOPortByte(port + 0, Truncate8(value >> 0));
+  bus->WriteIOPortByte(port + 1, Truncate8(value >> 8));
+  bus->WriteIOPortByte(port + 2, Truncate8(value >> 16));
+  bus->WriteIOPortByte(port + 3, Truncate8(value >> 24));
+}
+
+void Bus::WriteIOPortByteListeners(void* context, u16 port, u8 value)
+{
+  for (const IOPortConnection* conn = static_cast<const IOPortConnection*>(context); conn; conn = conn->next)
+  {
+    if (conn->write_pointer)
+      *conn->write_pointer = value;
+    else if (conn->write_byte_handler)
+      conn->write_byte_handler(port, value);
+  }
+}
+
+void Bus::WriteIOPortWordListeners(void* context, u16 port, u16 value)
+{
+  for (const IOPortConnection* conn = static_cast<const IOPortConnection*>(context); conn; conn = conn->next)
+  {
+    if (conn->write_word_handler)
+      conn->write_word_handler(port, value);
+  }
+}
+
+void Bus::WriteIOPortDWordListeners(void* context, u16 port, u32 value)
+{
+  for (const IOPortConnection* conn = static_cast<const IOPortConnection*>(context); conn; conn = conn->next)
+  {
+    if (conn->write_dword_handler)
+      conn->write_dword_handler(port, value);
+  }
+}
+
+void Bus::UpdateIOPortDispatch(u16 port)
+{
+  IOPortDispatch& dispatch = m_ioport_dispatch[port];
+  IOPortConnection* head = m_ioport_handlers[port];
+
+  // Reads are serviced by the first connection with a handler for the width, every connection sees writes.
+  IOPortConnection* read_byte = nullptr;
+  IOPortConnection* read_word = nullptr;
+  IOPortConnection* read_dword = nullptr;
+  IOPortConnection* write_byte = nullptr;
+  IOPortConnection* write_word = nullptr;
+  IOPortConnection* write_dword = nullptr;
+  u32 write_byte_count = 0;
+  u32 write_word_count = 0;
+  u32 write_dword_count = 0;
+  for (IOPortConnection* conn = head; conn; conn = conn->next)
+  {
+    if (!read_byte && (conn->read_pointer || conn->read_byte_handler))
+      read_byte = conn;
+    if (!read_word && conn->read_word_handler)
+      read_word = conn;
+    if (!read_dword && conn->read_dword_handler)
+      read_dword = conn;
+    if (conn->write_pointer || conn->write_byte_handler)
+    {
+      write_byte = write_byte ? write_byte : conn;
+      write_byte_count++;
+    }
+    if (conn->write_word_handler)
+    {
+      write_word = write_word ? write_word : conn;
+      write_word_count++;
+    }
+    if (conn->write_dword_handler)
+    {
+      write_dword = write_dword ? write_dword : conn;
+      write_dword_count++;
+    }
+  }
+
+  if (!read_byte)
+    dispatch.read_byte = {ReadUnconnectedIOPort, this};
+  else if (read_byte->read_pointer)
+    dispatch.read_byte = {ReadIOPortPointer, const_cast<u8*>(read_byte->read_pointer)};
+  else
+    dispatch.read_byte = {ReadIOPortHandler<u8>, &read_byte->read_byte_handler};
+
+  if (read_word)
+    dispatch.read_word = {ReadIOPortHandler<u16>, &read_word->read_word_handler};
+  else
+    dispatch.read_word = {ReadIOPortWordAsBytes, this};
+
+  if (read_dword)
+    dispatch.read_dword = {ReadIOPortHandler<u32>, &read_dword->read_dword_handler};
+  else
+    dispatch.read_dword = {ReadIOPortDWordAsWords, this};
+
+  if (!head)
+    dispatch.write_byte = {WriteUnconnectedIOPort, this};
+  else if (write_byte_count == 0)
+    dispatch.write_byte = {WriteIgnoredIOPort<u8>, this};
+  else if (write_byte_count > 1)
+    dispatch.write_byte = {WriteIOPortByteListeners, head};
+  else if (write_byte->write_pointer)
+    dispatch.write_byte = {WriteIOPortPointer, write_byte->write_pointer};
+  else
+    dispatch.write_byte = {WriteIOPortHandler<u8>, &write_byte->write_byte_handler};
+
+  // Wide writes are only split when the first connection has no handler for the width.
+  if (!head || !head->write_word_handler)
+    dispatch.write_word = {WriteIOPortWordAsBytes, this};
+  else if (write_word_count > 1)
+    dispatch.write_word = {WriteIOPortWordListeners, head};
+  else
+    dispatch.write_word = {WriteIOPortHandler<u16>, &write_word->write_word_handler};
+
+  if (!head || !head->write_dword_handler)
+    dispatch.write_dword = {WriteIOPortDWordAsWords, this};
+  else if (write_dword_count > 1)
+    dispatch.write_dword = {WriteIOPortDWordListeners, head};
+  else
+    dispatch.write_dword = {WriteIOPortHandler<u32>, &write_dword->write_dword_handler};
+
+  // Block transfers bypass the other connections, so they can only be used when there aren't any.
+  const bool single_connection = (head && !head->next);
+  dispatch.read_block = (single_connection && head->read_block_handler) ? &head->read_block_handler : nullptr;
+  dispatch.write_block = (single_connection && head->write_block_handler) ? &head->write_block_handler : nullptr;
+
+  // Split dword accesses depend on the word handlers of this port and the one two below it.
+  UpdateIOPortDWordSplit(port);
+  UpdateIOPortDWordSplit(static_cast<u16>(port - 2));
+}
+
+void Bus::UpdateIOPortDWordSplit(u16 port)
+{
+  IOPortDispatch& dispatch = m_ioport_dispatch[port];
+  const IOPortDispatch& high_dispatch = m_ioport_dispatch[static_cast<u16>(port + 2)];
+
+  if (dispatch.read_dword.fn == ReadIOPortDWordAsWords || dispatch.read_dword.fn == ReadIOPortDWordAsBytes)
+  {
+    const bool split_to_bytes =
+      (dispatch.read_word.fn == ReadIOPortWordAsBytes && high_dispatch.read_word.fn == ReadIOPortWordAsBytes);
+    dispatch.read_dword.fn = split_to_bytes ? ReadIOPortDWordAsBytes : ReadIOPortDWordAsWords;
+  }
+
+  if (dispatch.write_dword.fn == WriteIOPortDWordAsWords || dispatch.write_dword.fn == WriteIOPortDWordAsBytes)
+  {
+    const bool split_to_bytes =
+      (dispatch.write_word.fn == WriteIOPortWordAsBytes && high_dispatch.write_word.fn == WriteIOPortWordAsBytes);
+    dispatch.write_dword.fn = split_to_bytes ? WriteIOPortDWordAsBytes : WriteIOPortDWordAsWords;
+  }
 }
 
 void Bus::ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteHandler read_callback)
@@ -190,6 +428,8 @@ void Bus::ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteHandler r
     connection = CreateIOPortConnection(port, owner);
 
   connection->read_byte_handler = std::move(read_callback);
+  connection->read_pointer = nullptr;
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortReadWord(u16 port, const void* owner, IOPortReadWordHandler read_callback)
@@ -199,6 +439,7 @@ void Bus::ConnectIOPortReadWord(u16 port, const void* owner, IOPortReadWordHandl
     connection = CreateIOPortConnection(port, owner);
 
   connection->read_word_handler = std::move(read_callback);
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortReadDWord(u16 port, const void* owner, IOPortReadDWordHandler read_callback)
@@ -208,6 +449,7 @@ void Bus::ConnectIOPortReadDWord(u16 port, const void* owner, IOPortReadDWordHan
     connection = CreateIOPortConnection(port, owner);
 
   connection->read_dword_handler = std::move(read_callback);
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteHandler write_callback)
@@ -217,6 +459,8 @@ void Bus::ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteHandler
     connection = CreateIOPortConnection(port, owner);
 
   connection->write_byte_handler = std::move(write_callback);
+  connection->write_pointer = nullptr;
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordHandler write_callback)
@@ -226,6 +470,7 @@ void Bus::ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordHan
     connection = CreateIOPortConnection(port, owner);
 
   connection->write_word_handler = std::move(write_callback);
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordHandler write_callback)
@@ -235,6 +480,27 @@ void Bus::ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordH
     connection = CreateIOPortConnection(port, owner);
 
   connection->write_dword_handler = std::move(write_callback);
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortReadBlock(u16 port, const void* owner, IOPortReadBlockHandler read_callback)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->read_block_handler = std::move(read_callback);
+  UpdateIOPortDispatch(port);
+}
+
+void Bus::ConnectIOPortWriteBlock(u16 port, const void* owner, IOPortWriteBlockHandler write_callback)
+{
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
+
+  connection->write_block_handler = std::move(write_callback);
+  UpdateIOPortDispatch(port);
 }
 
 void Bus::DisconnectIOPort(u16 port, const void* owner)
@@ -267,133 +533,61 @@ void Bus::DisconnectIOPorts(const void* owner)
   m_ioport_owners.erase(iter);
 }
 
-u8 Bus::ReadIOPortByte(u16 port)
+u32 Bus::ReadIOPortBlock(u16 port, u32 size, u32 count, void* destination)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  while (conn)
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->read_byte_handler)
-      return current->read_byte_handler(port);
-  }
-
-  Log_DebugPrintf("Unknown IO port 0x%04X (read)", port);
-  return 0xFF;
+  const IOPortReadBlockHandler* handler = m_ioport_dispatch[port].read_block;
+  return handler ? (*handler)(port, size, count, destination) : 0;
 }
 
-u16 Bus::ReadIOPortWord(u16 port)
+u32 Bus::WriteIOPortBlock(u16 port, u32 size, u32 count, const void* source)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  while (conn)
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->read_word_handler)
-      return current->read_word_handler(port);
-  }
-
-  // If this port does not support 16-bit IO, write as two 8-bit ports.
-  const u8 b0 = ReadIOPortByte(port + 0);
-  const u8 b1 = ReadIOPortByte(port + 1);
-  return ZeroExtend16(b0) | (ZeroExtend16(b1) << 8);
+  const IOPortWriteBlockHandler* handler = m_ioport_dispatch[port].write_block;
+  return handler ? (*handler)(port, size, count, source) : 0;
 }
 
-u32 Bus::ReadIOPortDWord(u16 port)
+// Pointer connections are read and written directly by the dispatch table, without going through a handler.
+void Bus::ConnectIOPortReadToPointer(u16 port, const void* owner, const u8* var)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  while (conn)
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->read_dword_handler)
-      return current->read_dword_handler(port);
-  }
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
 
-  // If this port does not support 32-bit IO, write as two 16-bit ports, which will
-  // turn into 2 8-bit ports.
-  const u16 b0 = ReadIOPortWord(port + 0);
-  const u16 b1 = ReadIOPortWord(port + 2);
-  return ZeroExtend32(b0) | (ZeroExtend32(b1) << 16);
+  connection->read_byte_handler = nullptr;
+  connection->read_pointer = var;
+  UpdateIOPortDispatch(port);
 }
 
-void Bus::WriteIOPortByte(u16 port, u8 value)
+void Bus::ConnectIOPortWriteToPointer(u16 port, const void* owner, u8* var)
 {
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  if (!conn)
-  {
-    Log_DebugPrintf("Unknown IO port 0x%04X (write), value = %04X", port, value);
-    return;
-  }
-
-  do
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->write_byte_handler)
-      current->write_byte_handler(port, value);
-  } while (conn);
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
 
-  // Log_TracePrintf("Write to ioport 0x%04X: 0x%02X", port, value);
+  connection->write_byte_handler = nullptr;
+  connection->write_pointer = var;
+  UpdateIOPortDispatch(port);
 }
 
-void Bus::WriteIOPortWord(u16 port, u16 value)
+void Bus::MarkIOPortReadEventDriven(u16 port, const void* owner)
 {
-  // If this port does not support 16-bit IO, write as two 8-bit ports.
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  if (!conn || !conn->write_word_handler)
-  {
-    WriteIOPortByte(port + 0, Truncate8(value >> 0));
-    WriteIOPortByte(port + 1, Truncate8(value >> 8));
-    return;
-  }
-
-  do
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->write_word_handler)
-      current->write_word_handler(port, value);
-  } while (conn);
+  IOPortConnection* connection = GetIOPortConnection(port, owner);
+  if (!connection)
+    connection = CreateIOPortConnection(port, owner);
 
-  // Log_TracePrintf("Write to ioport 0x%04X: 0x%04X", port, ZeroExtend32(value));
+  connection->read_event_driven = true;
 }
 
-void Bus::WriteIOPortDWord(u16 port, u32 value)
+bool Bus::IsIOPortReadEventDriven(u16 port) const
 {
-  // If this port does not support 32-bit IO, write as two 16-bit ports
-  // (which will turn into 2 8-bit ports).
-  const IOPortConnection* conn = m_ioport_handlers[port];
-  if (!conn || !conn->write_dword_handler)
+  for (const IOPortConnection* connection = m_ioport_handlers[port]; connection; connection = connection->next)
   {
-    WriteIOPortWord(port + 0, Truncate16(value >> 0));
-    WriteIOPortWord(port + 2, Truncate16(value >> 16));
-    return;
+    const bool has_read = (connection->read_pointer || connection->read_byte_handler ||
+                           connection->read_word_handler || connection->read_dword_handler);
+    if (has_read && !connection->read_event_driven)
+      return false;
   }
 
-  do
-  {
-    const IOPortConnection* current = conn;
-    conn = conn->next;
-    if (current->write_dword_handler)
-      current->write_dword_handler(port, value);
-  } while (conn);
-
-  // Log_TracePrintf("Write to ioport 0x%04X: 0x%04X", port, ZeroExtend32(value));
-}
-
-void Bus::ConnectIOPortReadToPointer(u16 port, const void* owner, const u8* var)
-{
-  IOPortReadByteHandler read_handler = [var](u16 cb_port) { return *var; };
-
-  ConnectIOPortRead(port, owner, std::move(read_handler));
-}
-
-void Bus::ConnectIOPortWriteToPointer(u16 port, const void* owner, u8* var)
-{
-  IOPortWriteByteHandler write_handler = [var](u32 cb_port, u8 cb_value) { *var = cb_value; };
-
-  ConnectIOPortWrite(port, owner, std::move(write_handler));
+  return true;
 }
 
 void Bus::ReadMemoryBlock(PhysicalMemoryAddress address, u32 length, void* destination)
@@ -489,6 +683,20 @@ void Bus::WriteMemoryBlock(PhysicalMemoryAddress address, u32 length, const void
     if (page.type & PhysicalMemoryPage::kWritableRAM)
     {
       std::memcpy(page.ram_ptr + page_offset, source_ptr, size_in_page);
+      if (page.type & PhysicalMemoryPage::kPageTable)
+      {
+        m_page_table_write_callback(address & m_physical_memory_address_mask,
+                                    std::min(size_in_page, MEMORY_PAGE_SIZE - page_offset));
+      }
+      if (page.type & PhysicalMemoryPage::kCachedCode)
+      {
+        const u32 code_check_size = std::min(size_in_page, MEMORY_PAGE_SIZE - page_offset);
+        if (page.code_mask & GetCodeChunkMask(page_offset, code_check_size))
+          m_code_invalidate_callback(address & m_physical_memory_address_mask, code_check_size);
+        else
+          m_code_invalidations_avoided++;
+      }
+
       source_ptr += size_in_page;
       address += size_in_page;
       length -= size_in_page;
@@ -705,6 +913,46 @@ void Bus::EnumeratePagesForRange(PhysicalMemoryAddress start_address, PhysicalMe
   }
 }
 
+bool Bus::ReadMMIOBlock(PhysicalMemoryAddress address, u32 length, void* destination)
+{
+  address &= m_physical_memory_address_mask;
+  DebugAssert(length > 0 && ((address % MEMORY_PAGE_SIZE) + length) <= MEMORY_PAGE_SIZE);
+
+  const PhysicalMemoryPage& page = m_physical_memory_pages[address / MEMORY_PAGE_SIZE];
+  if (!page.IsReadableMMIO())
+    return false;
+
+  MMIO* const handler = page.mmio_handler;
+  if (!handler->HasReadBlockHandler() || address < handler->GetStartAddress() ||
+      (address + (length - 1)) > handler->GetEndAddress())
+  {
+    return false;
+  }
+
+  handler->ReadBlock(address, length, destination);
+  return true;
+}
+
+bool Bus::WriteMMIOBlock(PhysicalMemoryAddress address, u32 length, const void* source)
+{
+  address &= m_physical_memory_address_mask;
+  DebugAssert(length > 0 && ((address % MEMORY_PAGE_SIZE) + length) <= MEMORY_PAGE_SIZE);
+
+  const PhysicalMemoryPage& page = m_physical_memory_pages[address / MEMORY_PAGE_SIZE];
+  if (!page.IsWritableMMIO())
+    return false;
+
+  MMIO* const handler = page.mmio_handler;
+  if (!handler->HasWriteBlockHandler() || address < handler->GetStartAddress() ||
+      (address + (length - 1)) > handler->GetEndAddress())
+  {
+    return false;
+  }
+
+  handler->WriteBlock(address, length, source);
+  return true;
+}
+
 void Bus::ConnectMMIO(MMIO* mmio)
 {
   // MMIO size should be 4 byte aligned, that way we don't have to split reads/writes.
@@ -740,6 +988,8 @@ void Bus::DisconnectMMIO(MMIO* mmio)
     mmio->Release();
   };
 
+  Log_PerfPrintf("MMIO region 0x%08X-0x%08X disconnected after %" PRIu64 " accesses", mmio->GetStartAddress(),
+                 mmio->GetEndAddress(), mmio->GetAccessCount());
   EnumeratePagesForRange(mmio->GetStartAddress(), mmio->GetEndAddress(), std::move(callback));
 }
 
@@ -776,12 +1026,16 @@ bool Bus::IsWritablePage(PhysicalMemoryAddress address) const
   return IsWritablePage(m_physical_memory_pages[page_number]);
 }
 
-void Bus::MarkPageAsCode(PhysicalMemoryAddress address)
+void Bus::MarkPageAsCode(PhysicalMemoryAddress address, u32 length)
 {
   u32 page_number = address / MEMORY_PAGE_SIZE;
+  u32 page_offset = address % MEMORY_PAGE_SIZE;
   DebugAssert(page_number < m_num_physical_memory_pages);
-  m_physical_memory_pages[page_number].type |= PhysicalMemoryPage::kCachedCode;
-  m_physical_memory_page_ram_index[page_number] = nullptr;
+  DebugAssert(length > 0 && (page_offset + length) <= MEMORY_PAGE_SIZE);
+
+  PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  page.type |= PhysicalMemoryPage::kCachedCode;
+  page.code_mask |= GetCodeChunkMask(page_offset, length);
 }
 
 void Bus::UnmarkPageAsCode(PhysicalMemoryAddress address)
@@ -791,8 +1045,7 @@ void Bus::UnmarkPageAsCode(PhysicalMemoryAddress address)
 
   PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
   page.type &= ~PhysicalMemoryPage::kCachedCode;
-  if (page.IsReadableWritableRAM())
-    m_physical_memory_page_ram_index[page_number] = page.ram_ptr;
+  page.code_mask = 0;
 }
 
 void Bus::ClearPageCodeFlags()
@@ -804,8 +1057,7 @@ void Bus::ClearPageCodeFlags()
       continue;
 
     page.type &= ~PhysicalMemoryPage::kCachedCode;
-    if (page.IsReadableWritableRAM())
-      m_physical_memory_page_ram_index[i] = page.ram_ptr;
+    page.code_mask = 0;
   }
 }
 
@@ -816,7 +1068,42 @@ void Bus::SetCodeInvalidationCallback(CodeInvalidateCallback callback)
 
 void Bus::ClearCodeInvalidationCallback()
 {
-  m_code_invalidate_callback = [](PhysicalMemoryAddress) {};
+  m_code_invalidate_callback = [](PhysicalMemoryAddress, u32) {};
+}
+
+bool Bus::MarkPageAsPageTable(PhysicalMemoryAddress address)
+{
+  u32 page_number = (address & m_physical_memory_address_mask) / MEMORY_PAGE_SIZE;
+  DebugAssert(page_number < m_num_physical_memory_pages);
+
+  PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  if (!page.IsReadableWritableRAM())
+    return false;
+
+  page.type |= PhysicalMemoryPage::kPageTable;
+  m_physical_memory_page_ram_index[page_number] = nullptr;
+  return true;
+}
+
+void Bus::UnmarkPageAsPageTable(PhysicalMemoryAddress address)
+{
+  u32 page_number = (address & m_physical_memory_address_mask) / MEMORY_PAGE_SIZE;
+  DebugAssert(page_number < m_num_physical_memory_pages);
+
+  PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
+  page.type &= ~PhysicalMemoryPage::kPageTable;
+  if (page.IsDirectAccessRAM())
+    m_physical_memory_page_ram_index[page_number] = page.ram_ptr;
+}
+
+void Bus::SetPageTableWriteCallback(PageTableWriteCallback callback)
+{
+  m_page_table_write_callback = std::move(callback);
+}
+
+void Bus::ClearPageTableWriteCallback()
+{
+  m_page_table_write_callback = [](PhysicalMemoryAddress, u32) {};
 }
 
 void Bus::SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memory, bool writable_memory)
@@ -832,7 +1119,9 @@ void Bus::SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memo
   // If it's code, we need to invalidate it.
   // TODO: This is only really required if we change states..
   if (page.type & PhysicalMemoryPage::kCachedCode)
-    m_code_invalidate_callback(page_address & MEMORY_PAGE_MASK);
+    m_code_invalidate_callback(page_address & MEMORY_PAGE_MASK, MEMORY_PAGE_SIZE);
+  if (page.type & PhysicalMemoryPage::kPageTable)
+    m_page_table_write_callback(page_address & MEMORY_PAGE_MASK, MEMORY_PAGE_SIZE);
 
   if (readable_memory)
     page.type |= PhysicalMemoryPage::kReadableRAM;
@@ -843,7 +1132,7 @@ void Bus::SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memo
   else
     page.type &= ~PhysicalMemoryPage::kWritableRAM;
 
-  m_physical_memory_page_ram_index[page_number] = page.IsReadableWritableRAM() ? page.ram_ptr : nullptr;
+  m_physical_memory_page_ram_index[page_number] = page.IsDirectAccessRAM() ? page.ram_ptr : nullptr;
 }
 
 void Bus::SetPagesRAMState(PhysicalMemoryAddress start_address, u32 size, bool readable_memory, bool writable_memory)
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstring>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 #include "YBaseLib/Barrier.h"
@@ -26,12 +27,16 @@ class Bus : public Object
 
 public:
   using CodeHashType = u64;
-  using CodeInvalidateCallback = std::function<void(PhysicalMemoryAddress)>;
+  using CodeInvalidateCallback = std::function<void(PhysicalMemoryAddress address, u32 size)>;
+  using PageTableWriteCallback = std::function<void(PhysicalMemoryAddress address, u32 size)>;
 
   static constexpr u32 MEMORY_PAGE_SIZE = 0x1000; // 4KiB
   static constexpr u32 MEMORY_PAGE_NUMBER_SHIFT = 12;
   static constexpr u32 MEMORY_PAGE_OFFSET_MASK = PhysicalMemoryAddress(MEMORY_PAGE_SIZE - 1);
   static constexpr u32 MEMORY_PAGE_MASK = ~MEMORY_PAGE_OFFSET_MASK;
+  static constexpr u32 CODE_CHUNK_SIZE = 64;
+  static constexpr u32 CODE_CHUNK_SHIFT = 6;
+  static_assert((MEMORY_PAGE_SIZE / CODE_CHUNK_SIZE) == 64, "code chunks fit in a 64-bit page mask");
   static constexpr u32 NUM_IOPORTS = 0x10000;
 
   static constexpr u32 GetMemoryPageIndex(PhysicalMemoryAddress address) { return address >> MEMORY_PAGE_NUMBER_SHIFT; }
@@ -45,6 +50,7 @@ public:
 
   PhysicalMemoryAddress GetMemoryAddressMask() const { return m_physical_memory_address_mask; }
   void SetMemoryAddressMask(PhysicalMemoryAddress mask) { m_physical_memory_address_mask = mask; }
+  const PhysicalMemoryAddress* GetMemoryAddressMaskPointer() const { return &m_physical_memory_address_mask; }
   u32 GetMemoryPageCount() const { return m_num_physical_memory_pages; }
   u32 GetUnassignedRAMSize() const { return m_ram_size - m_ram_assigned; }
 
@@ -75,6 +81,11 @@ public:
   using IOPortWriteWordHandler = std::function<void(u16 port, u16 value)>;
   using IOPortWriteDWordHandler = std::function<void(u16 port, u32 value)>;
 
+  // Block IO callbacks, for REP INS/OUTS. Transfers up to count elements of size bytes, and returns the number of
+  // elements transferred. Returning fewer leaves the rest of the transfer to the byte/word/dword handlers.
+  using IOPortReadBlockHandler = std::function<u32(u16 port, u32 size, u32 count, void* destination)>;
+  using IOPortWriteBlockHandler = std::function<u32(u16 port, u32 size, u32 count, const void* source)>;
+
   // IO port connections
   void ConnectIOPortRead(u16 port, const void* owner, IOPortReadByteHandler read_callback);
   void ConnectIOPortWrite(u16 port, const void* owner, IOPortWriteByteHandler write_callback);
@@ -88,11 +99,24 @@ public:
   void ConnectIOPortWriteWord(u16 port, const void* owner, IOPortWriteWordHandler write_callback);
   void ConnectIOPortWriteDWord(u16 port, const void* owner, IOPortWriteDWordHandler write_callback);
 
+  // Block IO is only used when the port has no other connections.
+  void ConnectIOPortReadBlock(u16 port, const void* owner, IOPortReadBlockHandler read_callback);
+  void ConnectIOPortWriteBlock(u16 port, const void* owner, IOPortWriteBlockHandler write_callback);
+
   // Connecting an IO port to a single variable
   void ConnectIOPortReadToPointer(u16 port, const void* owner, const u8* var);
   void ConnectIOPortWriteToPointer(u16 port, const void* owner, u8* var);
 
+  // Marks reads of the port by this owner as only changing when an event runs or the port's device is written to,
+  // e.g. a keyboard controller status register. Idle loops polling such ports can skip ahead to the next event, ones
+  // polling ports derived from the current time (retrace status, timer counters) cannot.
+  void MarkIOPortReadEventDriven(u16 port, const void* owner);
+
+  // Returns true if no connection reading the port depends on the current time. Unconnected ports read as constants.
+  bool IsIOPortReadEventDriven(u16 port) const;
+
   // IO port handler accessors (mainly for CPU)
+  // These go through the dispatch table, so each access is a single indirect call.
   u8 ReadIOPortByte(u16 port);
   u16 ReadIOPortWord(u16 port);
   u32 ReadIOPortDWord(u16 port);
@@ -100,6 +124,10 @@ public:
   void WriteIOPortWord(u16 port, u16 value);
   void WriteIOPortDWord(u16 port, u32 value);
 
+  // Block IO accessors. Returns the number of elements transferred, which is zero if the port has no block handler.
+  u32 ReadIOPortBlock(u16 port, u32 size, u32 count, void* destination);
+  u32 WriteIOPortBlock(u16 port, u32 size, u32 count, const void* source);
+
   // Reads/writes memory. Words must be within the same 4KiB page.
   // Reads of unmapped memory return -1.
   template<typename T>
@@ -137,6 +165,11 @@ public:
   void ReadMemoryBlock(PhysicalMemoryAddress address, u32 length, void* destination);
   void WriteMemoryBlock(PhysicalMemoryAddress address, u32 length, const void* source);
 
+  // Bulk transfers to/from a single MMIO region, for CPU string operations. The range must not cross a page. Returns
+  // false if the range is not entirely within an MMIO region which handles block accesses itself.
+  bool ReadMMIOBlock(PhysicalMemoryAddress address, u32 length, void* destination);
+  bool WriteMMIOBlock(PhysicalMemoryAddress address, u32 length, const void* source);
+
   // MMIO handlers
   void ConnectMMIO(MMIO* mmio);
   void DisconnectMMIO(MMIO* mmio);
@@ -148,14 +181,35 @@ public:
 
   // Hashes a block of code for use in backend code caches.
   CodeHashType GetCodeHash(PhysicalMemoryAddress address, u32 length);
-  void MarkPageAsCode(PhysicalMemoryAddress address);
+  // Code is tracked in CODE_CHUNK_SIZE chunks, so writes to data sharing a page with code don't invalidate it.
+  // The range passed to MarkPageAsCode must not cross a page boundary.
+  void MarkPageAsCode(PhysicalMemoryAddress address, u32 length);
   void UnmarkPageAsCode(PhysicalMemoryAddress address);
   void ClearPageCodeFlags();
 
-  // Code invalidate callback - executed when pages marked as code are modified.
+  // Number of modifying writes to code pages which did not touch any code chunks.
+  u64 GetCodeInvalidationsAvoided() const { return m_code_invalidations_avoided; }
+
+  // Checks if a write to the range would modify cached code. Pages holding code stay in the RAM pointer index, so
+  // writes through it have to check this first. The range must not cross a page boundary.
+  bool IsCodeInRange(PhysicalMemoryAddress address, u32 length) const
+  {
+    address &= m_physical_memory_address_mask;
+    return (m_physical_memory_pages[address >> MEMORY_PAGE_NUMBER_SHIFT].code_mask &
+            GetCodeChunkMask(address & MEMORY_PAGE_OFFSET_MASK, length)) != 0;
+  }
+
+  // Code invalidate callback - executed when code chunks are modified. The range is within a single page.
   void SetCodeInvalidationCallback(CodeInvalidateCallback callback);
   void ClearCodeInvalidationCallback();
 
+  // Pages holding paging structures are watched so the CPU can drop entries it has cached from them. Writes to a
+  // marked page go through the bus and fire the callback. Returns false if the page isn't RAM, and can't be watched.
+  bool MarkPageAsPageTable(PhysicalMemoryAddress address);
+  void UnmarkPageAsPageTable(PhysicalMemoryAddress address);
+  void SetPageTableWriteCallback(PageTableWriteCallback callback);
+  void ClearPageTableWriteCallback();
+
   // Change page types.
   void SetPageRAMState(PhysicalMemoryAddress page_address, bool readable_memory, bool writable_memory);
   void SetPagesRAMState(PhysicalMemoryAddress start_address, u32 size, bool readable_memory, bool writable_memory);
@@ -164,6 +218,7 @@ public:
   void Stall(SimulationTime time);
 
   // Gets the RAM pointer index - one pointer per page. If null, can't write to RAM directory, must go through Bus.
+  // Writes to pages containing code chunks must check IsCodeInRange() as well.
   byte** GetRAMPointerIndex() const { return m_physical_memory_page_ram_index; }
   byte* GetRAMPagePointer(PhysicalMemoryAddress address) const
   {
@@ -179,15 +234,18 @@ public:
       kWritableRAM = 2,
       kCachedCode = 4,
       kMirror = 8,
+      kPageTable = 16,
     };
 
     byte* ram_ptr;
     MMIO* mmio_handler;
+    u64 code_mask;
     u8 type;
 
     bool IsReadableRAM() const { return (type & kReadableRAM) != 0; }
     bool IsWritableRAM() const { return (type & kWritableRAM) != 0; }
     bool HasCachedCode() const { return (type & kCachedCode) != 0; }
+    bool IsPageTable() const { return (type & kPageTable) != 0; }
     bool IsMirror() const { return (type & kMirror) != 0; }
     bool IsMMIO() const { return (mmio_handler != nullptr); }
     bool IsReadableMMIO() const { return IsMMIO() && !IsReadableRAM(); }
@@ -196,18 +254,33 @@ public:
     {
       return ((type & (kReadableRAM | kWritableRAM)) == (kReadableRAM | kWritableRAM));
     }
+
+    // Pages which can be accessed through the RAM pointer index. Writes to paging structures have to be seen by the
+    // bus, as do writes to the code chunks of a page, which the code mask is checked for.
+    bool IsDirectAccessRAM() const
+    {
+      return ((type & (kReadableRAM | kWritableRAM | kPageTable)) == (kReadableRAM | kWritableRAM));
+    }
   };
 
+  // Page array, for the code mask checks in generated code.
+  const PhysicalMemoryPage* GetPhysicalMemoryPages() const { return m_physical_memory_pages; }
+
   struct IOPortConnection
   {
     const void* owner;
     IOPortConnection* next;
+    const u8* read_pointer;
+    u8* write_pointer;
+    bool read_event_driven;
     IOPortReadByteHandler read_byte_handler;
     IOPortReadWordHandler read_word_handler;
     IOPortReadDWordHandler read_dword_handler;
     IOPortWriteByteHandler write_byte_handler;
     IOPortWriteWordHandler write_word_handler;
     IOPortWriteDWordHandler write_dword_handler;
+    IOPortReadBlockHandler read_block_handler;
+    IOPortWriteBlockHandler write_block_handler;
   };
 
   void AllocateMemoryPages(u32 memory_address_bits);
@@ -217,6 +290,17 @@ public:
   static bool IsCachablePage(const PhysicalMemoryPage& page);
   static bool IsWritablePage(const PhysicalMemoryPage& page);
 
+  // Returns the code chunk bits covered by the specified range within a page.
+  static constexpr u64 GetCodeChunkMask(u32 page_offset, u32 length)
+  {
+    // Ranges running past the end of the page are clamped to it.
+    const u32 first_chunk = page_offset >> CODE_CHUNK_SHIFT;
+    const u32 end_chunk = (page_offset + length - 1) >> CODE_CHUNK_SHIFT;
+    const u32 last_chunk = (end_chunk > 63) ? 63 : end_chunk;
+    const u64 upper_mask = (last_chunk == 63) ? ~u64(0) : ((u64(1) << (last_chunk + 1)) - 1);
+    return upper_mask & ~((u64(1) << first_chunk) - 1);
+  }
+
   // Generic memory read/write handler
   template<typename T, bool aligned>
   bool ReadMemoryT(PhysicalMemoryAddress address, T* value);
@@ -231,6 +315,43 @@ public:
   IOPortConnection* CreateIOPortConnection(u16 port, const void* owner);
   void RemoveIOPortConnection(u16 port, const void* owner);
 
+  // IO port dispatch table entries. The context is the handler or variable of the connection, the head of the
+  // connection list when several devices listen to writes, or the bus for unconnected and split accesses.
+  template<typename T>
+  struct IOPortReadEntry
+  {
+    T (*fn)(void* context, u16 port);
+    void* context;
+  };
+  template<typename T>
+  struct IOPortWriteEntry
+  {
+    void (*fn)(void* context, u16 port, T value);
+    void* context;
+  };
+  struct IOPortDispatch
+  {
+    IOPortReadEntry<u8> read_byte;
+    IOPortReadEntry<u16> read_word;
+    IOPortReadEntry<u32> read_dword;
+    IOPortWriteEntry<u8> write_byte;
+    IOPortWriteEntry<u16> write_word;
+    IOPortWriteEntry<u32> write_dword;
+    const IOPortReadBlockHandler* read_block;
+    const IOPortWriteBlockHandler* write_block;
+  };
+
+  // Resolves the dispatch table entries for a port from its connections. Called whenever they change.
+  void UpdateIOPortDispatch(u16 port);
+
+  // Picks whether a dword access without a handler splits into words or straight into bytes.
+  void UpdateIOPortDWordSplit(u16 port);
+
+  // Writes which more than one connection is listening to.
+  static void WriteIOPortByteListeners(void* context, u16 port, u8 value);
+  static void WriteIOPortWordListeners(void* context, u16 port, u16 value);
+  static void WriteIOPortDWordListeners(void* context, u16 port, u32 value);
+
   System* m_system = nullptr;
 
   // System memory map
@@ -244,9 +365,14 @@ public:
   // IO ports
   IOPortConnection** m_ioport_handlers = nullptr;
   std::unordered_map<const void*, std::vector<u16>> m_ioport_owners;
+  std::unique_ptr<IOPortDispatch[]> m_ioport_dispatch;
 
   // Code invalidate callback - executed when pages marked as code are modified.
   CodeInvalidateCallback m_code_invalidate_callback;
+  u64 m_code_invalidations_avoided = 0;
+
+  // Page table write callback - executed when pages marked as paging structures are modified.
+  PageTableWriteCallback m_page_table_write_callback;
 
   // Amount of RAM allocated overall
   // Do not access this pointer directly
@@ -75,7 +75,7 @@ void Bus::WriteMemoryTyped(PhysicalMemoryAddress address, T value)
   PhysicalMemoryPage& page = m_physical_memory_pages[page_number];
   if (page.type & PhysicalMemoryPage::kWritableRAM)
   {
-    if (!(page.type & PhysicalMemoryPage::kCachedCode))
+    if (!(page.type & (PhysicalMemoryPage::kCachedCode | PhysicalMemoryPage::kPageTable)))
     {
       std::memcpy(page.ram_ptr + page_offset, &value, sizeof(value));
       return;
@@ -87,9 +87,18 @@ void Bus::WriteMemoryTyped(PhysicalMemoryAddress address, T value)
       return;
     }
 
-    // Copy value in and fire callback.
+    // Copy value in, and notify the CPU if the page holds paging structures.
     std::memcpy(page.ram_ptr + page_offset, &value, sizeof(value));
-    m_code_invalidate_callback(address & MEMORY_PAGE_MASK);
+    if (page.type & PhysicalMemoryPage::kPageTable)
+      m_page_table_write_callback(address, sizeof(value));
+    if (!(page.type & PhysicalMemoryPage::kCachedCode))
+      return;
+
+    // Only fire the code callback if the write touched a code chunk.
+    if (page.code_mask & GetCodeChunkMask(page_offset, sizeof(value)))
+      m_code_invalidate_callback(address, sizeof(value));
+    else
+      m_code_invalidations_avoided++;
     return;
   }
 
@@ -110,3 +119,39 @@ void Bus::WriteMemoryTyped(PhysicalMemoryAddress address, T value)
     return;
   }
 }
+
+inline u8 Bus::ReadIOPortByte(u16 port)
+{
+  const IOPortReadEntry<u8>& entry = m_ioport_dispatch[port].read_byte;
+  return entry.fn(entry.context, port);
+}
+
+inline u16 Bus::ReadIOPortWord(u16 port)
+{
+  const IOPortReadEntry<u16>& entry = m_ioport_dispatch[port].read_word;
+  return entry.fn(entry.context, port);
+}
+
+inline u32 Bus::ReadIOPortDWord(u16 port)
+{
+  const IOPortReadEntry<u32>& entry = m_ioport_dispatch[port].read_dword;
+  return entry.fn(entry.context, port);
+}
+
+inline void Bus::WriteIOPortByte(u16 port, u8 value)
+{
+  const IOPortWriteEntry<u8>& entry = m_ioport_dispatch[port].write_byte;
+  entry.fn(entry.context, port, value);
+}
+
+inline void Bus::WriteIOPortWord(u16 port, u16 value)
+{
+  const IOPortWriteEntry<u16>& entry = m_ioport_dispatch[port].write_word;
+  entry.fn(entry.context, port, value);
+}
+
+inline void Bus::WriteIOPortDWord(u16 port, u32 value)
+{
+  const IOPortWriteEntry<u32>& entry = m_ioport_dispatch[port].write_dword;
+  entry.fn(entry.context, port, value);
+}
@@ -84,6 +84,9 @@ const char* CPU::BackendTypeToString(BackendType type)
     case BackendType::Recompiler:
       return "Recompiler";
 
+    case BackendType::Tiered:
+      return "Tiered";
+
     default:
       return "Unknown";
   }
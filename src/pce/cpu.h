@@ -14,7 +14,8 @@ public:
   {
     Interpreter,
     CachedInterpreter,
-    Recompiler
+    Recompiler,
+    Tiered
   };
 
   struct ExecutionStats
@@ -24,8 +25,39 @@ public:
     u64 exceptions_raised;
     u64 interrupts_serviced;
     u64 num_code_cache_blocks;
+    u64 code_cache_block_memory;
     u64 code_cache_blocks_executed;
     u64 code_cache_instructions_executed;
+
+    // Per-tier split of code_cache_instructions_executed.
+    u64 cached_interpreter_instructions_executed;
+    u64 recompiled_instructions_executed;
+
+    // Code buffer eviction, for recompiler backends.
+    u64 code_cache_segment_evictions;
+    u64 code_cache_bytes_reclaimed;
+    u64 code_cache_eviction_recompiles;
+
+    // Modifying writes to code pages which missed all code chunks.
+    u64 code_invalidations_avoided;
+
+    // Cycles fast-forwarded while the guest was spinning in an idle loop.
+    u64 idle_cycles_skipped;
+
+    // TLB lookups and flushes, and directory entries found in the PDE cache on a miss. Hits from the recompiler's
+    // inline lookup aren't counted.
+    u64 tlb_hits;
+    u64 tlb_misses;
+    u64 tlb_flushes;
+    u64 pde_cache_hits;
+
+    // Indirect branch and return targets found through the shadow return stack or linked targets.
+    u64 branch_prediction_hits;
+    u64 branch_prediction_misses;
+
+    // Blocks compiled as traces past conditional branches, and trace executions which left through a side exit.
+    u64 code_cache_traces_formed;
+    u64 code_cache_trace_side_exits;
   };
 
   CPU(const String& identifier, float frequency, BackendType backend_type,
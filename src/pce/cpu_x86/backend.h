@@ -12,6 +12,7 @@ public:
   virtual void AbortCurrentInstruction() = 0;
 
   virtual size_t GetCodeBlockCount() const = 0;
+  virtual size_t GetCodeBlockMemoryUsage() const = 0;
   virtual void FlushCodeCache() = 0;
 };
 
@@ -14,7 +14,11 @@ extern u32 TRACE_EXECUTION_LAST_EIP;
 
 CachedInterpreterBackend::CachedInterpreterBackend(CPU* cpu) : CodeCacheBackend(cpu) {}
 
-CachedInterpreterBackend::~CachedInterpreterBackend() {}
+CachedInterpreterBackend::~CachedInterpreterBackend()
+{
+  // Blocks live in the arena, so they have to be destroyed before it goes away.
+  CodeCacheBackend::FlushCodeCache();
+}
 
 void CachedInterpreterBackend::Execute()
 {
@@ -61,9 +65,17 @@ void CachedInterpreterBackend::Execute()
       ExecuteBlock();
       m_cpu->CommitPendingCycles();
 
-      // Fix up delayed block destroying.
+      // Fix up delayed block destroying. The return stack has to follow every call and return, even if we don't
+      // chain from this block. A trace which left through a side exit never reached its exit instruction, so it
+      // neither pushes nor pops, and the next block isn't a successor of that exit.
       Block* previous_block = m_current_block;
       m_current_block = nullptr;
+      const bool side_exit = m_cpu->m_trace_side_exit;
+      m_cpu->m_trace_side_exit = false;
+      BlockKey return_key;
+      return_key.qword = UINT64_C(0xFFFFFFFFFFFFFFFF);
+      if (!side_exit)
+        return_key = UpdateReturnStack(previous_block);
       if (previous_block->IsDestroyPending())
       {
         FlushBlock(previous_block);
@@ -71,34 +83,22 @@ void CachedInterpreterBackend::Execute()
       }
 
       // Block chaining?
-      if (!m_cpu->HasExternalInterrupt() && previous_block->IsLinkable())
+      if (!side_exit && !m_cpu->HasExternalInterrupt() && previous_block->IsLinkable())
       {
         if (GetBlockKeyForCurrentState(&key))
         {
           // Block points to itself?
           if (previous_block->key == key && CanExecuteBlock(previous_block))
           {
-            // Execute self again.
+            // Execute self again. Idle loops skip ahead to the next event instead of spinning.
             m_current_block = previous_block;
+            if (previous_block->IsIdleLoop())
+              SkipIdleLoop(previous_block);
           }
           else
           {
-            // Try to find an already-linked block.
-            for (BlockBase* linked_block : previous_block->link_successors)
-            {
-              if (linked_block->key == key)
-              {
-                if (!CanExecuteBlock(linked_block))
-                {
-                  // CanExecuteBlock can result in a block flush, so stop iterating here.
-                  break;
-                }
-
-                // Execute the
-                m_current_block = static_cast<Block*>(linked_block);
-                continue;
-              }
-            }
+            // Try the predicted return address, or an already-linked block.
+            m_current_block = static_cast<Block*>(GetLinkedBlock(previous_block, key, return_key));
 
             // No acceptable blocks found in the successor list, try a new one.
             if (!m_current_block)
@@ -145,7 +145,7 @@ void CachedInterpreterBackend::FlushCodeCache()
 
 BlockBase* CachedInterpreterBackend::AllocateBlock(const BlockKey key)
 {
-  return new Block(key);
+  return AllocateBlockStorage<Block>(key);
 }
 
 bool CachedInterpreterBackend::CompileBlock(BlockBase* block)
@@ -154,21 +154,14 @@ bool CachedInterpreterBackend::CompileBlock(BlockBase* block)
     return false;
 
   Block* cblock = static_cast<Block*>(block);
-  cblock->entries.reserve(cblock->instructions.size());
-  for (const Instruction& instruction : cblock->instructions)
+  if (!Interpreter::BuildThreadedOps(m_cpu, cblock->instructions.data(), cblock->instructions.size(), &cblock->ops,
+                                     &cblock->fallback_data))
   {
-    auto handler = Interpreter::GetInterpreterHandlerForInstruction(&instruction);
-    if (!handler)
-    {
-      String disassembled;
-      Decoder::DisassembleToString(&instruction, &disassembled);
-      Log_ErrorPrintf("Failed to get handler for instruction '%s'", disassembled.GetCharArray());
-      return false;
-    }
-
-    cblock->entries.push_back({handler, instruction.data, static_cast<u8>(instruction.length)});
+    return false;
   }
 
+  // The threaded ops hold everything needed to execute the block.
+  ReleaseBlockInstructions(cblock);
   return true;
 }
 
@@ -176,7 +169,8 @@ void CachedInterpreterBackend::ResetBlock(BlockBase* block)
 {
   Block* cblock = static_cast<Block*>(block);
   CodeCacheBackend::ResetBlock(cblock);
-  cblock->entries.clear();
+  cblock->ops.clear();
+  cblock->fallback_data.clear();
 }
 
 void CachedInterpreterBackend::FlushBlock(BlockBase* block, bool defer_destroy /* = false */)
@@ -190,31 +184,18 @@ void CachedInterpreterBackend::FlushBlock(BlockBase* block, bool defer_destroy /
 
 void CachedInterpreterBackend::DestroyBlock(BlockBase* block)
 {
-  delete static_cast<Block*>(block);
+  DestroyBlockStorage(static_cast<Block*>(block));
 }
 
 void CachedInterpreterBackend::ExecuteBlock()
 {
   // m_cpu->PrintCurrentStateAndInstruction(m_cpu->m_registers.EIP);
   m_cpu->m_execution_stats.code_cache_blocks_executed++;
-  m_cpu->m_execution_stats.code_cache_instructions_executed += m_current_block->entries.size();
-  for (const Block::Entry& instruction : m_current_block->entries)
-  {
-#if 0
-    if (TRACE_EXECUTION && m_cpu->m_registers.EIP != TRACE_EXECUTION_LAST_EIP)
-    {
-      m_cpu->PrintCurrentStateAndInstruction(m_cpu->m_registers.EIP, nullptr);
-      TRACE_EXECUTION_LAST_EIP = m_cpu->m_registers.EIP;
-    }
-#endif
-
-    m_cpu->m_current_EIP = m_cpu->m_registers.EIP;
-    m_cpu->m_current_ESP = m_cpu->m_registers.ESP;
-    m_cpu->m_registers.EIP = (m_cpu->m_registers.EIP + instruction.length) & m_cpu->m_EIP_mask;
-    std::memcpy(&m_cpu->idata, &instruction.data, sizeof(m_cpu->idata));
-    instruction.handler(m_cpu);
-    // Interpreter::ExecuteInstruction(m_cpu);
-  }
+  m_cpu->m_execution_stats.code_cache_instructions_executed += m_current_block->instruction_count;
+  m_cpu->m_execution_stats.cached_interpreter_instructions_executed += m_current_block->instruction_count;
+
+  const Interpreter::ThreadedOp* ops = m_current_block->ops.data();
+  Interpreter::ExecuteThreadedOps(m_cpu, ops, ops + m_current_block->ops.size());
 }
 
 } // namespace CPU_X86
\ No newline at end of file
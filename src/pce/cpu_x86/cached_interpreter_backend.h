@@ -2,6 +2,7 @@
 #include "common/fastjmp.h"
 #include "pce/cpu_x86/code_cache_backend.h"
 #include "pce/cpu_x86/cpu_x86.h"
+#include "pce/cpu_x86/interpreter.h"
 #include <unordered_map>
 #include <utility>
 
@@ -18,18 +19,15 @@ public:
   void FlushCodeCache() override;
 
 protected:
-  // We don't need to store any additional information, only the instruction stream.
+  // Blocks are executed as threaded code, see Interpreter::ThreadedOp.
   struct Block : public BlockBase
   {
     Block(const BlockKey key_) : BlockBase(key_) {}
 
-    struct Entry
-    {
-      void (*handler)(CPU*);
-      InstructionData data;
-      u8 length;
-    };
-    std::vector<Entry> entries;
+    std::vector<Interpreter::ThreadedOp> ops;
+
+    // Instruction data for ops which fall back to the regular interpreter handlers.
+    std::vector<InstructionData> fallback_data;
   };
 
   BlockBase* AllocateBlock(const BlockKey key) override;
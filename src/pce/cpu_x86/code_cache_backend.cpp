@@ -8,6 +8,7 @@
 #include <array>
 #include <cstdint>
 #include <cstdio>
+#include <initializer_list>
 Log_SetChannel(CPU_X86::CodeCacheBackend);
 
 namespace CPU_X86 {
@@ -20,8 +21,8 @@ extern u32 TRACE_EXECUTION_LAST_EIP;
 CodeCacheBackend::CodeCacheBackend(CPU* cpu) : m_cpu(cpu), m_system(cpu->GetSystem()), m_bus(cpu->GetBus())
 {
   m_physical_page_blocks = std::make_unique<BlockArray[]>(m_bus->GetMemoryPageCount());
-  m_bus->SetCodeInvalidationCallback(
-    std::bind(&CodeCacheBackend::InvalidateBlocksWithPhysicalPage, this, std::placeholders::_1));
+  m_bus->SetCodeInvalidationCallback(std::bind(&CodeCacheBackend::InvalidateBlocksWithPhysicalRange, this,
+                                                std::placeholders::_1, std::placeholders::_2));
 }
 
 CodeCacheBackend::~CodeCacheBackend()
@@ -30,14 +31,15 @@ CodeCacheBackend::~CodeCacheBackend()
   m_bus->ClearPageCodeFlags();
 }
 
-void CodeCacheBackend::InvalidateBlocksWithPhysicalPage(PhysicalMemoryAddress physical_page_address)
+void CodeCacheBackend::InvalidateBlocksWithPhysicalRange(PhysicalMemoryAddress address, u32 size)
 {
+  const PhysicalMemoryAddress physical_page_address = address & CPU::PAGE_MASK;
   PODArray<BlockBase*>& block_list = m_physical_page_blocks[Bus::GetMemoryPageIndex(physical_page_address)];
   if (block_list.IsEmpty())
     return;
 
-  // We unmark all pages as code, and invalidate the blocks.
-  // When the blocks are next executed, they will be re-marked as code.
+  // We unmark the page as code, and invalidate the blocks which overlap the write.
+  // The remaining blocks re-mark their chunks, invalidated blocks are re-marked when they are next executed.
   m_bus->UnmarkPageAsCode(physical_page_address);
 
   // Move the list out, so we don't disturb it while iterating.
@@ -45,10 +47,35 @@ void CodeCacheBackend::InvalidateBlocksWithPhysicalPage(PhysicalMemoryAddress ph
   temp_block_list.Swap(block_list);
 
   for (BlockBase* block : temp_block_list)
-    InvalidateBlock(block);
+  {
+    if (BlockOverlapsPhysicalRange(block, address, size))
+    {
+      InvalidateBlock(block);
+      continue;
+    }
 
-  temp_block_list.Swap(block_list);
-  block_list.Clear();
+    // Write only touched data sharing a chunk with this block, so leave it be.
+    if (block->GetPhysicalPageAddress() == physical_page_address)
+      AddBlockPhysicalMapping(block->key.eip_physical_address, block->GetLengthInFirstPage(), block);
+    else
+      AddBlockPhysicalMapping(block->GetNextPhysicalPageAddress(), block->code_length - block->GetLengthInFirstPage(),
+                              block);
+  }
+}
+
+bool CodeCacheBackend::BlockOverlapsPhysicalRange(const BlockBase* block, PhysicalMemoryAddress address, u32 size)
+{
+  const PhysicalMemoryAddress first_start = block->key.eip_physical_address;
+  const u32 first_length = block->GetLengthInFirstPage();
+  if (address < (first_start + first_length) && first_start < (address + size))
+    return true;
+
+  if (!block->CrossesPage())
+    return false;
+
+  const PhysicalMemoryAddress second_start = block->GetNextPhysicalPageAddress();
+  const u32 second_length = block->code_length - first_length;
+  return (address < (second_start + second_length) && second_start < (address + size));
 }
 
 Bus::CodeHashType CodeCacheBackend::GetBlockCodeHash(BlockBase* block)
@@ -56,7 +83,7 @@ Bus::CodeHashType CodeCacheBackend::GetBlockCodeHash(BlockBase* block)
   if (block->CrossesPage())
   {
     // Combine the hashes of both pages together.
-    const u32 size_in_first_page = CPU::PAGE_SIZE - (block->key.eip_physical_address & CPU::PAGE_OFFSET_MASK);
+    const u32 size_in_first_page = block->GetLengthInFirstPage();
     const u32 size_in_second_page = block->code_length - size_in_first_page;
     return (m_bus->GetCodeHash(block->key.eip_physical_address, size_in_first_page) +
             m_bus->GetCodeHash(block->next_page_physical_address, size_in_second_page));
@@ -155,17 +182,9 @@ BlockBase* CodeCacheBackend::GetNextBlock()
   }
 
   // Block lookup.
-  BlockBase* block;
-  auto iter = m_blocks.find(key);
-  if (iter != m_blocks.end())
+  BlockBase* block = m_blocks.Lookup(key);
+  if (block)
   {
-    block = iter->second;
-    if (!block)
-    {
-      // This block failed compilation previously, leave it.
-      return nullptr;
-    }
-
     // If CanExecuteBlock returns false, it means the block is incompatible with the current execution state.
     // In this case, fall back to the interpreter.
     if (!CanExecuteBlock(block))
@@ -176,6 +195,9 @@ BlockBase* CodeCacheBackend::GetNextBlock()
   }
 
   // Block doesn't exist, so compile it.
+  if (!ShouldCacheBlock(key))
+    return nullptr;
+
   Log_DebugPrintf("Attempting to compile block %08X", key.eip_physical_address);
   block = AllocateBlock(key);
   if (!CompileBlock(block))
@@ -190,29 +212,40 @@ BlockBase* CodeCacheBackend::GetNextBlock()
   return block;
 }
 
+bool CodeCacheBackend::ShouldCacheBlock(const BlockKey& key)
+{
+  return true;
+}
+
+bool CodeCacheBackend::PredictTraceBranch(const BlockBase* block, VirtualMemoryAddress segment_eip, bool* taken)
+{
+  return false;
+}
+
 void CodeCacheBackend::ResetBlock(BlockBase* block)
 {
   UnlinkBlockBase(block);
-  block->instructions.clear();
+  ReleaseBlockInstructions(block);
+  block->instruction_count = 0;
   block->total_cycles = 0;
   block->code_hash = 0;
   block->code_length = 0;
   block->next_page_physical_address = 0;
   block->flags = BlockFlags::None;
+  block->trace_branch_count = 0;
+  block->trace_branch_taken = 0;
 }
 
 void CodeCacheBackend::FlushBlock(BlockBase* block, bool defer_destroy /* = false */)
 {
   Log_DebugPrintf("Flushing block %08X", block->key.eip_physical_address);
 
-  auto iter = m_blocks.find(block->key);
-  if (iter == m_blocks.end())
+  if (!m_blocks.Remove(block))
   {
     Panic("Flushing untracked block");
     return;
   }
 
-  m_blocks.erase(iter);
   UnlinkBlockBase(block);
 
   // This lookup may fail, if the block has been invalidated.
@@ -230,35 +263,43 @@ void CodeCacheBackend::InvalidateBlock(BlockBase* block)
   Log_DebugPrintf("Invalidating block %08X", block->key.eip_physical_address);
   block->flags |= BlockFlags::Invalidated;
   RemoveBlockPhysicalMappings(block);
+
+  // Links are re-established when the block is revalidated, nothing should enter it directly until then.
+  UnlinkBlockBase(block);
 }
 
 size_t CodeCacheBackend::GetCodeBlockCount() const
 {
-  return m_blocks.size();
+  return m_blocks.GetCount();
+}
+
+size_t CodeCacheBackend::GetCodeBlockMemoryUsage() const
+{
+  return m_block_arena.GetUsedSize();
 }
 
 void CodeCacheBackend::FlushCodeCache()
 {
   for (u32 i = 0; i < m_bus->GetMemoryPageCount(); i++)
     m_physical_page_blocks[i].Clear();
-  for (auto& iter : m_blocks)
-    DestroyBlock(iter.second);
-  m_blocks.clear();
+  m_blocks.EnumerateBlocks([this](BlockBase* block) { DestroyBlock(block); });
+  m_blocks.Clear();
   m_bus->ClearPageCodeFlags();
 }
 
-void CodeCacheBackend::AddBlockPhysicalMapping(PhysicalMemoryAddress address, BlockBase* block)
+void CodeCacheBackend::AddBlockPhysicalMapping(PhysicalMemoryAddress address, u32 length, BlockBase* block)
 {
   const u32 page_index = Bus::GetMemoryPageIndex(address);
   m_physical_page_blocks[page_index].Add(block);
-  m_bus->MarkPageAsCode(address);
+  m_bus->MarkPageAsCode(address, length);
 }
 
 void CodeCacheBackend::AddBlockPhysicalMappings(BlockBase* block)
 {
-  AddBlockPhysicalMapping(block->GetPhysicalPageAddress(), block);
+  const u32 length_in_first_page = block->GetLengthInFirstPage();
+  AddBlockPhysicalMapping(block->key.eip_physical_address, length_in_first_page, block);
   if (block->CrossesPage())
-    AddBlockPhysicalMapping(block->GetNextPhysicalPageAddress(), block);
+    AddBlockPhysicalMapping(block->GetNextPhysicalPageAddress(), block->code_length - length_in_first_page, block);
 }
 
 void CodeCacheBackend::RemoveBlockPhysicalMapping(PhysicalMemoryAddress address, BlockBase* block)
@@ -277,7 +318,7 @@ void CodeCacheBackend::RemoveBlockPhysicalMappings(BlockBase* block)
     RemoveBlockPhysicalMapping(block->GetNextPhysicalPageAddress(), block);
 }
 
-bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
+bool CodeCacheBackend::CompileBlockBase(BlockBase* block, bool form_trace /* = false */)
 {
   static constexpr u32 BUFFER_SIZE = 64;
   DebugAssert(block != nullptr);
@@ -343,6 +384,21 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
       }
     }
 
+    // Moves the decode position forward, discarding the skipped bytes.
+    void Skip(u32 count)
+    {
+      const u32 buffer_remaining = buffer_size - buffer_pos;
+      if (count <= buffer_remaining)
+      {
+        buffer_pos += count;
+        return;
+      }
+
+      EIP = (EIP + (count - buffer_remaining)) & EIP_mask;
+      buffer_size = 0;
+      buffer_pos = 0;
+    }
+
     bool FetchByte(u8* val)
     {
       u32 buffer_remaining = buffer_size - buffer_pos;
@@ -414,49 +470,131 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
   auto fetchb = std::bind(&FetchCallback::FetchByte, &callback, std::placeholders::_1);
   auto fetchw = std::bind(&FetchCallback::FetchWord, &callback, std::placeholders::_1);
   auto fetchd = std::bind(&FetchCallback::FetchDWord, &callback, std::placeholders::_1);
-  size_t instruction_count = 0;
   VirtualMemoryAddress start_EIP = m_cpu->m_registers.EIP;
   VirtualMemoryAddress next_EIP = start_EIP;
-  block->instructions.reserve(16);
+  block->start_eip = start_EIP;
+
+  auto SetExitFlags = [block](const Instruction* instruction) {
+    if (IsLinkableExitInstruction(instruction))
+      block->flags |= BlockFlags::Linkable;
+
+    if (instruction->operation == Operation_CALL_Near)
+      block->flags |= BlockFlags::CallExit;
+    else if (instruction->operation == Operation_RET_Near)
+      block->flags |= BlockFlags::ReturnExit;
+    if (instruction->operation == Operation_RET_Near ||
+        ((instruction->operation == Operation_JMP_Near || instruction->operation == Operation_CALL_Near) &&
+         instruction->operands[0].mode != OperandMode_Relative))
+    {
+      block->flags |= BlockFlags::IndirectExit;
+    }
+  };
+
+  // Trace segments after the first have to stay within the page the block starts in, so the block is still a single
+  // range of code in one page, and the page mappings and hash cover all of it.
+  const u32 page_remaining =
+    CPU::PAGE_SIZE - (m_cpu->CalculateLinearAddress(Segment_CS, start_EIP) & CPU::PAGE_OFFSET_MASK);
+  const u32 replay_branch_count = block->trace_branch_count;
+  block->trace_branch_count = 0;
+  VirtualMemoryAddress segment_EIP = start_EIP;
+
+  // Picks the direction to follow past a conditional branch, or returns false to end the block at it.
+  auto FollowBranch = [&](const Instruction* instruction, bool* taken) {
+    const u32 index = block->trace_branch_count;
+    if (instruction->operation != Operation_Jcc || instruction->operands[1].mode != OperandMode_Relative ||
+        index == MAX_TRACE_BRANCHES || block->code_length > page_remaining)
+    {
+      return false;
+    }
+
+    if (index < replay_branch_count)
+      *taken = ((block->trace_branch_taken >> index) & 1) != 0;
+    else if (!form_trace || !PredictTraceBranch(block, segment_EIP, taken))
+      return false;
+
+    // Only forward branches can be followed when taken, backward branches would make the trace loop.
+    if (*taken)
+    {
+      const u32 target_offset = GetRelativeBranchTarget(*instruction) - start_EIP;
+      return (target_offset > (next_EIP - start_EIP) && target_offset < page_remaining);
+    }
+
+    return true;
+  };
 
+  // State after the last branch a trace continued past. A segment which can't be completed is dropped, ending the
+  // block at that branch instead.
+  size_t rewind_instruction_count = 0;
+  u32 rewind_code_length = 0;
+  CycleCount rewind_total_cycles = 0;
+  auto RewindTraceSegment = [&]() {
+    m_decode_buffer.resize(rewind_instruction_count);
+    block->code_length = rewind_code_length;
+    block->total_cycles = rewind_total_cycles;
+    block->trace_branch_count--;
+    block->trace_branch_taken &= static_cast<u8>(~(1u << block->trace_branch_count));
+    SetExitFlags(&m_decode_buffer.back());
+  };
+
+  // Decode into the scratch buffer, the block only gets an exact-sized copy.
+  m_decode_buffer.clear();
   for (;;)
   {
-    block->instructions.emplace_back();
-    Instruction* instruction = &block->instructions.back();
+    m_decode_buffer.emplace_back();
+    Instruction* instruction = &m_decode_buffer.back();
     if (!Decoder::DecodeInstruction(instruction, m_cpu->m_current_address_size, m_cpu->m_current_operand_size, next_EIP,
-                                    fetchb, fetchw, fetchd))
+                                    fetchb, fetchw, fetchd) ||
+        (block->IsTrace() && ((instruction->address - start_EIP) + instruction->length) > page_remaining))
     {
-      block->instructions.pop_back();
+      m_decode_buffer.pop_back();
+      if (block->IsTrace())
+        RewindTraceSegment();
       break;
     }
 
-    instruction_count++;
     block->total_cycles++;
     block->code_length += instruction->length;
     next_EIP = (next_EIP + instruction->length) & m_cpu->m_EIP_mask;
 
     if (IsExitBlockInstruction(instruction))
     {
-      if (IsLinkableExitInstruction(instruction))
-        block->flags |= BlockFlags::Linkable;
+      bool taken = false;
+      if (FollowBranch(instruction, &taken))
+      {
+        rewind_instruction_count = m_decode_buffer.size();
+        rewind_code_length = block->code_length;
+        rewind_total_cycles = block->total_cycles;
+        if (taken)
+        {
+          // The skipped bytes stay part of the block's code, so writes to them still invalidate it.
+          const VirtualMemoryAddress target = GetRelativeBranchTarget(*instruction);
+          callback.Skip(target - next_EIP);
+          block->code_length += target - next_EIP;
+          block->trace_branch_taken |= static_cast<u8>(1u << block->trace_branch_count);
+          next_EIP = target;
+        }
 
+        block->trace_branch_count++;
+        segment_EIP = next_EIP;
+        continue;
+      }
+
+      SetExitFlags(instruction);
       break;
     }
   }
 
-  block->instructions.shrink_to_fit();
-
 #if !defined(Y_BUILD_CONFIG_RELEASE)
 
   Log_DebugPrintf("-- COMPILED BLOCK AT %04X:%08X --", ZeroExtend32(m_cpu->m_registers.CS), m_cpu->m_registers.EIP);
 
-  if (block->instructions.empty())
+  if (m_decode_buffer.empty())
   {
     Log_DebugPrintf("!!! EMPTY BLOCK !!!");
     return false;
   }
 
-  for (const Instruction& instruction : block->instructions)
+  for (const Instruction& instruction : m_decode_buffer)
   {
     SmallString disasm;
     Decoder::DisassembleToString(&instruction, &disasm);
@@ -467,11 +605,13 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
 
 #else
 
-  if (block->instructions.empty())
+  if (m_decode_buffer.empty())
     return false;
 
 #endif
 
+  AllocateBlockInstructions(block, m_decode_buffer.data(), m_decode_buffer.size());
+
   // Does this block cross a page boundary?
   const VirtualMemoryAddress eip_linear_address = m_cpu->CalculateLinearAddress(Segment_CS, m_cpu->m_registers.EIP);
   if ((eip_linear_address & CPU::PAGE_MASK) != ((eip_linear_address + (block->code_length - 1)) & CPU::PAGE_MASK))
@@ -483,6 +623,9 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
     block->next_page_physical_address = callback.last_physical_page;
   }
 
+  if (IsIdleLoopBlock(block, &block->idle_loop_reads))
+    block->flags |= BlockFlags::IdleLoop;
+
   // Hash the code block to check invalidation.
   block->code_hash = GetBlockCodeHash(block);
 
@@ -492,9 +635,48 @@ bool CodeCacheBackend::CompileBlockBase(BlockBase* block)
   return true;
 }
 
+void CodeCacheBackend::AllocateBlockInstructions(BlockBase* block, const Instruction* instructions, size_t count)
+{
+  DebugAssert(block->instructions.empty());
+  block->instructions.ptr =
+    static_cast<Instruction*>(m_block_arena.Allocate(sizeof(Instruction) * count));
+  block->instructions.count = static_cast<u32>(count);
+  block->instruction_count = static_cast<u32>(count);
+  std::copy(instructions, instructions + count, block->instructions.ptr);
+}
+
+void CodeCacheBackend::ReleaseBlockInstructions(BlockBase* block)
+{
+  if (block->instructions.empty())
+    return;
+
+  m_block_arena.Free(block->instructions.ptr, sizeof(Instruction) * block->instructions.count);
+  block->instructions = {};
+}
+
+bool CodeCacheBackend::RebuildBlockInstructions(BlockBase* block)
+{
+  // Decoding into a temporary block gives us the instructions without touching the links or flags. The block has just
+  // been validated, so the code can't have changed unless the decode goes wrong.
+  BlockBase temp_block(block->key);
+  temp_block.trace_branch_count = block->trace_branch_count;
+  temp_block.trace_branch_taken = block->trace_branch_taken;
+  if (!CompileBlockBase(&temp_block) || temp_block.code_length != block->code_length ||
+      temp_block.code_hash != block->code_hash)
+  {
+    Log_WarningPrintf("Failed to rebuild instructions for block %08X", block->GetPhysicalAddress());
+    ReleaseBlockInstructions(&temp_block);
+    return false;
+  }
+
+  block->instructions = temp_block.instructions;
+  temp_block.instructions = {};
+  return true;
+}
+
 void CodeCacheBackend::InsertBlock(BlockBase* block)
 {
-  m_blocks.emplace(block->key, block);
+  m_blocks.Insert(block);
   AddBlockPhysicalMappings(block);
 }
 
@@ -502,6 +684,11 @@ void CodeCacheBackend::LinkBlockBase(BlockBase* from, BlockBase* to)
 {
   Log_DebugPrintf("Linking block %p(%08x) to %p(%08x)", from, from->key.eip_physical_address, to,
                   to->key.eip_physical_address);
+
+  // Indirect branches can have any number of targets, so only keep the most recent.
+  if (from->IsIndirectExit() && from->link_successors.size() >= INDIRECT_TARGET_CACHE_SIZE)
+    UnlinkBlockSuccessor(from, from->link_successors.front());
+
   from->link_successors.push_back(to);
   to->link_predecessors.push_back(from);
 }
@@ -525,6 +712,133 @@ void CodeCacheBackend::UnlinkBlockBase(BlockBase* block)
   block->link_successors.clear();
 }
 
+void CodeCacheBackend::UnlinkBlockSuccessor(BlockBase* from, BlockBase* to)
+{
+  auto successor_iter = std::find(from->link_successors.begin(), from->link_successors.end(), to);
+  Assert(successor_iter != from->link_successors.end());
+  from->link_successors.erase(successor_iter);
+
+  auto predecessor_iter = std::find(to->link_predecessors.begin(), to->link_predecessors.end(), from);
+  Assert(predecessor_iter != to->link_predecessors.end());
+  to->link_predecessors.erase(predecessor_iter);
+}
+
+BlockKey CodeCacheBackend::UpdateReturnStack(const BlockBase* block)
+{
+  BlockKey invalid_key;
+  invalid_key.qword = UINT64_C(0xFFFFFFFFFFFFFFFF);
+
+  if (block->IsCallExit())
+  {
+    // The call is the last instruction, so the return address follows the block. We can only tell its physical
+    // address if it's in the same page, otherwise the entry is left invalid to keep the stack balanced.
+    BlockKey return_key = invalid_key;
+    const u32 return_page_offset = (block->key.eip_physical_address & CPU::PAGE_OFFSET_MASK) + block->code_length;
+    if (!block->CrossesPage() && return_page_offset < CPU::PAGE_SIZE)
+    {
+      return_key = block->key;
+      return_key.eip_physical_address += block->code_length;
+    }
+
+    m_return_stack[m_return_stack_position++ % RETURN_STACK_SIZE] = return_key;
+  }
+  else if (block->IsReturnExit())
+  {
+    return m_return_stack[--m_return_stack_position % RETURN_STACK_SIZE];
+  }
+
+  return invalid_key;
+}
+
+BlockBase* CodeCacheBackend::GetLinkedBlock(BlockBase* previous_block, const BlockKey& key,
+                                            const BlockKey& return_key)
+{
+  // Returns to the address pushed by the matching call skip searching the successors, which would otherwise grow
+  // with every call site of the function.
+  if (previous_block->IsReturnExit() && return_key == key)
+  {
+    BlockBase* block = m_blocks.Lookup(key);
+    if (block && CanExecuteBlock(block))
+    {
+      m_cpu->m_execution_stats.branch_prediction_hits++;
+      return block;
+    }
+  }
+
+  // Try to find an already-linked block.
+  BlockBase* block = nullptr;
+  for (BlockBase* linked_block : previous_block->link_successors)
+  {
+    if (linked_block->key == key)
+    {
+      // CanExecuteBlock can result in a block flush, so stop iterating here.
+      if (CanExecuteBlock(linked_block))
+        block = linked_block;
+      break;
+    }
+  }
+
+  if (previous_block->IsIndirectExit())
+  {
+    if (block)
+      m_cpu->m_execution_stats.branch_prediction_hits++;
+    else
+      m_cpu->m_execution_stats.branch_prediction_misses++;
+  }
+
+  return block;
+}
+
+void CodeCacheBackend::SkipIdleLoop(const BlockBase* block)
+{
+  // Nothing the loop reads can change until the next event runs, so spinning until then would only burn host time.
+  // Advancing the pending cycles puts the guest exactly where it would be had it executed the loop up to the event.
+  // That doesn't hold for ports derived from the current time, e.g. the VGA retrace status, or for MMIO.
+  if (!IsIdleLoopPortReadEventDriven(block, m_bus, m_cpu->m_registers.DX) || !IsIdleLoopMemoryReadRAM(block))
+    return;
+
+  const CycleCount skip_cycles = m_cpu->m_execution_downcount - m_cpu->m_pending_cycles;
+  if (skip_cycles <= 0)
+    return;
+
+  m_cpu->m_pending_cycles += skip_cycles;
+  m_cpu->m_execution_stats.idle_cycles_skipped += static_cast<u64>(skip_cycles);
+  m_cpu->CommitPendingCycles();
+}
+
+bool CodeCacheBackend::IsIdleLoopMemoryReadRAM(const BlockBase* block)
+{
+  for (u32 i = 0; i < block->idle_loop_reads.count; i++)
+  {
+    const IdleLoopRead& read = block->idle_loop_reads.reads[i];
+    if (read.type != IdleLoopRead::Type::Memory)
+      continue;
+
+    // The address registers are loop-invariant, so their current values give the address every iteration reads.
+    VirtualMemoryAddress offset = read.offset;
+    if (read.base_register != IdleLoopRead::NO_REGISTER)
+      offset += m_cpu->m_registers.reg32[read.base_register];
+    if (read.index_register != IdleLoopRead::NO_REGISTER)
+      offset += m_cpu->m_registers.reg32[read.index_register] << read.index_shift;
+    if (read.address_size == AddressSize_16)
+      offset &= 0xFFFF;
+
+    // Check both ends, in case the read crosses a page. ROM pages are fine too, as they can't change.
+    const LinearMemoryAddress linear_address = m_cpu->CalculateLinearAddress(read.segment, offset);
+    for (const LinearMemoryAddress address : {linear_address, linear_address + read.length - 1})
+    {
+      PhysicalMemoryAddress physical_address;
+      if (!m_cpu->TranslateLinearAddress(&physical_address, address, AccessFlags::Debugger) ||
+          !m_bus->IsCachablePage(physical_address))
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 void CodeCacheBackend::InterpretUncachedBlock()
 {
   auto fetchb = [this](u8* val) {
@@ -564,8 +878,8 @@ void CodeCacheBackend::InterpretUncachedBlock()
       break;
     }
 
+    // Fetching the instruction bytes has already moved EIP past the instruction.
     auto handler = Interpreter::GetInterpreterHandlerForInstruction(&instruction);
-    m_cpu->m_registers.EIP = (m_cpu->m_registers.EIP + instruction.length) & m_cpu->m_EIP_mask;
     std::memcpy(&m_cpu->idata, &instruction.data, sizeof(m_cpu->idata));
     m_cpu->m_execution_stats.instructions_interpreted++;
     handler(m_cpu);
@@ -12,10 +12,20 @@ namespace CPU_X86 {
 class CodeCacheBackend : public Backend
 {
 public:
+  // Number of return addresses predicted for near returns. Deeper call chains wrap around, and mispredict.
+  static constexpr u32 RETURN_STACK_SIZE = 16;
+
+  // Maximum number of targets linked from a block ending in an indirect branch. The oldest is dropped when full.
+  static constexpr u32 INDIRECT_TARGET_CACHE_SIZE = 4;
+
+  // Maximum number of conditional branches a trace continues past.
+  static constexpr u32 MAX_TRACE_BRANCHES = 4;
+
   CodeCacheBackend(CPU* cpu);
   ~CodeCacheBackend();
 
   virtual size_t GetCodeBlockCount() const override;
+  virtual size_t GetCodeBlockMemoryUsage() const override;
   virtual void FlushCodeCache() override;
 
 protected:
@@ -25,6 +35,9 @@ protected:
   /// Uses the current state of the CPU to compile a block.
   virtual bool CompileBlock(BlockBase* block) = 0;
 
+  /// Called before a block is created for a key which isn't cached. Returning false runs the code uncached instead.
+  virtual bool ShouldCacheBlock(const BlockKey& key);
+
   /// Resets a block before recompiling it, which may be more efficient than completely destroying it.
   virtual void ResetBlock(BlockBase* block);
 
@@ -37,20 +50,48 @@ protected:
   /// Returns a code block ready for execution based on the current state, otherwise fall back to the interpreter.
   BlockBase* GetNextBlock();
 
-  /// Compiles the base portion of a block (retrieves/decodes the instruction stream).
-  bool CompileBlockBase(BlockBase* block);
+  /// Compiles the base portion of a block (retrieves/decodes the instruction stream). A block which is already a trace
+  /// is decoded along the same path. If form_trace is set, PredictTraceBranch is asked whether to continue past each
+  /// conditional branch after that.
+  bool CompileBlockBase(BlockBase* block, bool form_trace = false);
+
+  /// Returns true if a trace should continue past the conditional branch ending the code at segment_eip, and sets taken
+  /// to the direction to follow. The other direction becomes a side exit. The segment is in the same page as the block.
+  virtual bool PredictTraceBranch(const BlockBase* block, VirtualMemoryAddress segment_eip, bool* taken);
+
+  /// Block storage comes from the arena. Destroying a block also frees its instructions.
+  template<typename T>
+  T* AllocateBlockStorage(const BlockKey key)
+  {
+    return m_block_arena.New<T>(key);
+  }
+  template<typename T>
+  void DestroyBlockStorage(T* block)
+  {
+    ReleaseBlockInstructions(block);
+    m_block_arena.Delete(block);
+  }
+
+  /// Instructions are dropped once a block no longer needs them to execute, and decoded again if it does. Rebuilding
+  /// must be done with the CPU at the start of the block.
+  void AllocateBlockInstructions(BlockBase* block, const Instruction* instructions, size_t count);
+  void ReleaseBlockInstructions(BlockBase* block);
+  bool RebuildBlockInstructions(BlockBase* block);
 
   /// Inserts the block into the block map.
   void InsertBlock(BlockBase* block);
 
   /// Invalidates a single block of code, ensuring the code is re-hashed next execution.
-  void InvalidateBlock(BlockBase* block);
+  virtual void InvalidateBlock(BlockBase* block);
+
+  /// Invalidates any code blocks whose instruction bytes overlap the modified range. The range is within one page.
+  void InvalidateBlocksWithPhysicalRange(PhysicalMemoryAddress address, u32 size);
 
-  /// Invalidates any code blocks with a matching physical page.
-  void InvalidateBlocksWithPhysicalPage(PhysicalMemoryAddress physical_page_address);
+  /// Returns true if any of the bytes occupied by the block fall within the specified range.
+  static bool BlockOverlapsPhysicalRange(const BlockBase* block, PhysicalMemoryAddress address, u32 size);
 
   /// Removes the physical page -> block mapping for block.
-  void AddBlockPhysicalMapping(PhysicalMemoryAddress address, BlockBase* block);
+  void AddBlockPhysicalMapping(PhysicalMemoryAddress address, u32 length, BlockBase* block);
   void AddBlockPhysicalMappings(BlockBase* block);
   void RemoveBlockPhysicalMapping(PhysicalMemoryAddress address, BlockBase* block);
   void RemoveBlockPhysicalMappings(BlockBase* block);
@@ -67,10 +108,30 @@ protected:
   bool CanExecuteBlock(BlockBase* block);
 
   /// Link block from to to.
-  void LinkBlockBase(BlockBase* from, BlockBase* to);
+  virtual void LinkBlockBase(BlockBase* from, BlockBase* to);
 
   /// Unlink all blocks which point to this block, and any that this block links to.
-  void UnlinkBlockBase(BlockBase* block);
+  virtual void UnlinkBlockBase(BlockBase* block);
+
+  /// Removes a single link from from to to.
+  virtual void UnlinkBlockSuccessor(BlockBase* from, BlockBase* to);
+
+  /// Pushes the return address of a block ending in a near call to the shadow return stack, or pops the predicted
+  /// return address for a block ending in a near return. Call after every executed block. Returns the predicted key
+  /// for returns, otherwise an invalid key.
+  BlockKey UpdateReturnStack(const BlockBase* block);
+
+  /// Finds the block to chain to after previous_block, using the predicted return key or the blocks it is already
+  /// linked to. Returns nullptr if the block has to be looked up.
+  BlockBase* GetLinkedBlock(BlockBase* previous_block, const BlockKey& key, const BlockKey& return_key);
+
+  /// Fast-forwards to the next event. Call when an idle loop block branches back to itself. Loops polling ports which
+  /// change with time rather than on events, or MMIO, keep spinning instead.
+  void SkipIdleLoop(const BlockBase* block);
+
+  /// Returns true if the memory an idle loop reads is all RAM or ROM. Reads of MMIO can have side effects, or return
+  /// values derived from the current time.
+  bool IsIdleLoopMemoryReadRAM(const BlockBase* block);
 
   /// Runs the interpreter until the emulated CPU branches.
   void InterpretUncachedBlock();
@@ -79,10 +140,17 @@ protected:
   System* m_system;
   Bus* m_bus;
 
-  std::unordered_map<BlockKey, BlockBase*, BlockKeyHash> m_blocks;
+  BlockArena m_block_arena;
+  BlockLookupTable m_blocks;
+  std::vector<Instruction> m_decode_buffer;
 
   using BlockArray = PODArray<BlockBase*>;
   std::unique_ptr<BlockArray[]> m_physical_page_blocks;
   bool m_branched = false;
+
+  // Block keys of the return addresses of recent near calls. Keys rather than blocks are stored, so the entries
+  // don't have to be cleaned up when blocks are flushed.
+  std::array<BlockKey, RETURN_STACK_SIZE> m_return_stack = {};
+  u32 m_return_stack_position = 0;
 };
 } // namespace CPU_X86
@@ -1,10 +1,168 @@
 #include "pce/cpu_x86/code_cache_types.h"
+#include "YBaseLib/Assert.h"
+#include "pce/cpu_x86/decoder.h"
+#include <algorithm>
+#include <cstring>
 #include <optional>
 
 namespace CPU_X86 {
 
+BlockArena::BlockArena() = default;
+
+BlockArena::~BlockArena() = default;
+
+u32 BlockArena::GetSizeClass(size_t size)
+{
+  u32 size_class = 0;
+  while ((size_t(1) << (size_class + MIN_SIZE_CLASS_SHIFT)) < size)
+    size_class++;
+  return size_class;
+}
+
+void* BlockArena::Allocate(size_t size)
+{
+  const u32 size_class = GetSizeClass(size);
+  if (size_class >= NUM_SIZE_CLASSES)
+  {
+    m_used_size += size;
+    return new u8[size];
+  }
+
+  const size_t class_size = size_t(1) << (size_class + MIN_SIZE_CLASS_SHIFT);
+  m_used_size += class_size;
+
+  FreeNode*& free_list = m_free_lists[size_class];
+  if (free_list)
+  {
+    FreeNode* node = free_list;
+    free_list = node->next;
+    return node;
+  }
+
+  // Whatever is left of the current chunk is too small for this class, so it's given to the smaller classes. Chunk
+  // offsets are always a multiple of the smallest class, so every piece is aligned for any class it fits.
+  if (m_chunk_remaining < class_size)
+  {
+    for (u32 i = size_class; i > 0 && m_chunk_remaining > 0;)
+    {
+      i--;
+      const size_t piece_size = size_t(1) << (i + MIN_SIZE_CLASS_SHIFT);
+      while (m_chunk_remaining >= piece_size)
+      {
+        FreeNode* node = reinterpret_cast<FreeNode*>(m_chunk_position);
+        node->next = m_free_lists[i];
+        m_free_lists[i] = node;
+        m_chunk_position += piece_size;
+        m_chunk_remaining -= piece_size;
+      }
+    }
+
+    m_chunks.push_back(std::make_unique<u8[]>(CHUNK_SIZE));
+    m_chunk_position = m_chunks.back().get();
+    m_chunk_remaining = CHUNK_SIZE;
+    m_reserved_size += CHUNK_SIZE;
+  }
+
+  void* ptr = m_chunk_position;
+  m_chunk_position += class_size;
+  m_chunk_remaining -= class_size;
+  return ptr;
+}
+
+void BlockArena::Free(void* ptr, size_t size)
+{
+  const u32 size_class = GetSizeClass(size);
+  if (size_class >= NUM_SIZE_CLASSES)
+  {
+    m_used_size -= size;
+    delete[] static_cast<u8*>(ptr);
+    return;
+  }
+
+  m_used_size -= size_t(1) << (size_class + MIN_SIZE_CLASS_SHIFT);
+
+  FreeNode* node = static_cast<FreeNode*>(ptr);
+  node->next = m_free_lists[size_class];
+  m_free_lists[size_class] = node;
+}
+
+BlockLinkList::~BlockLinkList()
+{
+  if (m_data != m_inline)
+    delete[] m_data;
+}
+
+void BlockLinkList::push_back(BlockBase* block)
+{
+  if (m_size == m_capacity)
+  {
+    const u32 new_capacity = m_capacity * 2;
+    BlockBase** new_data = new BlockBase*[new_capacity];
+    std::copy(m_data, m_data + m_size, new_data);
+    if (m_data != m_inline)
+      delete[] m_data;
+
+    m_data = new_data;
+    m_capacity = new_capacity;
+  }
+
+  m_data[m_size++] = block;
+}
+
+BlockBase** BlockLinkList::erase(BlockBase** pos)
+{
+  DebugAssert(pos >= begin() && pos < end());
+  std::copy(pos + 1, end(), pos);
+  m_size--;
+  return pos;
+}
+
+void BlockLinkList::clear()
+{
+  if (m_data != m_inline)
+  {
+    delete[] m_data;
+    m_data = m_inline;
+    m_capacity = INLINE_CAPACITY;
+  }
+
+  m_size = 0;
+}
+
 BlockBase::BlockBase(const BlockKey key_) : key(key_) {}
 
+BlockLookupTable::BlockLookupTable()
+{
+  m_fast_lookup.fill(nullptr);
+}
+
+void BlockLookupTable::Insert(BlockBase* block)
+{
+  m_blocks.emplace(block->key, block);
+  m_fast_lookup[GetFastLookupIndex(block->key)] = block;
+}
+
+bool BlockLookupTable::Remove(BlockBase* block)
+{
+  auto iter = m_blocks.find(block->key);
+  if (iter == m_blocks.end())
+    return false;
+
+  m_blocks.erase(iter);
+
+  BlockBase*& entry = m_fast_lookup[GetFastLookupIndex(block->key)];
+  if (entry == block)
+    entry = nullptr;
+
+  return true;
+}
+
+void BlockLookupTable::Clear()
+{
+  m_blocks.clear();
+  m_fast_lookup.fill(nullptr);
+}
+
 bool IsExitBlockInstruction(const Instruction* instruction)
 {
   switch (instruction->operation)
@@ -173,6 +331,259 @@ bool OperandRegistersMatch(const Instruction& instruction, u32 index1, u32 index
   return *reg1 == *reg2;
 }
 
+u32 GetRegisterLaneMask(OperandSize size, u8 reg)
+{
+  switch (size)
+  {
+    case OperandSize_8:
+      return (reg < 4) ? (UINT32_C(0x1) << (reg * 4)) : (UINT32_C(0x2) << ((reg - 4) * 4));
+    case OperandSize_16:
+      return UINT32_C(0x3) << (reg * 4);
+    default:
+      return UINT32_C(0xF) << (reg * 4);
+  }
+}
+
+// Returns the number of bytes an operand reads.
+static u32 GetIdleLoopOperandLength(const Instruction& instruction, u32 index)
+{
+  const OperandSize size = (instruction.operands[index].size == OperandSize_Count) ? instruction.GetOperandSize() :
+                                                                                     instruction.operands[index].size;
+  return (size == OperandSize_8) ? 1 : ((size == OperandSize_16) ? 2 : 4);
+}
+
+static bool AddIdleLoopRead(IdleLoopReads* reads, const IdleLoopRead& read)
+{
+  if (reads->count == IdleLoopReads::MAX_READS)
+    return false;
+
+  reads->reads[reads->count++] = read;
+  return true;
+}
+
+// Adds the registers read by a source operand to read_mask, and any memory it reads to reads. Returns false for
+// operands an idle loop can't contain.
+static bool GetIdleLoopOperandReads(const Instruction& instruction, u32 index, u32* read_mask, IdleLoopReads* reads)
+{
+  const Instruction::Operand& operand = instruction.operands[index];
+  if (operand.mode == OperandMode_Immediate)
+    return true;
+
+  IdleLoopRead read = {};
+  read.offset = instruction.data.disp32;
+  read.type = IdleLoopRead::Type::Memory;
+  read.segment = instruction.GetMemorySegment();
+  read.address_size = instruction.GetAddressSize();
+  read.base_register = IdleLoopRead::NO_REGISTER;
+  read.index_register = IdleLoopRead::NO_REGISTER;
+  read.length = static_cast<u8>(GetIdleLoopOperandLength(instruction, index));
+  if (operand.mode == OperandMode_Memory)
+    return AddIdleLoopRead(reads, read);
+
+  const std::optional<u8> reg = GetOperandRegister(instruction, index);
+  if (reg)
+  {
+    *read_mask |= GetRegisterLaneMask(operand.size, *reg);
+    return true;
+  }
+
+  if (operand.mode != OperandMode_ModRM_RM)
+    return false;
+
+  // Memory operand, the address registers are read in full.
+  const Decoder::ModRMAddress* addr = Decoder::DecodeModRMAddress(instruction.GetAddressSize(), instruction.data.modrm);
+  switch (addr->addressing_mode)
+  {
+    case ModRMAddressingMode::Direct:
+      break;
+
+    case ModRMAddressingMode::Indirect:
+    case ModRMAddressingMode::Indexed:
+      read.base_register = addr->base_register;
+      break;
+
+    case ModRMAddressingMode::BasedIndexed:
+    case ModRMAddressingMode::BasedIndexedDisplacement:
+      read.base_register = addr->base_register;
+      read.index_register = addr->index_register;
+      break;
+
+    case ModRMAddressingMode::SIB:
+      if (instruction.HasSIBBase())
+        read.base_register = static_cast<u8>(instruction.GetSIBBaseRegister());
+      if (instruction.HasSIBIndex())
+        read.index_register = static_cast<u8>(instruction.GetSIBIndexRegister());
+      read.index_shift = instruction.GetSIBScaling();
+      break;
+
+    default:
+      return false;
+  }
+
+  if (read.base_register != IdleLoopRead::NO_REGISTER)
+    *read_mask |= GetRegisterLaneMask(OperandSize_32, read.base_register);
+  if (read.index_register != IdleLoopRead::NO_REGISTER)
+    *read_mask |= GetRegisterLaneMask(OperandSize_32, read.index_register);
+
+  return AddIdleLoopRead(reads, read);
+}
+
+// Returns the registers an instruction in the body of an idle loop reads and writes, and adds the ports and memory it
+// reads to reads. Only instructions which read ports or memory, or compute on registers and flags, are allowed.
+static bool GetIdleLoopRegisterUsage(const Instruction& instruction, u32* read_mask, u32* write_mask,
+                                     IdleLoopReads* reads)
+{
+  if (instruction.data.has_lock)
+    return false;
+
+  switch (instruction.operation)
+  {
+    case Operation_NOP:
+      return true;
+
+    case Operation_IN:
+    {
+      const std::optional<u8> dst_reg = GetOperandRegister(instruction, 0);
+      if (!dst_reg)
+        return false;
+
+      *write_mask |= GetRegisterLaneMask(instruction.operands[0].size, *dst_reg);
+
+      IdleLoopRead read = {};
+      read.length = static_cast<u8>(GetIdleLoopOperandLength(instruction, 0));
+      if (instruction.operands[1].mode == OperandMode_Immediate)
+      {
+        read.offset = ZeroExtend32(instruction.data.imm8);
+        read.type = IdleLoopRead::Type::Port;
+      }
+      else
+      {
+        *read_mask |= GetRegisterLaneMask(OperandSize_16, Reg16_DX);
+        read.type = IdleLoopRead::Type::PortDX;
+      }
+
+      return AddIdleLoopRead(reads, read);
+    }
+
+    case Operation_MOV:
+    case Operation_ADD:
+    case Operation_SUB:
+    case Operation_AND:
+    case Operation_OR:
+    case Operation_XOR:
+    {
+      // Destination has to be a register, writes to memory or ports are side effects.
+      const std::optional<u8> dst_reg = GetOperandRegister(instruction, 0);
+      if (!dst_reg)
+        return false;
+
+      const u32 dst_mask = GetRegisterLaneMask(instruction.operands[0].size, *dst_reg);
+      if (instruction.operation != Operation_MOV)
+        *read_mask |= dst_mask;
+      *write_mask |= dst_mask;
+      return GetIdleLoopOperandReads(instruction, 1, read_mask, reads);
+    }
+
+    case Operation_CMP:
+    case Operation_TEST:
+      return GetIdleLoopOperandReads(instruction, 0, read_mask, reads) &&
+             GetIdleLoopOperandReads(instruction, 1, read_mask, reads);
+
+    default:
+      return false;
+  }
+}
+
+u32 GetRelativeBranchTarget(const Instruction& instruction)
+{
+  return (instruction.address + instruction.length + instruction.data.disp32) & instruction.data.GetOperandSizeMask();
+}
+
+bool IsIdleLoopBlock(const BlockBase* block, IdleLoopReads* out_reads)
+{
+  if (block->instructions.empty())
+    return false;
+
+  // The block has to end with a relative branch back to its first instruction.
+  const Instruction& branch = block->instructions.back();
+  if (branch.operation == Operation_Jcc)
+  {
+    if (branch.operands[0].jump_condition == JumpCondition_CXZero || branch.operands[1].mode != OperandMode_Relative)
+      return false;
+  }
+  else if (branch.operation != Operation_JMP_Near || branch.operands[0].mode != OperandMode_Relative)
+  {
+    return false;
+  }
+
+  if (GetRelativeBranchTarget(branch) != block->instructions.front().address)
+    return false;
+
+  const size_t body_length = block->instructions.size() - 1;
+  u32 loop_write_mask = 0;
+  IdleLoopReads reads;
+  for (size_t i = 0; i < body_length; i++)
+  {
+    u32 read_mask = 0;
+    if (!GetIdleLoopRegisterUsage(block->instructions[i], &read_mask, &loop_write_mask, &reads))
+      return false;
+  }
+
+  // Any register the loop reads must either be loop-invariant, or written earlier in the same iteration. Otherwise the
+  // loop is counting or accumulating something, and each iteration differs from the last.
+  u32 iteration_write_mask = 0;
+  for (size_t i = 0; i < body_length; i++)
+  {
+    u32 read_mask = 0;
+    u32 write_mask = 0;
+    IdleLoopReads unused_reads;
+    GetIdleLoopRegisterUsage(block->instructions[i], &read_mask, &write_mask, &unused_reads);
+    if ((read_mask & loop_write_mask & ~iteration_write_mask) != 0)
+      return false;
+
+    iteration_write_mask |= write_mask;
+  }
+
+  // The port of IN DX and the address of memory reads have to be loop-invariant, so the dispatcher can check them with
+  // the current register values.
+  for (u32 i = 0; i < reads.count; i++)
+  {
+    const IdleLoopRead& read = reads.reads[i];
+    u32 address_mask = 0;
+    if (read.type == IdleLoopRead::Type::PortDX)
+      address_mask |= GetRegisterLaneMask(OperandSize_16, Reg16_DX);
+    if (read.type == IdleLoopRead::Type::Memory && read.base_register != IdleLoopRead::NO_REGISTER)
+      address_mask |= GetRegisterLaneMask(OperandSize_32, read.base_register);
+    if (read.type == IdleLoopRead::Type::Memory && read.index_register != IdleLoopRead::NO_REGISTER)
+      address_mask |= GetRegisterLaneMask(OperandSize_32, read.index_register);
+    if ((loop_write_mask & address_mask) != 0)
+      return false;
+  }
+
+  *out_reads = reads;
+  return true;
+}
+
+bool IsIdleLoopPortReadEventDriven(const BlockBase* block, const Bus* bus, u16 dx)
+{
+  for (u32 i = 0; i < block->idle_loop_reads.count; i++)
+  {
+    const IdleLoopRead& read = block->idle_loop_reads.reads[i];
+    if (read.type == IdleLoopRead::Type::Memory)
+      continue;
+
+    // Word/dword reads of a port without a wider handler are split across the following ports.
+    const u16 port = (read.type == IdleLoopRead::Type::Port) ? Truncate16(read.offset) : dx;
+    for (u32 offset = 0; offset < read.length; offset++)
+    {
+      if (!bus->IsIOPortReadEventDriven(static_cast<u16>(port + offset)))
+        return false;
+    }
+  }
+
+  return true;
+}
+
 bool IsInvalidInstruction(const Instruction& instruction)
 {
   if (instruction.data.has_lock)
@@ -2,8 +2,15 @@
 #include "pce/bus.h"
 #include "pce/cpu_x86/cpu_x86.h"
 #include "pce/cpu_x86/instruction.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <optional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace CPU_X86 {
 
@@ -43,12 +50,20 @@ struct BlockKey
 
 struct BlockKeyHash
 {
-  size_t operator()(const BlockKey& key) const
+  // std::hash<u64> is the identity function on most standard libraries, and block addresses are clustered,
+  // so mix the key before it is used as a bucket index.
+  static u64 Mix(u64 value)
   {
-    return std::hash<u64>()(key.qword);
-    // return size_t(key.qword);
+    value ^= value >> 33;
+    value *= UINT64_C(0xFF51AFD7ED558CCD);
+    value ^= value >> 33;
+    value *= UINT64_C(0xC4CEB9FE1A85EC53);
+    value ^= value >> 33;
+    return value;
   }
 
+  size_t operator()(const BlockKey& key) const { return static_cast<size_t>(Mix(key.qword)); }
+
   size_t operator()(const BlockKey& lhs, const BlockKey& rhs) const { return lhs.qword < rhs.qword; }
 };
 
@@ -63,27 +78,187 @@ enum class BlockFlags : u32
   BackgroundCompiling = (1 << 4), // Only used by recompiler backends.
   Invalidated = (1 << 5),
   DestroyPending = (1 << 6),
+  IdleLoop = (1 << 7),
+
+  // Exit instruction types, for branch prediction.
+  CallExit = (1 << 8),
+  ReturnExit = (1 << 9),
+  IndirectExit = (1 << 10),
 };
 IMPLEMENT_ENUM_CLASS_BITWISE_OPERATORS(BlockFlags);
 
+struct BlockBase;
+
+// Allocator for block metadata and instruction arrays. Allocations are rounded up to a power-of-two size class and
+// carved out of large chunks, and freed allocations are reused from a per-class free list. Memory is only returned to
+// the system when the arena is destroyed.
+class BlockArena
+{
+public:
+  static constexpr u32 CHUNK_SIZE = 256 * 1024;
+  static constexpr u32 MIN_SIZE_CLASS_SHIFT = 5;
+  static constexpr u32 MAX_SIZE_CLASS_SHIFT = 15;
+  static constexpr u32 NUM_SIZE_CLASSES = MAX_SIZE_CLASS_SHIFT - MIN_SIZE_CLASS_SHIFT + 1;
+
+  BlockArena();
+  ~BlockArena();
+
+  // Allocations larger than the biggest size class go to the heap.
+  void* Allocate(size_t size);
+  void Free(void* ptr, size_t size);
+
+  template<typename T, typename... Args>
+  T* New(Args&&... args)
+  {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "arena allocations are suitably aligned");
+    return new (Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+  }
+
+  template<typename T>
+  void Delete(T* ptr)
+  {
+    ptr->~T();
+    Free(ptr, sizeof(T));
+  }
+
+  // Bytes handed out and not yet freed, including size class rounding.
+  size_t GetUsedSize() const { return m_used_size; }
+
+  // Bytes reserved from the system.
+  size_t GetReservedSize() const { return m_reserved_size; }
+
+private:
+  struct FreeNode
+  {
+    FreeNode* next;
+  };
+
+  static u32 GetSizeClass(size_t size);
+
+  std::array<FreeNode*, NUM_SIZE_CLASSES> m_free_lists = {};
+  std::vector<std::unique_ptr<u8[]>> m_chunks;
+  u8* m_chunk_position = nullptr;
+  size_t m_chunk_remaining = 0;
+  size_t m_used_size = 0;
+  size_t m_reserved_size = 0;
+};
+
+// Decoded instructions of a block, allocated from the backend's arena. Empty once a block has been compiled, until
+// something needs the instructions again.
+struct BlockInstructions
+{
+  Instruction* ptr = nullptr;
+  u32 count = 0;
+
+  Instruction* data() const { return ptr; }
+  Instruction* begin() const { return ptr; }
+  Instruction* end() const { return ptr + count; }
+  size_t size() const { return count; }
+  bool empty() const { return (count == 0); }
+  Instruction& front() const { return ptr[0]; }
+  Instruction& back() const { return ptr[count - 1]; }
+  Instruction& operator[](size_t index) const { return ptr[index]; }
+};
+
+// List of linked blocks. Most blocks only link to their branch targets, so a few entries are stored inline, and the
+// list only goes to the heap when it grows past that. Order is preserved.
+class BlockLinkList
+{
+public:
+  static constexpr u32 INLINE_CAPACITY = 4;
+
+  BlockLinkList() = default;
+  BlockLinkList(const BlockLinkList&) = delete;
+  ~BlockLinkList();
+
+  BlockLinkList& operator=(const BlockLinkList&) = delete;
+
+  BlockBase** begin() { return m_data; }
+  BlockBase** end() { return m_data + m_size; }
+  BlockBase* const* begin() const { return m_data; }
+  BlockBase* const* end() const { return m_data + m_size; }
+  size_t size() const { return m_size; }
+  bool empty() const { return (m_size == 0); }
+  BlockBase* front() const { return m_data[0]; }
+
+  void push_back(BlockBase* block);
+  BlockBase** erase(BlockBase** pos);
+  void clear();
+
+private:
+  BlockBase** m_data = m_inline;
+  u32 m_size = 0;
+  u32 m_capacity = INLINE_CAPACITY;
+  BlockBase* m_inline[INLINE_CAPACITY];
+};
+
+// A port or memory read in the body of an idle loop. Reads are recorded when the block is compiled, since its
+// instructions may have been released by the time the loop is skipped.
+struct IdleLoopRead
+{
+  static constexpr u8 NO_REGISTER = 0xFF;
+
+  enum class Type : u8
+  {
+    Port,   // Port number in offset.
+    PortDX, // Port in DX.
+    Memory, // Offset plus the base and scaled index registers, in segment.
+  };
+
+  VirtualMemoryAddress offset;
+  Type type;
+  Segment segment;
+  AddressSize address_size;
+  u8 base_register;
+  u8 index_register;
+  u8 index_shift;
+  u8 length;
+};
+
+// Loops reading more than MAX_READS ports or memory locations are rare, and aren't treated as idle.
+struct IdleLoopReads
+{
+  static constexpr u32 MAX_READS = 2;
+
+  std::array<IdleLoopRead, MAX_READS> reads;
+  u32 count = 0;
+};
+
 struct BlockBase
 {
   BlockBase(const BlockKey key_);
 
-  std::vector<Instruction> instructions;
-  std::vector<BlockBase*> link_predecessors;
-  std::vector<BlockBase*> link_successors;
+  BlockInstructions instructions;
+  BlockLinkList link_predecessors;
+  BlockLinkList link_successors;
   CycleCount total_cycles = 0;
   Bus::CodeHashType code_hash;
   BlockKey key = {};
+  VirtualMemoryAddress start_eip = 0;
+  u32 instruction_count = 0;
   u32 code_length = 0;
   u32 next_page_physical_address = 0;
   BlockFlags flags = BlockFlags::None;
 
+  // Traces continue past conditional branches along their usual direction. Bit n of trace_branch_taken is set if the
+  // n-th branch is followed when taken. The code of a trace is still one range, which includes any bytes skipped by
+  // forward branches.
+  u8 trace_branch_count = 0;
+  u8 trace_branch_taken = 0;
+
+  // Only valid for idle loops.
+  IdleLoopReads idle_loop_reads;
+
   PhysicalMemoryAddress GetPhysicalAddress() const { return key.eip_physical_address; }
   PhysicalMemoryAddress GetPhysicalPageAddress() const { return (key.eip_physical_address & CPU::PAGE_MASK); }
   PhysicalMemoryAddress GetNextPhysicalPageAddress() const { return next_page_physical_address; }
 
+  // Returns the number of code bytes in the first page, the remainder is in the next page.
+  u32 GetLengthInFirstPage() const
+  {
+    return CrossesPage() ? (CPU::PAGE_SIZE - (key.eip_physical_address & CPU::PAGE_OFFSET_MASK)) : code_length;
+  }
+
   bool IsValid() const { return (flags & BlockFlags::Invalidated) == BlockFlags::None; }
 
   bool IsInvalidated() const { return (flags & BlockFlags::Invalidated) != BlockFlags::None; }
@@ -95,11 +270,70 @@ struct BlockBase
 
   bool IsDestroyPending() const { return (flags & BlockFlags::DestroyPending) != BlockFlags::None; }
 
+  bool IsIdleLoop() const { return (flags & BlockFlags::IdleLoop) != BlockFlags::None; }
+
+  bool IsTrace() const { return (trace_branch_count != 0); }
+
+  // Near calls, near returns, and any branch whose target isn't encoded in the instruction.
+  bool IsCallExit() const { return (flags & BlockFlags::CallExit) != BlockFlags::None; }
+  bool IsReturnExit() const { return (flags & BlockFlags::ReturnExit) != BlockFlags::None; }
+  bool IsIndirectExit() const { return (flags & BlockFlags::IndirectExit) != BlockFlags::None; }
+
   bool Is16BitCode() const { return key.Is16BitCode(); }
   bool Is32BitCode() const { return key.Is32BitCode(); }
   bool IsV8086Code() const { return key.IsV8086Code(); }
 };
 
+// Two-level block lookup. A direct-mapped table of recently used blocks sits in front of the map holding every block,
+// so the common case is a single load and key compare.
+class BlockLookupTable
+{
+public:
+  static constexpr u32 FAST_LOOKUP_BITS = 12;
+  static constexpr u32 FAST_LOOKUP_SIZE = 1u << FAST_LOOKUP_BITS;
+
+  BlockLookupTable();
+
+  size_t GetCount() const { return m_blocks.size(); }
+
+  BlockBase* Lookup(const BlockKey& key)
+  {
+    BlockBase*& entry = m_fast_lookup[GetFastLookupIndex(key)];
+    if (entry && entry->key == key)
+      return entry;
+
+    auto iter = m_blocks.find(key);
+    if (iter == m_blocks.end())
+      return nullptr;
+
+    entry = iter->second;
+    return entry;
+  }
+
+  void Insert(BlockBase* block);
+
+  // Returns false if the block was not in the table.
+  bool Remove(BlockBase* block);
+
+  void Clear();
+
+  template<typename T>
+  void EnumerateBlocks(T callback) const
+  {
+    for (const auto& iter : m_blocks)
+      callback(iter.second);
+  }
+
+private:
+  static u32 GetFastLookupIndex(const BlockKey& key)
+  {
+    return static_cast<u32>(BlockKeyHash::Mix(key.qword) >> (64 - FAST_LOOKUP_BITS));
+  }
+
+  std::unordered_map<BlockKey, BlockBase*, BlockKeyHash> m_blocks;
+  std::array<BlockBase*, FAST_LOOKUP_SIZE> m_fast_lookup;
+};
+
 bool IsExitBlockInstruction(const Instruction* instruction);
 bool IsLinkableExitInstruction(const Instruction* instruction);
 bool CanInstructionFault(const Instruction* instruction);
@@ -108,6 +342,22 @@ bool OperandIsESP(const Instruction& instruction, u32 index);
 std::optional<u8> GetOperandRegister(const Instruction& instruction, u32 index);
 bool OperandRegistersMatch(const Instruction& instruction, u32 index1, u32 index2);
 
+// Returns the target of a branch with a relative operand. The displacement is stored in disp32.
+u32 GetRelativeBranchTarget(const Instruction& instruction);
+
+// Registers are tracked per byte lane, four bits per 32-bit register, so AL and AH are distinct from each other and
+// from the upper half of EAX.
+u32 GetRegisterLaneMask(OperandSize size, u8 reg);
+
+// Returns true if the block is a loop back to its own start which only polls ports or memory, and carries no register
+// state from one iteration to the next. Such a loop can't exit until an event changes device state or interrupts it.
+// The ports and memory the loop reads are stored in out_reads. Memory is only read at loop-invariant addresses.
+bool IsIdleLoopBlock(const BlockBase* block, IdleLoopReads* out_reads);
+
+// Returns true if every port an idle loop block reads only changes when an event runs, so skipping to the next event
+// can't miss a change. dx is the current value of DX, which IsIdleLoopBlock requires to be loop-invariant.
+bool IsIdleLoopPortReadEventDriven(const BlockBase* block, const Bus* bus, u16 dx);
+
 // TODO: Model
 bool IsInvalidInstruction(const Instruction& instruction);
 
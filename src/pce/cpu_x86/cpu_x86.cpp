@@ -12,12 +12,21 @@
 #include "pce/cpu_x86/recompiler_backend.h"
 #include "pce/interrupt_controller.h"
 #include "pce/system.h"
+#include <algorithm>
+#include <array>
 #include <cctype>
 Log_SetChannel(CPU_X86::CPU);
 
 namespace CPU_X86 {
 DEFINE_NAMED_OBJECT_TYPE_INFO(CPU, "CPU_X86");
 BEGIN_OBJECT_PROPERTY_MAP(CPU)
+PROPERTY_TABLE_MEMBER_UINT("TierCacheThreshold", 0, offsetof(CPU, m_tier_cache_threshold), nullptr, 0)
+PROPERTY_TABLE_MEMBER_UINT("TierCompileThreshold", 0, offsetof(CPU, m_tier_compile_threshold), nullptr, 0)
+PROPERTY_TABLE_MEMBER_UINT("TierDemoteInvalidations", 0, offsetof(CPU, m_tier_demote_invalidations), nullptr, 0)
+PROPERTY_TABLE_MEMBER_UINT("TierTraceThreshold", 0, offsetof(CPU, m_tier_trace_threshold), nullptr, 0)
+PROPERTY_TABLE_MEMBER_BOOL("PrefetchEmulation", 0, offsetof(CPU, m_prefetch_emulation), nullptr, 0)
+PROPERTY_TABLE_MEMBER_BOOL("FastFPU", 0, offsetof(CPU, m_fast_fpu), nullptr, 0)
+PROPERTY_TABLE_MEMBER_BOOL("RecompilerDumpIR", 0, offsetof(CPU, m_recompiler_dump_ir), nullptr, 0)
 END_OBJECT_PROPERTY_MAP()
 
 // Used by backends to enable tracing feature.
@@ -84,6 +93,10 @@ bool CPU::Initialize(System* system, Bus* bus)
   InvalidateAllTLBEntries(true);
 #endif
 
+  // Writes to the page directory have to be seen by the PDE cache.
+  m_bus->SetPageTableWriteCallback(
+    [this](PhysicalMemoryAddress address, u32 size) { OnPageTableWrite(address, size); });
+
   // Backend is created on reset.
   return true;
 }
@@ -98,6 +111,7 @@ void CPU::Reset()
   Y_memzero(&m_registers, sizeof(m_registers));
   Y_memzero(&m_fpu_registers, sizeof(m_fpu_registers));
   Y_memzero(&m_msr_registers, sizeof(m_msr_registers));
+  m_lazy_flags = {};
 
   // IOPL NT, reserved are 1 on 8086
   m_registers.EFLAGS.bits = 0;
@@ -206,6 +220,8 @@ bool CPU::DoState(StateWrapper& sw)
   sw.Do(&m_current_EIP);
   sw.Do(&m_current_ESP);
 
+  // Pending status flags are written to EFLAGS first, when saving. When loading, they're replaced.
+  SyncLazyFlags();
   sw.DoArray(m_registers.reg32, Reg32_Count);
   sw.DoArray(m_registers.segment_selectors, Segment_Count);
   sw.Do(&m_registers.LDTR);
@@ -243,19 +259,27 @@ bool CPU::DoState(StateWrapper& sw)
   sw.Do(&m_irq_state);
 
 #ifdef ENABLE_TLB_EMULATION
-  u32 tlb_entry_count = Truncate32(TLB_ENTRY_COUNT);
-  sw.Do(&tlb_entry_count);
-  if (tlb_entry_count != Truncate32(TLB_ENTRY_COUNT))
+  u32 tlb_set_count = TLB_SET_COUNT;
+  u32 tlb_way_count = TLB_WAY_COUNT;
+  u32 large_tlb_entry_count = LARGE_TLB_ENTRY_COUNT;
+  sw.Do(&tlb_set_count);
+  sw.Do(&tlb_way_count);
+  sw.Do(&large_tlb_entry_count);
+  if (tlb_set_count != TLB_SET_COUNT || tlb_way_count != TLB_WAY_COUNT ||
+      large_tlb_entry_count != LARGE_TLB_ENTRY_COUNT)
+  {
     return false;
+  }
   for (u32 user_supervisor = 0; user_supervisor < 2; user_supervisor++)
   {
-    for (u32 write_read = 0; write_read < 3; write_read++)
-      sw.DoPODArray(m_tlb_entries[user_supervisor][write_read], TLB_ENTRY_COUNT);
+    for (u32 set = 0; set < TLB_SET_COUNT; set++)
+      sw.DoPODArray(m_tlb_entries[user_supervisor][set], TLB_WAY_COUNT);
+    sw.DoPODArray(m_large_tlb_entries[user_supervisor], LARGE_TLB_ENTRY_COUNT);
+    sw.DoArray(m_tlb_next_way[user_supervisor], TLB_SET_COUNT);
   }
   sw.Do(&m_tlb_counter_bits);
 #endif
 
-#ifdef ENABLE_PREFETCH_EMULATION
   u32 prefetch_queue_size = PREFETCH_QUEUE_SIZE;
   sw.Do(&prefetch_queue_size);
   if (prefetch_queue_size != PREFETCH_QUEUE_SIZE)
@@ -263,7 +287,6 @@ bool CPU::DoState(StateWrapper& sw)
   sw.DoBytes(m_prefetch_queue, PREFETCH_QUEUE_SIZE);
   sw.Do(&m_prefetch_queue_position);
   sw.Do(&m_prefetch_queue_size);
-#endif
 
   if (sw.IsReading())
   {
@@ -271,6 +294,7 @@ bool CPU::DoState(StateWrapper& sw)
     std::memset(&idata, 0, sizeof(idata));
     m_execution_stats = {};
 
+    InvalidatePDECache(true);
     m_backend->FlushCodeCache();
   }
 
@@ -316,7 +340,7 @@ void CPU::SignalNMI()
 bool CPU::SupportsBackend(CPU::BackendType mode)
 {
   return (mode == CPU::BackendType::Interpreter || mode == CPU::BackendType::CachedInterpreter ||
-          mode == CPU::BackendType::Recompiler);
+          mode == CPU::BackendType::Recompiler || mode == CPU::BackendType::Tiered);
 }
 
 void CPU::SetBackend(CPU::BackendType mode)
@@ -350,6 +374,8 @@ void CPU::GetExecutionStats(ExecutionStats* stats) const
   std::memcpy(stats, &m_execution_stats, sizeof(*stats));
   stats->cycles_executed = m_tsc_cycles + m_pending_cycles;
   stats->num_code_cache_blocks = m_backend->GetCodeBlockCount();
+  stats->code_cache_block_memory = m_backend->GetCodeBlockMemoryUsage();
+  stats->code_invalidations_avoided = m_bus->GetCodeInvalidationsAvoided();
 }
 
 void CPU::CreateBackend()
@@ -366,7 +392,13 @@ void CPU::CreateBackend()
 
 #if defined(Y_CPU_X64)
     case BackendType::Recompiler:
-      m_backend = std::make_unique<Recompiler::Backend>(this);
+      m_backend = std::make_unique<Recompiler::Backend>(this, Recompiler::Backend::TierThresholds{});
+      break;
+
+    case BackendType::Tiered:
+      m_backend = std::make_unique<Recompiler::Backend>(
+        this, Recompiler::Backend::TierThresholds{m_tier_cache_threshold, m_tier_compile_threshold,
+                                                  m_tier_demote_invalidations, m_tier_trace_threshold});
       break;
 #endif
 
@@ -380,29 +412,26 @@ void CPU::CreateBackend()
 
 u8 CPU::FetchInstructionByte()
 {
-#ifdef ENABLE_PREFETCH_EMULATION
-  // It's possible this will still fail if we're at the end of the segment.
+  // The queue is always empty without prefetch emulation. It's possible filling it will still fail if we're at
+  // the end of the segment.
   u8 value;
-  if ((m_prefetch_queue_size - m_prefetch_queue_position) >= sizeof(u8) || FillPrefetchQueue())
+  if ((m_prefetch_queue_size - m_prefetch_queue_position) >= sizeof(u8) ||
+      (m_prefetch_emulation && FillPrefetchQueue()))
     value = m_prefetch_queue[m_prefetch_queue_position++];
   else
     value = FetchDirectInstructionByte(m_registers.EIP);
 
   m_registers.EIP = (m_registers.EIP + sizeof(u8)) & m_EIP_mask;
   return value;
-#else
-  u8 value = FetchDirectInstructionByte(m_registers.EIP);
-  m_registers.EIP = (m_registers.EIP + sizeof(u8)) & m_EIP_mask;
-  return value;
-#endif
 }
 
 u16 CPU::FetchInstructionWord()
 {
-#ifdef ENABLE_PREFETCH_EMULATION
-  // It's possible this will still fail if we're at the end of the segment.
+  // The queue is always empty without prefetch emulation. It's possible filling it will still fail if we're at
+  // the end of the segment.
   u16 value;
-  if ((m_prefetch_queue_size - m_prefetch_queue_position) >= sizeof(u16) || FillPrefetchQueue())
+  if ((m_prefetch_queue_size - m_prefetch_queue_position) >= sizeof(u16) ||
+      (m_prefetch_emulation && FillPrefetchQueue()))
   {
     std::memcpy(&value, &m_prefetch_queue[m_prefetch_queue_position], sizeof(u16));
     m_prefetch_queue_position += sizeof(u16);
@@ -414,19 +443,15 @@ u16 CPU::FetchInstructionWord()
 
   m_registers.EIP = (m_registers.EIP + sizeof(u16)) & m_EIP_mask;
   return value;
-#else
-  u16 value = FetchDirectInstructionWord(m_registers.EIP);
-  m_registers.EIP = (m_registers.EIP + sizeof(u16)) & m_EIP_mask;
-  return value;
-#endif
 }
 
 u32 CPU::FetchInstructionDWord()
 {
-#ifdef ENABLE_PREFETCH_EMULATION
-  // It's possible this will still fail if we're at the end of the segment.
+  // The queue is always empty without prefetch emulation. It's possible filling it will still fail if we're at
+  // the end of the segment.
   u32 value;
-  if ((m_prefetch_queue_size - m_prefetch_queue_position) >= sizeof(u32) || FillPrefetchQueue())
+  if ((m_prefetch_queue_size - m_prefetch_queue_position) >= sizeof(u32) ||
+      (m_prefetch_emulation && FillPrefetchQueue()))
   {
     std::memcpy(&value, &m_prefetch_queue[m_prefetch_queue_position], sizeof(u32));
     m_prefetch_queue_position += sizeof(u32);
@@ -438,11 +463,6 @@ u32 CPU::FetchInstructionDWord()
 
   m_registers.EIP = (m_registers.EIP + sizeof(u32)) & m_EIP_mask;
   return value;
-#else
-  u32 value = FetchDirectInstructionDWord(m_registers.EIP);
-  m_registers.EIP = (m_registers.EIP + sizeof(u32)) & m_EIP_mask;
-  return value;
-#endif
 }
 
 u8 CPU::FetchDirectInstructionByte(u32 address)
@@ -770,8 +790,9 @@ void CPU::LoadSpecialRegister(Reg32 reg, u32 value)
       if (m_registers.CR3 != value)
         Log_DebugPrintf("CR3 <- 0x%08X", value);
 
+      // Global pages stay in the TLB across address space switches.
       m_registers.CR3 = value;
-      InvalidateAllTLBEntries();
+      InvalidateNonGlobalTLBEntries();
       FlushPrefetchQueue();
     }
     break;
@@ -782,6 +803,10 @@ void CPU::LoadSpecialRegister(Reg32 reg, u32 value)
       if (m_registers.CR4.bits != value)
         Log_DebugPrintf("CR4 <- 0x%08X", value);
 
+      // Changing the paging mode or disabling global pages has to drop everything, global entries included.
+      if ((m_registers.CR4.bits ^ value) & (CR4Bit_PSE | CR4Bit_PAE | CR4Bit_PGE))
+        InvalidateAllTLBEntries();
+
       m_registers.CR4.bits = value;
     }
     break;
@@ -821,23 +846,48 @@ void CPU::LoadSpecialRegister(Reg32 reg, u32 value)
   }
 }
 
+// Returns the permissions granted by a page directory or table entry. Bits 0-2 are user read/write/execute, bits 3-5
+// supervisor read/write/execute.
+static u8 GetPageEntryPermissions(u32 entry_bits)
+{
+  // U bit set implies userspace can access it
+  // R bit implies userspace can write to it
+  u8 permissions = (0x05 << 3);                     // supervisor=read,execute
+  permissions |= (entry_bits << 3) & 0x10;          // supervisor=write from R/W bit
+  permissions |= (entry_bits >> 2) & 0x01;          // user=read from U/S bit
+  permissions |= (entry_bits) & 0x04;               // user=execute from U/S bit
+  permissions |= (entry_bits) & 0x02;               // user=write from R/W bit
+  permissions &= 0x3D | ((entry_bits >> 1) & 0x02); // user=write from U/S bit
+  return permissions;
+}
+
 bool CPU::LookupPageTable(PhysicalMemoryAddress* out_physical_address, LinearMemoryAddress linear_address,
                           AccessFlags flags)
 {
-  // TODO: Large (4MB) pages
   const bool user_mode = (InUserMode() && !HasAccessFlagBit(flags, AccessFlags::UseSupervisorPrivileges));
+  const AccessType access_type = GetAccessTypeFromFlags(flags);
 
   // Obtain the address of the page directory. Bits 22-31 index the page directory.
   LinearMemoryAddress dir_base_address = (m_registers.CR3 & 0xFFFFF000);
-  LinearMemoryAddress dir_entry_address =
-    dir_base_address + (((linear_address >> 22) & 0x3FF) * sizeof(PAGE_DIRECTORY_ENTRY));
+  const u32 dir_index = ((linear_address >> 22) & 0x3FF);
+  LinearMemoryAddress dir_entry_address = dir_base_address + (dir_index * sizeof(PAGE_DIRECTORY_ENTRY));
 
-  // Read the page directory entry.
+  // Read the page directory entry, from the cache if we've already seen it.
   PAGE_DIRECTORY_ENTRY directory_entry;
-  directory_entry.bits = m_bus->ReadMemoryDWord(dir_entry_address);
+  const PDECacheEntry& pde_cache_entry = m_pde_cache[dir_index % PDE_CACHE_SIZE];
+  if (pde_cache_entry.tag == (dir_index | (m_pde_cache_counter << 10)) &&
+      (dir_base_address & m_bus->GetMemoryAddressMask()) == m_pde_cache_page)
+  {
+    m_execution_stats.pde_cache_hits++;
+    directory_entry.bits = pde_cache_entry.bits;
+  }
+  else
+  {
+    directory_entry.bits = m_bus->ReadMemoryDWord(dir_entry_address);
+    UpdatePDECache(dir_base_address, dir_index, directory_entry.bits);
+  }
 
   // Check for present bits.
-  // TODO: Permissions
   if (!directory_entry.present)
   {
     // Page not present.
@@ -846,93 +896,114 @@ bool CPU::LookupPageTable(PhysicalMemoryAddress* out_physical_address, LinearMem
     return false;
   }
 
-  // Obtain the address of the page table. Address in the directory is 4KB aligned. Bits 12-21 index the page table.
-  LinearMemoryAddress table_base_address = (directory_entry.page_table_address << 12);
-  LinearMemoryAddress table_entry_address =
-    table_base_address + (((linear_address >> 12) & 0x3FF) * sizeof(PAGE_TABLE_ENTRY));
-
-  // Read the page table entry.
-  PAGE_TABLE_ENTRY table_entry;
-  table_entry.bits = m_bus->ReadMemoryDWord(table_entry_address);
-
-  // Check for present bits.
-  if (!table_entry.present)
+  // With PSE enabled, the directory entry can map a 4MB page directly.
+  const bool large_page = ((m_registers.CR4.bits & CR4Bit_PSE) != 0 && directory_entry.page_size);
+  PAGE_TABLE_ENTRY table_entry = {};
+  LinearMemoryAddress table_entry_address = 0;
+  if (!large_page)
   {
-    // Page not present.
-    if (!HasAccessFlagBit(flags, AccessFlags::NoPageFaults))
-      RaisePageFault(linear_address, flags, false);
-    return false;
-  }
+    // Obtain the address of the page table. Address in the directory is 4KB aligned. Bits 12-21 index the page table.
+    LinearMemoryAddress table_base_address = (directory_entry.page_table_address << 12);
+    table_entry_address = table_base_address + (((linear_address >> 12) & 0x3FF) * sizeof(PAGE_TABLE_ENTRY));
+
+    // Read the page table entry.
+    table_entry.bits = m_bus->ReadMemoryDWord(table_entry_address);
 
-  // Check access, requires both directory and page access
-  // Permission checks only apply in usermode, except if WP bit of CR0 is set
-  const bool do_access_check =
-    (!HasAccessFlagBit(flags, AccessFlags::NoPageProtectionCheck) && ((m_registers.CR0 & CR0Bit_WP) || user_mode));
-  if (do_access_check)
-  {
-    // Permissions for directory
-    // U bit set implies userspace can access it
-    // R bit implies userspace can write to it
-    u8 directory_permissions = (0x05 << 3);                               // supervisor=read,execute
-    directory_permissions |= (directory_entry.bits << 3) & 0x10;          // supervisor=write from R/W bit
-    directory_permissions |= (directory_entry.bits >> 2) & 0x01;          // user=read from U/S bit
-    directory_permissions |= (directory_entry.bits) & 0x04;               // user=execute from U/S bit
-    directory_permissions |= (directory_entry.bits) & 0x02;               // user=write from R/W bit
-    directory_permissions &= 0x3D | ((directory_entry.bits >> 1) & 0x02); // user=write from U/S bit
-
-    // Check for table permissions
-    // U bit set implies userspace can access it
-    // R bit implies userspace can write to it
-    u8 table_permissions = (0x05 << 3);                           // supervisor=read,execute
-    table_permissions |= (table_entry.bits << 3) & 0x10;          // supervisor=write from R/W bit
-    table_permissions |= (table_entry.bits >> 2) & 0x01;          // user=read from U/S bit
-    table_permissions |= (table_entry.bits) & 0x04;               // user=execute from U/S bit
-    table_permissions |= (table_entry.bits) & 0x02;               // user=write from R/W bit
-    table_permissions &= 0x3D | ((table_entry.bits >> 1) & 0x02); // user=write from U/S bit
-
-    u8 access_mask = (1 << static_cast<u8>(GetAccessTypeFromFlags(flags))) << (user_mode ? 0 : 3);
-
-    if ((access_mask & directory_permissions & table_permissions) == 0)
+    // Check for present bits.
+    if (!table_entry.present)
     {
+      // Page not present.
       if (!HasAccessFlagBit(flags, AccessFlags::NoPageFaults))
-        RaisePageFault(linear_address, flags, true);
+        RaisePageFault(linear_address, flags, false);
       return false;
     }
   }
 
-  // Calculate the physical address from the page table entry. Pages are 4KB aligned.
-  PhysicalMemoryAddress page_base_address = (table_entry.physical_address << PAGE_SHIFT);
-  PhysicalMemoryAddress translated_address = page_base_address + (linear_address & 0xFFF);
+  // Permissions require both directory and page access. Supervisor accesses ignore them unless the WP bit of CR0
+  // is set.
+  u8 permissions = GetPageEntryPermissions(directory_entry.bits);
+  if (!large_page)
+    permissions &= GetPageEntryPermissions(table_entry.bits);
+  if (!(m_registers.CR0 & CR0Bit_WP))
+    permissions |= (0x07 << 3);
+
+  const u8 access_shift = user_mode ? 0 : 3;
+  if (!HasAccessFlagBit(flags, AccessFlags::NoPageProtectionCheck) &&
+      (permissions & ((1 << static_cast<u8>(access_type)) << access_shift)) == 0)
+  {
+    if (!HasAccessFlagBit(flags, AccessFlags::NoPageFaults))
+      RaisePageFault(linear_address, flags, true);
+    return false;
+  }
+
+  // Calculate the physical address from the page table entry. Pages are 4KB aligned, large pages 4MB aligned.
+  PhysicalMemoryAddress page_base_address;
+  PhysicalMemoryAddress translated_address;
+  if (large_page)
+  {
+    page_base_address = (directory_entry.large_page_address << LARGE_PAGE_SHIFT);
+    translated_address = page_base_address + (linear_address & LARGE_PAGE_OFFSET_MASK);
+  }
+  else
+  {
+    page_base_address = (table_entry.physical_address << PAGE_SHIFT);
+    translated_address = page_base_address + (linear_address & PAGE_OFFSET_MASK);
+  }
 
   // Updating of accessed/dirty bits is only done with access checks are enabled (=> normal usage)
   if (!HasAccessFlagBit(flags, AccessFlags::NoTLBUpdate))
   {
-    // Update accessed bits on directory and table entries
-    if (!directory_entry.accessed)
+    bool dirty;
+    bool global;
+    if (large_page)
     {
-      directory_entry.accessed = true;
-      m_bus->WriteMemoryDWord(dir_entry_address, directory_entry.bits);
+      // Large pages keep the accessed and dirty bits in the directory entry.
+      if (!directory_entry.accessed || (access_type == AccessType::Write && !directory_entry.dirty))
+      {
+        directory_entry.accessed = true;
+        if (access_type == AccessType::Write)
+          directory_entry.dirty = true;
+        m_bus->WriteMemoryDWord(dir_entry_address, directory_entry.bits);
+        UpdatePDECache(dir_base_address, dir_index, directory_entry.bits);
+      }
+
+      dirty = directory_entry.dirty;
+      global = directory_entry.global;
     }
-    if (!table_entry.accessed)
+    else
     {
-      table_entry.accessed = true;
-      m_bus->WriteMemoryDWord(table_entry_address, table_entry.bits);
-    }
+      // Update accessed bits on directory and table entries
+      if (!directory_entry.accessed)
+      {
+        directory_entry.accessed = true;
+        m_bus->WriteMemoryDWord(dir_entry_address, directory_entry.bits);
+        UpdatePDECache(dir_base_address, dir_index, directory_entry.bits);
+      }
+      if (!table_entry.accessed)
+      {
+        table_entry.accessed = true;
+        m_bus->WriteMemoryDWord(table_entry_address, table_entry.bits);
+      }
 
-    // Update dirty bit on table entry
-    if (GetAccessTypeFromFlags(flags) == AccessType::Write && !table_entry.dirty)
-    {
-      table_entry.dirty = true;
-      m_bus->WriteMemoryDWord(table_entry_address, table_entry.bits);
+      // Update dirty bit on table entry
+      if (access_type == AccessType::Write && !table_entry.dirty)
+      {
+        table_entry.dirty = true;
+        m_bus->WriteMemoryDWord(table_entry_address, table_entry.bits);
+      }
+
+      dirty = table_entry.dirty;
+      global = table_entry.global;
     }
 
 #ifdef ENABLE_TLB_EMULATION
-    const size_t tlb_index = GetTLBEntryIndex(linear_address);
-    const u8 tlb_user_bit = BoolToUInt8(user_mode);
-    const u8 tlb_type = static_cast<u8>(GetAccessTypeFromFlags(flags));
-    TLBEntry& tlb_entry = m_tlb_entries[tlb_user_bit][tlb_type][tlb_index];
-    tlb_entry.linear_address = (linear_address & PAGE_MASK) | m_tlb_counter_bits;
-    tlb_entry.physical_address = page_base_address;
+    // Writes through the entry are only allowed once the page is dirty.
+    u8 tlb_access_mask = (permissions >> access_shift) & 0x07;
+    if (!dirty)
+      tlb_access_mask &= ~static_cast<u8>(AccessTypeMask::Write);
+
+    InsertTLBEntry(linear_address, page_base_address, user_mode, tlb_access_mask,
+                   global && (m_registers.CR4.bits & CR4Bit_PGE) != 0, large_page);
 #endif
   }
 
@@ -1048,7 +1119,7 @@ void CPU::WriteMemoryByte(CPU* cpu, LinearMemoryAddress address, u8 value)
   cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Write, AccessFlags::Normal));
 
   u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  if (ram_page_ptr && !cpu->m_bus->IsCodeInRange(address, sizeof(value)))
   {
     std::memcpy(&ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], &value, sizeof(value));
     return;
@@ -1082,7 +1153,7 @@ void CPU::WriteMemoryWord(CPU* cpu, LinearMemoryAddress address, u16 value)
   cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Write, AccessFlags::Normal));
 
   u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  if (ram_page_ptr && !cpu->m_bus->IsCodeInRange(address, sizeof(value)))
   {
     std::memcpy(&ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], &value, sizeof(value));
     return;
@@ -1116,7 +1187,7 @@ void CPU::WriteMemoryDWord(CPU* cpu, LinearMemoryAddress address, u32 value)
   cpu->TranslateLinearAddress(&address, address, AddAccessTypeToFlags(AccessType::Write, AccessFlags::Normal));
 
   u8* ram_page_ptr = cpu->m_bus->GetRAMPagePointer(address);
-  if (ram_page_ptr)
+  if (ram_page_ptr && !cpu->m_bus->IsCodeInRange(address, sizeof(value)))
   {
     std::memcpy(&ram_page_ptr[address & Bus::MEMORY_PAGE_OFFSET_MASK], &value, sizeof(value));
     return;
@@ -1167,6 +1238,218 @@ void CPU::WriteSegmentMemoryDWord(Segment segment, VirtualMemoryAddress address,
   WriteMemoryDWord(linear_address, value);
 }
 
+template<AccessType access>
+bool CPU::GetBulkStringRange(Segment segment, VirtualMemoryAddress offset, u32 element_size, u64 offset_limit,
+                             u32* count, PhysicalMemoryAddress* out_physical_address, byte** out_ram_ptr)
+{
+  const LinearMemoryAddress linear_address = CalculateLinearAddress(segment, offset);
+
+  // Misaligned elements raise #AC on the first access, which the per-element path does.
+  if (m_alignment_check_enabled && (linear_address & (element_size - 1)) != 0)
+    return false;
+
+  const u64 page_remaining = PAGE_SIZE - (linear_address & PAGE_OFFSET_MASK);
+  const u64 offset_remaining = offset_limit - offset;
+  *count = std::min(*count, static_cast<u32>(std::min(page_remaining, offset_remaining) / element_size));
+  if (*count == 0)
+    return false;
+
+  // The range doesn't wrap, so if both ends are within the segment, everything in between is too.
+  const VirtualMemoryAddress last_offset = offset + (*count * element_size) - 1;
+  if (!CheckSegmentAccess<sizeof(u8), access>(segment, offset, false) ||
+      !CheckSegmentAccess<sizeof(u8), access>(segment, last_offset, false))
+  {
+    return false;
+  }
+
+  // Page faults are left to the per-element path, so the exception is raised with the correct state.
+  if (!TranslateLinearAddress(out_physical_address, linear_address,
+                              AddAccessTypeToFlags(access, AccessFlags::Normal | AccessFlags::NoPageFaults)))
+  {
+    return false;
+  }
+
+  // RAM pointers are not available for MMIO, or for writes to cached code, which go through the bus.
+  byte* ram_page_ptr = m_bus->GetRAMPagePointer(*out_physical_address);
+  if (access == AccessType::Write && ram_page_ptr && m_bus->IsCodeInRange(*out_physical_address, *count * element_size))
+    ram_page_ptr = nullptr;
+  *out_ram_ptr = ram_page_ptr ? (ram_page_ptr + (*out_physical_address & Bus::MEMORY_PAGE_OFFSET_MASK)) : nullptr;
+  return true;
+}
+
+u32 CPU::ExecuteBulkStringOperation(Operation operation, OperandSize operand_size, AddressSize address_size,
+                                    Segment src_segment)
+{
+  // Reverse operations, single-stepping and debug breakpoints go through the per-element path.
+  if (m_registers.EFLAGS.DF || m_registers.EFLAGS.TF || (m_registers.DR7 & 0xFF) != 0)
+    return 0;
+
+  const bool is_16bit = (address_size == AddressSize_16);
+  const u64 offset_limit = is_16bit ? UINT64_C(0x10000) : UINT64_C(0x100000000);
+  const u32 element_size = GetOperandSizeInBytes(operand_size);
+  u32 count = is_16bit ? ZeroExtend32(m_registers.CX) : m_registers.ECX;
+
+  const u16 port = m_registers.DX;
+  if ((operation == Operation_INS || operation == Operation_OUTS) && !HasIOPermissions(port, element_size, false))
+    return 0;
+
+  const bool has_src = (operation == Operation_MOVS || operation == Operation_LODS || operation == Operation_OUTS);
+  PhysicalMemoryAddress src_address = 0;
+  byte* src_ptr = nullptr;
+  if (has_src)
+  {
+    const VirtualMemoryAddress src_offset = is_16bit ? ZeroExtend32(m_registers.SI) : m_registers.ESI;
+    if (!GetBulkStringRange<AccessType::Read>(src_segment, src_offset, element_size, offset_limit, &count,
+                                              &src_address, &src_ptr))
+    {
+      return 0;
+    }
+  }
+
+  const bool has_dst = (operation == Operation_MOVS || operation == Operation_STOS || operation == Operation_INS);
+  PhysicalMemoryAddress dst_address = 0;
+  byte* dst_ptr = nullptr;
+  if (has_dst)
+  {
+    const VirtualMemoryAddress dst_offset = is_16bit ? ZeroExtend32(m_registers.DI) : m_registers.EDI;
+    if (!GetBulkStringRange<AccessType::Write>(Segment_ES, dst_offset, element_size, offset_limit, &count,
+                                               &dst_address, &dst_ptr))
+    {
+      return 0;
+    }
+  }
+
+  // Only MOVS and STOS can have a non-RAM side, which has to be MMIO with a block handler.
+  if ((has_src && !src_ptr && operation != Operation_MOVS) || (has_dst && !dst_ptr && operation == Operation_INS) ||
+      (operation == Operation_MOVS && !src_ptr && !dst_ptr))
+  {
+    return 0;
+  }
+
+  // The destination clamp may have reduced the count, so the source range is still within its page.
+  u32 byte_count = count * element_size;
+  CycleCount element_cycles;
+  switch (operation)
+  {
+    case Operation_MOVS:
+    {
+      if (!dst_ptr)
+      {
+        if (!m_bus->WriteMMIOBlock(dst_address, byte_count, src_ptr))
+          return 0;
+      }
+      else if (!src_ptr)
+      {
+        if (!m_bus->ReadMMIOBlock(src_address, byte_count, dst_ptr))
+          return 0;
+      }
+      else
+      {
+        // A forward copy into the bytes just ahead of the source replicates the pattern, which memmove doesn't.
+        if (dst_ptr > src_ptr && dst_ptr < (src_ptr + byte_count))
+          return 0;
+
+        std::memmove(dst_ptr, src_ptr, byte_count);
+      }
+      element_cycles = GetCycles(CYCLES_REP_MOVS_N);
+    }
+    break;
+
+    case Operation_STOS:
+    {
+      // MMIO is filled from a buffer, in a single block write.
+      std::array<byte, PAGE_SIZE> buffer;
+      byte* fill_ptr = dst_ptr ? dst_ptr : buffer.data();
+      if (operand_size == OperandSize_8)
+      {
+        std::memset(fill_ptr, m_registers.AL, byte_count);
+      }
+      else
+      {
+        const u32 value = m_registers.EAX;
+        for (u32 i = 0; i < byte_count; i += element_size)
+          std::memcpy(fill_ptr + i, &value, element_size);
+      }
+      if (!dst_ptr && !m_bus->WriteMMIOBlock(dst_address, byte_count, buffer.data()))
+        return 0;
+
+      element_cycles = GetCycles(CYCLES_REP_STOS_N);
+    }
+    break;
+
+    case Operation_LODS:
+    {
+      // Only the last element survives.
+      const byte* last_ptr = src_ptr + byte_count - element_size;
+      if (operand_size == OperandSize_8)
+        m_registers.AL = *last_ptr;
+      else if (operand_size == OperandSize_16)
+        std::memcpy(&m_registers.AX, last_ptr, sizeof(u16));
+      else
+        std::memcpy(&m_registers.EAX, last_ptr, sizeof(u32));
+      element_cycles = GetCycles(CYCLES_REP_LODS_N);
+    }
+    break;
+
+    case Operation_INS:
+    case Operation_OUTS:
+    {
+      // The device may transfer fewer elements, e.g. when its buffer runs out. IO is timing-sensitive, so the device
+      // sees the time up to the start of the transfer.
+      CommitPendingCycles();
+      if (operation == Operation_INS)
+      {
+        count = m_bus->ReadIOPortBlock(port, element_size, count, dst_ptr);
+        element_cycles = GetCyclesPMode(CYCLES_REP_INS_N);
+      }
+      else
+      {
+        count = m_bus->WriteIOPortBlock(port, element_size, count, src_ptr);
+        element_cycles = GetCyclesPMode(CYCLES_REP_OUTS_N);
+      }
+      if (count == 0)
+        return 0;
+
+      byte_count = count * element_size;
+    }
+    break;
+
+    default:
+      DebugUnreachableCode();
+      return 0;
+  }
+
+  if (is_16bit)
+  {
+    m_registers.CX -= Truncate16(count);
+    if (has_src)
+      m_registers.SI += Truncate16(byte_count);
+    if (has_dst)
+      m_registers.DI += Truncate16(byte_count);
+  }
+  else
+  {
+    m_registers.ECX -= count;
+    if (has_src)
+      m_registers.ESI += byte_count;
+    if (has_dst)
+      m_registers.EDI += byte_count;
+  }
+
+  // The caller accounted for the first iteration, each one costs the per-element cycles plus the loop cycle.
+  m_pending_cycles += static_cast<CycleCount>(count - 1) * (element_cycles + 1);
+
+  // Check for events and interrupts at each page boundary, so a long transfer doesn't hold them off until it's done.
+  const bool elements_remaining = is_16bit ? (m_registers.CX != 0) : (m_registers.ECX != 0);
+  if (elements_remaining && (m_pending_cycles >= m_execution_downcount || HasExternalInterrupt()))
+  {
+    RestartCurrentInstruction();
+    AbortCurrentInstruction();
+  }
+
+  return count;
+}
+
 bool CPU::SafeReadMemoryByte(LinearMemoryAddress address, u8* value, AccessFlags access_flags)
 {
   PhysicalMemoryAddress physical_address;
@@ -1988,6 +2271,8 @@ void CPU::BranchFromException(u32 new_EIP)
 
 void CPU::AbortCurrentInstruction()
 {
+  // The operation recorded last has completed, only the current instruction is abandoned.
+  SyncLazyFlags();
   FlushPrefetchQueue();
 
   Log_TracePrintf("Aborting instruction at %04X:%08X", ZeroExtend32(m_registers.CS), m_registers.EIP);
@@ -1996,14 +2281,12 @@ void CPU::AbortCurrentInstruction()
 
 void CPU::RestartCurrentInstruction()
 {
-// Reset EIP, so that we start fetching from the beginning of the instruction again.
-#ifdef ENABLE_PREFETCH_EMULATION
+  // Reset EIP, so that we start fetching from the beginning of the instruction again.
   u32 current_fetch_length = m_registers.EIP - m_current_EIP;
   if (m_prefetch_queue_position >= current_fetch_length)
     m_prefetch_queue_position -= current_fetch_length;
   else
     FlushPrefetchQueue();
-#endif
   m_registers.EIP = m_current_EIP;
 }
 
@@ -2757,6 +3040,9 @@ void CPU::InterruptReturn(OperandSize operand_size)
 void CPU::SetupInterruptCall(u32 interrupt, bool software_interrupt, bool push_error_code, u32 error_code,
                              u32 return_EIP)
 {
+  // The handler sees EFLAGS, either on the stack or in the TSS.
+  SyncLazyFlags();
+
   if (InRealMode())
     SetupRealModeInterruptCall(interrupt, return_EIP);
   else
@@ -3897,7 +4183,7 @@ void CPU::ExecuteCPUIDInstruction()
           break;
 
         case MODEL_PENTIUM:
-          m_registers.EDX = CPUID_FLAG_FPU /*| CPUID_FLAG_DE */ | CPUID_FLAG_VME /*| CPUID_FLAG_PSE*/
+          m_registers.EDX = CPUID_FLAG_FPU /*| CPUID_FLAG_DE */ | CPUID_FLAG_VME | CPUID_FLAG_PSE
                             | CPUID_FLAG_TSC | CPUID_FLAG_MSR |
                             /*| CPUID_FLAG_MCE */ CPUID_FLAG_CX8;
           break;
@@ -4120,47 +4406,195 @@ void CPU::DumpStack()
   }
 }
 
+void CPU::InsertTLBEntry(LinearMemoryAddress linear_address, PhysicalMemoryAddress page_base_address, bool user_mode,
+                         u8 access_mask, bool global, bool large_page)
+{
+#ifdef ENABLE_TLB_EMULATION
+  const u8 tlb_user_bit = BoolToUInt8(user_mode);
+  TLBEntry* entry;
+  if (large_page)
+  {
+    entry = &m_large_tlb_entries[tlb_user_bit][GetLargeTLBEntryIndex(linear_address)];
+    entry->linear_address = (linear_address & LARGE_PAGE_MASK) | m_tlb_counter_bits;
+  }
+  else
+  {
+    // Replace the existing entry for this page if there is one (e.g. a read entry gaining write access), otherwise
+    // evict round-robin within the set.
+    const u32 set_index = GetTLBSetIndex(linear_address);
+    const u32 tag = (linear_address & PAGE_MASK) | m_tlb_counter_bits;
+    TLBEntry* set = m_tlb_entries[tlb_user_bit][set_index];
+    entry = nullptr;
+    for (u32 way = 0; way < TLB_WAY_COUNT; way++)
+    {
+      if (set[way].linear_address == tag)
+      {
+        entry = &set[way];
+        break;
+      }
+    }
+    if (!entry)
+    {
+      u8& next_way = m_tlb_next_way[tlb_user_bit][set_index];
+      entry = &set[next_way];
+      next_way = (next_way + 1) % TLB_WAY_COUNT;
+    }
+
+    entry->linear_address = tag;
+  }
+
+  entry->physical_address = page_base_address;
+  entry->access_mask = access_mask;
+  entry->global = global;
+#endif
+}
+
 void CPU::InvalidateAllTLBEntries(bool force_clear /* = false */)
 {
+  InvalidatePDECache(force_clear);
+
 #ifdef ENABLE_TLB_EMULATION
+  m_execution_stats.tlb_flushes++;
   m_tlb_counter_bits++;
   Log_DebugPrintf("Invaliding TLB entries, counter=0x%03X", m_tlb_counter_bits);
   if (m_tlb_counter_bits == 0xFFF || force_clear)
   {
     std::memset(m_tlb_entries, 0xFF, sizeof(m_tlb_entries));
+    std::memset(m_large_tlb_entries, 0xFF, sizeof(m_large_tlb_entries));
+    std::memset(m_tlb_next_way, 0, sizeof(m_tlb_next_way));
     m_tlb_counter_bits = 0;
   }
 #endif
 }
 
+void CPU::InvalidateNonGlobalTLBEntries()
+{
+#ifdef ENABLE_TLB_EMULATION
+  const u32 old_counter_bits = m_tlb_counter_bits;
+  InvalidateAllTLBEntries();
+  if (!(m_registers.CR4.bits & CR4Bit_PGE) || m_tlb_counter_bits == 0)
+    return;
+
+  // Move the global entries over to the new counter value, so they survive the flush. Invalid entries can't match
+  // the old counter, as it never reaches 0xFFF.
+  auto retag_entry = [this, old_counter_bits](TLBEntry& entry) {
+    if (entry.global && (entry.linear_address & PAGE_OFFSET_MASK) == old_counter_bits)
+      entry.linear_address = (entry.linear_address & PAGE_MASK) | m_tlb_counter_bits;
+  };
+  for (u32 user_supervisor = 0; user_supervisor < 2; user_supervisor++)
+  {
+    for (u32 set = 0; set < TLB_SET_COUNT; set++)
+    {
+      for (u32 way = 0; way < TLB_WAY_COUNT; way++)
+        retag_entry(m_tlb_entries[user_supervisor][set][way]);
+    }
+    for (u32 index = 0; index < LARGE_TLB_ENTRY_COUNT; index++)
+      retag_entry(m_large_tlb_entries[user_supervisor][index]);
+  }
+#endif
+}
+
 void CPU::InvalidateTLBEntry(u32 linear_address)
 {
+  // INVLPG also drops the directory entry used to translate the address.
+  InvalidatePDECacheEntry((linear_address >> 22) & 0x3FF);
+
 #ifdef ENABLE_TLB_EMULATION
   const u32 compare_linear_address = (linear_address & PAGE_MASK) | m_tlb_counter_bits;
-  const u32 index = GetTLBEntryIndex(linear_address);
+  const u32 compare_large_linear_address = (linear_address & LARGE_PAGE_MASK) | m_tlb_counter_bits;
+  const u32 set_index = GetTLBSetIndex(linear_address);
+  const u32 large_index = GetLargeTLBEntryIndex(linear_address);
   for (u32 user_supervisor = 0; user_supervisor < 2; user_supervisor++)
   {
-    for (u32 write_read = 0; write_read < 3; write_read++)
+    for (u32 way = 0; way < TLB_WAY_COUNT; way++)
     {
-      TLBEntry& entry = m_tlb_entries[user_supervisor][write_read][index];
+      TLBEntry& entry = m_tlb_entries[user_supervisor][set_index][way];
       if (entry.linear_address == compare_linear_address)
         entry.linear_address = 0xFFFFFFFF;
     }
+
+    TLBEntry& large_entry = m_large_tlb_entries[user_supervisor][large_index];
+    if (large_entry.linear_address == compare_large_linear_address)
+      large_entry.linear_address = 0xFFFFFFFF;
   }
 #endif
 }
 
+void CPU::UpdatePDECache(PhysicalMemoryAddress dir_base_address, u32 dir_index, u32 bits)
+{
+  dir_base_address &= m_bus->GetMemoryAddressMask();
+  if (dir_base_address != m_pde_cache_page)
+  {
+    // Switching to a different page directory, so stop watching the old one.
+    if (m_pde_cache_page != 0xFFFFFFFF)
+      m_bus->UnmarkPageAsPageTable(m_pde_cache_page);
+
+    InvalidatePDECache();
+    m_pde_cache_page = 0xFFFFFFFF;
+
+    // Directories outside of RAM can't be watched for writes, so they can't be cached.
+    if (!m_bus->MarkPageAsPageTable(dir_base_address))
+      return;
+
+    m_pde_cache_page = dir_base_address;
+  }
+
+  PDECacheEntry& entry = m_pde_cache[dir_index % PDE_CACHE_SIZE];
+  entry.tag = dir_index | (m_pde_cache_counter << 10);
+  entry.bits = bits;
+}
+
+void CPU::InvalidatePDECache(bool force_clear /* = false */)
+{
+  // The counter lives in the upper 22 bits of the tag, and can't reach all-ones as that marks an invalid entry.
+  m_pde_cache_counter++;
+  if (m_pde_cache_counter == 0x3FFFFF || force_clear)
+  {
+    std::memset(m_pde_cache, 0xFF, sizeof(m_pde_cache));
+    m_pde_cache_counter = 0;
+  }
+}
+
+void CPU::InvalidatePDECacheEntry(u32 dir_index)
+{
+  PDECacheEntry& entry = m_pde_cache[dir_index % PDE_CACHE_SIZE];
+  if ((entry.tag & 0x3FF) == dir_index)
+    entry.tag = 0xFFFFFFFF;
+}
+
+void CPU::OnPageTableWrite(PhysicalMemoryAddress address, u32 size)
+{
+  // Pages we no longer cache from can be left marked after a CR3 load when nothing has been looked up since.
+  if ((address & PAGE_MASK) != m_pde_cache_page)
+  {
+    m_bus->UnmarkPageAsPageTable(address);
+    return;
+  }
+
+  // Whole-page notifications also come from the page changing type, in which case it may no longer be RAM.
+  if (size >= PAGE_SIZE)
+  {
+    m_bus->UnmarkPageAsPageTable(m_pde_cache_page);
+    m_pde_cache_page = 0xFFFFFFFF;
+    InvalidatePDECache();
+    return;
+  }
+
+  const u32 page_offset = address & PAGE_OFFSET_MASK;
+  const u32 first_index = page_offset / sizeof(PAGE_DIRECTORY_ENTRY);
+  const u32 last_index = std::min((page_offset + size - 1) / u32(sizeof(PAGE_DIRECTORY_ENTRY)), u32(0x3FF));
+  for (u32 dir_index = first_index; dir_index <= last_index; dir_index++)
+    InvalidatePDECacheEntry(dir_index);
+}
+
 void CPU::FlushPrefetchQueue()
 {
-#ifdef ENABLE_PREFETCH_EMULATION
   m_prefetch_queue_position = 0;
   m_prefetch_queue_size = 0;
-#endif
 }
 
 bool CPU::FillPrefetchQueue()
 {
-#ifdef ENABLE_PREFETCH_EMULATION
   m_prefetch_queue_position = 0;
   m_prefetch_queue_size = 0;
 
@@ -4188,9 +4622,6 @@ bool CPU::FillPrefetchQueue()
   m_bus->ReadMemoryBlock(physical_address, PREFETCH_QUEUE_SIZE, m_prefetch_queue);
   m_prefetch_queue_size = PREFETCH_QUEUE_SIZE;
   return true;
-#else
-  return false;
-#endif
 }
 
 #if 0
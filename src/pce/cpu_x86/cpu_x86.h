@@ -9,7 +9,6 @@
 
 // Enable TLB emulation?
 #define ENABLE_TLB_EMULATION 1
-#define ENABLE_PREFETCH_EMULATION 1
 #define PREFETCH_QUEUE_SIZE 32
 
 class DebuggerInterface;
@@ -49,7 +48,14 @@ public:
   static constexpr u32 PAGE_OFFSET_MASK = (PAGE_SIZE - 1);
   static constexpr u32 PAGE_MASK = ~PAGE_OFFSET_MASK;
   static constexpr u32 PAGE_SHIFT = 12;
-  static constexpr size_t TLB_ENTRY_COUNT = 8192;
+  static constexpr u32 TLB_SET_COUNT = 128;
+  static constexpr u32 TLB_WAY_COUNT = 4;
+  static constexpr u32 LARGE_PAGE_SIZE = 4 * 1024 * 1024;
+  static constexpr u32 LARGE_PAGE_OFFSET_MASK = (LARGE_PAGE_SIZE - 1);
+  static constexpr u32 LARGE_PAGE_MASK = ~LARGE_PAGE_OFFSET_MASK;
+  static constexpr u32 LARGE_PAGE_SHIFT = 22;
+  static constexpr u32 LARGE_TLB_ENTRY_COUNT = 16;
+  static constexpr u32 PDE_CACHE_SIZE = 64;
 
 #pragma pack(push, 1)
   // Needed because the 8-bit register indices are all low bits -> all high bits
@@ -221,6 +227,28 @@ public:
     u32 reg32[Reg32_Count];
   };
 
+  // Flag-producing ALU operation recorded by the interpreter in place of its status flags.
+  enum class LazyFlagsOp : u8
+  {
+    None,
+    Add,
+    Sub,
+    Logic,
+    Inc,
+    Dec
+  };
+
+  // Operands and result of the recorded operation, zero-extended from size. carry is the CF preserved by INC/DEC.
+  struct LazyFlags
+  {
+    LazyFlagsOp op;
+    OperandSize size;
+    u32 lhs;
+    u32 rhs;
+    u32 result;
+    u32 carry;
+  };
+
   struct FPURegisters
   {
     float80 ST[8];
@@ -368,17 +396,32 @@ public:
     }
 
 #ifdef ENABLE_TLB_EMULATION
-    // Check TLB.
-    const u32 tlb_index = GetTLBEntryIndex(linear_address);
+    // Check TLB. Entries are shared between access types, so the entry has to permit this one.
     const u8 tlb_user_bit = BoolToUInt8(InUserMode() && !HasAccessFlagBit(flags, AccessFlags::UseSupervisorPrivileges));
-    const u8 tlb_type = static_cast<u8>(GetAccessTypeFromFlags(flags));
-    TLBEntry& tlb_entry = m_tlb_entries[tlb_user_bit][tlb_type][tlb_index];
-    if (tlb_entry.linear_address == ((linear_address & PAGE_MASK) | m_tlb_counter_bits))
+    const u8 tlb_access_bit = static_cast<u8>(1 << static_cast<u8>(GetAccessTypeFromFlags(flags)));
+    const u32 tlb_tag = (linear_address & PAGE_MASK) | m_tlb_counter_bits;
+    const TLBEntry* tlb_set = m_tlb_entries[tlb_user_bit][GetTLBSetIndex(linear_address)];
+    for (u32 way = 0; way < TLB_WAY_COUNT; way++)
+    {
+      if (tlb_set[way].linear_address == tlb_tag && (tlb_set[way].access_mask & tlb_access_bit))
+      {
+        // TLB hit!
+        m_execution_stats.tlb_hits++;
+        *out_physical_address = tlb_set[way].physical_address + (linear_address & PAGE_OFFSET_MASK);
+        return true;
+      }
+    }
+
+    const TLBEntry& large_tlb_entry = m_large_tlb_entries[tlb_user_bit][GetLargeTLBEntryIndex(linear_address)];
+    if (large_tlb_entry.linear_address == ((linear_address & LARGE_PAGE_MASK) | m_tlb_counter_bits) &&
+        (large_tlb_entry.access_mask & tlb_access_bit))
     {
-      // TLB hit!
-      *out_physical_address = tlb_entry.physical_address + (linear_address & PAGE_OFFSET_MASK);
+      m_execution_stats.tlb_hits++;
+      *out_physical_address = large_tlb_entry.physical_address + (linear_address & LARGE_PAGE_OFFSET_MASK);
       return true;
     }
+
+    m_execution_stats.tlb_misses++;
 #endif
 
     return LookupPageTable(out_physical_address, linear_address, flags);
@@ -439,6 +482,16 @@ public:
   void WriteSegmentMemoryWord(Segment segment, VirtualMemoryAddress address, u16 value);
   void WriteSegmentMemoryDWord(Segment segment, VirtualMemoryAddress address, u32 value);
 
+  // Bulk fast path for REP MOVS/STOS/LODS/INS/OUTS, shared by the interpreter and recompiler. Copies or fills up to the
+  // next page boundary with host memory operations, when both sides are plain RAM. INS/OUTS hand the RAM to the port's
+  // block handler, and MOVS/STOS to or from MMIO use the region's block handler if it has one. The caller has already
+  // checked that the count is non-zero and added the cycles for the first iteration. Returns the number of iterations
+  // completed, or zero if the fast path can't be used, in which case nothing is modified. When elements remain and an
+  // event or interrupt is due, the instruction is restarted through the dispatcher instead of returning, with the
+  // registers describing the remaining elements.
+  u32 ExecuteBulkStringOperation(Operation operation, OperandSize operand_size, AddressSize address_size,
+                                 Segment src_segment);
+
   // Unchecked memory reads/writes (don't perform access checks, or raise exceptions).
   // Safe to use outside instruction handlers.
   bool SafeReadMemoryByte(LinearMemoryAddress address, u8* value, AccessFlags access_flags);
@@ -500,6 +553,12 @@ protected:
   bool LookupPageTable(PhysicalMemoryAddress* out_physical_address, LinearMemoryAddress linear_address,
                        AccessFlags flags);
 
+  // Translates the range of a string operation's elements, clamping count to stay within the page and segment. The
+  // host pointer is null when the page is not directly accessible RAM, e.g. MMIO.
+  template<AccessType access>
+  bool GetBulkStringRange(Segment segment, VirtualMemoryAddress offset, u32 element_size, u64 offset_limit,
+                          u32* count, PhysicalMemoryAddress* out_physical_address, byte** out_ram_ptr);
+
   // Instruction fetching
   u8 FetchInstructionByte();
   u16 FetchInstructionWord();
@@ -521,6 +580,15 @@ protected:
 
   // Sets flags from a value, masking away bits that can't be changed
   void SetFlags(u32 value);
+
+  // Writes the status flags of the operation recorded in m_lazy_flags to EFLAGS. Anything reading CF/PF/AF/ZF/SF/OF
+  // while the interpreter may have left them pending has to call this first.
+  void SyncLazyFlags()
+  {
+    if (m_lazy_flags.op != LazyFlagsOp::None)
+      MaterializeLazyFlags();
+  }
+  void MaterializeLazyFlags();
   void UpdateAlignmentCheckMask();
   void SetCPL(u8 cpl);
   void Halt();
@@ -634,14 +702,26 @@ protected:
   void DumpStack();
 
   // TLB emulation
-  u32 GetTLBEntryIndex(LinearMemoryAddress linear_address)
+  static u32 GetTLBSetIndex(LinearMemoryAddress linear_address)
   {
-    // Maybe a better hash function should be used here?
-    return static_cast<u32>(linear_address >> PAGE_SHIFT) % TLB_ENTRY_COUNT;
+    return static_cast<u32>(linear_address >> PAGE_SHIFT) % TLB_SET_COUNT;
   }
+  static u32 GetLargeTLBEntryIndex(LinearMemoryAddress linear_address)
+  {
+    return static_cast<u32>(linear_address >> LARGE_PAGE_SHIFT) % LARGE_TLB_ENTRY_COUNT;
+  }
+  void InsertTLBEntry(LinearMemoryAddress linear_address, PhysicalMemoryAddress page_base_address, bool user_mode,
+                      u8 access_mask, bool global, bool large_page);
   void InvalidateAllTLBEntries(bool force_clear = false);
+  void InvalidateNonGlobalTLBEntries();
   void InvalidateTLBEntry(u32 linear_address);
 
+  // Page directory entry cache
+  void UpdatePDECache(PhysicalMemoryAddress dir_base_address, u32 dir_index, u32 bits);
+  void InvalidatePDECache(bool force_clear = false);
+  void InvalidatePDECacheEntry(u32 dir_index);
+  void OnPageTableWrite(PhysicalMemoryAddress address, u32 size);
+
   // Prefetch queue emulation
   void FlushPrefetchQueue();
   bool FillPrefetchQueue();
@@ -652,6 +732,10 @@ protected:
   Registers m_registers = {};
   FPURegisters m_fpu_registers = {};
 
+  // Last flag-producing ALU operation executed through the interpreter's dispatcher. Its status flags are only written
+  // to EFLAGS once something needs them. Synced before the state is saved, so not saved itself.
+  LazyFlags m_lazy_flags = {};
+
   // Current execution state.
   VirtualMemoryAddress m_effective_address = 0;
   InstructionData idata = {};
@@ -719,12 +803,34 @@ protected:
   // Exception currently being thrown. Interrupt_Count at all other times. Not saved to state.
   u32 m_current_exception = Interrupt_Count;
 
+  // Set when a trace leaves through a side exit instead of its final exit, cleared by the dispatcher. Not saved to
+  // state.
+  bool m_trace_side_exit = false;
+
   // Timing data.
   u16 m_cycle_group_timings[NUM_CYCLE_GROUPS] = {};
 
   // Execution statistics.
   ExecutionStats m_execution_stats = {};
 
+  // Tiered backend thresholds. A block is decoded once it has been looked up this many times, compiled once it has
+  // run this many times in the cached interpreter, and kept in the cached interpreter once invalidated this many times.
+  // Compiled blocks continue as traces past conditional branches which have been profiled this many times.
+  u32 m_tier_cache_threshold = 2;
+  u32 m_tier_compile_threshold = 16;
+  u32 m_tier_demote_invalidations = 8;
+  u32 m_tier_trace_threshold = 8;
+
+  // Fetch instructions through an emulated prefetch queue, so stores to the bytes just ahead of EIP aren't seen
+  // until the queue is flushed, as on real hardware. Only self-modifying code that depends on this needs it.
+  bool m_prefetch_emulation = true;
+
+  // Use host doubles for x87 arithmetic when the guest's control word allows it, instead of softfloat.
+  bool m_fast_fpu = false;
+
+  // Log the recompiler's IR for each block before and after the optimization passes.
+  bool m_recompiler_dump_ir = false;
+
 #ifdef ENABLE_TLB_EMULATION
   // We use the lower 12 bits to represent a "counter" which is incremented each
   // time the TLB is flushed. This way, we don't need to wipe out the array every
@@ -736,18 +842,40 @@ protected:
     // bits set, so it will never be confused for a real entry.
     LinearMemoryAddress linear_address;
     PhysicalMemoryAddress physical_address;
+
+    // Access types (1 << AccessType) which can use the entry without walking the page tables. Writes are only
+    // allowed once the page is dirty, so the first write still goes through the walk to set the dirty bit.
+    u8 access_mask;
+
+    // Global entries survive CR3 loads while CR4.PGE is set.
+    bool global;
+
+    u8 padding[6];
   };
 
-  // Indexed by [user_supervisor][write_read]
-  TLBEntry m_tlb_entries[2][3][TLB_ENTRY_COUNT] = {};
+  // Indexed by [user_supervisor][set][way]. 4MB pages live in their own direct-mapped table, as a single entry.
+  TLBEntry m_tlb_entries[2][TLB_SET_COUNT][TLB_WAY_COUNT] = {};
+  TLBEntry m_large_tlb_entries[2][LARGE_TLB_ENTRY_COUNT] = {};
+  u8 m_tlb_next_way[2][TLB_SET_COUNT] = {};
   u32 m_tlb_counter_bits = 0;
 #endif
 
-#ifdef ENABLE_PREFETCH_EMULATION
+  // Directory entries of the current page directory, so a TLB miss only has to read the page table entry. The tag
+  // holds the directory index in the low 10 bits and the invalidation counter above, invalid entries are 0xFFFFFFFF.
+  // The directory page is marked in the bus, so guest writes to it drop the affected entries.
+  struct PDECacheEntry
+  {
+    u32 tag;
+    u32 bits;
+  };
+  PDECacheEntry m_pde_cache[PDE_CACHE_SIZE] = {};
+  u32 m_pde_cache_counter = 0;
+  PhysicalMemoryAddress m_pde_cache_page = 0xFFFFFFFF;
+
+  // Always empty when prefetch emulation is disabled.
   byte m_prefetch_queue[PREFETCH_QUEUE_SIZE] = {};
   u32 m_prefetch_queue_position = 0;
   u32 m_prefetch_queue_size = 0;
-#endif
 };
 
 } // namespace CPU_X86
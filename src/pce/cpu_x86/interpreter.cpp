@@ -1,9 +1,13 @@
 #include "interpreter.h"
+#include "YBaseLib/Log.h"
+#include "code_cache_types.h"
+Log_SetChannel(CPU_X86::Interpreter);
 
 // clang-format off
 #include "interpreter.inl"
 #include "interpreter_x87.inl"
 #include "interpreter_dispatch.inl"
+#include "interpreter_threaded.inl"
 // clang-format on
 
 namespace CPU_X86 {
@@ -43,4 +47,25 @@ Interpreter::HandlerFunction Interpreter::GetInterpreterHandlerForInstruction(co
   auto iter = s_handler_functions.find(key);
   return (iter != s_handler_functions.end()) ? iter->second : nullptr;
 }
+
+void CPU::MaterializeLazyFlags()
+{
+  const LazyFlags& lf = m_lazy_flags;
+  switch (lf.size)
+  {
+    case OperandSize_8:
+      m_registers.EFLAGS.bits = EFLAGS_LazyOp<u8>(m_registers.EFLAGS.bits, lf.op, Truncate8(lf.lhs),
+                                                  Truncate8(lf.rhs), Truncate8(lf.result), lf.carry);
+      break;
+    case OperandSize_16:
+      m_registers.EFLAGS.bits = EFLAGS_LazyOp<u16>(m_registers.EFLAGS.bits, lf.op, Truncate16(lf.lhs),
+                                                   Truncate16(lf.rhs), Truncate16(lf.result), lf.carry);
+      break;
+    default:
+      m_registers.EFLAGS.bits = EFLAGS_LazyOp<u32>(m_registers.EFLAGS.bits, lf.op, lf.lhs, lf.rhs, lf.result, lf.carry);
+      break;
+  }
+
+  m_lazy_flags.op = LazyFlagsOp::None;
+}
 } // namespace CPU_X86
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <map>
 #include <softfloat.h>
 #include <softfloatx80.h>
+#include <vector>
 
 namespace CPU_X86 {
 class Interpreter
@@ -19,7 +20,122 @@ public:
 
   static void RaiseInvalidOpcode(CPU* cpu);
 
+  // Pre-decoded instruction for the threaded cached interpreter. Register indices, immediates, branch targets, memory
+  // operand addressing forms and cycle counts are resolved when the block is built, and each handler returns the next
+  // op to execute.
+  struct ThreadedOp
+  {
+    using Handler = const ThreadedOp* (*)(CPU* cpu, const ThreadedOp* op);
+
+    Handler handler;
+    union
+    {
+      // Instructions without a specialised handler run the regular handler on a copy of the instruction data.
+      struct
+      {
+        HandlerFunction interpreter_handler;
+        const InstructionData* data;
+      };
+
+      // Register/immediate forms. jump_target is used by Jcc and fused compare-and-branch ops.
+      struct
+      {
+        u32 imm;
+        u32 jump_target;
+      };
+    };
+    u16 cycles;
+    u8 length;
+    u8 jump_length;
+    u8 dst_reg;
+    u8 src_reg;
+    JumpCondition condition;
+
+    // Memory operand, addressed as segment:((base + (index << scale) + displacement) & address_mask).
+    // base_reg/index_reg are ThreadedNoRegister when the form doesn't use them.
+    Segment segment;
+    u8 base_reg;
+    u8 index_reg;
+    u8 scale;
+    u32 displacement;
+    u32 address_mask;
+  };
+  static constexpr u8 ThreadedNoRegister = 0xFF;
+
+  // Builds the threaded ops for a decoded instruction stream. CMP/TEST followed by Jcc is fused into a single op.
+  // Generic ops point into data_array, which must not be modified while the ops are in use.
+  static bool BuildThreadedOps(CPU* cpu, const Instruction* instructions, size_t count,
+                               std::vector<ThreadedOp>* ops, std::vector<InstructionData>* data_array);
+
+  static void ExecuteThreadedOps(CPU* cpu, const ThreadedOp* op, const ThreadedOp* end)
+  {
+    while (op != end)
+      op = op->handler(cpu, op);
+  }
+
 private:
+  enum class ThreadedALUOp : u8
+  {
+    ADD,
+    SUB,
+    AND,
+    OR,
+    XOR,
+    CMP,
+    TEST
+  };
+
+  // Which operand of a threaded MOV/ALU op is in memory, if any.
+  enum class ThreadedMemoryOperand : u8
+  {
+    None,
+    Destination,
+    Source
+  };
+
+  enum class HostFloatOp : u8
+  {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Sqrt,
+    Sin,
+    Cos,
+    Tan,
+    F2XM1,
+    Atan,
+    YL2X,
+    YL2XP1
+  };
+
+  // Threaded op builders and handlers
+  static bool BuildThreadedMOV(CPU* cpu, const Instruction& instruction, ThreadedOp* op);
+  static bool BuildThreadedALU(CPU* cpu, const Instruction& instruction, bool fuse_jcc, ThreadedOp* op);
+  static bool BuildThreadedJcc(const Instruction& instruction, ThreadedOp* op);
+  static bool BuildThreadedAddress(const Instruction& instruction, u32 index, ThreadedOp* op);
+  template<typename T>
+  static inline T& GetThreadedRegister(CPU* cpu, u8 index);
+  static inline VirtualMemoryAddress CalculateThreadedAddress(CPU* cpu, const ThreadedOp* op);
+  template<typename T>
+  static inline T ReadThreadedMemory(CPU* cpu, const ThreadedOp* op, VirtualMemoryAddress address);
+  template<typename T>
+  static inline void WriteThreadedMemory(CPU* cpu, const ThreadedOp* op, VirtualMemoryAddress address, T value);
+  static inline bool TestThreadedJumpCondition(CPU* cpu, JumpCondition condition);
+  static inline const ThreadedOp* ExecuteThreadedJcc(CPU* cpu, const ThreadedOp* op);
+  static const ThreadedOp* ThreadedOp_Generic(CPU* cpu, const ThreadedOp* op);
+  template<typename T, bool src_imm, ThreadedMemoryOperand mem>
+  static const ThreadedOp* ThreadedOp_MOV(CPU* cpu, const ThreadedOp* op);
+  template<ThreadedALUOp alu_op, typename T, bool src_imm, ThreadedMemoryOperand mem, bool fuse_jcc>
+  static const ThreadedOp* ThreadedOp_ALU(CPU* cpu, const ThreadedOp* op);
+  static const ThreadedOp* ThreadedOp_Jcc(CPU* cpu, const ThreadedOp* op);
+  template<typename T>
+  static ThreadedOp::Handler GetThreadedMOVHandler(bool src_imm, ThreadedMemoryOperand mem);
+  template<ThreadedALUOp alu_op, ThreadedMemoryOperand mem, bool fuse_jcc>
+  static ThreadedOp::Handler GetThreadedALUHandler(OperandSize size, bool src_imm);
+  template<ThreadedALUOp alu_op, bool fuse_jcc>
+  static ThreadedOp::Handler SelectThreadedALUHandler(OperandSize size, bool src_imm, ThreadedMemoryOperand mem);
+
   // Helper routines
   static inline void FetchModRM(CPU* cpu);
 
@@ -36,31 +152,31 @@ private:
 
   // Instruction handlers
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-           u32 src_constant>
+           u32 src_constant, bool lazy_flags = false>
   static inline void Execute_Operation_ADD(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
            u32 src_constant>
   static inline void Execute_Operation_ADC(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-           u32 src_constant>
+           u32 src_constant, bool lazy_flags = false>
   static inline void Execute_Operation_SUB(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
            u32 src_constant>
   static inline void Execute_Operation_SBB(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-           u32 src_constant>
+           u32 src_constant, bool lazy_flags = false>
   static inline void Execute_Operation_CMP(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-           u32 src_constant>
+           u32 src_constant, bool lazy_flags = false>
   static inline void Execute_Operation_AND(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-           u32 src_constant>
+           u32 src_constant, bool lazy_flags = false>
   static inline void Execute_Operation_OR(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-           u32 src_constant>
+           u32 src_constant, bool lazy_flags = false>
   static inline void Execute_Operation_XOR(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-           u32 src_constant>
+           u32 src_constant, bool lazy_flags = false>
   static inline void Execute_Operation_TEST(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
            u32 src_constant>
@@ -114,9 +230,9 @@ private:
            u32 src_constant>
   static inline void Execute_Operation_OUT(CPU* cpu);
 
-  template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
+  template<OperandSize val_size, OperandMode val_mode, u32 val_constant, bool lazy_flags = false>
   static inline void Execute_Operation_INC(CPU* cpu);
-  template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
+  template<OperandSize val_size, OperandMode val_mode, u32 val_constant, bool lazy_flags = false>
   static inline void Execute_Operation_DEC(CPU* cpu);
 
   template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
@@ -162,11 +278,13 @@ private:
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
   static inline void Execute_Operation_JMP_Near(CPU* cpu);
 
-  template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
+  template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant,
+           bool lazy_flags = false>
   static inline void Execute_Operation_Jcc(CPU* cpu);
   template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
   static inline void Execute_Operation_LOOP(CPU* cpu);
-  template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
+  template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant,
+           bool lazy_flags = false>
   static inline void Execute_Operation_SETcc(CPU* cpu);
   template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size,
            OperandMode src_mode, u32 src_constant>
@@ -189,7 +307,7 @@ private:
   static inline void Execute_Operation_IRET(CPU* cpu);
 
   // String operations
-  template<Operation operation, bool check_equal, typename callback>
+  template<Operation operation, bool check_equal, OperandSize operand_size = OperandSize_Count, typename callback>
   static inline void Execute_REP(CPU* cpu, callback cb);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
            u32 src_constant>
@@ -368,6 +486,13 @@ private:
   template<JumpCondition condition>
   static inline bool TestJumpCondition(CPU* cpu);
 
+  // Lazy status flags. Handlers instantiated with lazy_flags record their operation in CPU::m_lazy_flags rather than
+  // computing EFLAGS. Only the dispatcher uses them, since it knows which instructions read the flags.
+  template<CPU::LazyFlagsOp op, bool lazy_flags, typename T>
+  static inline void UpdateALUFlags(CPU* cpu, T lhs, T rhs, T result);
+  template<JumpCondition condition>
+  static inline bool TestLazyJumpCondition(CPU* cpu);
+
   // x87/FPU
   static inline void StartX87Instruction(CPU* cpu, bool check_exceptions = true);
   template<OperandSize size, OperandMode mode, u32 constant>
@@ -388,6 +513,16 @@ private:
   static inline void SetStatusWordFromCompare(CPU* cpu, const float_status_t& fs, int res);
   static inline void ClearC1(CPU* cpu);
 
+  // Host double fast path, used in place of softfloat when the CPU's FastFPU option is set and the guest can't tell.
+  static inline bool UseHostFloat(CPU* cpu);
+  static inline bool FloatX80ToHostDouble(const floatx80& value, double* out_value);
+  static inline bool IsExactSingle(double value);
+  static inline bool HostDoubleToFloatX80(double value, floatx80* out_value);
+  template<HostFloatOp op>
+  static inline bool HostFloatUnary(CPU* cpu, const floatx80& value, floatx80* result);
+  template<HostFloatOp op>
+  static inline bool HostFloatBinary(CPU* cpu, const floatx80& lhs, const floatx80& rhs, floatx80* result);
+
   static inline void Execute_Operation_F2XM1(CPU* cpu);
   static inline void Execute_Operation_FABS(CPU* cpu);
   template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
@@ -1310,8 +1310,198 @@ ALWAYS_INLINE u32 ALUOp_Sbb32(u32* eflags, u32 lhs, u32 rhs)
   return out_value;
 }
 
+template<typename ValueType>
+ALWAYS_INLINE constexpr u32 EFLAGS_BitwiseOps(u32 old_eflags, ValueType new_value)
+{
+  // The OF and CF flags are cleared; the SF, ZF, and PF flags are set according to the result. The state of the AF flag
+  // is undefined.
+  return (old_eflags & ~(Flag_OF | Flag_CF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Clear OF/CF/AF
+         SignFlag(new_value) |                                                         // SF
+         ParityFlag(new_value) |                                                       // PF
+         ZeroFlag(new_value);                                                          // ZF
+}
+
+template<typename T>
+ALWAYS_INLINE constexpr u32 EFLAGS_ALUAdd(u32 old_eflags, T lhs, T rhs, T result)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return EFLAGS_ALUAdd8(old_eflags, lhs, rhs, ZeroExtend32(lhs) + ZeroExtend32(rhs), result);
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return EFLAGS_ALUAdd16(old_eflags, lhs, rhs, ZeroExtend32(lhs) + ZeroExtend32(rhs), result);
+  else
+    return EFLAGS_ALUAdd32(old_eflags, lhs, rhs, ZeroExtend64(lhs) + ZeroExtend64(rhs), result);
+}
+
+template<typename T>
+ALWAYS_INLINE constexpr u32 EFLAGS_ALUSub(u32 old_eflags, T lhs, T rhs, T result)
+{
+  if constexpr (sizeof(T) == sizeof(u8))
+    return EFLAGS_ALUSub8(old_eflags, lhs, rhs, ZeroExtend32(lhs) - ZeroExtend32(rhs), result);
+  else if constexpr (sizeof(T) == sizeof(u16))
+    return EFLAGS_ALUSub16(old_eflags, lhs, rhs, ZeroExtend32(lhs) - ZeroExtend32(rhs), result);
+  else
+    return EFLAGS_ALUSub32(old_eflags, lhs, rhs, ZeroExtend64(lhs) - ZeroExtend64(rhs), result);
+}
+
+// Status flags after one of the operations the interpreter can record lazily. INC/DEC are ADD/SUB of one which keep
+// the carry flag passed in.
+template<typename T>
+ALWAYS_INLINE constexpr u32 EFLAGS_LazyOp(u32 old_eflags, CPU::LazyFlagsOp op, T lhs, T rhs, T result, u32 carry)
+{
+  switch (op)
+  {
+    case CPU::LazyFlagsOp::Add:
+      return EFLAGS_ALUAdd(old_eflags, lhs, rhs, result);
+    case CPU::LazyFlagsOp::Sub:
+      return EFLAGS_ALUSub(old_eflags, lhs, rhs, result);
+    case CPU::LazyFlagsOp::Logic:
+      return EFLAGS_BitwiseOps(old_eflags, result);
+    case CPU::LazyFlagsOp::Inc:
+      return (EFLAGS_ALUAdd(old_eflags, lhs, T(1), result) & ~Flag_CF) | carry;
+    case CPU::LazyFlagsOp::Dec:
+      return (EFLAGS_ALUSub(old_eflags, lhs, T(1), result) & ~Flag_CF) | carry;
+    default:
+      return old_eflags;
+  }
+}
+
+template<typename T>
+ALWAYS_INLINE constexpr OperandSize OperandSizeOf()
+{
+  return (sizeof(T) == sizeof(u8)) ? OperandSize_8 : ((sizeof(T) == sizeof(u16)) ? OperandSize_16 : OperandSize_32);
+}
+
+// The carry flag of the recorded operation, without writing the other flags.
+ALWAYS_INLINE bool IsLazyCarry(const CPU::LazyFlags& lf)
+{
+  switch (lf.op)
+  {
+    case CPU::LazyFlagsOp::Add:
+      return (lf.result < lf.lhs);
+    case CPU::LazyFlagsOp::Sub:
+      return (lf.lhs < lf.rhs);
+    case CPU::LazyFlagsOp::Logic:
+      return false;
+    default:
+      return (lf.carry != 0);
+  }
+}
+
+template<CPU::LazyFlagsOp op, bool lazy_flags, typename T>
+void Interpreter::UpdateALUFlags(CPU* cpu, T lhs, T rhs, T result)
+{
+  if constexpr (lazy_flags)
+  {
+    // Only the carry flag of the previous operation survives INC/DEC, the rest of it can be dropped.
+    u32 carry = 0;
+    if constexpr (op == CPU::LazyFlagsOp::Inc || op == CPU::LazyFlagsOp::Dec)
+    {
+      if (cpu->m_lazy_flags.op != CPU::LazyFlagsOp::None)
+        carry = IsLazyCarry(cpu->m_lazy_flags) ? u32(Flag_CF) : u32(0);
+      else
+        carry = cpu->m_registers.EFLAGS.bits & Flag_CF;
+    }
+
+    cpu->m_lazy_flags = {op, OperandSizeOf<T>(), lhs, rhs, result, carry};
+  }
+  else
+  {
+    const u32 carry = cpu->m_registers.EFLAGS.bits & Flag_CF;
+    cpu->m_registers.EFLAGS.bits = EFLAGS_LazyOp<T>(cpu->m_registers.EFLAGS.bits, op, lhs, rhs, result, carry);
+  }
+}
+
+ALWAYS_INLINE bool IsLazySign(const CPU::LazyFlags& lf)
+{
+  return ((lf.result >> ((u32(8) << lf.size) - 1)) & 1) != 0;
+}
+
+ALWAYS_INLINE s32 SignExtendLazyOperand(const CPU::LazyFlags& lf, u32 value)
+{
+  const u32 shift = 32 - (u32(8) << lf.size);
+  return static_cast<s32>(value << shift) >> shift;
+}
+
+template<JumpCondition condition>
+bool Interpreter::TestLazyJumpCondition(CPU* cpu)
+{
+  const CPU::LazyFlags& lf = cpu->m_lazy_flags;
+  if constexpr (condition == JumpCondition_Always || condition == JumpCondition_CXZero)
+    return TestJumpCondition<condition>(cpu);
+
+  // Conditions on ZF, SF and CF, and the compares after SUB/CMP, come straight from the operands. OF and PF need the
+  // flags written out, as does anything after an operation that wasn't recorded.
+  if (lf.op != CPU::LazyFlagsOp::None)
+  {
+    switch (condition)
+    {
+      case JumpCondition_Equal:
+        return (lf.result == 0);
+      case JumpCondition_NotEqual:
+        return (lf.result != 0);
+      case JumpCondition_Sign:
+        return IsLazySign(lf);
+      case JumpCondition_NotSign:
+        return !IsLazySign(lf);
+      case JumpCondition_Below:
+        return IsLazyCarry(lf);
+      case JumpCondition_AboveOrEqual:
+        return !IsLazyCarry(lf);
+      case JumpCondition_BelowOrEqual:
+        return (lf.op == CPU::LazyFlagsOp::Sub) ? (lf.lhs <= lf.rhs) : (IsLazyCarry(lf) || lf.result == 0);
+      case JumpCondition_Above:
+        return (lf.op == CPU::LazyFlagsOp::Sub) ? (lf.lhs > lf.rhs) : !(IsLazyCarry(lf) || lf.result == 0);
+      default:
+        break;
+    }
+
+    if (lf.op == CPU::LazyFlagsOp::Sub)
+    {
+      const s32 lhs = SignExtendLazyOperand(lf, lf.lhs);
+      const s32 rhs = SignExtendLazyOperand(lf, lf.rhs);
+      switch (condition)
+      {
+        case JumpCondition_Less:
+          return (lhs < rhs);
+        case JumpCondition_GreaterOrEqual:
+          return (lhs >= rhs);
+        case JumpCondition_LessOrEqual:
+          return (lhs <= rhs);
+        case JumpCondition_Greater:
+          return (lhs > rhs);
+        default:
+          break;
+      }
+    }
+    else if (lf.op == CPU::LazyFlagsOp::Logic)
+    {
+      // OF is clear after a logical operation, so the signed compares only depend on SF and ZF.
+      switch (condition)
+      {
+        case JumpCondition_Overflow:
+          return false;
+        case JumpCondition_NotOverflow:
+          return true;
+        case JumpCondition_Less:
+          return IsLazySign(lf);
+        case JumpCondition_GreaterOrEqual:
+          return !IsLazySign(lf);
+        case JumpCondition_LessOrEqual:
+          return (lf.result == 0 || IsLazySign(lf));
+        case JumpCondition_Greater:
+          return (lf.result != 0 && !IsLazySign(lf));
+        default:
+          break;
+      }
+    }
+  }
+
+  cpu->SyncLazyFlags();
+  return TestJumpCondition<condition>(cpu);
+}
+
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-         u32 src_constant>
+         u32 src_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_ADD(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -1322,28 +1512,25 @@ void Interpreter::Execute_Operation_ADD(CPU* cpu)
   {
     const u8 lhs = ReadByteOperand<dst_mode, dst_constant>(cpu);
     const u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u8 new_value = ALUOp_Add8(&eflags, lhs, rhs);
+    const u8 new_value = u8(lhs + rhs);
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Add, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
     const u16 lhs = ReadWordOperand<dst_mode, dst_constant>(cpu);
     const u16 rhs = ReadSignExtendedWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u16 new_value = ALUOp_Add16(&eflags, lhs, rhs);
+    const u16 new_value = u16(lhs + rhs);
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Add, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 lhs = ReadDWordOperand<dst_mode, dst_constant>(cpu);
     const u32 rhs = ReadSignExtendedDWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u32 new_value = ALUOp_Add32(&eflags, lhs, rhs);
+    const u32 new_value = u32(lhs + rhs);
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Add, lazy_flags>(cpu, lhs, rhs, new_value);
   }
 
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
@@ -1403,7 +1590,7 @@ void Interpreter::Execute_Operation_ADC(CPU* cpu)
 }
 
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-         u32 src_constant>
+         u32 src_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_SUB(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -1414,28 +1601,25 @@ void Interpreter::Execute_Operation_SUB(CPU* cpu)
   {
     const u8 lhs = ReadByteOperand<dst_mode, dst_constant>(cpu);
     const u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u8 new_value = ALUOp_Sub8(&eflags, lhs, rhs);
+    const u8 new_value = u8(lhs - rhs);
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Sub, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
     const u16 lhs = ReadWordOperand<dst_mode, dst_constant>(cpu);
     const u16 rhs = ReadSignExtendedWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u16 new_value = ALUOp_Sub16(&eflags, lhs, rhs);
+    const u16 new_value = u16(lhs - rhs);
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Sub, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 lhs = ReadDWordOperand<dst_mode, dst_constant>(cpu);
     const u32 rhs = ReadSignExtendedDWordOperand<src_size, src_mode, src_constant>(cpu);
-    u32 eflags = cpu->m_registers.EFLAGS.bits;
-    u32 new_value = ALUOp_Sub32(&eflags, lhs, rhs);
+    const u32 new_value = u32(lhs - rhs);
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Sub, lazy_flags>(cpu, lhs, rhs, new_value);
   }
 
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
@@ -1495,7 +1679,7 @@ void Interpreter::Execute_Operation_SBB(CPU* cpu)
 }
 
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-         u32 src_constant>
+         u32 src_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_CMP(CPU* cpu)
 {
   OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -1507,19 +1691,19 @@ void Interpreter::Execute_Operation_CMP(CPU* cpu)
   {
     const u8 lhs = ReadByteOperand<dst_mode, dst_constant>(cpu);
     const u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
-    ALUOp_Sub8(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    UpdateALUFlags<CPU::LazyFlagsOp::Sub, lazy_flags>(cpu, lhs, rhs, u8(lhs - rhs));
   }
   else if (actual_size == OperandSize_16)
   {
     const u16 lhs = ReadWordOperand<dst_mode, dst_constant>(cpu);
     const u16 rhs = ReadSignExtendedWordOperand<src_size, src_mode, src_constant>(cpu);
-    ALUOp_Sub16(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    UpdateALUFlags<CPU::LazyFlagsOp::Sub, lazy_flags>(cpu, lhs, rhs, u16(lhs - rhs));
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 lhs = ReadDWordOperand<dst_mode, dst_constant>(cpu);
     const u32 rhs = ReadSignExtendedDWordOperand<src_size, src_mode, src_constant>(cpu);
-    ALUOp_Sub32(&cpu->m_registers.EFLAGS.bits, lhs, rhs);
+    UpdateALUFlags<CPU::LazyFlagsOp::Sub, lazy_flags>(cpu, lhs, rhs, u32(lhs - rhs));
   }
 
   if constexpr (dst_mode == OperandMode_Register && src_mode == OperandMode_Immediate)
@@ -1532,19 +1716,8 @@ void Interpreter::Execute_Operation_CMP(CPU* cpu)
     static_assert(dependent_int_false<dst_mode>::value, "unknown mode");
 }
 
-template<typename ValueType>
-ALWAYS_INLINE constexpr u32 EFLAGS_BitwiseOps(u32 old_eflags, ValueType new_value)
-{
-  // The OF and CF flags are cleared; the SF, ZF, and PF flags are set according to the result. The state of the AF flag
-  // is undefined.
-  return (old_eflags & ~(Flag_OF | Flag_CF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Clear OF/CF/AF
-         SignFlag(new_value) |                                                         // SF
-         ParityFlag(new_value) |                                                       // PF
-         ZeroFlag(new_value);                                                          // ZF
-}
-
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-         u32 src_constant>
+         u32 src_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_AND(CPU* cpu)
 {
   OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -1558,7 +1731,7 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
     u8 new_value = lhs & rhs;
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1567,7 +1740,7 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
     u16 new_value = lhs & rhs;
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1576,7 +1749,7 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
     u32 new_value = lhs & rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else
   {
@@ -1595,7 +1768,7 @@ void Interpreter::Execute_Operation_AND(CPU* cpu)
 }
 
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-         u32 src_constant>
+         u32 src_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_OR(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -1609,7 +1782,7 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
     u8 new_value = lhs | rhs;
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1618,7 +1791,7 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
     u16 new_value = lhs | rhs;
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1627,7 +1800,7 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
     u32 new_value = lhs | rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else
   {
@@ -1646,7 +1819,7 @@ void Interpreter::Execute_Operation_OR(CPU* cpu)
 }
 
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-         u32 src_constant>
+         u32 src_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_XOR(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -1660,7 +1833,7 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
     u8 new_value = lhs ^ rhs;
     WriteByteOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1669,7 +1842,7 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
     u16 new_value = lhs ^ rhs;
     WriteWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1678,7 +1851,7 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
     u32 new_value = lhs ^ rhs;
     WriteDWordOperand<dst_mode, dst_constant>(cpu, new_value);
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else
   {
@@ -1697,7 +1870,7 @@ void Interpreter::Execute_Operation_XOR(CPU* cpu)
 }
 
 template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSize src_size, OperandMode src_mode,
-         u32 src_constant>
+         u32 src_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_TEST(CPU* cpu)
 {
   const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -1710,7 +1883,7 @@ void Interpreter::Execute_Operation_TEST(CPU* cpu)
     u8 rhs = ReadByteOperand<src_mode, src_constant>(cpu);
     u8 new_value = lhs & rhs;
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_16)
   {
@@ -1718,7 +1891,7 @@ void Interpreter::Execute_Operation_TEST(CPU* cpu)
     u16 rhs = ReadWordOperand<src_mode, src_constant>(cpu);
     u16 new_value = lhs & rhs;
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else if (actual_size == OperandSize_32)
   {
@@ -1726,7 +1899,7 @@ void Interpreter::Execute_Operation_TEST(CPU* cpu)
     u32 rhs = ReadDWordOperand<src_mode, src_constant>(cpu);
     u32 new_value = lhs & rhs;
 
-    cpu->m_registers.EFLAGS.bits = EFLAGS_BitwiseOps(cpu->m_registers.EFLAGS.bits, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Logic, lazy_flags>(cpu, lhs, rhs, new_value);
   }
   else
   {
@@ -2557,7 +2730,7 @@ void Interpreter::Execute_Operation_OUT(CPU* cpu)
   }
 }
 
-template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
+template<OperandSize val_size, OperandMode val_mode, u32 val_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_INC(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
@@ -2572,51 +2745,28 @@ void Interpreter::Execute_Operation_INC(CPU* cpu)
 
   if (actual_size == OperandSize_8)
   {
-    const u32 old_value = ZeroExtend32(ReadByteOperand<val_mode, val_constant>(cpu));
-    const u32 new_value = old_value + u32(1);
-    const u8 out_value = Truncate8(new_value);
-    const u32 eflags =
-      (cpu->m_registers.EFLAGS.bits & ~(Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Modify OF/AF/SF/ZF/PF
-      ((static_cast<u32>((new_value ^ old_value) & new_value) & u32(0x80)) << 4) |          // OF
-      (static_cast<u32>(old_value ^ u32(1) ^ new_value) & Flag_AF) |                        // AF
-      SignFlag(out_value) |                                                                 // SF
-      ZeroFlag(out_value) |                                                                 // ZF
-      ParityFlag(out_value);
-    WriteByteOperand<val_mode, val_constant>(cpu, out_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    const u8 old_value = ReadByteOperand<val_mode, val_constant>(cpu);
+    const u8 new_value = Truncate8(old_value + 1);
+    WriteByteOperand<val_mode, val_constant>(cpu, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Inc, lazy_flags>(cpu, old_value, u8(1), new_value);
   }
   else if (actual_size == OperandSize_16)
   {
-    const u32 old_value = ZeroExtend32(ReadWordOperand<val_mode, val_constant>(cpu));
-    const u32 new_value = old_value + u32(1);
-    const u16 out_value = Truncate16(new_value);
-    const u32 eflags =
-      (cpu->m_registers.EFLAGS.bits & ~(Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Modify OF/AF/SF/ZF/PF
-      ((static_cast<u32>((new_value ^ old_value) & new_value) & u32(0x8000)) >> 4) |        // OF
-      (static_cast<u32>(old_value ^ new_value) & Flag_AF) |                                 // AF
-      SignFlag(out_value) |                                                                 // SF
-      ZeroFlag(out_value) |                                                                 // ZF
-      ParityFlag(out_value);
-    WriteWordOperand<val_mode, val_constant>(cpu, out_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    const u16 old_value = ReadWordOperand<val_mode, val_constant>(cpu);
+    const u16 new_value = Truncate16(old_value + 1);
+    WriteWordOperand<val_mode, val_constant>(cpu, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Inc, lazy_flags>(cpu, old_value, u16(1), new_value);
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 old_value = ReadDWordOperand<val_mode, val_constant>(cpu);
     const u32 new_value = old_value + u32(1);
-    const u32 eflags =
-      (cpu->m_registers.EFLAGS.bits & ~(Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Modify OF/AF/SF/ZF/PF
-      ((static_cast<u32>((new_value ^ old_value) & new_value) & u32(0x80000000)) >> 20) |   // OF
-      (static_cast<u32>(old_value ^ new_value) & Flag_AF) |                                 // AF
-      SignFlag(new_value) |                                                                 // SF
-      ZeroFlag(new_value) |                                                                 // ZF
-      ParityFlag(new_value);
     WriteDWordOperand<val_mode, val_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Inc, lazy_flags>(cpu, old_value, u32(1), new_value);
   }
 }
 
-template<OperandSize val_size, OperandMode val_mode, u32 val_constant>
+template<OperandSize val_size, OperandMode val_mode, u32 val_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_DEC(CPU* cpu)
 {
   const OperandSize actual_size = (val_size == OperandSize_Count) ? cpu->idata.operand_size : val_size;
@@ -2631,50 +2781,24 @@ void Interpreter::Execute_Operation_DEC(CPU* cpu)
 
   if (actual_size == OperandSize_8)
   {
-    const u32 old_value = ZeroExtend32(ReadByteOperand<val_mode, val_constant>(cpu));
-    const u32 new_value = old_value - u32(1);
-    const u8 out_value = Truncate8(new_value);
-    const u32 eflags =
-      (cpu->m_registers.EFLAGS.bits & ~(Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Modify OF/AF/SF/ZF/PF
-      ((static_cast<u32>((new_value ^ old_value) & old_value) & u32(0x80)) << 4) |          // OF
-      (static_cast<u32>(old_value ^ new_value) & Flag_AF) |                                 // AF
-      SignFlag(out_value) |                                                                 // SF
-      ZeroFlag(out_value) |                                                                 // ZF
-      ParityFlag(out_value);
-
-    WriteByteOperand<val_mode, val_constant>(cpu, out_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    const u8 old_value = ReadByteOperand<val_mode, val_constant>(cpu);
+    const u8 new_value = Truncate8(old_value - 1);
+    WriteByteOperand<val_mode, val_constant>(cpu, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Dec, lazy_flags>(cpu, old_value, u8(1), new_value);
   }
   else if (actual_size == OperandSize_16)
   {
-    const u32 old_value = ZeroExtend32(ReadWordOperand<val_mode, val_constant>(cpu));
-    const u32 new_value = old_value - u32(1);
-    const u16 out_value = Truncate16(new_value);
-    const u32 eflags =
-      (cpu->m_registers.EFLAGS.bits & ~(Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Modify OF/AF/SF/ZF/PF
-      ((static_cast<u32>((new_value ^ old_value) & old_value) & u32(0x8000)) >> 4) |        // OF
-      (static_cast<u32>(old_value ^ new_value) & Flag_AF) |                                 // AF
-      SignFlag(out_value) |                                                                 // SF
-      ZeroFlag(out_value) |                                                                 // ZF
-      ParityFlag(out_value);
-
-    WriteWordOperand<val_mode, val_constant>(cpu, out_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    const u16 old_value = ReadWordOperand<val_mode, val_constant>(cpu);
+    const u16 new_value = Truncate16(old_value - 1);
+    WriteWordOperand<val_mode, val_constant>(cpu, new_value);
+    UpdateALUFlags<CPU::LazyFlagsOp::Dec, lazy_flags>(cpu, old_value, u16(1), new_value);
   }
   else if (actual_size == OperandSize_32)
   {
     const u32 old_value = ReadDWordOperand<val_mode, val_constant>(cpu);
     const u32 new_value = old_value - u32(1);
-    const u32 eflags =
-      (cpu->m_registers.EFLAGS.bits & ~(Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF)) | // Modify OF/AF/SF/ZF/PF
-      ((static_cast<u32>((new_value ^ old_value) & old_value) & u32(0x80000000)) >> 20) |   // OF
-      (static_cast<u32>(old_value ^ new_value) & Flag_AF) |                                 // AF
-      SignFlag(new_value) |                                                                 // SF
-      ZeroFlag(new_value) |                                                                 // ZF
-      ParityFlag(new_value);
-
     WriteDWordOperand<val_mode, val_constant>(cpu, new_value);
-    cpu->m_registers.EFLAGS.bits = eflags;
+    UpdateALUFlags<CPU::LazyFlagsOp::Dec, lazy_flags>(cpu, old_value, u32(1), new_value);
   }
 }
 
@@ -3451,11 +3575,11 @@ void Interpreter::Execute_Operation_JMP_Near(CPU* cpu)
   cpu->BranchTo(jump_address);
 }
 
-template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
+template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_Jcc(CPU* cpu)
 {
   CalculateEffectiveAddress<dst_mode>(cpu);
-  if (!TestJumpCondition<condition>(cpu))
+  if (!(lazy_flags ? TestLazyJumpCondition<condition>(cpu) : TestJumpCondition<condition>(cpu)))
   {
     cpu->AddCycles((condition == JumpCondition_CXZero) ? CYCLES_JCXZ_NOT_TAKEN : CYCLES_Jcc_NOT_TAKEN);
     return;
@@ -5098,7 +5222,7 @@ void Interpreter::Execute_Operation_BT(CPU* cpu)
   Execute_Operation_BTx<Operation_BT, dst_size, dst_mode, dst_constant, src_size, src_mode, src_constant>(cpu);
 }
 
-template<Operation operation, bool check_equal, typename callback>
+template<Operation operation, bool check_equal, OperandSize operand_size, typename callback>
 void Interpreter::Execute_REP(CPU* cpu, callback cb)
 {
   const bool has_rep = cpu->idata.has_rep;
@@ -5158,6 +5282,24 @@ void Interpreter::Execute_REP(CPU* cpu, callback cb)
         return;
     }
 
+    // Copy/fill up to the next page boundary in one go, if the memory involved is plain RAM. INS/OUTS transfer to or
+    // from the device in one go, if the port has a block handler.
+    if constexpr (operation == Operation_MOVS || operation == Operation_STOS || operation == Operation_LODS ||
+                  operation == Operation_INS || operation == Operation_OUTS)
+    {
+      const OperandSize actual_size = (operand_size == OperandSize_Count) ? cpu->idata.operand_size : operand_size;
+      if (cpu->ExecuteBulkStringOperation(operation, actual_size, cpu->idata.address_size, cpu->idata.segment) > 0)
+      {
+        // The cycles at the top of the loop are for the next element, so only go around if there is one.
+        const bool elements_remaining = (cpu->idata.address_size == AddressSize_16) ? (cpu->m_registers.CX != 0) :
+                                                                                       (cpu->m_registers.ECX != 0);
+        if (!elements_remaining)
+          return;
+
+        continue;
+      }
+    }
+
     // Execute the actual instruction.
     cb(cpu);
 
@@ -5204,7 +5346,7 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_INS(CPU* cpu)
 {
   // TODO: Move the port number check out of the loop.
-  Execute_REP<Operation_INS, false>(cpu, [](CPU* cpu) {
+  Execute_REP<Operation_INS, false, dst_size>(cpu, [](CPU* cpu) {
     const VirtualMemoryAddress dst_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.DI) : cpu->m_registers.EDI;
     const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -5280,7 +5422,7 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
          u32 src_constant>
 void Interpreter::Execute_Operation_OUTS(CPU* cpu)
 {
-  Execute_REP<Operation_OUTS, false>(cpu, [](CPU* cpu) {
+  Execute_REP<Operation_OUTS, false, src_size>(cpu, [](CPU* cpu) {
     const Segment segment = cpu->idata.segment;
     const VirtualMemoryAddress src_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.SI) : cpu->m_registers.ESI;
@@ -5413,7 +5555,7 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_LODS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_LODS, false>(cpu, [](CPU* cpu) {
+  Execute_REP<Operation_LODS, false, dst_size>(cpu, [](CPU* cpu) {
     const Segment segment = cpu->idata.segment;
     const VirtualMemoryAddress src_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.SI) : cpu->m_registers.ESI;
@@ -5466,7 +5608,7 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_STOS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_STOS, false>(cpu, [](CPU* cpu) {
+  Execute_REP<Operation_STOS, false, dst_size>(cpu, [](CPU* cpu) {
     const VirtualMemoryAddress dst_address =
       (cpu->idata.address_size == AddressSize_16) ? ZeroExtend32(cpu->m_registers.DI) : cpu->m_registers.EDI;
     const OperandSize actual_size = (dst_size == OperandSize_Count) ? cpu->idata.operand_size : dst_size;
@@ -5589,7 +5731,7 @@ template<OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, OperandSi
 void Interpreter::Execute_Operation_MOVS(CPU* cpu)
 {
   static_assert(src_size == dst_size, "operand sizes are the same");
-  Execute_REP<Operation_MOVS, false>(cpu, [](CPU* cpu) {
+  Execute_REP<Operation_MOVS, false, dst_size>(cpu, [](CPU* cpu) {
     // The DS segment may be over-ridden with a segment override prefix, but the ES segment cannot be overridden.
     const Segment src_segment = cpu->idata.segment;
     const VirtualMemoryAddress src_address =
@@ -5678,13 +5820,13 @@ void Interpreter::Execute_Operation_CMOVcc(CPU* cpu)
   }
 }
 
-template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant>
+template<JumpCondition condition, OperandSize dst_size, OperandMode dst_mode, u32 dst_constant, bool lazy_flags>
 void Interpreter::Execute_Operation_SETcc(CPU* cpu)
 {
   CalculateEffectiveAddress<dst_mode>(cpu);
   cpu->AddCyclesRM(CYCLES_SETcc_RM_MEM, cpu->idata.ModRM_RM_IsReg());
 
-  bool flag = TestJumpCondition<condition>(cpu);
+  bool flag = lazy_flags ? TestLazyJumpCondition<condition>(cpu) : TestJumpCondition<condition>(cpu);
   WriteByteOperand<dst_mode, dst_constant>(cpu, BoolToUInt8(flag));
 }
 
@@ -42,6 +42,7 @@ void InterpreterBackend::Execute()
 
       if (TRACE_EXECUTION)
       {
+        m_cpu->SyncLazyFlags();
         if (TRACE_EXECUTION_LAST_EIP != m_cpu->m_registers.EIP)
           m_cpu->PrintCurrentStateAndInstruction(m_cpu->m_registers.EIP);
         TRACE_EXECUTION_LAST_EIP = m_cpu->m_registers.EIP;
@@ -51,6 +52,9 @@ void InterpreterBackend::Execute()
       m_cpu->CommitPendingCycles();
     }
 
+    // Events and anything outside the interpreter expect complete flags.
+    m_cpu->SyncLazyFlags();
+
     // Run events if needed.
     m_system->RunEvents();
   }
@@ -67,6 +71,11 @@ size_t InterpreterBackend::GetCodeBlockCount() const
   return 0;
 }
 
+size_t InterpreterBackend::GetCodeBlockMemoryUsage() const
+{
+  return 0;
+}
+
 void InterpreterBackend::FlushCodeCache() {}
 
 } // namespace CPU_X86
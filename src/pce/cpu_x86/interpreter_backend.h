@@ -14,6 +14,7 @@ public:
   void AbortCurrentInstruction() override;
 
   size_t GetCodeBlockCount() const override;
+  size_t GetCodeBlockMemoryUsage() const override;
   void FlushCodeCache() override;
 
 private:
@@ -0,0 +1,644 @@
+// Threaded code for the cached interpreter.
+// Included after interpreter.inl, as the specialised handlers share the ALU and flag helpers.
+
+#ifdef Y_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable : 4127) // warning C4127: conditional expression is constant
+#endif
+
+namespace CPU_X86 {
+
+template<typename T>
+T& Interpreter::GetThreadedRegister(CPU* cpu, u8 index)
+{
+  if constexpr (std::is_same_v<T, u8>)
+    return cpu->m_registers.reg8[index];
+  else if constexpr (std::is_same_v<T, u16>)
+    return cpu->m_registers.reg16[index];
+  else
+    return cpu->m_registers.reg32[index];
+}
+
+VirtualMemoryAddress Interpreter::CalculateThreadedAddress(CPU* cpu, const ThreadedOp* op)
+{
+  // 16-bit forms index reg32 with the 16-bit register numbers, the upper halves are discarded by the mask.
+  VirtualMemoryAddress address = op->displacement;
+  if (op->base_reg != ThreadedNoRegister)
+    address += cpu->m_registers.reg32[op->base_reg];
+  if (op->index_reg != ThreadedNoRegister)
+    address += cpu->m_registers.reg32[op->index_reg] << op->scale;
+  return address & op->address_mask;
+}
+
+template<typename T>
+T Interpreter::ReadThreadedMemory(CPU* cpu, const ThreadedOp* op, VirtualMemoryAddress address)
+{
+  if constexpr (std::is_same_v<T, u8>)
+    return cpu->ReadSegmentMemoryByte(op->segment, address);
+  else if constexpr (std::is_same_v<T, u16>)
+    return cpu->ReadSegmentMemoryWord(op->segment, address);
+  else
+    return cpu->ReadSegmentMemoryDWord(op->segment, address);
+}
+
+template<typename T>
+void Interpreter::WriteThreadedMemory(CPU* cpu, const ThreadedOp* op, VirtualMemoryAddress address, T value)
+{
+  if constexpr (std::is_same_v<T, u8>)
+    cpu->WriteSegmentMemoryByte(op->segment, address, value);
+  else if constexpr (std::is_same_v<T, u16>)
+    cpu->WriteSegmentMemoryWord(op->segment, address, value);
+  else
+    cpu->WriteSegmentMemoryDWord(op->segment, address, value);
+}
+
+bool Interpreter::TestThreadedJumpCondition(CPU* cpu, JumpCondition condition)
+{
+  switch (condition)
+  {
+    case JumpCondition_Overflow:
+      return TestJumpCondition<JumpCondition_Overflow>(cpu);
+    case JumpCondition_NotOverflow:
+      return TestJumpCondition<JumpCondition_NotOverflow>(cpu);
+    case JumpCondition_Sign:
+      return TestJumpCondition<JumpCondition_Sign>(cpu);
+    case JumpCondition_NotSign:
+      return TestJumpCondition<JumpCondition_NotSign>(cpu);
+    case JumpCondition_Equal:
+      return TestJumpCondition<JumpCondition_Equal>(cpu);
+    case JumpCondition_NotEqual:
+      return TestJumpCondition<JumpCondition_NotEqual>(cpu);
+    case JumpCondition_Below:
+      return TestJumpCondition<JumpCondition_Below>(cpu);
+    case JumpCondition_AboveOrEqual:
+      return TestJumpCondition<JumpCondition_AboveOrEqual>(cpu);
+    case JumpCondition_BelowOrEqual:
+      return TestJumpCondition<JumpCondition_BelowOrEqual>(cpu);
+    case JumpCondition_Above:
+      return TestJumpCondition<JumpCondition_Above>(cpu);
+    case JumpCondition_Less:
+      return TestJumpCondition<JumpCondition_Less>(cpu);
+    case JumpCondition_GreaterOrEqual:
+      return TestJumpCondition<JumpCondition_GreaterOrEqual>(cpu);
+    case JumpCondition_LessOrEqual:
+      return TestJumpCondition<JumpCondition_LessOrEqual>(cpu);
+    case JumpCondition_Greater:
+      return TestJumpCondition<JumpCondition_Greater>(cpu);
+    case JumpCondition_Parity:
+      return TestJumpCondition<JumpCondition_Parity>(cpu);
+    case JumpCondition_NotParity:
+      return TestJumpCondition<JumpCondition_NotParity>(cpu);
+    default:
+      DebugUnreachableCode();
+      return false;
+  }
+}
+
+const Interpreter::ThreadedOp* Interpreter::ExecuteThreadedJcc(CPU* cpu, const ThreadedOp* op)
+{
+  cpu->m_current_EIP = cpu->m_registers.EIP;
+  cpu->m_current_ESP = cpu->m_registers.ESP;
+  if (!TestThreadedJumpCondition(cpu, op->condition))
+  {
+    cpu->AddCycles(CYCLES_Jcc_NOT_TAKEN);
+    cpu->m_registers.EIP = (cpu->m_registers.EIP + op->jump_length) & cpu->m_EIP_mask;
+    return op + 1;
+  }
+
+  cpu->AddCycles(CYCLES_Jcc_TAKEN);
+  cpu->BranchTo(op->jump_target);
+  return op + 1;
+}
+
+const Interpreter::ThreadedOp* Interpreter::ThreadedOp_Generic(CPU* cpu, const ThreadedOp* op)
+{
+  cpu->m_current_EIP = cpu->m_registers.EIP;
+  cpu->m_current_ESP = cpu->m_registers.ESP;
+  cpu->m_registers.EIP = (cpu->m_registers.EIP + op->length) & cpu->m_EIP_mask;
+  std::memcpy(&cpu->idata, op->data, sizeof(cpu->idata));
+  op->interpreter_handler(cpu);
+  return op + 1;
+}
+
+template<typename T, bool src_imm, Interpreter::ThreadedMemoryOperand mem>
+const Interpreter::ThreadedOp* Interpreter::ThreadedOp_MOV(CPU* cpu, const ThreadedOp* op)
+{
+  // Memory accesses can fault, so the instruction has to be restartable.
+  if constexpr (mem != ThreadedMemoryOperand::None)
+  {
+    cpu->m_current_EIP = cpu->m_registers.EIP;
+    cpu->m_current_ESP = cpu->m_registers.ESP;
+  }
+
+  cpu->m_registers.EIP = (cpu->m_registers.EIP + op->length) & cpu->m_EIP_mask;
+  cpu->m_pending_cycles += op->cycles;
+
+  T value;
+  if constexpr (src_imm)
+    value = static_cast<T>(op->imm);
+  else if constexpr (mem == ThreadedMemoryOperand::Source)
+    value = ReadThreadedMemory<T>(cpu, op, CalculateThreadedAddress(cpu, op));
+  else
+    value = GetThreadedRegister<T>(cpu, op->src_reg);
+
+  if constexpr (mem == ThreadedMemoryOperand::Destination)
+    WriteThreadedMemory<T>(cpu, op, CalculateThreadedAddress(cpu, op), value);
+  else
+    GetThreadedRegister<T>(cpu, op->dst_reg) = value;
+
+  return op + 1;
+}
+
+template<Interpreter::ThreadedALUOp alu_op, typename T, bool src_imm, Interpreter::ThreadedMemoryOperand mem,
+         bool fuse_jcc>
+const Interpreter::ThreadedOp* Interpreter::ThreadedOp_ALU(CPU* cpu, const ThreadedOp* op)
+{
+  if constexpr (mem != ThreadedMemoryOperand::None)
+  {
+    cpu->m_current_EIP = cpu->m_registers.EIP;
+    cpu->m_current_ESP = cpu->m_registers.ESP;
+  }
+
+  cpu->m_registers.EIP = (cpu->m_registers.EIP + op->length) & cpu->m_EIP_mask;
+  cpu->m_pending_cycles += op->cycles;
+
+  VirtualMemoryAddress address = 0;
+  T lhs;
+  if constexpr (mem == ThreadedMemoryOperand::Destination)
+  {
+    address = CalculateThreadedAddress(cpu, op);
+    lhs = ReadThreadedMemory<T>(cpu, op, address);
+  }
+  else
+  {
+    lhs = GetThreadedRegister<T>(cpu, op->dst_reg);
+  }
+
+  T rhs;
+  if constexpr (src_imm)
+    rhs = static_cast<T>(op->imm);
+  else if constexpr (mem == ThreadedMemoryOperand::Source)
+    rhs = ReadThreadedMemory<T>(cpu, op, CalculateThreadedAddress(cpu, op));
+  else
+    rhs = GetThreadedRegister<T>(cpu, op->src_reg);
+
+  // Flags are committed after the result is written, so a faulting store leaves them untouched.
+  u32 eflags = cpu->m_registers.EFLAGS.bits;
+  T result;
+  if constexpr (alu_op == ThreadedALUOp::ADD)
+  {
+    if constexpr (std::is_same_v<T, u8>)
+      result = ALUOp_Add8(&eflags, lhs, rhs);
+    else if constexpr (std::is_same_v<T, u16>)
+      result = ALUOp_Add16(&eflags, lhs, rhs);
+    else
+      result = ALUOp_Add32(&eflags, lhs, rhs);
+  }
+  else if constexpr (alu_op == ThreadedALUOp::SUB || alu_op == ThreadedALUOp::CMP)
+  {
+    if constexpr (std::is_same_v<T, u8>)
+      result = ALUOp_Sub8(&eflags, lhs, rhs);
+    else if constexpr (std::is_same_v<T, u16>)
+      result = ALUOp_Sub16(&eflags, lhs, rhs);
+    else
+      result = ALUOp_Sub32(&eflags, lhs, rhs);
+  }
+  else
+  {
+    if constexpr (alu_op == ThreadedALUOp::OR)
+      result = lhs | rhs;
+    else if constexpr (alu_op == ThreadedALUOp::XOR)
+      result = lhs ^ rhs;
+    else
+      result = lhs & rhs;
+
+    eflags = EFLAGS_BitwiseOps(eflags, result);
+  }
+
+  if constexpr (alu_op != ThreadedALUOp::CMP && alu_op != ThreadedALUOp::TEST)
+  {
+    if constexpr (mem == ThreadedMemoryOperand::Destination)
+      WriteThreadedMemory<T>(cpu, op, address, result);
+    else
+      GetThreadedRegister<T>(cpu, op->dst_reg) = result;
+  }
+  cpu->m_registers.EFLAGS.bits = eflags;
+
+  if constexpr (fuse_jcc)
+    return ExecuteThreadedJcc(cpu, op);
+  else
+    return op + 1;
+}
+
+const Interpreter::ThreadedOp* Interpreter::ThreadedOp_Jcc(CPU* cpu, const ThreadedOp* op)
+{
+  return ExecuteThreadedJcc(cpu, op);
+}
+
+bool Interpreter::BuildThreadedAddress(const Instruction& instruction, u32 index, ThreadedOp* op)
+{
+  const Instruction::Operand& operand = instruction.operands[index];
+  op->segment = instruction.data.segment;
+  op->base_reg = ThreadedNoRegister;
+  op->index_reg = ThreadedNoRegister;
+  op->scale = 0;
+  op->address_mask = instruction.data.GetAddressMask();
+
+  // Direct offset, e.g. MOV AL, [moffs].
+  if (operand.mode == OperandMode_Memory)
+  {
+    op->displacement = instruction.data.disp32;
+    return true;
+  }
+  if (operand.mode != OperandMode_ModRM_RM || instruction.ModRM_RM_IsReg())
+    return false;
+
+  // Same forms as CalculateEffectiveAddress, resolved once here rather than on every execution.
+  const Decoder::ModRMAddress* addr =
+    Decoder::DecodeModRMAddress(instruction.data.address_size, instruction.data.modrm);
+  bool has_displacement = (addr->displacement_size != 0);
+  switch (addr->addressing_mode)
+  {
+    case ModRMAddressingMode::Direct:
+      break;
+
+    case ModRMAddressingMode::Indirect:
+    case ModRMAddressingMode::Indexed:
+      op->base_reg = addr->base_register;
+      break;
+
+    case ModRMAddressingMode::BasedIndexed:
+    case ModRMAddressingMode::BasedIndexedDisplacement:
+      op->base_reg = addr->base_register;
+      op->index_reg = addr->index_register;
+      break;
+
+    case ModRMAddressingMode::SIB:
+    {
+      // SIB has a displacement instead of base if set to EBP.
+      if (instruction.data.HasSIBBase())
+        op->base_reg = static_cast<u8>(instruction.data.GetSIBBaseRegister());
+      else
+        has_displacement = true;
+      if (instruction.data.HasSIBIndex())
+      {
+        op->index_reg = static_cast<u8>(instruction.data.GetSIBIndexRegister());
+        op->scale = instruction.data.GetSIBScaling();
+      }
+    }
+    break;
+
+    default:
+      return false;
+  }
+
+  op->displacement = has_displacement ? instruction.data.disp32 : 0;
+  return true;
+}
+
+bool Interpreter::BuildThreadedMOV(CPU* cpu, const Instruction& instruction, ThreadedOp* op)
+{
+  if (instruction.operation != Operation_MOV || instruction.data.has_lock)
+    return false;
+
+  const Instruction::Operand& dst = instruction.operands[0];
+  const Instruction::Operand& src = instruction.operands[1];
+  const bool src_imm = (src.mode == OperandMode_Immediate);
+
+  // At most one of the operands is in memory, the other must be a general purpose register or immediate.
+  ThreadedMemoryOperand mem = ThreadedMemoryOperand::None;
+  const std::optional<u8> dst_reg = GetOperandRegister(instruction, 0);
+  if (!dst_reg)
+  {
+    if (!BuildThreadedAddress(instruction, 0, op))
+      return false;
+    mem = ThreadedMemoryOperand::Destination;
+  }
+
+  const std::optional<u8> src_reg = src_imm ? std::optional<u8>(0) : GetOperandRegister(instruction, 1);
+  if (!src_reg)
+  {
+    if (mem != ThreadedMemoryOperand::None || !BuildThreadedAddress(instruction, 1, op))
+      return false;
+    mem = ThreadedMemoryOperand::Source;
+  }
+
+  if (dst.mode == OperandMode_Register && src_imm)
+    op->cycles = static_cast<u16>(cpu->GetCycles(CYCLES_MOV_REG_IMM));
+  else if (dst.mode == OperandMode_Register && src.mode == OperandMode_Memory)
+    op->cycles = static_cast<u16>(cpu->GetCycles(CYCLES_MOV_REG_MEM));
+  else if (dst.mode == OperandMode_Memory && src.mode == OperandMode_Register)
+    op->cycles = static_cast<u16>(cpu->GetCycles(CYCLES_MOV_RM_MEM_REG));
+  else if (dst.mode == OperandMode_ModRM_RM)
+    op->cycles = static_cast<u16>(cpu->GetCyclesRM(CYCLES_MOV_RM_MEM_REG, instruction.ModRM_RM_IsReg()));
+  else if (src.mode == OperandMode_ModRM_RM)
+    op->cycles = static_cast<u16>(cpu->GetCyclesRM(CYCLES_MOV_REG_RM_MEM, instruction.ModRM_RM_IsReg()));
+  else
+    return false;
+
+  switch (dst.size)
+  {
+    case OperandSize_8:
+      op->handler = GetThreadedMOVHandler<u8>(src_imm, mem);
+      break;
+    case OperandSize_16:
+      op->handler = GetThreadedMOVHandler<u16>(src_imm, mem);
+      break;
+    case OperandSize_32:
+      op->handler = GetThreadedMOVHandler<u32>(src_imm, mem);
+      break;
+    default:
+      return false;
+  }
+
+  op->dst_reg = dst_reg.value_or(0);
+  op->src_reg = src_reg.value_or(0);
+  if (src_imm)
+  {
+    if (src.size == OperandSize_8)
+      op->imm = ZeroExtend32(instruction.data.imm8);
+    else if (src.size == OperandSize_16)
+      op->imm = ZeroExtend32(instruction.data.imm16);
+    else
+      op->imm = instruction.data.imm32;
+  }
+
+  return true;
+}
+
+template<typename T>
+Interpreter::ThreadedOp::Handler Interpreter::GetThreadedMOVHandler(bool src_imm, ThreadedMemoryOperand mem)
+{
+  switch (mem)
+  {
+    case ThreadedMemoryOperand::Destination:
+      return src_imm ? &ThreadedOp_MOV<T, true, ThreadedMemoryOperand::Destination> :
+                       &ThreadedOp_MOV<T, false, ThreadedMemoryOperand::Destination>;
+    case ThreadedMemoryOperand::Source:
+      return &ThreadedOp_MOV<T, false, ThreadedMemoryOperand::Source>;
+    case ThreadedMemoryOperand::None:
+    default:
+      return src_imm ? &ThreadedOp_MOV<T, true, ThreadedMemoryOperand::None> :
+                       &ThreadedOp_MOV<T, false, ThreadedMemoryOperand::None>;
+  }
+}
+
+template<Interpreter::ThreadedALUOp alu_op, Interpreter::ThreadedMemoryOperand mem, bool fuse_jcc>
+Interpreter::ThreadedOp::Handler Interpreter::GetThreadedALUHandler(OperandSize size, bool src_imm)
+{
+  // Immediates never appear alongside a memory source.
+  constexpr bool imm_allowed = (mem != ThreadedMemoryOperand::Source);
+  switch (size)
+  {
+    case OperandSize_8:
+      return (imm_allowed && src_imm) ? &ThreadedOp_ALU<alu_op, u8, imm_allowed, mem, fuse_jcc> :
+                                        &ThreadedOp_ALU<alu_op, u8, false, mem, fuse_jcc>;
+    case OperandSize_16:
+      return (imm_allowed && src_imm) ? &ThreadedOp_ALU<alu_op, u16, imm_allowed, mem, fuse_jcc> :
+                                        &ThreadedOp_ALU<alu_op, u16, false, mem, fuse_jcc>;
+    case OperandSize_32:
+      return (imm_allowed && src_imm) ? &ThreadedOp_ALU<alu_op, u32, imm_allowed, mem, fuse_jcc> :
+                                        &ThreadedOp_ALU<alu_op, u32, false, mem, fuse_jcc>;
+    default:
+      return nullptr;
+  }
+}
+
+template<Interpreter::ThreadedALUOp alu_op, bool fuse_jcc>
+Interpreter::ThreadedOp::Handler Interpreter::SelectThreadedALUHandler(OperandSize size, bool src_imm,
+                                                                       ThreadedMemoryOperand mem)
+{
+  switch (mem)
+  {
+    case ThreadedMemoryOperand::Destination:
+      return GetThreadedALUHandler<alu_op, ThreadedMemoryOperand::Destination, fuse_jcc>(size, src_imm);
+    case ThreadedMemoryOperand::Source:
+      return GetThreadedALUHandler<alu_op, ThreadedMemoryOperand::Source, fuse_jcc>(size, src_imm);
+    case ThreadedMemoryOperand::None:
+    default:
+      return GetThreadedALUHandler<alu_op, ThreadedMemoryOperand::None, fuse_jcc>(size, src_imm);
+  }
+}
+
+bool Interpreter::BuildThreadedALU(CPU* cpu, const Instruction& instruction, bool fuse_jcc, ThreadedOp* op)
+{
+  ThreadedALUOp alu_op;
+  switch (instruction.operation)
+  {
+    case Operation_ADD:
+      alu_op = ThreadedALUOp::ADD;
+      break;
+    case Operation_SUB:
+      alu_op = ThreadedALUOp::SUB;
+      break;
+    case Operation_AND:
+      alu_op = ThreadedALUOp::AND;
+      break;
+    case Operation_OR:
+      alu_op = ThreadedALUOp::OR;
+      break;
+    case Operation_XOR:
+      alu_op = ThreadedALUOp::XOR;
+      break;
+    case Operation_CMP:
+      alu_op = ThreadedALUOp::CMP;
+      break;
+    case Operation_TEST:
+      alu_op = ThreadedALUOp::TEST;
+      break;
+    default:
+      return false;
+  }
+
+  // Only compares have flags worth branching on straight away.
+  if (fuse_jcc && alu_op != ThreadedALUOp::CMP && alu_op != ThreadedALUOp::TEST)
+    return false;
+  if (instruction.data.has_lock)
+    return false;
+
+  const Instruction::Operand& dst = instruction.operands[0];
+  const Instruction::Operand& src = instruction.operands[1];
+  const bool src_imm = (src.mode == OperandMode_Immediate);
+
+  ThreadedMemoryOperand mem = ThreadedMemoryOperand::None;
+  const std::optional<u8> dst_reg = GetOperandRegister(instruction, 0);
+  if (!dst_reg)
+  {
+    if (!BuildThreadedAddress(instruction, 0, op))
+      return false;
+    mem = ThreadedMemoryOperand::Destination;
+  }
+
+  const std::optional<u8> src_reg = src_imm ? std::optional<u8>(0) : GetOperandRegister(instruction, 1);
+  if (!src_reg)
+  {
+    if (mem != ThreadedMemoryOperand::None || !BuildThreadedAddress(instruction, 1, op))
+      return false;
+    mem = ThreadedMemoryOperand::Source;
+  }
+
+  // Same cycle groups as the interpreter handlers.
+  CYCLE_GROUP reg_imm_group, rm_reg_group, reg_rm_group;
+  if (alu_op == ThreadedALUOp::CMP)
+  {
+    reg_imm_group = CYCLES_CMP_REG_IMM;
+    rm_reg_group = CYCLES_CMP_RM_MEM_REG;
+    reg_rm_group = CYCLES_CMP_REG_RM_MEM;
+  }
+  else if (alu_op == ThreadedALUOp::TEST)
+  {
+    reg_imm_group = CYCLES_TEST_RM_MEM_REG;
+    rm_reg_group = CYCLES_TEST_RM_MEM_REG;
+    reg_rm_group = CYCLES_TEST_REG_RM_MEM;
+  }
+  else
+  {
+    reg_imm_group = CYCLES_ALU_REG_IMM;
+    rm_reg_group = CYCLES_ALU_RM_MEM_REG;
+    reg_rm_group = CYCLES_ALU_REG_RM_MEM;
+  }
+
+  CycleCount cycles;
+  if (alu_op == ThreadedALUOp::TEST && src_imm)
+    cycles = cpu->GetCyclesRM(CYCLES_TEST_RM_MEM_REG,
+                              (dst.mode == OperandMode_ModRM_RM) ? instruction.ModRM_RM_IsReg() : false);
+  else if (dst.mode == OperandMode_Register && src_imm)
+    cycles = cpu->GetCycles(reg_imm_group);
+  else if (dst.mode == OperandMode_ModRM_RM)
+    cycles = cpu->GetCyclesRM(rm_reg_group, instruction.ModRM_RM_IsReg());
+  else if (src.mode == OperandMode_ModRM_RM)
+    cycles = cpu->GetCyclesRM(reg_rm_group, instruction.ModRM_RM_IsReg());
+  else
+    return false;
+
+  ThreadedOp::Handler handler;
+  switch (alu_op)
+  {
+    case ThreadedALUOp::ADD:
+      handler = SelectThreadedALUHandler<ThreadedALUOp::ADD, false>(dst.size, src_imm, mem);
+      break;
+    case ThreadedALUOp::SUB:
+      handler = SelectThreadedALUHandler<ThreadedALUOp::SUB, false>(dst.size, src_imm, mem);
+      break;
+    case ThreadedALUOp::AND:
+      handler = SelectThreadedALUHandler<ThreadedALUOp::AND, false>(dst.size, src_imm, mem);
+      break;
+    case ThreadedALUOp::OR:
+      handler = SelectThreadedALUHandler<ThreadedALUOp::OR, false>(dst.size, src_imm, mem);
+      break;
+    case ThreadedALUOp::XOR:
+      handler = SelectThreadedALUHandler<ThreadedALUOp::XOR, false>(dst.size, src_imm, mem);
+      break;
+    case ThreadedALUOp::CMP:
+      handler = fuse_jcc ? SelectThreadedALUHandler<ThreadedALUOp::CMP, true>(dst.size, src_imm, mem) :
+                           SelectThreadedALUHandler<ThreadedALUOp::CMP, false>(dst.size, src_imm, mem);
+      break;
+    case ThreadedALUOp::TEST:
+    default:
+      handler = fuse_jcc ? SelectThreadedALUHandler<ThreadedALUOp::TEST, true>(dst.size, src_imm, mem) :
+                           SelectThreadedALUHandler<ThreadedALUOp::TEST, false>(dst.size, src_imm, mem);
+      break;
+  }
+  if (!handler)
+    return false;
+
+  op->handler = handler;
+  op->cycles = static_cast<u16>(cycles);
+  op->length = static_cast<u8>(instruction.length);
+  op->dst_reg = dst_reg.value_or(0);
+  op->src_reg = src_reg.value_or(0);
+  if (src_imm)
+  {
+    // Byte immediates are sign-extended for word/dword destinations, e.g. 83 /7 ib.
+    if (src.size == OperandSize_8)
+      op->imm = SignExtend32(instruction.data.imm8);
+    else if (src.size == OperandSize_16)
+      op->imm = SignExtend32(instruction.data.imm16);
+    else
+      op->imm = instruction.data.imm32;
+  }
+
+  return true;
+}
+
+bool Interpreter::BuildThreadedJcc(const Instruction& instruction, ThreadedOp* op)
+{
+  if (instruction.operation != Operation_Jcc || instruction.operands[0].mode != OperandMode_JumpCondition ||
+      instruction.operands[1].mode != OperandMode_Relative ||
+      instruction.operands[0].jump_condition == JumpCondition_CXZero)
+  {
+    return false;
+  }
+
+  // The target is relative to the next instruction, same as CalculateJumpTarget.
+  const u32 next_eip = instruction.address + instruction.length;
+  op->condition = instruction.operands[0].jump_condition;
+  op->jump_target = (next_eip + instruction.data.disp32) & instruction.data.GetOperandSizeMask();
+  op->jump_length = static_cast<u8>(instruction.length);
+  return true;
+}
+
+bool Interpreter::BuildThreadedOps(CPU* cpu, const Instruction* instructions, size_t count,
+                                   std::vector<ThreadedOp>* ops, std::vector<InstructionData>* data_array)
+{
+  ops->clear();
+  ops->reserve(count);
+  data_array->clear();
+  data_array->reserve(count);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const Instruction& instruction = instructions[i];
+    ThreadedOp op = {};
+
+    // CMP/TEST immediately followed by a conditional branch runs as a single op.
+    if ((i + 1) < count && BuildThreadedJcc(instructions[i + 1], &op) &&
+        BuildThreadedALU(cpu, instruction, true, &op))
+    {
+      ops->push_back(op);
+      i++;
+      continue;
+    }
+
+    op = {};
+    if (BuildThreadedMOV(cpu, instruction, &op) || BuildThreadedALU(cpu, instruction, false, &op))
+    {
+      op.length = static_cast<u8>(instruction.length);
+      ops->push_back(op);
+      continue;
+    }
+
+    op = {};
+    if (BuildThreadedJcc(instruction, &op))
+    {
+      op.handler = &ThreadedOp_Jcc;
+      ops->push_back(op);
+      continue;
+    }
+
+    const HandlerFunction handler = GetInterpreterHandlerForInstruction(&instruction);
+    if (!handler)
+    {
+      String disassembled;
+      Decoder::DisassembleToString(&instruction, &disassembled);
+      Log_ErrorPrintf("Failed to get handler for instruction '%s'", disassembled.GetCharArray());
+      return false;
+    }
+
+    data_array->push_back(instruction.data);
+    op = {};
+    op.handler = &ThreadedOp_Generic;
+    op.interpreter_handler = handler;
+    op.data = &data_array->back();
+    op.length = static_cast<u8>(instruction.length);
+    ops->push_back(op);
+  }
+
+  return true;
+}
+
+} // namespace CPU_X86
+
+#ifdef Y_COMPILER_MSVC
+#pragma warning(pop)
+#endif
@@ -5,6 +5,9 @@
 #include "pce/cpu_x86/interpreter.h"
 #include "pce/interrupt_controller.h"
 #include "pce/system.h"
+#include <cfloat>
+#include <cmath>
+#include <cstring>
 
 #ifdef Y_COMPILER_MSVC
 #include <intrin.h>
@@ -52,6 +55,15 @@ floatx80 Interpreter::ReadFloatOperand(CPU* cpu, float_status_t& fs)
     {
       // Convert single precision -> extended precision.
       u32 dword_val = cpu->ReadSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address);
+      if (UseHostFloat(cpu))
+      {
+        float float_val;
+        floatx80 ret;
+        std::memcpy(&float_val, &dword_val, sizeof(float_val));
+        if (HostDoubleToFloatX80(static_cast<double>(float_val), &ret))
+          return ret;
+      }
+
       return float32_to_floatx80(dword_val, fs);
     }
     else if constexpr (size == OperandSize_64)
@@ -61,6 +73,15 @@ floatx80 Interpreter::ReadFloatOperand(CPU* cpu, float_status_t& fs)
       u32 dword_val_high =
         cpu->ReadSegmentMemoryDWord(cpu->idata.segment, (cpu->m_effective_address + 4) & cpu->idata.GetAddressMask());
       float64 qword_val = (ZeroExtend64(dword_val_high) << 32) | ZeroExtend64(dword_val_low);
+      if (UseHostFloat(cpu))
+      {
+        double double_val;
+        floatx80 ret;
+        std::memcpy(&double_val, &qword_val, sizeof(double_val));
+        if (HostDoubleToFloatX80(double_val, &ret))
+          return ret;
+      }
+
       return float64_to_floatx80(qword_val, fs);
     }
     else if constexpr (size == OperandSize_80)
@@ -124,13 +145,31 @@ void Interpreter::WriteFloatOperand(CPU* cpu, float_status_t& fs, const floatx80
     if constexpr (size == OperandSize_32)
     {
       // Convert extended precision -> single precision.
-      u32 dword_val = floatx80_to_float32(value, fs);
+      // Results outside the normal single precision range go through softfloat for the underflow/overflow flags.
+      u32 dword_val;
+      double double_val;
+      if (UseHostFloat(cpu) && FloatX80ToHostDouble(value, &double_val) &&
+          (double_val == 0.0 || std::isnormal(static_cast<float>(double_val))))
+      {
+        const float float_val = static_cast<float>(double_val);
+        std::memcpy(&dword_val, &float_val, sizeof(dword_val));
+      }
+      else
+      {
+        dword_val = floatx80_to_float32(value, fs);
+      }
+
       cpu->WriteSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address, dword_val);
     }
     if constexpr (size == OperandSize_64)
     {
       // Convert extended precision -> double precision
-      u64 qword_val = floatx80_to_float64(value, fs);
+      u64 qword_val;
+      double double_val;
+      if (UseHostFloat(cpu) && FloatX80ToHostDouble(value, &double_val))
+        std::memcpy(&qword_val, &double_val, sizeof(qword_val));
+      else
+        qword_val = floatx80_to_float64(value, fs);
       cpu->WriteSegmentMemoryDWord(cpu->idata.segment, cpu->m_effective_address, Truncate32(qword_val));
       cpu->WriteSegmentMemoryDWord(cpu->idata.segment, (cpu->m_effective_address + 4) & cpu->idata.GetAddressMask(),
                             Truncate32(qword_val >> 32));
@@ -288,6 +327,197 @@ void Interpreter::ClearC1(CPU* cpu)
   cpu->m_fpu_registers.SW.C1 = 0;
 }
 
+bool Interpreter::UseHostFloat(CPU* cpu)
+{
+  // Host doubles only give the same results as the guest when rounding to nearest at 53 bits or fewer, and nothing
+  // would be delivered to the guest as an exception. Setting 64-bit precision or unmasking anything falls back to
+  // softfloat. The precision flag and C1 aren't updated on this path, which is the price of the fast mode.
+  const FPUControlWord& cw = cpu->m_fpu_registers.CW;
+  const FPUPrecision precision = cw.PC.GetValue();
+  return cpu->m_fast_fpu && (precision == FPUPrecision_24 || precision == FPUPrecision_53) &&
+         cw.RC.GetValue() == FPURoundingControl_Nearest && (cw.bits & 0x3F) == 0x3F;
+}
+
+bool Interpreter::FloatX80ToHostDouble(const floatx80& value, double* out_value)
+{
+  // Only exact conversions are allowed. NaNs, infinities, denormals, unnormals and anything with more than 53
+  // significant bits or outside the double exponent range is left to softfloat.
+  const u64 sign = ZeroExtend64(value.exp >> 15) << 63;
+  const s32 exponent = s32(value.exp & 0x7FFF);
+  u64 bits;
+  if (exponent == 0)
+  {
+    if (value.fraction != 0)
+      return false;
+
+    bits = sign;
+  }
+  else
+  {
+    const s32 double_exponent = exponent - 16383 + 1023;
+    if (!(value.fraction & UINT64_C(0x8000000000000000)) || (value.fraction & 0x7FF) != 0 || double_exponent <= 0 ||
+        double_exponent >= 0x7FF)
+    {
+      return false;
+    }
+
+    bits = sign | (u64(double_exponent) << 52) | ((value.fraction >> 11) & UINT64_C(0x000FFFFFFFFFFFFF));
+  }
+
+  std::memcpy(out_value, &bits, sizeof(bits));
+  return true;
+}
+
+bool Interpreter::IsExactSingle(double value)
+{
+  // Converting out-of-range values to float is undefined, so they're checked first.
+  return std::fabs(value) <= FLT_MAX && static_cast<double>(static_cast<float>(value)) == value;
+}
+
+bool Interpreter::HostDoubleToFloatX80(double value, floatx80* out_value)
+{
+  u64 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const u16 sign = Truncate16(bits >> 48) & 0x8000;
+  const u32 exponent = Truncate32(bits >> 52) & 0x7FF;
+  const u64 fraction = bits & UINT64_C(0x000FFFFFFFFFFFFF);
+  if (exponent == 0)
+  {
+    // Denormal results would have been normal in extended precision.
+    if (fraction != 0)
+      return false;
+
+    out_value->exp = sign;
+    out_value->fraction = 0;
+    return true;
+  }
+  else if (exponent == 0x7FF)
+  {
+    // Overflow or invalid, softfloat sets the status flags and produces the right NaN.
+    return false;
+  }
+
+  out_value->exp = sign | Truncate16(exponent - 1023 + 16383);
+  out_value->fraction = UINT64_C(0x8000000000000000) | (fraction << 11);
+  return true;
+}
+
+template<Interpreter::HostFloatOp op>
+bool Interpreter::HostFloatUnary(CPU* cpu, const floatx80& value, floatx80* result)
+{
+  double value_d;
+  if (!UseHostFloat(cpu) || !FloatX80ToHostDouble(value, &value_d))
+    return false;
+
+  double result_d;
+  if constexpr (op == HostFloatOp::Sqrt)
+  {
+    // Doubles carry at least twice the bits of single precision plus two, so when the operand is a float, rounding the
+    // double result to single precision gives the correctly rounded result. Wider operands would be rounded twice.
+    const bool single_precision = (cpu->m_fpu_registers.CW.PC.GetValue() == FPUPrecision_24);
+    if (single_precision && !IsExactSingle(value_d))
+      return false;
+
+    result_d = std::sqrt(value_d);
+    if (single_precision)
+      result_d = static_cast<double>(static_cast<float>(result_d));
+  }
+  else if constexpr (op == HostFloatOp::F2XM1)
+  {
+    // Only defined for -1 <= x <= 1.
+    if (std::fabs(value_d) > 1.0)
+      return false;
+
+    result_d = std::expm1(value_d * 0.69314718055994530942);
+  }
+  else
+  {
+    static_assert(op == HostFloatOp::Sin || op == HostFloatOp::Cos || op == HostFloatOp::Tan, "unknown unary op");
+
+    // Out-of-range operands set C2 and leave the register alone, which softfloat handles.
+    if (std::fabs(value_d) >= 9223372036854775808.0)
+      return false;
+
+    if constexpr (op == HostFloatOp::Sin)
+      result_d = std::sin(value_d);
+    else if constexpr (op == HostFloatOp::Cos)
+      result_d = std::cos(value_d);
+    else
+      result_d = std::tan(value_d);
+  }
+
+  return HostDoubleToFloatX80(result_d, result);
+}
+
+template<Interpreter::HostFloatOp op>
+bool Interpreter::HostFloatBinary(CPU* cpu, const floatx80& lhs, const floatx80& rhs, floatx80* result)
+{
+  double lhs_d, rhs_d;
+  if (!UseHostFloat(cpu) || !FloatX80ToHostDouble(lhs, &lhs_d) || !FloatX80ToHostDouble(rhs, &rhs_d))
+    return false;
+
+  double result_d;
+  if constexpr (op == HostFloatOp::Add || op == HostFloatOp::Subtract || op == HostFloatOp::Multiply ||
+                op == HostFloatOp::Divide)
+  {
+    // As with square roots, rounding the double result to single precision is only exact for float operands.
+    const bool single_precision = (cpu->m_fpu_registers.CW.PC.GetValue() == FPUPrecision_24);
+    if (single_precision && (!IsExactSingle(lhs_d) || !IsExactSingle(rhs_d)))
+      return false;
+
+    if constexpr (op == HostFloatOp::Add)
+      result_d = lhs_d + rhs_d;
+    else if constexpr (op == HostFloatOp::Subtract)
+      result_d = lhs_d - rhs_d;
+    else if constexpr (op == HostFloatOp::Multiply)
+      result_d = lhs_d * rhs_d;
+    else
+      result_d = lhs_d / rhs_d;
+
+    // A zero product or quotient of non-zero operands underflowed the double range, but not the extended range.
+    if (result_d == 0.0 && ((op == HostFloatOp::Multiply && lhs_d != 0.0 && rhs_d != 0.0) ||
+                            (op == HostFloatOp::Divide && lhs_d != 0.0)))
+    {
+      return false;
+    }
+
+    if (single_precision)
+    {
+      const float result_f = static_cast<float>(result_d);
+      if (result_d != 0.0 && !std::isnormal(result_f))
+        return false;
+
+      result_d = static_cast<double>(result_f);
+    }
+  }
+  else if constexpr (op == HostFloatOp::Atan)
+  {
+    // ST(1) <- arctan(ST(1) / ST(0))
+    result_d = std::atan2(rhs_d, lhs_d);
+  }
+  else if constexpr (op == HostFloatOp::YL2X)
+  {
+    // ST(1) <- ST(1) * log2(ST(0)), invalid for non-positive ST(0).
+    if (!(lhs_d > 0.0))
+      return false;
+
+    result_d = rhs_d * std::log2(lhs_d);
+  }
+  else
+  {
+    static_assert(op == HostFloatOp::YL2XP1, "unknown binary op");
+
+    // ST(1) <- ST(1) * log2(ST(0) + 1), only defined for |ST(0)| < 1 - sqrt(2) / 2.
+    if (std::fabs(lhs_d) >= 0.29289321881345247560)
+      return false;
+
+    result_d = rhs_d * (std::log1p(lhs_d) * 1.44269504088896340736);
+  }
+
+  return HostDoubleToFloatX80(result_d, result);
+}
+
 void Interpreter::Execute_Operation_WAIT(CPU* cpu)
 {
   if ((cpu->m_registers.CR0 & (CR0Bit_MP | CR0Bit_TS)) == (CR0Bit_MP | CR0Bit_TS))
@@ -396,8 +626,12 @@ void Interpreter::Execute_Operation_FADD(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_add(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Add>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_add(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -645,8 +879,12 @@ void Interpreter::Execute_Operation_FDIV(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Divide>(cpu, dividend, divisor, &res))
+  {
+    res = floatx80_div(dividend, divisor, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -675,8 +913,12 @@ void Interpreter::Execute_Operation_FDIVR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Divide>(cpu, dividend, divisor, &res))
+  {
+    res = floatx80_div(dividend, divisor, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -716,8 +958,12 @@ void Interpreter::Execute_Operation_FIADD(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_add(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Add>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_add(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -738,8 +984,12 @@ void Interpreter::Execute_Operation_FISUB(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Subtract>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_sub(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -760,8 +1010,12 @@ void Interpreter::Execute_Operation_FISUBR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Subtract>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_sub(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -782,8 +1036,12 @@ void Interpreter::Execute_Operation_FIMUL(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_mul(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Multiply>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_mul(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -804,8 +1062,12 @@ void Interpreter::Execute_Operation_FIDIV(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Divide>(cpu, dividend, divisor, &res))
+  {
+    res = floatx80_div(dividend, divisor, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -826,8 +1088,12 @@ void Interpreter::Execute_Operation_FIDIVR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_div(dividend, divisor, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Divide>(cpu, dividend, divisor, &res))
+  {
+    res = floatx80_div(dividend, divisor, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -1075,8 +1341,12 @@ void Interpreter::Execute_Operation_FMUL(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_mul(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Multiply>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_mul(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -1222,13 +1492,17 @@ void Interpreter::Execute_Operation_FPTAN(CPU* cpu)
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 val = ReadFloatRegister(cpu, 0);
-  if (ftan(val, fs) != 0)
+  if (!HostFloatUnary<HostFloatOp::Tan>(cpu, val, &val))
   {
-    cpu->m_fpu_registers.SW.C2 = 1;
-    return;
+    if (ftan(val, fs) != 0)
+    {
+      cpu->m_fpu_registers.SW.C2 = 1;
+      return;
+    }
+
+    RaiseFloatExceptions(cpu, fs);
   }
 
-  RaiseFloatExceptions(cpu, fs);
   CheckFloatStackOverflow(cpu);
   WriteFloatRegister(cpu, 0, val);
   PushFloatStack(cpu);
@@ -1279,8 +1553,12 @@ void Interpreter::Execute_Operation_FSQRT(CPU* cpu)
   // ST(0) <- SquareRoot(ST(0))
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 val = ReadFloatRegister(cpu, 0);
-  floatx80 res = floatx80_sqrt(val, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatUnary<HostFloatOp::Sqrt>(cpu, val, &res))
+  {
+    res = floatx80_sqrt(val, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
   WriteFloatRegister(cpu, 0, res);
 }
 
@@ -1325,8 +1603,12 @@ void Interpreter::Execute_Operation_FSUB(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Subtract>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_sub(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -1356,8 +1638,12 @@ void Interpreter::Execute_Operation_FSUBR(CPU* cpu)
   ClearC1(cpu);
   RaiseFloatExceptions(cpu, fs);
 
-  floatx80 res = floatx80_sub(lhs, rhs, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Subtract>(cpu, lhs, rhs, &res))
+  {
+    res = floatx80_sub(lhs, rhs, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
 
   WriteFloatOperand<dst_size, dst_mode, dst_constant>(cpu, fs, res);
 }
@@ -1476,8 +1762,12 @@ void Interpreter::Execute_Operation_FPATAN(CPU* cpu)
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 st0 = ReadFloatRegister(cpu, 0);
   floatx80 st1 = ReadFloatRegister(cpu, 1);
-  floatx80 res = fpatan(st0, st1, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::Atan>(cpu, st0, st1, &res))
+  {
+    res = fpatan(st0, st1, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
   WriteFloatRegister(cpu, 1, res);
   PopFloatStack(cpu);
 }
@@ -1492,8 +1782,12 @@ void Interpreter::Execute_Operation_F2XM1(CPU* cpu)
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 val = ReadFloatRegister(cpu, 0);
-  floatx80 res = f2xm1(val, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatUnary<HostFloatOp::F2XM1>(cpu, val, &res))
+  {
+    res = f2xm1(val, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
   WriteFloatRegister(cpu, 0, res);
 }
 
@@ -1509,8 +1803,12 @@ void Interpreter::Execute_Operation_FYL2X(CPU* cpu)
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 st0 = ReadFloatRegister(cpu, 0);
   floatx80 st1 = ReadFloatRegister(cpu, 1);
-  floatx80 res = fyl2x(st0, st1, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::YL2X>(cpu, st0, st1, &res))
+  {
+    res = fyl2x(st0, st1, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
   WriteFloatRegister(cpu, 1, res);
   PopFloatStack(cpu);
 }
@@ -1527,8 +1825,12 @@ void Interpreter::Execute_Operation_FYL2XP1(CPU* cpu)
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 st0 = ReadFloatRegister(cpu, 0);
   floatx80 st1 = ReadFloatRegister(cpu, 1);
-  floatx80 res = fyl2xp1(st0, st1, fs);
-  RaiseFloatExceptions(cpu, fs);
+  floatx80 res;
+  if (!HostFloatBinary<HostFloatOp::YL2XP1>(cpu, st0, st1, &res))
+  {
+    res = fyl2xp1(st0, st1, fs);
+    RaiseFloatExceptions(cpu, fs);
+  }
   WriteFloatRegister(cpu, 1, res);
 }
 
@@ -1542,13 +1844,17 @@ void Interpreter::Execute_Operation_FCOS(CPU* cpu)
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 val = ReadFloatRegister(cpu, 0);
-  if (fcos(val, fs) != 0)
+  if (!HostFloatUnary<HostFloatOp::Cos>(cpu, val, &val))
   {
-    cpu->m_fpu_registers.SW.C2 = 1;
-    return;
+    if (fcos(val, fs) != 0)
+    {
+      cpu->m_fpu_registers.SW.C2 = 1;
+      return;
+    }
+
+    RaiseFloatExceptions(cpu, fs);
   }
 
-  RaiseFloatExceptions(cpu, fs);
   WriteFloatRegister(cpu, 0, val);
 }
 
@@ -1562,13 +1868,17 @@ void Interpreter::Execute_Operation_FSIN(CPU* cpu)
 
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 val = ReadFloatRegister(cpu, 0);
-  if (fsin(val, fs) != 0)
+  if (!HostFloatUnary<HostFloatOp::Sin>(cpu, val, &val))
   {
-    cpu->m_fpu_registers.SW.C2 = 1;
-    return;
+    if (fsin(val, fs) != 0)
+    {
+      cpu->m_fpu_registers.SW.C2 = 1;
+      return;
+    }
+
+    RaiseFloatExceptions(cpu, fs);
   }
 
-  RaiseFloatExceptions(cpu, fs);
   WriteFloatRegister(cpu, 0, val);
 }
 
@@ -1583,13 +1893,17 @@ void Interpreter::Execute_Operation_FSINCOS(CPU* cpu)
   float_status_t fs = GetFloatStatus(cpu);
   floatx80 val = ReadFloatRegister(cpu, 0);
   floatx80 sin_val, cos_val;
-  if (fsincos(val, &sin_val, &cos_val, fs) != 0)
+  if (!HostFloatUnary<HostFloatOp::Sin>(cpu, val, &sin_val) || !HostFloatUnary<HostFloatOp::Cos>(cpu, val, &cos_val))
   {
-    cpu->m_fpu_registers.SW.C2 = 1;
-    return;
+    if (fsincos(val, &sin_val, &cos_val, fs) != 0)
+    {
+      cpu->m_fpu_registers.SW.C2 = 1;
+      return;
+    }
+
+    RaiseFloatExceptions(cpu, fs);
   }
 
-  RaiseFloatExceptions(cpu, fs);
   CheckFloatStackOverflow(cpu);
   WriteFloatRegister(cpu, 0, sin_val);
   PushFloatStack(cpu);
@@ -6,6 +6,8 @@
 #include "decoder.h"
 #include "interpreter.h"
 #include "recompiler_code_generator.h"
+#include <algorithm>
+#include <cstring>
 Log_SetChannel(CPU_X86::Recompiler);
 
 namespace CPU_X86 {
@@ -15,12 +17,35 @@ extern u32 TRACE_EXECUTION_LAST_EIP;
 
 namespace CPU_X86::Recompiler {
 
-Backend::Backend(CPU* cpu) : CodeCacheBackend(cpu), m_code_space(std::make_unique<JitCodeBuffer>())
+// Space kept at the start of the code buffer for the ASM functions. Blocks are compiled into the remainder.
+static constexpr size_t AsmFunctionsCodeSpaceSize = 64 * 1024;
+
+Backend::Backend(CPU* cpu, const TierThresholds& tier_thresholds)
+  : CodeCacheBackend(cpu), m_code_space(std::make_unique<JitCodeBuffer>()), m_tier_thresholds(tier_thresholds)
 {
+  const size_t segment_size = (m_code_space->GetFreeCodeSpace() - AsmFunctionsCodeSpaceSize) / NumCodeSegments;
+  for (CodeSegment& segment : m_code_segments)
+    segment.buffer = m_code_space->SplitBuffer(segment_size);
+
   m_asm_functions = ASMFunctions::Generate(m_code_space.get());
+  m_compile_thread = std::thread(&Backend::CompileThreadEntryPoint, this);
 }
 
-Backend::~Backend() {}
+Backend::~Backend()
+{
+  CancelAllBackgroundCompiles();
+  {
+    std::unique_lock<std::mutex> lock(m_compile_mutex);
+    m_compile_thread_shutdown = true;
+  }
+  m_compile_queue_cv.notify_one();
+  m_compile_thread.join();
+
+  // Blocks live in the arena, so they have to be destroyed before it goes away.
+  CodeCacheBackend::FlushCodeCache();
+
+  CodeGenerator::LogFallbackStatistics(m_fallback_operation_counts);
+}
 
 void Backend::Execute()
 {
@@ -42,14 +67,9 @@ void Backend::Execute()
 
     while (m_cpu->m_execution_downcount > 0)
     {
-      // Block flush pending?
-      if (m_code_buffer_overflow)
-      {
-        Log_ErrorPrint("Out of code space, flushing all blocks.");
-        m_code_buffer_overflow = false;
-        m_current_block = nullptr;
-        FlushCodeCache();
-      }
+      // Pick up any blocks the compile thread has finished with.
+      if (m_compiled_blocks_pending.load())
+        InstallBackgroundCompiledBlocks();
 
       // Check for external interrupts.
       if (m_cpu->HasExternalInterrupt())
@@ -76,9 +96,17 @@ void Backend::Execute()
       ExecuteBlock();
       m_cpu->CommitPendingCycles();
 
-      // Fix up delayed block destroying.
+      // Fix up delayed block destroying. The return stack has to follow every call and return, even if we don't
+      // chain from this block. A trace which left through a side exit never reached its exit instruction, so it
+      // neither pushes nor pops, and the next block isn't a successor of that exit.
       Block* previous_block = m_current_block;
       m_current_block = nullptr;
+      const bool side_exit = m_cpu->m_trace_side_exit;
+      m_cpu->m_trace_side_exit = false;
+      BlockKey return_key;
+      return_key.qword = UINT64_C(0xFFFFFFFFFFFFFFFF);
+      if (!side_exit)
+        return_key = UpdateReturnStack(previous_block);
       if (previous_block->IsDestroyPending())
       {
         FlushBlock(previous_block);
@@ -86,34 +114,30 @@ void Backend::Execute()
       }
 
       // Block chaining?
-      if (!m_cpu->HasExternalInterrupt() && previous_block->IsLinkable())
+      if (!side_exit && !m_cpu->HasExternalInterrupt() && previous_block->IsLinkable())
       {
         if (GetBlockKeyForCurrentState(&key))
         {
           // Block points to itself?
           if (previous_block->key == key && CanExecuteBlock(previous_block))
           {
-            // Execute self again.
+            // Execute self again, and link it so the next iteration doesn't come back here. Idle loops are left
+            // unlinked, so that each iteration returns here and can skip ahead to the next event.
             m_current_block = previous_block;
+            if (previous_block->IsIdleLoop())
+            {
+              SkipIdleLoop(previous_block);
+            }
+            else if (std::find(previous_block->link_successors.begin(), previous_block->link_successors.end(),
+                               previous_block) == previous_block->link_successors.end())
+            {
+              LinkBlockBase(previous_block, previous_block);
+            }
           }
           else
           {
-            // Try to find an already-linked block.
-            for (BlockBase* linked_block : previous_block->link_successors)
-            {
-              if (linked_block->key == key)
-              {
-                if (!CanExecuteBlock(linked_block))
-                {
-                  // CanExecuteBlock can result in a block flush, so stop iterating here.
-                  break;
-                }
-
-                // Execute the
-                m_current_block = static_cast<Block*>(linked_block);
-                continue;
-              }
-            }
+            // Try the predicted return address, or an already-linked block.
+            m_current_block = static_cast<Block*>(GetLinkedBlock(previous_block, key, return_key));
 
             // No acceptable blocks found in the successor list, try a new one.
             if (!m_current_block)
@@ -151,11 +175,24 @@ void Backend::AbortCurrentInstruction()
 
 void Backend::FlushCodeCache()
 {
+  // The compile thread can't be writing to the code space while it is reset.
+  CancelAllBackgroundCompiles();
+
   // Prevent the current block from being flushed.
   if (m_current_block)
     FlushBlock(m_current_block, true);
 
+  // Clearing the segment lists first saves each destroyed block searching them.
+  for (CodeSegment& segment : m_code_segments)
+  {
+    segment.buffer->Reset();
+    segment.blocks.clear();
+    segment.last_used = 0;
+  }
+  m_active_code_segment = 0;
+
   CodeCacheBackend::FlushCodeCache();
+  m_uncached_block_lookups.clear();
   m_code_space->Reset();
 
   // recompile asm functions
@@ -164,7 +201,7 @@ void Backend::FlushCodeCache()
 
 BlockBase* Backend::AllocateBlock(const BlockKey key)
 {
-  return new Block(key);
+  return AllocateBlockStorage<Block>(key);
 }
 
 bool Backend::CompileBlock(BlockBase* block)
@@ -172,37 +209,84 @@ bool Backend::CompileBlock(BlockBase* block)
   if (!CompileBlockBase(block))
     return false;
 
-  Block* cblock = static_cast<Block*>(block);
-  if (m_code_space->GetFreeCodeSpace() < (cblock->instructions.size() * MaximumBytesPerInstruction))
+  // The block is interpreted until the compile thread is done with it. The compile is queued the first time it runs,
+  // as the dispatcher may still be updating the block's flags until then.
+  return BuildInterpreterHandlers(static_cast<Block*>(block));
+}
+
+bool Backend::BuildInterpreterHandlers(Block* cblock)
+{
+  cblock->interpreter_handlers.clear();
+  cblock->interpreter_handlers.reserve(cblock->instructions.size());
+  for (const Instruction& instruction : cblock->instructions)
   {
-    Log_WarningPrintf("Code space is possibly insufficient for block %08X (%zu instructions), flushing",
-                      cblock->GetPhysicalAddress(), cblock->instructions.size());
-    m_code_buffer_overflow = true;
-    return false;
+    auto handler = Interpreter::GetInterpreterHandlerForInstruction(&instruction);
+    if (!handler)
+    {
+      String disassembled;
+      Decoder::DisassembleToString(&instruction, &disassembled);
+      Log_ErrorPrintf("Failed to get handler for instruction '%s'", disassembled.GetCharArray());
+      return false;
+    }
+
+    cblock->interpreter_handlers.push_back(handler);
   }
 
-  CodeGenerator::AlignCodeBuffer(m_code_space.get());
+  return true;
+}
 
-  CodeGenerator codegen(m_cpu, m_code_space.get(), m_asm_functions);
-  if (!codegen.CompileBlock(block, &cblock->code_pointer, &cblock->code_size))
-  {
-    Log_WarningPrintf("Failed to compile block at paddr %08X", block->key.eip_physical_address);
+bool Backend::ShouldCacheBlock(const BlockKey& key)
+{
+  if (m_tier_thresholds.cache_threshold == 0)
+    return true;
+
+  // Cold code such as one-shot initialization never gets past the uncached interpreter.
+  if (m_uncached_block_lookups.size() >= MaxUncachedBlockLookups)
+    m_uncached_block_lookups.clear();
+
+  u32& lookup_count = m_uncached_block_lookups[key];
+  if (++lookup_count < m_tier_thresholds.cache_threshold)
     return false;
-  }
 
+  m_uncached_block_lookups.erase(key);
   return true;
 }
 
+bool Backend::PredictTraceBranch(const BlockBase* block, VirtualMemoryAddress segment_eip, bool* taken)
+{
+  if (m_tier_thresholds.trace_threshold == 0)
+    return false;
+
+  // The branch's profile is kept in the block starting at the segment. It's in the same page, at the same offset.
+  BlockKey segment_key = block->key;
+  segment_key.eip_physical_address += segment_eip - block->start_eip;
+  const Block* segment_block = static_cast<const Block*>(m_blocks.Lookup(segment_key));
+  if (!segment_block || !segment_block->IsValid())
+    return false;
+
+  const u32 taken_count = segment_block->branch_taken_count;
+  const u32 not_taken_count = segment_block->branch_not_taken_count;
+  const u32 total_count = taken_count + not_taken_count;
+  if (total_count < m_tier_thresholds.trace_threshold)
+    return false;
+
+  *taken = (taken_count > not_taken_count);
+  return ((*taken ? not_taken_count : taken_count) * TraceBranchBias) <= total_count;
+}
+
 void Backend::ResetBlock(BlockBase* block)
 {
   Block* cblock = static_cast<Block*>(block);
+  CancelBackgroundCompile(cblock);
   CodeCacheBackend::ResetBlock(cblock);
-  cblock->code_pointer = nullptr;
-  cblock->code_size = 0;
+  ReleaseBlockCode(cblock);
+  cblock->interpreter_handlers.clear();
 }
 
 void Backend::FlushBlock(BlockBase* block, bool defer_destroy /* = false */)
 {
+  CancelBackgroundCompile(static_cast<Block*>(block));
+
   // Defer flush to after execution.
   if (m_current_block == block)
     defer_destroy = true;
@@ -212,15 +296,442 @@ void Backend::FlushBlock(BlockBase* block, bool defer_destroy /* = false */)
 
 void Backend::DestroyBlock(BlockBase* block)
 {
-  delete static_cast<Block*>(block);
+  Block* cblock = static_cast<Block*>(block);
+  CancelBackgroundCompile(cblock);
+  ReleaseBlockCode(cblock);
+  DestroyBlockStorage(cblock);
+}
+
+void Backend::InvalidateBlock(BlockBase* block)
+{
+  // The code is being compiled from stale instructions, so throw it away. If the block is revalidated later, it is
+  // queued again the next time it executes.
+  Block* cblock = static_cast<Block*>(block);
+  CancelBackgroundCompile(cblock);
+  CodeCacheBackend::InvalidateBlock(block);
+
+  // Self-modifying code would keep recompiling, leave it in the cached interpreter instead.
+  cblock->invalidation_count++;
+  if (m_tier_thresholds.demote_invalidations != 0 &&
+      cblock->invalidation_count == m_tier_thresholds.demote_invalidations)
+  {
+    Log_PerfPrintf("Block %08X invalidated %u times, demoting to cached interpreter", block->GetPhysicalAddress(),
+                   cblock->invalidation_count);
+  }
+}
+
+bool Backend::IsBlockDemoted(const Block* block) const
+{
+  return (m_tier_thresholds.demote_invalidations != 0 &&
+          block->invalidation_count >= m_tier_thresholds.demote_invalidations);
+}
+
+bool Backend::FormTrace(Block* block)
+{
+  // Traces are kept within one page, so the block can't already cross one.
+  if (m_tier_thresholds.trace_threshold == 0 || block->IsTrace() || block->CrossesPage() ||
+      block->instructions.back().operation != Operation_Jcc)
+  {
+    return true;
+  }
+
+  bool taken;
+  if (!PredictTraceBranch(block, block->start_eip, &taken))
+    return true;
+
+  // The trace covers more code than the block did, so the page mapping has to be replaced as well.
+  RemoveBlockPhysicalMappings(block);
+  ResetBlock(block);
+  if (!CompileBlockBase(block, true) || !BuildInterpreterHandlers(block))
+  {
+    // It's decoded again, or flushed, the next time it's looked up.
+    Log_WarningPrintf("Failed to form trace at paddr %08X", block->GetPhysicalAddress());
+    block->flags |= BlockFlags::Invalidated;
+    return false;
+  }
+
+  AddBlockPhysicalMappings(block);
+  if (block->IsTrace())
+  {
+    Log_DevPrintf("Formed trace at paddr %08X (%u branches, %u instructions)", block->GetPhysicalAddress(),
+                  ZeroExtend32(block->trace_branch_count), block->instruction_count);
+    m_cpu->m_execution_stats.code_cache_traces_formed++;
+  }
+
+  return true;
+}
+
+void Backend::ReleaseBlockCode(Block* block)
+{
+  if (block->code_segment != InvalidCodeSegment)
+  {
+    std::vector<Block*>& segment_blocks = m_code_segments[block->code_segment].blocks;
+    auto iter = std::find(segment_blocks.begin(), segment_blocks.end(), block);
+    if (iter != segment_blocks.end())
+    {
+      *iter = segment_blocks.back();
+      segment_blocks.pop_back();
+    }
+  }
+
+  block->code_pointer = nullptr;
+  block->code_size = 0;
+  block->link_slot_count = 0;
+  block->code_segment = InvalidCodeSegment;
+}
+
+void Backend::SwitchCodeSegment()
+{
+  // Prefer an empty segment, otherwise the one which has gone the longest without running. The active segment can't
+  // be picked, as the compile thread may still be writing to it.
+  u32 new_segment = InvalidCodeSegment;
+  for (u32 i = 0; i < NumCodeSegments; i++)
+  {
+    if (i == m_active_code_segment)
+      continue;
+
+    if (m_code_segments[i].buffer->GetUsedCodeSpace() == 0)
+    {
+      new_segment = i;
+      break;
+    }
+
+    if (new_segment == InvalidCodeSegment || m_code_segments[i].last_used < m_code_segments[new_segment].last_used)
+      new_segment = i;
+  }
+
+  // Compiles are installed in order, so nothing compiled into an inactive segment is still waiting to be installed.
+  if (m_code_segments[new_segment].buffer->GetUsedCodeSpace() > 0)
+    EvictCodeSegment(new_segment);
+
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  m_active_code_segment = new_segment;
+}
+
+void Backend::EvictCodeSegment(u32 index)
+{
+  CodeSegment& segment = m_code_segments[index];
+  Log_PerfPrintf("Evicting code segment %u (%zu blocks, %zu bytes)", index, segment.blocks.size(),
+                 segment.buffer->GetUsedCodeSpace());
+
+  // Blocks go back to the cached interpreter, and are queued for compiling again next time they run. Unlinking
+  // reverts any jumps from other segments into this one.
+  std::vector<Block*> blocks;
+  blocks.swap(segment.blocks);
+  for (Block* block : blocks)
+  {
+    UnlinkBlockBase(block);
+    block->code_segment = InvalidCodeSegment;
+    ReleaseBlockCode(block);
+    block->code_evicted = true;
+  }
+
+  m_cpu->m_execution_stats.code_cache_segment_evictions++;
+  m_cpu->m_execution_stats.code_cache_bytes_reclaimed += segment.buffer->GetUsedCodeSpace();
+  segment.buffer->Reset();
+  segment.last_used = 0;
+}
+
+void Backend::LinkBlockBase(BlockBase* from, BlockBase* to)
+{
+  // Blocks which are still being compiled can't be patched yet. Leaving them unlinked means the dispatcher looks up
+  // the successor again, and the link is made once both blocks have code.
+  Block* from_block = static_cast<Block*>(from);
+  Block* to_block = static_cast<Block*>(to);
+  if (!from_block->code_pointer || !to_block->code_pointer)
+    return;
+
+  CodeCacheBackend::LinkBlockBase(from, to);
+
+  // Patch the exit of the previous block to jump straight to the new block. The block we're linking to must be in
+  // the same physical and linear page, and can't cross a page, otherwise the link would skip the page translation.
+  // Since only static branch targets are linked, EIP and the CS base matching implies the same linear address.
+  const u32 cs_base = m_cpu->m_segment_cache[Segment_CS].base_address;
+  const LinearMemoryAddress from_linear_address = cs_base + from_block->start_eip;
+  const LinearMemoryAddress to_linear_address = cs_base + m_cpu->m_registers.EIP;
+  if (to_block->CrossesPage() || from_block->GetPhysicalPageAddress() != to_block->GetPhysicalPageAddress() ||
+      (from_linear_address & CPU::PAGE_MASK) != (to_linear_address & CPU::PAGE_MASK))
+  {
+    return;
+  }
+
+  // Each slot belongs to one target of the final exit. Side exits of traces aren't linked.
+  for (u32 i = 0; i < from_block->link_slot_count; i++)
+  {
+    BlockLinkSlot& slot = from_block->link_slots[i];
+    if (slot.linked_block || slot.target_eip != m_cpu->m_registers.EIP)
+      continue;
+
+    CodeGenerator::LinkBlockSlot(&slot, m_cpu->m_registers.EIP, cs_base, to_block,
+                                 reinterpret_cast<const void*>(to_block->code_pointer));
+    break;
+  }
+}
+
+void Backend::UnlinkBlockSuccessor(BlockBase* from, BlockBase* to)
+{
+  Block* from_block = static_cast<Block*>(from);
+  for (u32 i = 0; i < from_block->link_slot_count; i++)
+  {
+    if (from_block->link_slots[i].linked_block == to)
+      CodeGenerator::UnlinkBlockSlot(&from_block->link_slots[i]);
+  }
+
+  CodeCacheBackend::UnlinkBlockSuccessor(from, to);
+}
+
+void Backend::UnlinkBlockBase(BlockBase* block)
+{
+  // Revert any jumps into this block, and any jumps out of it.
+  for (BlockBase* predecessor : block->link_predecessors)
+  {
+    Block* predecessor_block = static_cast<Block*>(predecessor);
+    for (u32 i = 0; i < predecessor_block->link_slot_count; i++)
+    {
+      if (predecessor_block->link_slots[i].linked_block == block)
+        CodeGenerator::UnlinkBlockSlot(&predecessor_block->link_slots[i]);
+    }
+  }
+
+  Block* cblock = static_cast<Block*>(block);
+  for (u32 i = 0; i < cblock->link_slot_count; i++)
+  {
+    if (cblock->link_slots[i].linked_block)
+      CodeGenerator::UnlinkBlockSlot(&cblock->link_slots[i]);
+  }
+
+  CodeCacheBackend::UnlinkBlockBase(block);
 }
 
 void Backend::ExecuteBlock()
 {
   // m_cpu->PrintCurrentStateAndInstruction(m_cpu->m_registers.EIP);
+  // Execution stats and m_current_block are updated by the block itself, as it can chain to other blocks.
+  if (m_current_block->code_pointer)
+  {
+    m_code_segments[m_current_block->code_segment].last_used = ++m_code_segment_use_counter;
+    m_current_block->code_pointer(m_cpu);
+    return;
+  }
+
+  // Blocks which lost their code to an eviction dropped their instructions when it was installed, so decode them again
+  // for interpreting and the next compile.
+  if (m_current_block->instructions.empty() &&
+      (!RebuildBlockInstructions(m_current_block) || !BuildInterpreterHandlers(m_current_block)))
+  {
+    InterpretUncachedBlock();
+    return;
+  }
+
+  // No code yet. Either it's still compiling, it hasn't reached the compile threshold, or the compile was cancelled
+  // by an invalidation and the block has since been revalidated.
+  if (!m_current_block->IsBackgroundCompiling() && !IsBlockDemoted(m_current_block))
+  {
+    if (m_current_block->execution_count >= m_tier_thresholds.compile_threshold)
+    {
+      if (m_current_block->code_evicted)
+      {
+        m_cpu->m_execution_stats.code_cache_eviction_recompiles++;
+        m_current_block->code_evicted = false;
+      }
+
+      if (!FormTrace(m_current_block))
+      {
+        InterpretUncachedBlock();
+        return;
+      }
+
+      QueueBackgroundCompile(m_current_block);
+    }
+    else
+      m_current_block->execution_count++;
+  }
+
+  InterpretBlock();
+}
+
+void Backend::InterpretBlock()
+{
+  Block* block = m_current_block;
   m_cpu->m_execution_stats.code_cache_blocks_executed++;
-  m_cpu->m_execution_stats.code_cache_instructions_executed += m_current_block->instructions.size();
-  m_current_block->code_pointer(m_cpu);
+  m_cpu->m_execution_stats.code_cache_instructions_executed += block->instruction_count;
+  m_cpu->m_execution_stats.cached_interpreter_instructions_executed += block->instruction_count;
+
+  const size_t num_instructions = block->instructions.size();
+  for (size_t i = 0; i < num_instructions; i++)
+  {
+    const Instruction& instruction = block->instructions[i];
+    m_cpu->m_current_EIP = m_cpu->m_registers.EIP;
+    m_cpu->m_current_ESP = m_cpu->m_registers.ESP;
+    m_cpu->m_registers.EIP = (m_cpu->m_registers.EIP + instruction.length) & m_cpu->m_EIP_mask;
+    std::memcpy(&m_cpu->idata, &instruction.data, sizeof(m_cpu->idata));
+    block->interpreter_handlers[i](m_cpu);
+
+    // Traces are left at a branch which didn't go the way the trace does.
+    if (instruction.operation == Operation_Jcc && (i + 1) < num_instructions &&
+        m_cpu->m_registers.EIP != block->instructions[i + 1].address)
+    {
+      const u32 skipped_instructions = static_cast<u32>(num_instructions - (i + 1));
+      m_cpu->m_execution_stats.code_cache_instructions_executed -= skipped_instructions;
+      m_cpu->m_execution_stats.cached_interpreter_instructions_executed -= skipped_instructions;
+      m_cpu->m_execution_stats.code_cache_trace_side_exits++;
+      m_cpu->m_trace_side_exit = true;
+      return;
+    }
+  }
+
+  // Profile the branch ending the block, for forming traces.
+  const Instruction& exit_instruction = block->instructions.back();
+  if (exit_instruction.operation == Operation_Jcc && !block->IsTrace())
+  {
+    if (m_cpu->m_registers.EIP == GetRelativeBranchTarget(exit_instruction))
+      block->branch_taken_count++;
+    else
+      block->branch_not_taken_count++;
+  }
+}
+
+void Backend::QueueBackgroundCompile(Block* block)
+{
+  DebugAssert(!block->IsBackgroundCompiling() && !block->code_pointer);
+  block->flags |= BlockFlags::BackgroundCompiling;
+
+  {
+    std::unique_lock<std::mutex> lock(m_compile_mutex);
+    m_compile_queue.push_back(block);
+  }
+  m_compile_queue_cv.notify_one();
+}
+
+void Backend::CancelBackgroundCompile(Block* block)
+{
+  if (!block->IsBackgroundCompiling())
+    return;
+
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  auto iter = std::find(m_compile_queue.begin(), m_compile_queue.end(), block);
+  if (iter != m_compile_queue.end())
+    m_compile_queue.erase(iter);
+
+  // If it's being compiled right now, the result will show up in the completed list, so wait for that.
+  m_compile_done_cv.wait(lock, [this, block]() { return m_compiling_block != block; });
+  m_compiled_blocks.erase(std::remove_if(m_compiled_blocks.begin(), m_compiled_blocks.end(),
+                                         [block](const CompiledBlockResult& result) { return result.block == block; }),
+                          m_compiled_blocks.end());
+
+  block->flags &= ~BlockFlags::BackgroundCompiling;
+}
+
+void Backend::CancelAllBackgroundCompiles()
+{
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  for (Block* block : m_compile_queue)
+    block->flags &= ~BlockFlags::BackgroundCompiling;
+  m_compile_queue.clear();
+
+  m_compile_done_cv.wait(lock, [this]() { return m_compiling_block == nullptr; });
+  for (const CompiledBlockResult& result : m_compiled_blocks)
+    result.block->flags &= ~BlockFlags::BackgroundCompiling;
+  m_compiled_blocks.clear();
+}
+
+void Backend::InstallBackgroundCompiledBlocks()
+{
+  std::vector<CompiledBlockResult> results;
+  {
+    std::unique_lock<std::mutex> lock(m_compile_mutex);
+    results.swap(m_compiled_blocks);
+    m_compiled_blocks_pending.store(false);
+  }
+
+  bool switch_code_segment = false;
+  for (const CompiledBlockResult& result : results)
+  {
+    Block* block = result.block;
+    block->flags &= ~BlockFlags::BackgroundCompiling;
+    if (result.success)
+    {
+      block->code_pointer = result.code_pointer;
+      block->code_size = result.code_size;
+      block->link_slots = result.link_slots;
+      block->link_slot_count = result.link_slot_count;
+      block->code_segment = result.code_segment;
+      m_code_segments[result.code_segment].blocks.push_back(block);
+
+      // Only the native code is needed from now on.
+      ReleaseBlockInstructions(block);
+      std::vector<void (*)(CPU*)>().swap(block->interpreter_handlers);
+      continue;
+    }
+
+    // The block stays in the cached interpreter, and is queued again next time it runs. Later compiles may have
+    // failed on the same full segment, which only needs switching once.
+    if (result.code_buffer_overflow)
+    {
+      switch_code_segment |= (result.code_segment == m_active_code_segment);
+      continue;
+    }
+
+    Log_WarningPrintf("Failed to compile block at paddr %08X", block->key.eip_physical_address);
+    FlushBlock(block);
+  }
+
+  if (switch_code_segment)
+    SwitchCodeSegment();
+}
+
+void Backend::CompileThreadEntryPoint()
+{
+  std::unique_lock<std::mutex> lock(m_compile_mutex);
+  for (;;)
+  {
+    m_compile_queue_cv.wait(lock, [this]() { return m_compile_thread_shutdown || !m_compile_queue.empty(); });
+    if (m_compile_thread_shutdown)
+      break;
+
+    CompiledBlockResult result = {};
+    result.block = m_compile_queue.front();
+    result.code_segment = m_active_code_segment;
+    m_compile_queue.pop_front();
+    m_compiling_block = result.block;
+    lock.unlock();
+
+    CompileBlockCode(&result);
+
+    lock.lock();
+    m_compiling_block = nullptr;
+    m_compiled_blocks.push_back(result);
+    m_compiled_blocks_pending.store(true);
+    m_compile_done_cv.notify_all();
+  }
+}
+
+void Backend::CompileBlockCode(CompiledBlockResult* result)
+{
+  // Runs on the compile thread. The block can't be modified until the result is installed or cancelled.
+  const Block* block = result->block;
+  JitCodeBuffer* code_buffer = m_code_segments[result->code_segment].buffer.get();
+  if (code_buffer->GetFreeCodeSpace() < (block->instructions.size() * MaximumBytesPerInstruction))
+  {
+    // An empty segment that's still too small can't ever fit the block.
+    if (code_buffer->GetUsedCodeSpace() == 0)
+    {
+      Log_ErrorPrintf("Block %08X (%zu instructions) is too large for a code segment", block->GetPhysicalAddress(),
+                      block->instructions.size());
+      return;
+    }
+
+    Log_DevPrintf("Code segment %u is full, switching", result->code_segment);
+    result->code_buffer_overflow = true;
+    return;
+  }
+
+  CodeGenerator::AlignCodeBuffer(code_buffer);
+
+  CodeGenerator codegen(m_cpu, code_buffer, m_asm_functions, reinterpret_cast<BlockBase**>(&m_current_block),
+                        &m_fallback_operation_counts);
+  result->success = codegen.CompileBlock(block, &result->code_pointer, &result->code_size, result->link_slots.data(),
+                                         &result->link_slot_count);
 }
 
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
@@ -5,15 +5,39 @@
 #include "pce/cpu_x86/cpu_x86.h"
 #include "pce/cpu_x86/recompiler_thunks.h"
 #include "pce/cpu_x86/recompiler_types.h"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace CPU_X86::Recompiler {
 
 class Backend : public CodeCacheBackend
 {
 public:
-  Backend(CPU* cpu);
+  // Controls when blocks move between tiers. The defaults compile every block the first time it is seen.
+  struct TierThresholds
+  {
+    // Lookups of an uncached block before it is decoded. Until then it runs in the uncached interpreter.
+    u32 cache_threshold = 0;
+
+    // Executions in the cached interpreter before the block is queued for compiling.
+    u32 compile_threshold = 0;
+
+    // Invalidations after which a block stays in the cached interpreter. Zero never demotes blocks.
+    u32 demote_invalidations = 0;
+
+    // Executions of a conditional branch profiled in the cached interpreter before a trace can continue past it. Zero
+    // never forms traces.
+    u32 trace_threshold = 0;
+  };
+
+  Backend(CPU* cpu, const TierThresholds& tier_thresholds);
   ~Backend();
 
   void Execute() override;
@@ -21,23 +45,116 @@ public:
   void FlushCodeCache() override;
 
 protected:
+  // Blocks are compiled into one segment of the code buffer at a time. When it fills, the least recently executed
+  // segment is evicted and reused, rather than flushing every block.
+  static constexpr u32 NumCodeSegments = 16;
+  static constexpr u32 InvalidCodeSegment = NumCodeSegments;
+
+  // Traces only follow branches which go the other way in at most one of this many executions.
+  static constexpr u32 TraceBranchBias = 8;
+
+  // Uncached blocks are counted until they're cached. The counts are dropped when this many blocks are being counted,
+  // so a guest running lots of cold code doesn't grow the map without bound. Hot blocks quickly count up again.
+  static constexpr u32 MaxUncachedBlockLookups = 65536;
+
   struct Block : public BlockBase
   {
     Block(const BlockKey key_) : BlockBase(key_) {}
 
     BlockFunctionType code_pointer = nullptr;
     size_t code_size = 0;
+
+    std::array<BlockLinkSlot, MaxBlockLinkSlots> link_slots = {};
+    u32 link_slot_count = 0;
+
+    // Interpreter handlers, used to run the block while it is compiled in the background.
+    std::vector<void (*)(CPU*)> interpreter_handlers;
+
+    // Tiering state, kept across resets of the block.
+    u32 execution_count = 0;
+    u32 invalidation_count = 0;
+
+    // Directions of the conditional branch ending the block, counted while it runs in the cached interpreter.
+    u32 branch_taken_count = 0;
+    u32 branch_not_taken_count = 0;
+
+    // Code segment holding the compiled code, if any.
+    u32 code_segment = InvalidCodeSegment;
+    bool code_evicted = false;
+
+    bool IsBackgroundCompiling() const { return (flags & BlockFlags::BackgroundCompiling) != BlockFlags::None; }
+  };
+
+  // Output of the compile thread, installed into the block by the CPU thread at the next dispatch.
+  struct CompiledBlockResult
+  {
+    Block* block;
+    u32 code_segment;
+    BlockFunctionType code_pointer;
+    size_t code_size;
+    std::array<BlockLinkSlot, MaxBlockLinkSlots> link_slots;
+    u32 link_slot_count;
+    bool success;
+    bool code_buffer_overflow;
+  };
+
+  struct CodeSegment
+  {
+    std::unique_ptr<JitCodeBuffer> buffer;
+    std::vector<Block*> blocks;
+    u64 last_used = 0;
   };
 
   BlockBase* AllocateBlock(const BlockKey key) override;
   bool CompileBlock(BlockBase* block) override;
+  bool BuildInterpreterHandlers(Block* cblock);
+  bool ShouldCacheBlock(const BlockKey& key) override;
+  bool PredictTraceBranch(const BlockBase* block, VirtualMemoryAddress segment_eip, bool* taken) override;
   void ResetBlock(BlockBase* block) override;
   void FlushBlock(BlockBase* block, bool defer_destroy = false) override;
   void DestroyBlock(BlockBase* block) override;
+  void LinkBlockBase(BlockBase* from, BlockBase* to) override;
+  void UnlinkBlockBase(BlockBase* block) override;
+  void UnlinkBlockSuccessor(BlockBase* from, BlockBase* to) override;
+  void InvalidateBlock(BlockBase* block) override;
 
   void ExecuteBlock();
 
+  /// Returns true if the block has been invalidated too often to be worth compiling.
+  bool IsBlockDemoted(const Block* block) const;
+
+  /// Decodes a block again as a trace, if the branch ending it is biased. Call before the block is queued for compiling,
+  /// with the CPU at the start of the block. Returns false if decoding failed, leaving the block invalidated.
+  bool FormTrace(Block* block);
+
+  /// Drops the compiled code for a block, and removes it from its code segment.
+  void ReleaseBlockCode(Block* block);
+
+  /// Moves compiling on to an empty segment, evicting the least recently executed one if none are empty.
+  void SwitchCodeSegment();
+  void EvictCodeSegment(u32 index);
+
+  /// Runs the current block through the interpreter handlers, until its compiled code is installed.
+  void InterpretBlock();
+
+  /// Adds a decoded block to the compile thread's queue.
+  void QueueBackgroundCompile(Block* block);
+
+  /// Removes a block from the compile queue, waiting for the compile thread if it is currently compiling the block.
+  /// Any code generated for the block is discarded. Must be called before a queued block is modified or destroyed.
+  void CancelBackgroundCompile(Block* block);
+
+  /// Cancels all queued compiles and waits for the compile thread to become idle.
+  void CancelAllBackgroundCompiles();
+
+  /// Installs the code for blocks which have finished compiling since the last dispatch.
+  void InstallBackgroundCompiledBlocks();
+
+  void CompileThreadEntryPoint();
+  void CompileBlockCode(CompiledBlockResult* result);
+
   ASMFunctions m_asm_functions = {};
+  FallbackOperationCounts m_fallback_operation_counts = {};
 
 #ifdef Y_COMPILER_MSVC
 #pragma warning(push)
@@ -50,6 +167,23 @@ protected:
 
   Block* m_current_block = nullptr;
   std::unique_ptr<JitCodeBuffer> m_code_space;
-  bool m_code_buffer_overflow = false;
+  std::array<CodeSegment, NumCodeSegments> m_code_segments;
+  u64 m_code_segment_use_counter = 0;
+
+  TierThresholds m_tier_thresholds;
+  std::unordered_map<BlockKey, u32, BlockKeyHash> m_uncached_block_lookups;
+
+  // Background compiling. The compile thread only emits into the active code segment, and only reads blocks which
+  // are flagged as BackgroundCompiling. The CPU thread cancels the compile before modifying such a block.
+  u32 m_active_code_segment = 0;
+  std::thread m_compile_thread;
+  std::mutex m_compile_mutex;
+  std::condition_variable m_compile_queue_cv;
+  std::condition_variable m_compile_done_cv;
+  std::deque<Block*> m_compile_queue;
+  std::vector<CompiledBlockResult> m_compiled_blocks;
+  Block* m_compiling_block = nullptr;
+  std::atomic_bool m_compiled_blocks_pending{false};
+  bool m_compile_thread_shutdown = false;
 };
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
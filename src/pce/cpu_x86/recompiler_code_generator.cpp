@@ -4,6 +4,8 @@
 #include "debugger_interface.h"
 #include "decoder.h"
 #include "interpreter.h"
+#include <algorithm>
+#include <cinttypes>
 Log_SetChannel(CPU_X86::Recompiler);
 
 namespace CPU_X86::Recompiler {
@@ -14,15 +16,15 @@ namespace CPU_X86::Recompiler {
 // Threaded code generator?
 // Push functions per stack address mode
 // Only sync EIP on potentially-faulting instructions
-// Lazy flag calculation - store operands and opcode
 // TODO: Block leaking on invalidation
 // TODO: Remove physical references when block is destroyed
-// TODO: block linking
 // TODO: memcpy-like stuff from bus for validation
 // TODO: xor eax, eax -> invalidate and constant 0
 
-CodeGenerator::CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions)
-  : m_cpu(cpu), m_code_buffer(code_buffer), m_asm_functions(asm_functions), m_register_cache(*this),
+CodeGenerator::CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions,
+                             BlockBase** current_block_ptr, FallbackOperationCounts* fallback_counts)
+  : m_cpu(cpu), m_code_buffer(code_buffer), m_asm_functions(asm_functions), m_current_block_ptr(current_block_ptr),
+    m_fallback_counts(fallback_counts), m_register_cache(*this),
     m_emit(code_buffer->GetFreeCodeSpace(), code_buffer->GetFreeCodePointer())
 {
   InitHostRegs();
@@ -94,51 +96,132 @@ u32 CodeGenerator::CalculateSegmentRegisterOffset(Segment segment)
   return uint32(offsetof(CPU, m_registers.segment_selectors[0]) + (segment * sizeof(uint16)));
 }
 
-bool CodeGenerator::CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size)
+bool CodeGenerator::CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size,
+                                 BlockLinkSlot* out_link_slots, u32* out_link_slot_count)
 {
   // TODO: Align code buffer.
 
   m_block = block;
   m_block_start = block->instructions.data();
   m_block_end = block->instructions.data() + block->instructions.size();
+  m_link_slots = out_link_slots;
+  m_link_slot_count = GetBlockLinkSlotCount(block);
+
+  m_ir.Build(m_block_start, block->instructions.size());
+  if (m_cpu->m_recompiler_dump_ir)
+    m_ir.Dump("before optimization");
+  m_ir.Optimize();
+  if (m_cpu->m_recompiler_dump_ir)
+    m_ir.Dump("after optimization");
 
   EmitBeginBlock();
 
-  const Instruction* instruction = m_block_start;
-  while (instruction != m_block_end)
+  for (const IRInstruction& ir : m_ir)
   {
+    // Merged into the stack run before it.
+    if (ir.IsStackRunMember())
+      continue;
+
+    const Instruction* instruction = ir.instruction;
+    m_ir_instruction = &ir;
+    m_live_flags = ir.live_flags_after;
+
 #ifndef Y_BUILD_CONFIG_RELEASE
     SmallString disasm;
     Decoder::DisassembleToString(instruction, &disasm);
     Log_DebugPrintf("Compiling instruction '%08x: %s'", instruction->address, disasm.GetCharArray());
 #endif
 
-    if (!CompileInstruction(*instruction))
+    const bool result = ir.IsStackRunStart() ? Compile_StackRun(*instruction) : CompileInstruction(*instruction);
+    if (!result)
     {
+      m_ir_instruction = nullptr;
+      m_live_flags = StatusFlagsMask;
+      m_link_slots = nullptr;
       m_block_end = nullptr;
       m_block_start = nullptr;
       m_block = nullptr;
       return false;
     }
-
-    instruction++;
   }
 
   // Re-sync instruction pointers.
+  m_ir_instruction = nullptr;
+  m_live_flags = StatusFlagsMask;
   m_register_cache.FlushAllGuestRegisters(true);
   SyncInstructionPointer();
   EmitEndBlock();
 
+  // Slots only link the targets of the final exit. Side exits of traces always go back to the dispatcher.
+  if (m_link_slot_count > 0)
+  {
+    const Instruction& exit_instruction = m_block_end[-1];
+    m_link_slots[0].target_eip = GetRelativeBranchTarget(exit_instruction);
+    if (m_link_slot_count > 1)
+    {
+      m_link_slots[1].target_eip =
+        (exit_instruction.address + exit_instruction.length) & (m_block->Is32BitCode() ? 0xFFFFFFFFu : 0xFFFFu);
+    }
+  }
+
   FinalizeBlock(out_function_ptr, out_code_size);
 
   DebugAssert(m_register_cache.GetUsedHostRegisters() == 0);
 
+  *out_link_slot_count = m_link_slot_count;
+  m_link_slots = nullptr;
   m_block_end = nullptr;
   m_block_start = nullptr;
   m_block = nullptr;
   return true;
 }
 
+u32 CodeGenerator::GetBlockLinkSlotCount(const BlockBase* block)
+{
+  // Only exits with static targets can be chained. This guarantees the successor is in the same linear page as the
+  // block whenever EIP and the CS base match, so the page mapping can't have changed under the link.
+  if (!block->IsLinkable() || block->instructions.empty())
+    return 0;
+
+  const Instruction& instruction = block->instructions.back();
+  switch (instruction.operation)
+  {
+    case Operation_Jcc:
+    case Operation_JCXZ:
+    case Operation_LOOP:
+      return 2;
+
+    case Operation_JMP_Near:
+      return (instruction.operands[0].mode == OperandMode_Relative) ? 1 : 0;
+
+    // Calls have to go through the dispatcher to push the shadow return stack, otherwise the returns, which always
+    // reach the dispatcher, would pop entries that were never pushed.
+    case Operation_CALL_Near:
+      return 0;
+
+    default:
+      return 0;
+  }
+}
+
+u32 CodeGenerator::GetTraceSegmentLength(const Instruction* segment_start) const
+{
+  // Conditional branches only appear before the end of a block when it's a trace.
+  const Instruction* segment_end = segment_start;
+  while (segment_end != (m_block_end - 1) && segment_end->operation != Operation_Jcc)
+    segment_end++;
+
+  return static_cast<u32>(segment_end - segment_start) + 1;
+}
+
+void CodeGenerator::EmitAddInstructionsExecuted(u32 count)
+{
+  EmitAddCPUStructField(offsetof(CPU, m_execution_stats.code_cache_instructions_executed),
+                        Value::FromConstantU64(count));
+  EmitAddCPUStructField(offsetof(CPU, m_execution_stats.recompiled_instructions_executed),
+                        Value::FromConstantU64(count));
+}
+
 bool CodeGenerator::CompileInstruction(const Instruction& instruction)
 {
   if (IsInvalidInstruction(instruction))
@@ -194,9 +277,79 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
     case Operation_ADD:
     case Operation_SUB:
     case Operation_CMP:
+    case Operation_ADC:
+    case Operation_SBB:
       result = Compile_AddSub(instruction);
       break;
 
+    case Operation_NEG:
+      result = Compile_NEG(instruction);
+      break;
+
+    case Operation_MUL:
+    case Operation_IMUL:
+      result = Compile_MUL(instruction);
+      break;
+
+    case Operation_DIV:
+    case Operation_IDIV:
+      result = Compile_DIV(instruction);
+      break;
+
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+      result = Compile_MOVX(instruction);
+      break;
+
+    case Operation_XCHG:
+      result = Compile_XCHG(instruction);
+      break;
+
+    case Operation_SETcc:
+      result = Compile_SETcc(instruction);
+      break;
+
+    case Operation_BT:
+    case Operation_BTS:
+    case Operation_BTR:
+    case Operation_BTC:
+      result = Compile_BTx(instruction);
+      break;
+
+    case Operation_BSF:
+    case Operation_BSR:
+      result = Compile_BitScan(instruction);
+      break;
+
+    case Operation_ROL:
+    case Operation_ROR:
+    case Operation_RCL:
+    case Operation_RCR:
+      result = Compile_Rotate(instruction);
+      break;
+
+    case Operation_CBW:
+      result = Compile_CBW(instruction);
+      break;
+
+    case Operation_CWD:
+      result = Compile_CWD(instruction);
+      break;
+
+    case Operation_LAHF:
+      result = Compile_LAHF(instruction);
+      break;
+
+    case Operation_SAHF:
+      result = Compile_SAHF(instruction);
+      break;
+
+    case Operation_CLC:
+    case Operation_STC:
+    case Operation_CMC:
+      result = Compile_CarryFlag(instruction);
+      break;
+
     case Operation_INC:
     case Operation_DEC:
       result = Compile_IncDec(instruction);
@@ -230,6 +383,60 @@ bool CodeGenerator::CompileInstruction(const Instruction& instruction)
       result = Compile_RET_Near(instruction);
       break;
 
+    case Operation_LOOP:
+      result = Compile_LOOP(instruction);
+      break;
+
+    case Operation_LEAVE:
+      result = Compile_LEAVE(instruction);
+      break;
+
+    case Operation_ENTER:
+      result = Compile_ENTER(instruction);
+      break;
+
+    case Operation_FADD:
+    case Operation_FADDP:
+    case Operation_FSUB:
+    case Operation_FSUBP:
+    case Operation_FSUBR:
+    case Operation_FSUBRP:
+    case Operation_FMUL:
+    case Operation_FMULP:
+    case Operation_FDIV:
+    case Operation_FDIVP:
+    case Operation_FDIVR:
+    case Operation_FDIVRP:
+    case Operation_FIADD:
+    case Operation_FISUB:
+    case Operation_FISUBR:
+    case Operation_FIMUL:
+    case Operation_FIDIV:
+    case Operation_FIDIVR:
+    case Operation_FLD:
+    case Operation_FILD:
+    case Operation_FLD1:
+    case Operation_FLDZ:
+    case Operation_FST:
+    case Operation_FSTP:
+    case Operation_FXCH:
+    case Operation_FCHS:
+    case Operation_FABS:
+    case Operation_FCOM:
+    case Operation_FCOMP:
+    case Operation_FCOMPP:
+    case Operation_FSQRT:
+    case Operation_FSIN:
+    case Operation_FCOS:
+    case Operation_FSINCOS:
+    case Operation_FPTAN:
+    case Operation_FPATAN:
+    case Operation_F2XM1:
+    case Operation_FYL2X:
+    case Operation_FYL2XP1:
+      result = Compile_X87(instruction);
+      break;
+
     default:
       result = Compile_Fallback(instruction);
       break;
@@ -288,6 +495,26 @@ Value CodeGenerator::ConvertValueSize(const Value& value, OperandSize size, bool
       }
       break;
 
+      case OperandSize_64:
+      {
+        switch (value.size)
+        {
+          case OperandSize_8:
+            return Value::FromConstantU64(sign_extend ? SignExtend64(Truncate8(value.constant_value)) :
+                                                        ZeroExtend64(Truncate8(value.constant_value)));
+          case OperandSize_16:
+            return Value::FromConstantU64(sign_extend ? SignExtend64(Truncate16(value.constant_value)) :
+                                                        ZeroExtend64(Truncate16(value.constant_value)));
+          case OperandSize_32:
+            return Value::FromConstantU64(sign_extend ? SignExtend64(Truncate32(value.constant_value)) :
+                                                        ZeroExtend64(Truncate32(value.constant_value)));
+
+          default:
+            break;
+        }
+      }
+      break;
+
       default:
         break;
     }
@@ -407,6 +634,14 @@ Value CodeGenerator::ShlValues(const Value& lhs, const Value& rhs)
 
 void CodeGenerator::UpdateEFLAGS(Value&& merge_value, u32 clear_flags_mask, u32 copy_flags_mask, u32 set_flags_mask)
 {
+  // Status flags which are overwritten before anything reads them don't need to be computed.
+  const u32 dead_flags = StatusFlagsMask & ~m_live_flags;
+  clear_flags_mask &= ~dead_flags;
+  copy_flags_mask &= ~dead_flags;
+  set_flags_mask &= ~dead_flags;
+  if ((clear_flags_mask | copy_flags_mask | set_flags_mask) == 0)
+    return;
+
   Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
 
   const u32 bits_to_clear = clear_flags_mask | copy_flags_mask;
@@ -497,6 +732,13 @@ Value CodeGenerator::ReadOperand(const Instruction& instruction, size_t index, O
   const Instruction::Operand* operand = &instruction.operands[index];
 
   auto MakeRegisterAccess = [&](uint32 reg) -> Value {
+    // The value of the register is known, so it's used as an immediate.
+    if (index == 1 && m_ir_instruction && m_ir_instruction->HasConstantSource())
+    {
+      const Value val = Value::FromConstant(m_ir_instruction->source_value, operand->size);
+      return (output_size != operand->size) ? ConvertValueSize(val, output_size, sign_extend) : val;
+    }
+
     switch (operand->size)
     {
       case OperandSize_8:
@@ -927,7 +1169,8 @@ uint32 CodeGenerator::GetConstantOperand(const Instruction* instruction, size_t
   }
 }
 
-void CodeGenerator::LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment)
+void CodeGenerator::EmitLoadSegmentMemoryThunk(Value* dest_value, OperandSize size, const Value& address,
+                                               Segment segment)
 {
   DebugAssert(address.size == OperandSize_32);
   switch (size)
@@ -946,7 +1189,7 @@ void CodeGenerator::LoadSegmentMemory(Value* dest_value, OperandSize size, const
   }
 }
 
-void CodeGenerator::StoreSegmentMemory(const Value& value, const Value& address, Segment segment)
+void CodeGenerator::EmitStoreSegmentMemoryThunk(const Value& value, const Value& address, Segment segment)
 {
   if (value.IsConstant())
   {
@@ -1076,15 +1319,39 @@ void CodeGenerator::SyncCurrentESP()
   EmitStoreCPUStructField(offsetof(CPU, m_current_ESP), m_register_cache.ReadGuestRegister(Reg32_ESP, false));
 }
 
-static std::array<u64, Operation_Count> s_fallback_operation_instruction_counts;
+void CodeGenerator::LogFallbackStatistics(const FallbackOperationCounts& counts)
+{
+  std::array<std::pair<u64, Operation>, Operation_Count> sorted_counts;
+  u64 total_count = 0;
+  for (u32 i = 0; i < Operation_Count; i++)
+  {
+    sorted_counts[i] = std::make_pair(counts[i], static_cast<Operation>(i));
+    total_count += counts[i];
+  }
+  if (total_count == 0)
+    return;
+
+  std::sort(sorted_counts.begin(), sorted_counts.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+  Log_InfoPrintf("%" PRIu64 " instructions executed through interpreter fallback:", total_count);
+  for (const auto& it : sorted_counts)
+  {
+    if (it.first == 0)
+      break;
+
+    Log_InfoPrintf("  %-12s %10" PRIu64 " (%.2f%%)", Decoder::GetOperationName(it.second), it.first,
+                   (static_cast<double>(it.first) * 100.0) / static_cast<double>(total_count));
+  }
+}
 
 bool CodeGenerator::Compile_Fallback(const Instruction& instruction)
 {
   InstructionPrologue(instruction, 0, true);
-  s_fallback_operation_instruction_counts[instruction.operation]++;
 
   // flush and invalidate all guest registers, since the fallback could change any of them
   m_register_cache.FlushAllGuestRegisters(true);
+  EmitIncrementCounter(&(*m_fallback_counts)[instruction.operation]);
 
   // set up the instruction data
   EmitStoreCPUStructField(offsetof(CPU, idata.bits64[0]), Value::FromConstantU64(instruction.data.bits64[0]));
@@ -1101,6 +1368,56 @@ bool CodeGenerator::Compile_Fallback(const Instruction& instruction)
   return true;
 }
 
+bool CodeGenerator::Compile_Folded(const Instruction& instruction, CycleCount cycles)
+{
+  // None of the flags are needed, and the result is either known or not needed either.
+  InstructionPrologue(instruction, cycles);
+  if (!m_ir_instruction->IsDeadResult())
+    WriteOperand(instruction, 0, Value::FromConstant(m_ir_instruction->result_value, instruction.operands[0].size));
+
+  return true;
+}
+
+bool CodeGenerator::Compile_StackRun(const Instruction& instruction)
+{
+  const bool is_push = (instruction.operation == Operation_PUSH);
+  InstructionPrologue(instruction, m_cpu->GetCycles(is_push ? CYCLES_PUSH_REG : CYCLES_POP_REG));
+
+  // The thunk works on the registers in the CPU struct, which the prologue has written back. It advances EIP for the
+  // rest of the run itself, so a fault part way through is still reported at the right instruction.
+  if (is_push)
+    m_register_cache.FlushGuestRegister(Reg32_ESP, true);
+  else
+    m_register_cache.FlushAllGuestRegisters(true);
+
+  EmitFunctionCall(nullptr, is_push ? &Thunks::PushRegisterRun : &Thunks::PopRegisterRun,
+                   m_register_cache.GetCPUPtr(), Value::FromConstantU32(m_ir_instruction->stack_run),
+                   Value::FromConstantU32(instruction.GetOperandSize()));
+  m_register_cache.InvalidateGuestRegister(Reg32_EIP);
+
+  // All instructions in the run have the same length, so the delayed current EIP add is still correct.
+  SyncCurrentESP();
+  return true;
+}
+
+bool CodeGenerator::Compile_X87(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, 0, true);
+
+  // These only touch the FPU state and memory, so unlike the generic fallback the guest registers stay cached across
+  // the call. They still have to be written back for the effective address and in case the instruction faults. The
+  // handler takes the host double path itself whenever the control word allows it.
+  m_register_cache.FlushAllGuestRegisters(false);
+
+  EmitStoreCPUStructField(offsetof(CPU, idata.bits64[0]), Value::FromConstantU64(instruction.data.bits64[0]));
+  EmitStoreCPUStructField(offsetof(CPU, idata.bits64[1]), Value::FromConstantU64(instruction.data.bits64[1]));
+
+  Interpreter::HandlerFunction handler = Interpreter::GetInterpreterHandlerForInstruction(&instruction);
+  DebugAssert(handler);
+  EmitFunctionCall(nullptr, handler, m_register_cache.GetCPUPtr());
+  return true;
+}
+
 bool CodeGenerator::Compile_NOP(const Instruction& instruction)
 {
   InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_NOP));
@@ -1110,6 +1427,9 @@ bool CodeGenerator::Compile_NOP(const Instruction& instruction)
 bool CodeGenerator::Compile_LEA(const Instruction& instruction)
 {
   InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_LEA));
+  if (m_ir_instruction->IsDeadResult())
+    return true;
+
   CalculateEffectiveAddress(instruction);
 
   // 16-bit leas need conversion
@@ -1137,6 +1457,9 @@ bool CodeGenerator::Compile_MOV(const Instruction& instruction)
     cycles = m_cpu->GetCyclesRM(CYCLES_MOV_REG_RM_MEM, instruction.ModRM_RM_IsReg());
 
   InstructionPrologue(instruction, cycles);
+  if (m_ir_instruction->IsDeadResult())
+    return true;
+
   CalculateEffectiveAddress(instruction);
   WriteOperand(instruction, 0, ReadOperand(instruction, 1, instruction.operands[1].size, false));
 
@@ -1166,10 +1489,13 @@ bool CodeGenerator::Compile_Bitwise(const Instruction& instruction)
   else
     Panic("Unknown mode");
 
-  // Special case for xor reg, reg.
-  if (instruction.operation == Operation_XOR && OperandRegistersMatch(instruction, 0, 1))
+  if (m_ir_instruction->IsDeadResult() || m_ir_instruction->HasConstantResult())
   {
-    // Register contains zero, eflags has PF and ZF set.
+    Compile_Folded(instruction, cycles);
+  }
+  else if (instruction.operation == Operation_XOR && OperandRegistersMatch(instruction, 0, 1))
+  {
+    // xor reg, reg: register contains zero, eflags has PF and ZF set.
     InstructionPrologue(instruction, cycles);
     CalculateEffectiveAddress(instruction);
     WriteOperand(instruction, 0, Value::FromConstant(0, instruction.operands[0].size));
@@ -1181,7 +1507,6 @@ bool CodeGenerator::Compile_Bitwise(const Instruction& instruction)
   }
   else
   {
-    // TODO: constant folding here
     if (!Compile_Bitwise_Impl(instruction, cycles))
       return Compile_Fallback(instruction);
   }
@@ -1279,9 +1604,9 @@ bool CodeGenerator::Compile_AddSub(const Instruction& instruction)
   else
     Panic("Unknown mode");
 
-  // TODO: constant folding here
-
-  if (!Compile_AddSub_Impl(instruction, cycles))
+  if (m_ir_instruction->IsDeadResult() || m_ir_instruction->HasConstantResult())
+    Compile_Folded(instruction, cycles);
+  else if (!Compile_AddSub_Impl(instruction, cycles))
     return Compile_Fallback(instruction);
 
   if (OperandIsESP(instruction, 0))
@@ -1300,7 +1625,9 @@ bool CodeGenerator::Compile_IncDec(const Instruction& instruction)
   else
     Panic("Unknown mode");
 
-  if (!Compile_IncDec_Impl(instruction, cycles))
+  if (m_ir_instruction->IsDeadResult() || m_ir_instruction->HasConstantResult())
+    Compile_Folded(instruction, cycles);
+  else if (!Compile_IncDec_Impl(instruction, cycles))
     return Compile_Fallback(instruction);
 
   if (OperandIsESP(instruction, 0))
@@ -1455,4 +1782,333 @@ bool CodeGenerator::Compile_RET_Near(const Instruction& instruction)
   return true;
 }
 
+bool CodeGenerator::Compile_NEG(const Instruction& instruction)
+{
+  CycleCount cycles = 0;
+  if (instruction.DestinationMode() == OperandMode_Register)
+    cycles = m_cpu->GetCycles(CYCLES_NEG_RM_REG);
+  else if (instruction.DestinationMode() == OperandMode_ModRM_RM)
+    cycles = m_cpu->GetCyclesRM(CYCLES_NEG_RM_MEM, instruction.ModRM_RM_IsReg());
+  else
+    Panic("Unknown mode");
+
+  if (!Compile_NEG_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_MUL(const Instruction& instruction)
+{
+  const OperandSize size = instruction.operands[0].size;
+  const bool is_reg = instruction.ModRM_RM_IsReg();
+
+  CycleCount cycles = 0;
+  if (instruction.operation == Operation_MUL)
+  {
+    cycles = m_cpu->GetCyclesRM((size == OperandSize_8) ?
+                                  CYCLES_MUL_8_RM_MEM :
+                                  ((size == OperandSize_16) ? CYCLES_MUL_16_RM_MEM : CYCLES_MUL_32_RM_MEM),
+                                is_reg);
+  }
+  else if (instruction.operands[2].mode != OperandMode_None)
+  {
+    // three-operand form
+    cycles = m_cpu->GetCyclesRM((size == OperandSize_16) ? CYCLES_IMUL_16_REG_RM_MEM : CYCLES_IMUL_32_REG_RM_MEM, is_reg);
+  }
+  else
+  {
+    cycles = m_cpu->GetCyclesRM((size == OperandSize_8) ?
+                                  CYCLES_IMUL_8_RM_MEM :
+                                  ((size == OperandSize_16) ? CYCLES_IMUL_16_RM_MEM : CYCLES_IMUL_32_RM_MEM),
+                                is_reg);
+  }
+
+  if (!Compile_MUL_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_DIV(const Instruction& instruction)
+{
+  const OperandSize size = instruction.operands[0].size;
+  const bool is_signed = (instruction.operation == Operation_IDIV);
+
+  CycleCount cycles;
+  switch (size)
+  {
+    case OperandSize_8:
+      cycles = m_cpu->GetCyclesRM(is_signed ? CYCLES_IDIV_8_RM_MEM : CYCLES_DIV_8_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    case OperandSize_16:
+      cycles = m_cpu->GetCyclesRM(is_signed ? CYCLES_IDIV_16_RM_MEM : CYCLES_DIV_16_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+    default:
+      cycles = m_cpu->GetCyclesRM(is_signed ? CYCLES_IDIV_32_RM_MEM : CYCLES_DIV_32_RM_MEM, instruction.ModRM_RM_IsReg());
+      break;
+  }
+
+  if (!Compile_DIV_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  return true;
+}
+
+bool CodeGenerator::Compile_MOVX(const Instruction& instruction)
+{
+  const bool sign_extend = (instruction.operation == Operation_MOVSX);
+  const CycleCount cycles = m_cpu->GetCyclesRM(sign_extend ? CYCLES_MOVSX_REG_RM_MEM : CYCLES_MOVZX_REG_RM_MEM,
+                                               instruction.ModRM_RM_IsReg());
+
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+  WriteOperand(instruction, 0, ReadOperand(instruction, 1, instruction.operands[0].size, sign_extend));
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_XCHG(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCyclesRM(CYCLES_XCHG_REG_RM_MEM, instruction.ModRM_RM_IsReg()));
+  CalculateEffectiveAddress(instruction);
+
+  // Writing the first operand can change the host register the second is cached in, so take a copy of the first.
+  const OperandSize size = instruction.operands[0].size;
+  Value value0 = ReadOperand(instruction, 0, size, false);
+  if (!value0.IsConstant() && !value0.IsScratch())
+  {
+    Value temp = m_register_cache.AllocateScratch(size);
+    EmitCopyValue(temp.host_reg, value0);
+    value0 = std::move(temp);
+  }
+
+  // In the memory version, memory is op0 and must be written first.
+  WriteOperand(instruction, 0, ReadOperand(instruction, 1, size, false));
+  WriteOperand(instruction, 1, std::move(value0));
+
+  if (OperandIsESP(instruction, 0) || OperandIsESP(instruction, 1))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_SETcc(const Instruction& instruction)
+{
+  const CycleCount cycles = m_cpu->GetCyclesRM(CYCLES_SETcc_RM_MEM, instruction.ModRM_RM_IsReg());
+  if (!Compile_SETcc_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  return true;
+}
+
+bool CodeGenerator::Compile_BTx(const Instruction& instruction)
+{
+  const bool is_bt = (instruction.operation == Operation_BT);
+  CycleCount cycles;
+  if (instruction.SourceMode() == OperandMode_Immediate)
+    cycles = m_cpu->GetCyclesRM(is_bt ? CYCLES_BT_RM_MEM_IMM : CYCLES_BTx_RM_MEM_IMM, instruction.ModRM_RM_IsReg());
+  else
+    cycles = m_cpu->GetCyclesRM(is_bt ? CYCLES_BT_RM_MEM_REG : CYCLES_BTx_RM_MEM_REG, instruction.ModRM_RM_IsReg());
+
+  if (!Compile_BTx_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_BitScan(const Instruction& instruction)
+{
+  const CycleCount cycles = m_cpu->GetCycles(CYCLES_BSF_BASE) + m_cpu->GetCycles(CYCLES_BSF_N);
+  if (!Compile_BitScan_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_Rotate(const Instruction& instruction)
+{
+  const bool through_carry = (instruction.operation == Operation_RCL || instruction.operation == Operation_RCR);
+  const CycleCount cycles =
+    m_cpu->GetCyclesRM(through_carry ? CYCLES_RCL_RM_MEM : CYCLES_ROL_RM_MEM, instruction.ModRM_RM_IsReg());
+
+  if (!Compile_Rotate_Impl(instruction, cycles))
+    return Compile_Fallback(instruction);
+
+  if (OperandIsESP(instruction, 0))
+    SyncCurrentESP();
+
+  return true;
+}
+
+bool CodeGenerator::Compile_CBW(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_CBW));
+
+  if (instruction.GetOperandSize() == OperandSize_16)
+  {
+    // AX <- sign-extend(AL)
+    Value value = m_register_cache.ReadGuestRegister(Reg8_AL);
+    m_register_cache.WriteGuestRegister(Reg16_AX, ConvertValueSize(value, OperandSize_16, true));
+  }
+  else
+  {
+    // EAX <- sign-extend(AX)
+    Value value = m_register_cache.ReadGuestRegister(Reg16_AX);
+    m_register_cache.WriteGuestRegister(Reg32_EAX, ConvertValueSize(value, OperandSize_32, true));
+  }
+
+  return true;
+}
+
+bool CodeGenerator::Compile_CWD(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_CWD));
+
+  // (E)DX <- sign of (E)AX
+  const OperandSize size = instruction.GetOperandSize();
+  const u32 sign_shift = (size == OperandSize_16) ? 15 : 31;
+  Value value = m_register_cache.ReadGuestRegister(size, static_cast<u8>(Reg32_EAX));
+  if (value.IsConstant())
+  {
+    const bool sign = ((value.constant_value >> sign_shift) & 1) != 0;
+    m_register_cache.WriteGuestRegister(
+      size, static_cast<u8>(Reg32_EDX),
+      Value::FromConstant(sign ? ((size == OperandSize_16) ? 0xFFFF : 0xFFFFFFFF) : 0, size));
+  }
+  else
+  {
+    Value sign = m_register_cache.AllocateScratch(size);
+    EmitCopyValue(sign.host_reg, value);
+    EmitSar(sign.host_reg, size, Value::FromConstantU8(Truncate8(sign_shift)));
+    m_register_cache.WriteGuestRegister(size, static_cast<u8>(Reg32_EDX), std::move(sign));
+  }
+
+  return true;
+}
+
+bool CodeGenerator::Compile_LAHF(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_LAHF));
+
+  // AH <- low byte of EFLAGS
+  Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
+  m_register_cache.WriteGuestRegister(Reg8_AH, ConvertValueSize(eflags, OperandSize_8, false));
+  return true;
+}
+
+bool CodeGenerator::Compile_SAHF(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_SAHF));
+
+  Value ah = m_register_cache.ReadGuestRegister(Reg8_AH);
+  UpdateEFLAGS(ConvertValueSize(ah, OperandSize_32, false), 0, Flag_SF | Flag_ZF | Flag_AF | Flag_PF | Flag_CF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_CarryFlag(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_CLEAR_SET_FLAG));
+
+  Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
+  switch (instruction.operation)
+  {
+    case Operation_CLC:
+      EmitAnd(eflags.GetHostRegister(), Value::FromConstantU32(~Flag_CF));
+      break;
+
+    case Operation_STC:
+      EmitOr(eflags.GetHostRegister(), Value::FromConstantU32(Flag_CF));
+      break;
+
+    case Operation_CMC:
+      EmitXor(eflags.GetHostRegister(), Value::FromConstantU32(Flag_CF));
+      break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+
+  m_register_cache.WriteGuestRegister(Reg32_EFLAGS, std::move(eflags));
+  return true;
+}
+
+bool CodeGenerator::Compile_LOOP(const Instruction& instruction)
+{
+  const bool is_loopz = (instruction.operands[0].jump_condition != JumpCondition_Always);
+  return Compile_LOOP_Impl(instruction, m_cpu->GetCycles(is_loopz ? CYCLES_LOOPZ : CYCLES_LOOP));
+}
+
+bool CodeGenerator::Compile_LEAVE(const Instruction& instruction)
+{
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_LEAVE));
+
+  // ESP <- EBP, using the stack address size.
+  if (m_block->key.ss_size)
+    m_register_cache.WriteGuestRegister(Reg32_ESP, m_register_cache.ReadGuestRegister(Reg32_EBP));
+  else
+    m_register_cache.WriteGuestRegister(Reg16_SP, m_register_cache.ReadGuestRegister(Reg16_BP));
+
+  // EBP <- pop(), using the operand size.
+  const OperandSize size = instruction.GetOperandSize();
+  Value frame_pointer = GuestPop(size);
+  m_register_cache.WriteGuestRegister(size, static_cast<u8>(Reg32_EBP), std::move(frame_pointer));
+  SyncCurrentESP();
+  return true;
+}
+
+bool CodeGenerator::Compile_ENTER(const Instruction& instruction)
+{
+  // Nested procedures copy the frame pointers of the enclosing frames, leave those to the interpreter.
+  if (instruction.data.imm2_8 != 0)
+    return Compile_Fallback(instruction);
+
+  InstructionPrologue(instruction, m_cpu->GetCycles(CYCLES_ENTER));
+
+  // push(EBP)
+  const OperandSize size = instruction.GetOperandSize();
+  GuestPush(m_register_cache.ReadGuestRegister(size, static_cast<u8>(Reg32_EBP)));
+
+  // EBP <- ESP
+  m_register_cache.WriteGuestRegister(size, static_cast<u8>(Reg32_EBP),
+                                      m_register_cache.ReadGuestRegister(size, static_cast<u8>(Reg32_ESP)));
+
+  // ESP <- ESP - frame size, using the stack address size.
+  const u16 frame_size = instruction.data.imm16;
+  if (frame_size != 0)
+  {
+    if (m_block->key.ss_size)
+    {
+      Value esp = m_register_cache.ReadGuestRegister(Reg32_ESP, true, true);
+      EmitSub(esp.GetHostRegister(), Value::FromConstantU32(ZeroExtend32(frame_size)));
+      m_register_cache.WriteGuestRegister(Reg32_ESP, std::move(esp));
+    }
+    else
+    {
+      Value sp = m_register_cache.ReadGuestRegister(Reg16_SP, true, true);
+      EmitSub(sp.GetHostRegister(), Value::FromConstantU16(frame_size));
+      m_register_cache.WriteGuestRegister(Reg16_SP, std::move(sp));
+    }
+  }
+
+  SyncCurrentESP();
+  return true;
+}
+
 } // namespace CPU_X86::Recompiler
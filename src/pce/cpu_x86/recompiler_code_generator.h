@@ -2,10 +2,12 @@
 #include <array>
 #include <initializer_list>
 #include <utility>
+#include <vector>
 
 #include "common/jit_code_buffer.h"
 
 #include "pce/cpu_x86/decoder.h"
+#include "pce/cpu_x86/recompiler_ir.h"
 #include "pce/cpu_x86/recompiler_register_cache.h"
 #include "pce/cpu_x86/recompiler_thunks.h"
 #include "pce/cpu_x86/types.h"
@@ -28,7 +30,8 @@ namespace CPU_X86::Recompiler {
 class CodeGenerator
 {
 public:
-  CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions);
+  CodeGenerator(CPU* cpu, JitCodeBuffer* code_buffer, const ASMFunctions& asm_functions,
+                BlockBase** current_block_ptr, FallbackOperationCounts* fallback_counts);
   ~CodeGenerator();
 
   static u32 CalculateRegisterOffset(Reg8 reg);
@@ -41,7 +44,18 @@ public:
   RegisterCache& GetRegisterCache() { return m_register_cache; }
   CodeEmitter& GetCodeEmitter() { return m_emit; }
 
-  bool CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size);
+  bool CompileBlock(const BlockBase* block, BlockFunctionType* out_function_ptr, size_t* out_code_size,
+                    BlockLinkSlot* out_link_slots, u32* out_link_slot_count);
+
+  /// Returns the number of link slots emitted at the end of the block, i.e. the number of static exit targets.
+  static u32 GetBlockLinkSlotCount(const BlockBase* block);
+
+  /// Patches a link slot to jump directly to code when EIP and the CS base match. UnlinkBlockSlot reverts it.
+  static void LinkBlockSlot(BlockLinkSlot* slot, u32 eip, u32 cs_base, BlockBase* block, const void* code);
+  static void UnlinkBlockSlot(BlockLinkSlot* slot);
+
+  /// Logs how many times each operation was executed through the interpreter fallback.
+  static void LogFallbackStatistics(const FallbackOperationCounts& counts);
 
   //////////////////////////////////////////////////////////////////////////
   // Helpers
@@ -54,6 +68,15 @@ public:
   //////////////////////////////////////////////////////////////////////////
   void EmitBeginBlock();
   void EmitEndBlock();
+  void EmitBlockLinkSlots();
+
+  /// Returns to the dispatcher from the middle of a trace. The register cache is left as it was, so the code which
+  /// follows is compiled as though the exit wasn't taken. Guest registers must already be flushed.
+  void EmitSideExit();
+
+  /// Adds to the executed instruction counts. Traces count each segment when it's entered, as side exits skip the rest.
+  void EmitAddInstructionsExecuted(u32 count);
+
   void FinalizeBlock(BlockFunctionType* out_function_ptr, size_t* out_code_size);
 
   void EmitSignExtend(HostReg to_reg, OperandSize to_size, HostReg from_reg, OperandSize from_size);
@@ -61,6 +84,8 @@ public:
   void EmitCopyValue(HostReg to_reg, const Value& value);
   void EmitAdd(HostReg to_reg, const Value& value);
   void EmitSub(HostReg to_reg, const Value& value);
+  void EmitAdc(HostReg to_reg, const Value& value);
+  void EmitSbb(HostReg to_reg, const Value& value);
   void EmitCmp(HostReg to_reg, const Value& value);
   void EmitInc(HostReg to_reg, OperandSize size);
   void EmitDec(HostReg to_reg, OperandSize size);
@@ -72,12 +97,14 @@ public:
   void EmitXor(HostReg to_reg, const Value& value);
   void EmitTest(HostReg to_reg, const Value& value);
   void EmitNot(HostReg to_reg, OperandSize size);
+  void EmitNeg(HostReg to_reg, OperandSize size);
 
   void EmitLoadGuestRegister(HostReg host_reg, OperandSize guest_size, u8 guest_reg);
   void EmitStoreGuestRegister(OperandSize guest_size, u8 guest_reg, const Value& value);
   void EmitLoadCPUStructField(HostReg host_reg, OperandSize guest_size, u32 offset);
   void EmitStoreCPUStructField(u32 offset, const Value& value);
   void EmitAddCPUStructField(u32 offset, const Value& value);
+  void EmitIncrementCounter(u64* counter);
 
   u32 PrepareStackForCall();
   void RestoreStackAfterCall(u32 adjust_size);
@@ -130,6 +157,10 @@ public:
 #if defined(Y_CPU_X64)
   void ReadFlagsFromHost(Value* value);
   Value ReadFlagsFromHost();
+
+  /// Reads the host flags only if any of copy_flags_mask is live after the current instruction, otherwise returns an
+  /// empty value. UpdateEFLAGS drops the dead bits from its masks, so the empty value is never merged.
+  Value ReadLiveFlagsFromHost(u32 copy_flags_mask);
 #endif
 
   // REP generator.
@@ -140,7 +171,7 @@ public:
   Value MulValues(const Value& lhs, const Value& rhs);
   Value ShlValues(const Value& lhs, const Value& rhs);
 
-  // EFLAGS merging.
+  // EFLAGS merging. Status flags which are dead after the current instruction are not updated.
   void UpdateEFLAGS(Value&& merge_value, u32 clear_flags_mask, u32 copy_flags_mask, u32 set_flags_mask);
 
   // Guest stack operations.
@@ -150,6 +181,8 @@ public:
   void GuestBranch(const Value& branch_address);
 
 private:
+  static constexpr u32 StatusFlagsMask = IRBlock::StatusFlagsMask;
+
   // Host register setup
   void InitHostRegs();
 
@@ -159,6 +192,9 @@ private:
   //////////////////////////////////////////////////////////////////////////
   // Code Generation Helpers
   //////////////////////////////////////////////////////////////////////////
+  /// Returns the number of instructions from segment_start up to and including the next side exit, or the block end.
+  u32 GetTraceSegmentLength(const Instruction* segment_start) const;
+
   void CalculateEffectiveAddress(const Instruction& instruction);
   Value CalculateOperandMemoryAddress(const Instruction& instruction, size_t index);
   Value CalculateJumpTarget(const Instruction& instruction, size_t index = 0);
@@ -167,6 +203,8 @@ private:
   Value WriteOperand(const Instruction& instruction, size_t index, Value&& value);
   void LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment);
   void StoreSegmentMemory(const Value& value, const Value& address, Segment segment);
+  void EmitLoadSegmentMemoryThunk(Value* dest_value, OperandSize size, const Value& address, Segment segment);
+  void EmitStoreSegmentMemoryThunk(const Value& value, const Value& address, Segment segment);
   void RaiseException(u32 exception, const Value& ec = Value::FromConstantU32(0));
   void InstructionPrologue(const Instruction& instruction, CycleCount cycles, bool force_sync = false);
   void SyncInstructionPointer();
@@ -177,6 +215,12 @@ private:
   Value GetZeroFlag(const Value& value);
   Value GetParityFlag(const Value& value);
 
+  /// Emits the inline segment check, TLB probe and RAM page lookup for a guest memory access. On success,
+  /// [ram_ptr_reg + offset_reg] addresses the data in host memory. Anything which can't be handled inline (faults,
+  /// TLB misses, MMIO, code pages, page-crossing accesses) branches to slow_path_label.
+  void EmitGuestMemoryLookup(HostReg ram_ptr_reg, HostReg offset_reg, HostReg temp_reg, const Value& address,
+                             Segment segment, AccessType access, u32 access_size, Xbyak::Label& slow_path_label);
+
   /// Loads the guest flags into the corresponding host flags. Only guaranteed to load sign/overflow/carry/zero.
   /// The mask specifies which bits *must* be loaded. Other bits may be loaded as an optimization.
   void CopyGuestFlagsToHostFlags(u32 mask);
@@ -186,6 +230,8 @@ private:
   //////////////////////////////////////////////////////////////////////////
   bool CompileInstruction(const Instruction& instruction);
   bool Compile_Fallback(const Instruction& instruction);
+  bool Compile_Folded(const Instruction& instruction, CycleCount cycles);
+  bool Compile_StackRun(const Instruction& instruction);
   bool Compile_NOP(const Instruction& instruction);
   bool Compile_LEA(const Instruction& instruction);
   bool Compile_MOV(const Instruction& instruction);
@@ -209,6 +255,32 @@ private:
   bool Compile_CALL_Near(const Instruction& instruction);
   bool Compile_RET_Near(const Instruction& instruction);
   bool Compile_String(const Instruction& instruction);
+  bool Compile_NEG(const Instruction& instruction);
+  bool Compile_NEG_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_MUL(const Instruction& instruction);
+  bool Compile_MUL_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_DIV(const Instruction& instruction);
+  bool Compile_DIV_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_MOVX(const Instruction& instruction);
+  bool Compile_XCHG(const Instruction& instruction);
+  bool Compile_SETcc(const Instruction& instruction);
+  bool Compile_SETcc_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_BTx(const Instruction& instruction);
+  bool Compile_BTx_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_BitScan(const Instruction& instruction);
+  bool Compile_BitScan_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_Rotate(const Instruction& instruction);
+  bool Compile_Rotate_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_CBW(const Instruction& instruction);
+  bool Compile_CWD(const Instruction& instruction);
+  bool Compile_LAHF(const Instruction& instruction);
+  bool Compile_SAHF(const Instruction& instruction);
+  bool Compile_CarryFlag(const Instruction& instruction);
+  bool Compile_LOOP(const Instruction& instruction);
+  bool Compile_LOOP_Impl(const Instruction& instruction, CycleCount cycles);
+  bool Compile_LEAVE(const Instruction& instruction);
+  bool Compile_ENTER(const Instruction& instruction);
+  bool Compile_X87(const Instruction& instruction);
 
   CPU* m_cpu;
   JitCodeBuffer* m_code_buffer;
@@ -216,6 +288,13 @@ private:
   const BlockBase* m_block = nullptr;
   const Instruction* m_block_start = nullptr;
   const Instruction* m_block_end = nullptr;
+  BlockBase** m_current_block_ptr;
+  FallbackOperationCounts* m_fallback_counts;
+  BlockLinkSlot* m_link_slots = nullptr;
+  u32 m_link_slot_count = 0;
+  IRBlock m_ir;
+  const IRInstruction* m_ir_instruction = nullptr;
+  u32 m_live_flags = StatusFlagsMask;
   RegisterCache m_register_cache;
   CodeEmitter m_emit;
 
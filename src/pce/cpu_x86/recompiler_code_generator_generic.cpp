@@ -5,6 +5,24 @@ namespace CPU_X86::Recompiler {
 
 #if !defined(Y_CPU_X64)
 void CodeGenerator::AlignCodeBuffer(JitCodeBuffer* code_buffer) {}
+void CodeGenerator::EmitBlockLinkSlots() {}
+void CodeGenerator::EmitSideExit() {}
+void CodeGenerator::LinkBlockSlot(BlockLinkSlot* slot, u32 eip, u32 cs_base, BlockBase* block, const void* code) {}
+void CodeGenerator::UnlinkBlockSlot(BlockLinkSlot* slot) {}
+#endif
+
+#if !defined(Y_CPU_X64)
+
+void CodeGenerator::LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment)
+{
+  EmitLoadSegmentMemoryThunk(dest_value, size, address, segment);
+}
+
+void CodeGenerator::StoreSegmentMemory(const Value& value, const Value& address, Segment segment)
+{
+  EmitStoreSegmentMemoryThunk(value, address, segment);
+}
+
 #endif
 
 #if !defined(Y_CPU_X64)
@@ -122,4 +140,48 @@ bool CodeGenerator::Compile_Jcc(const Instruction& instruction, CycleCount cycle
 
 #endif
 
+#if !defined(Y_CPU_X64)
+
+bool CodeGenerator::Compile_NEG_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_MUL_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_DIV_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_SETcc_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_BTx_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_BitScan_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_Rotate_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+bool CodeGenerator::Compile_LOOP_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  return Compile_Fallback(instruction);
+}
+
+#endif
+
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
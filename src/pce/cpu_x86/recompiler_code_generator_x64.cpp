@@ -1,6 +1,7 @@
 #include "interpreter.h"
 #include "recompiler_code_generator.h"
 #include "recompiler_thunks.h"
+#include <cstring>
 
 namespace CPU_X86::Recompiler {
 
@@ -68,6 +69,22 @@ static const Xbyak::Reg64 GetHostReg64(const Value& value)
   return Xbyak::Reg64(value.host_reg);
 }
 
+static const Xbyak::Reg GetHostReg(const Value& value)
+{
+  DebugAssert(value.IsInHostRegister());
+  switch (value.size)
+  {
+    case OperandSize_8:
+      return GetHostReg8(value.host_reg);
+    case OperandSize_16:
+      return GetHostReg16(value.host_reg);
+    case OperandSize_32:
+      return GetHostReg32(value.host_reg);
+    default:
+      return GetHostReg64(value.host_reg);
+  }
+}
+
 static const Xbyak::Reg64 GetCPUPtrReg()
 {
   return GetHostReg64(RCPUPTR);
@@ -149,6 +166,14 @@ void CodeGenerator::EmitBeginBlock()
   DebugAssert(cpu_reg_allocated);
   m_emit.mov(GetCPUPtrReg(), GetHostReg64(RARG1));
 
+  // Blocks can be entered from another block's exit, so keep the dispatcher's current block and the stats up to date
+  // here rather than in the dispatcher. rax/rdx are never allocated, and aren't arguments to the block.
+  m_emit.mov(m_emit.rax, reinterpret_cast<size_t>(m_current_block_ptr));
+  m_emit.mov(m_emit.rdx, reinterpret_cast<size_t>(m_block));
+  m_emit.mov(m_emit.qword[m_emit.rax], m_emit.rdx);
+  EmitAddCPUStructField(offsetof(CPU, m_execution_stats.code_cache_blocks_executed), Value::FromConstantU64(1));
+  EmitAddInstructionsExecuted(GetTraceSegmentLength(m_block_start));
+
   // Copy {EIP,ESP} to m_current_{EIP,ESP}
   SyncCurrentEIP();
   SyncCurrentESP();
@@ -156,12 +181,92 @@ void CodeGenerator::EmitBeginBlock()
 
 void CodeGenerator::EmitEndBlock()
 {
+  // The CPU pointer register is restored by the pops, so the link slots use the argument register instead.
+  if (m_link_slot_count > 0)
+    m_emit.mov(GetHostReg64(RARG1), GetCPUPtrReg());
+
   m_register_cache.FreeHostReg(RCPUPTR);
   m_register_cache.PopCalleeSavedRegisters();
 
+  if (m_link_slot_count > 0)
+    EmitBlockLinkSlots();
+
+  m_emit.ret();
+}
+
+void CodeGenerator::EmitSideExit()
+{
+  EmitAddCPUStructField(offsetof(CPU, m_execution_stats.code_cache_trace_side_exits), Value::FromConstantU64(1));
+  EmitStoreCPUStructField(offsetof(CPU, m_trace_side_exit), Value::FromConstantU8(1));
+  m_register_cache.PopCalleeSavedRegisters(false);
   m_emit.ret();
 }
 
+void CodeGenerator::EmitBlockLinkSlots()
+{
+  // The callee-saved registers have been restored at this point, so jumping to the entry of the next block is
+  // equivalent to the dispatcher calling it, with the return address still on the stack.
+  const Xbyak::Reg64 cpu_reg = GetHostReg64(RARG1);
+  Xbyak::Label exit_label, no_interrupt_label;
+
+  // Leave generated code when an event is due.
+  m_emit.mov(m_emit.rax, m_emit.qword[cpu_reg + offsetof(CPU, m_execution_downcount)]);
+  m_emit.sub(m_emit.rax, m_emit.qword[cpu_reg + offsetof(CPU, m_pending_cycles)]);
+  m_emit.jle(exit_label, CodeEmitter::T_NEAR);
+
+  // The dispatcher has to handle interrupts and single-stepping.
+  m_emit.test(m_emit.dword[cpu_reg + offsetof(CPU, m_registers.EFLAGS.bits)], Flag_TF);
+  m_emit.jnz(exit_label, CodeEmitter::T_NEAR);
+  m_emit.cmp(m_emit.byte[cpu_reg + offsetof(CPU, m_irq_state)], 0);
+  m_emit.je(no_interrupt_label);
+  m_emit.test(m_emit.dword[cpu_reg + offsetof(CPU, m_registers.EFLAGS.bits)], Flag_IF);
+  m_emit.jnz(exit_label, CodeEmitter::T_NEAR);
+  m_emit.L(no_interrupt_label);
+
+  m_emit.mov(m_emit.eax, m_emit.dword[cpu_reg + offsetof(CPU, m_registers.EIP)]);
+  m_emit.mov(m_emit.edx, m_emit.dword[cpu_reg + offsetof(CPU, m_segment_cache[Segment_CS].base_address)]);
+
+  // The immediates are placeholders which are large enough to force 32-bit encodings, they're patched on link.
+  std::array<u8*, MaxBlockLinkSlots> jump_displacements{};
+  for (u32 i = 0; i < m_link_slot_count; i++)
+  {
+    BlockLinkSlot& slot = m_link_slots[i];
+    Xbyak::Label next_slot_label;
+
+    m_emit.cmp(m_emit.eax, 0x7FFFFFFF);
+    slot.eip_immediate = m_emit.getCurr<u8*>() - sizeof(u32);
+    m_emit.jne(next_slot_label);
+    m_emit.cmp(m_emit.edx, 0x7FFFFFFF);
+    slot.cs_base_immediate = m_emit.getCurr<u8*>() - sizeof(u32);
+    m_emit.jne(next_slot_label);
+    m_emit.jmp(exit_label, CodeEmitter::T_NEAR);
+    slot.jump_displacement = m_emit.getCurr<u8*>() - sizeof(u32);
+    slot.linked_block = nullptr;
+    m_emit.L(next_slot_label);
+  }
+
+  m_emit.L(exit_label);
+  for (u32 i = 0; i < m_link_slot_count; i++)
+    m_link_slots[i].unlinked_target = m_emit.getCurr<const void*>();
+}
+
+void CodeGenerator::LinkBlockSlot(BlockLinkSlot* slot, u32 eip, u32 cs_base, BlockBase* block, const void* code)
+{
+  const s32 displacement = static_cast<s32>(reinterpret_cast<const u8*>(code) - (slot->jump_displacement + 4));
+  std::memcpy(slot->eip_immediate, &eip, sizeof(eip));
+  std::memcpy(slot->cs_base_immediate, &cs_base, sizeof(cs_base));
+  std::memcpy(slot->jump_displacement, &displacement, sizeof(displacement));
+  slot->linked_block = block;
+}
+
+void CodeGenerator::UnlinkBlockSlot(BlockLinkSlot* slot)
+{
+  const s32 displacement =
+    static_cast<s32>(reinterpret_cast<const u8*>(slot->unlinked_target) - (slot->jump_displacement + 4));
+  std::memcpy(slot->jump_displacement, &displacement, sizeof(displacement));
+  slot->linked_block = nullptr;
+}
+
 void CodeGenerator::FinalizeBlock(BlockFunctionType* out_function_ptr, size_t* out_code_size)
 {
   m_emit.ready();
@@ -201,6 +306,23 @@ void CodeGenerator::EmitSignExtend(HostReg to_reg, OperandSize to_size, HostReg
       }
     }
     break;
+
+    case OperandSize_64:
+    {
+      switch (from_size)
+      {
+        case OperandSize_8:
+          m_emit.movsx(GetHostReg64(to_reg), GetHostReg8(from_reg));
+          return;
+        case OperandSize_16:
+          m_emit.movsx(GetHostReg64(to_reg), GetHostReg16(from_reg));
+          return;
+        case OperandSize_32:
+          m_emit.movsxd(GetHostReg64(to_reg), GetHostReg32(from_reg));
+          return;
+      }
+    }
+    break;
   }
 
   Panic("Unknown sign-extend combination");
@@ -234,6 +356,24 @@ void CodeGenerator::EmitZeroExtend(HostReg to_reg, OperandSize to_size, HostReg
       }
     }
     break;
+
+    case OperandSize_64:
+    {
+      // 32-bit operations implicitly zero the upper half of the register.
+      switch (from_size)
+      {
+        case OperandSize_8:
+          m_emit.movzx(GetHostReg32(to_reg), GetHostReg8(from_reg));
+          return;
+        case OperandSize_16:
+          m_emit.movzx(GetHostReg32(to_reg), GetHostReg16(from_reg));
+          return;
+        case OperandSize_32:
+          m_emit.mov(GetHostReg32(to_reg), GetHostReg32(from_reg));
+          return;
+      }
+    }
+    break;
   }
 
   Panic("Unknown sign-extend combination");
@@ -406,6 +546,84 @@ void CodeGenerator::EmitSub(HostReg to_reg, const Value& value)
   }
 }
 
+void CodeGenerator::EmitAdc(HostReg to_reg, const Value& value)
+{
+  DebugAssert(value.IsConstant() || value.IsInHostRegister());
+
+  switch (value.size)
+  {
+    case OperandSize_8:
+    {
+      if (value.IsConstant())
+        m_emit.adc(GetHostReg8(to_reg), SignExtend32(Truncate8(value.constant_value)));
+      else
+        m_emit.adc(GetHostReg8(to_reg), GetHostReg8(value.host_reg));
+    }
+    break;
+
+    case OperandSize_16:
+    {
+      if (value.IsConstant())
+        m_emit.adc(GetHostReg16(to_reg), SignExtend32(Truncate16(value.constant_value)));
+      else
+        m_emit.adc(GetHostReg16(to_reg), GetHostReg16(value.host_reg));
+    }
+    break;
+
+    case OperandSize_32:
+    {
+      if (value.IsConstant())
+        m_emit.adc(GetHostReg32(to_reg), Truncate32(value.constant_value));
+      else
+        m_emit.adc(GetHostReg32(to_reg), GetHostReg32(value.host_reg));
+    }
+    break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+}
+
+void CodeGenerator::EmitSbb(HostReg to_reg, const Value& value)
+{
+  DebugAssert(value.IsConstant() || value.IsInHostRegister());
+
+  switch (value.size)
+  {
+    case OperandSize_8:
+    {
+      if (value.IsConstant())
+        m_emit.sbb(GetHostReg8(to_reg), SignExtend32(Truncate8(value.constant_value)));
+      else
+        m_emit.sbb(GetHostReg8(to_reg), GetHostReg8(value.host_reg));
+    }
+    break;
+
+    case OperandSize_16:
+    {
+      if (value.IsConstant())
+        m_emit.sbb(GetHostReg16(to_reg), SignExtend32(Truncate16(value.constant_value)));
+      else
+        m_emit.sbb(GetHostReg16(to_reg), GetHostReg16(value.host_reg));
+    }
+    break;
+
+    case OperandSize_32:
+    {
+      if (value.IsConstant())
+        m_emit.sbb(GetHostReg32(to_reg), Truncate32(value.constant_value));
+      else
+        m_emit.sbb(GetHostReg32(to_reg), GetHostReg32(value.host_reg));
+    }
+    break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+}
+
 void CodeGenerator::EmitCmp(HostReg to_reg, const Value& value)
 {
   DebugAssert(value.IsConstant() || value.IsInHostRegister());
@@ -918,6 +1136,31 @@ void CodeGenerator::EmitNot(HostReg to_reg, OperandSize size)
   }
 }
 
+void CodeGenerator::EmitNeg(HostReg to_reg, OperandSize size)
+{
+  switch (size)
+  {
+    case OperandSize_8:
+      m_emit.neg(GetHostReg8(to_reg));
+      break;
+
+    case OperandSize_16:
+      m_emit.neg(GetHostReg16(to_reg));
+      break;
+
+    case OperandSize_32:
+      m_emit.neg(GetHostReg32(to_reg));
+      break;
+
+    case OperandSize_64:
+      m_emit.neg(GetHostReg64(to_reg));
+      break;
+
+    default:
+      break;
+  }
+}
+
 u32 CodeGenerator::PrepareStackForCall()
 {
   // we assume that the stack is unaligned at this point
@@ -1128,6 +1371,14 @@ Value CodeGenerator::ReadFlagsFromHost()
   return temp;
 }
 
+Value CodeGenerator::ReadLiveFlagsFromHost(u32 copy_flags_mask)
+{
+  if ((copy_flags_mask & m_live_flags) == 0)
+    return Value();
+
+  return ReadFlagsFromHost();
+}
+
 void CodeGenerator::EmitLoadGuestRegister(HostReg host_reg, OperandSize guest_size, u8 guest_reg)
 {
   switch (guest_size)
@@ -1337,6 +1588,13 @@ void CodeGenerator::EmitAddCPUStructField(u32 offset, const Value& value)
   }
 }
 
+void CodeGenerator::EmitIncrementCounter(u64* counter)
+{
+  Value temp = m_register_cache.AllocateScratch(OperandSize_64);
+  m_emit.mov(GetHostReg64(temp), reinterpret_cast<size_t>(counter));
+  m_emit.inc(m_emit.qword[GetHostReg64(temp)]);
+}
+
 Value CodeGenerator::GetSignFlag(const Value& value)
 {
   Value ret = m_register_cache.AllocateScratch(OperandSize_32);
@@ -1459,6 +1717,249 @@ Value CodeGenerator::GetParityFlag(const Value& value)
   return ret;
 }
 
+void CodeGenerator::EmitGuestMemoryLookup(HostReg ram_ptr_reg, HostReg offset_reg, HostReg temp_reg,
+                                          const Value& address, Segment segment, AccessType access, u32 access_size,
+                                          Xbyak::Label& slow_path_label)
+{
+  const Xbyak::Reg64 ram_ptr = GetHostReg64(ram_ptr_reg);
+  const Xbyak::Reg64 offset = GetHostReg64(offset_reg);
+  const Xbyak::Reg64 temp = GetHostReg64(temp_reg);
+  const u32 segcache_offset =
+    static_cast<u32>(offsetof(CPU, m_segment_cache[0]) + static_cast<u32>(segment) * sizeof(CPU::SegmentCache));
+  const AccessTypeMask access_mask = (access == AccessType::Read) ? AccessTypeMask::Read : AccessTypeMask::Write;
+
+  // Segment access/limit checks. Any failure is left to the thunk, which raises the appropriate exception.
+  m_emit.test(m_emit.byte[GetCPUPtrReg() + (segcache_offset + offsetof(CPU::SegmentCache, access_mask))],
+              static_cast<u32>(access_mask));
+  m_emit.jz(slow_path_label, CodeEmitter::T_NEAR);
+
+  // The 32-bit move zero-extends, so we can use the 64-bit register for the upper limit check.
+  EmitCopyValue(offset_reg, address);
+  m_emit.cmp(offset.cvt32(), m_emit.dword[GetCPUPtrReg() + (segcache_offset + offsetof(CPU::SegmentCache, limit_low))]);
+  m_emit.jb(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.lea(temp, m_emit.qword[offset + (access_size - 1)]);
+  m_emit.mov(ram_ptr.cvt32(),
+             m_emit.dword[GetCPUPtrReg() + (segcache_offset + offsetof(CPU::SegmentCache, limit_high))]);
+  m_emit.cmp(temp, ram_ptr);
+  m_emit.ja(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.add(offset.cvt32(),
+             m_emit.dword[GetCPUPtrReg() + (segcache_offset + offsetof(CPU::SegmentCache, base_address))]);
+
+  // Unaligned accesses are fine as long as they don't cross a page and alignment checking is off.
+  if (access_size > 1)
+  {
+    Xbyak::Label aligned_label;
+    m_emit.test(offset.cvt32(), access_size - 1);
+    m_emit.jz(aligned_label);
+    m_emit.cmp(m_emit.byte[GetCPUPtrReg() + offsetof(CPU, m_alignment_check_enabled)], 0);
+    m_emit.jne(slow_path_label, CodeEmitter::T_NEAR);
+    m_emit.mov(temp.cvt32(), offset.cvt32());
+    m_emit.and_(temp.cvt32(), CPU::PAGE_OFFSET_MASK);
+    m_emit.cmp(temp.cvt32(), CPU::PAGE_SIZE - access_size);
+    m_emit.ja(slow_path_label, CodeEmitter::T_NEAR);
+    m_emit.L(aligned_label);
+  }
+
+  // Linear -> physical. Without paging, the linear address is the physical address.
+  Xbyak::Label physical_label;
+  m_emit.test(m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_registers.CR0)], CR0Bit_PG);
+  m_emit.jz(physical_label, CodeEmitter::T_NEAR);
+#ifdef ENABLE_TLB_EMULATION
+  {
+    static_assert(sizeof(CPU::TLBEntry) == 16, "TLB entry is 16 bytes");
+    static_assert(Common::IsPow2(CPU::TLB_SET_COUNT), "TLB set count is a power of two");
+    static_assert((CPU::TLB_WAY_COUNT * sizeof(CPU::TLBEntry)) == 64, "TLB set is 64 bytes");
+    const u32 tlb_offset = static_cast<u32>(offsetof(CPU, m_tlb_entries));
+    const u8 access_bit = static_cast<u8>(1 << static_cast<u32>(access));
+
+    // set = m_tlb_entries[m_tlb_user_bit][(linear >> PAGE_SHIFT) % TLB_SET_COUNT]
+    m_emit.movzx(ram_ptr.cvt32(), m_emit.byte[GetCPUPtrReg() + offsetof(CPU, m_tlb_user_bit)]);
+    m_emit.imul(ram_ptr.cvt32(), ram_ptr.cvt32(), static_cast<u32>(CPU::TLB_SET_COUNT));
+    m_emit.mov(temp.cvt32(), offset.cvt32());
+    m_emit.shr(temp.cvt32(), CPU::PAGE_SHIFT);
+    m_emit.and_(temp.cvt32(), static_cast<u32>(CPU::TLB_SET_COUNT - 1));
+    m_emit.add(ram_ptr.cvt32(), temp.cvt32());
+    m_emit.shl(ram_ptr.cvt32(), 6);
+    m_emit.lea(ram_ptr, m_emit.qword[GetCPUPtrReg() + ram_ptr + tlb_offset]);
+
+    // tag = (linear & PAGE_MASK) | m_tlb_counter_bits
+    m_emit.mov(temp.cvt32(), offset.cvt32());
+    m_emit.and_(temp.cvt32(), CPU::PAGE_MASK);
+    m_emit.or_(temp.cvt32(), m_emit.dword[GetCPUPtrReg() + offsetof(CPU, m_tlb_counter_bits)]);
+
+    // Check each way. A page is only ever in one way, so a tag match without the access bit goes to the slow path,
+    // as does a miss in every way. 4MB pages are only looked up on the slow path.
+    Xbyak::Label hit_label;
+    for (u32 way = 0; way < CPU::TLB_WAY_COUNT; way++)
+    {
+      const bool last_way = (way == (CPU::TLB_WAY_COUNT - 1));
+      const u32 way_offset = way * static_cast<u32>(sizeof(CPU::TLBEntry));
+      Xbyak::Label next_way_label;
+      m_emit.cmp(temp.cvt32(), m_emit.dword[ram_ptr + (way_offset + offsetof(CPU::TLBEntry, linear_address))]);
+      if (last_way)
+        m_emit.jne(slow_path_label, CodeEmitter::T_NEAR);
+      else
+        m_emit.jne(next_way_label);
+      m_emit.test(m_emit.byte[ram_ptr + (way_offset + offsetof(CPU::TLBEntry, access_mask))], access_bit);
+      m_emit.jz(slow_path_label, CodeEmitter::T_NEAR);
+      if (way_offset != 0)
+        m_emit.add(ram_ptr, way_offset);
+      if (!last_way)
+      {
+        m_emit.jmp(hit_label);
+        m_emit.L(next_way_label);
+      }
+    }
+
+    m_emit.L(hit_label);
+    m_emit.and_(offset.cvt32(), CPU::PAGE_OFFSET_MASK);
+    m_emit.add(offset.cvt32(), m_emit.dword[ram_ptr + offsetof(CPU::TLBEntry, physical_address)]);
+  }
+#else
+  m_emit.jmp(slow_path_label, CodeEmitter::T_NEAR);
+#endif
+  m_emit.L(physical_label);
+
+  // Physical -> host pointer. The RAM index is null for MMIO and ROM. The address mask can change at runtime (A20).
+  Bus* bus = m_cpu->GetBus();
+  m_emit.mov(temp, reinterpret_cast<size_t>(bus->GetMemoryAddressMaskPointer()));
+  m_emit.and_(offset.cvt32(), m_emit.dword[temp]);
+
+  // Writes to the code chunks of a page go through the bus, which invalidates the blocks. The access doesn't cross a
+  // page, so it covers the chunks of its first and last bytes, and BT takes the chunk index modulo 64.
+  if (access == AccessType::Write)
+  {
+    static_assert(sizeof(Bus::PhysicalMemoryPage) == 32, "physical memory page is 32 bytes");
+    Xbyak::Label no_code_label;
+    m_emit.mov(temp.cvt32(), offset.cvt32());
+    m_emit.shr(temp.cvt32(), Bus::MEMORY_PAGE_NUMBER_SHIFT);
+    m_emit.shl(temp, 5);
+    m_emit.mov(ram_ptr, reinterpret_cast<size_t>(bus->GetPhysicalMemoryPages()));
+    m_emit.mov(temp, m_emit.qword[ram_ptr + temp + offsetof(Bus::PhysicalMemoryPage, code_mask)]);
+    m_emit.test(temp, temp);
+    m_emit.jz(no_code_label);
+    m_emit.mov(ram_ptr.cvt32(), offset.cvt32());
+    m_emit.shr(ram_ptr.cvt32(), Bus::CODE_CHUNK_SHIFT);
+    m_emit.bt(temp, ram_ptr);
+    m_emit.jc(slow_path_label, CodeEmitter::T_NEAR);
+    if (access_size > 1)
+    {
+      m_emit.lea(ram_ptr.cvt32(), m_emit.dword[offset + (access_size - 1)]);
+      m_emit.shr(ram_ptr.cvt32(), Bus::CODE_CHUNK_SHIFT);
+      m_emit.bt(temp, ram_ptr);
+      m_emit.jc(slow_path_label, CodeEmitter::T_NEAR);
+    }
+    m_emit.L(no_code_label);
+  }
+
+  m_emit.mov(temp.cvt32(), offset.cvt32());
+  m_emit.shr(temp.cvt32(), Bus::MEMORY_PAGE_NUMBER_SHIFT);
+  m_emit.mov(ram_ptr, reinterpret_cast<size_t>(bus->GetRAMPointerIndex()));
+  m_emit.mov(ram_ptr, m_emit.qword[ram_ptr + temp * 8]);
+  m_emit.test(ram_ptr, ram_ptr);
+  m_emit.jz(slow_path_label, CodeEmitter::T_NEAR);
+  m_emit.and_(offset.cvt32(), Bus::MEMORY_PAGE_OFFSET_MASK);
+}
+
+void CodeGenerator::LoadSegmentMemory(Value* dest_value, OperandSize size, const Value& address, Segment segment)
+{
+  DebugAssert(address.size == OperandSize_32 && dest_value->IsInHostRegister());
+
+  Value ram_ptr = m_register_cache.AllocateScratch(OperandSize_64);
+  Value offset = m_register_cache.AllocateScratch(OperandSize_64);
+  Value temp = m_register_cache.AllocateScratch(OperandSize_64);
+  Xbyak::Label slow_path_label;
+  Xbyak::Label done_label;
+
+  EmitGuestMemoryLookup(ram_ptr.GetHostRegister(), offset.GetHostRegister(), temp.GetHostRegister(), address, segment,
+                        AccessType::Read, GetOperandSizeInBytes(size), slow_path_label);
+
+  const Xbyak::Reg64 ram_ptr_reg = GetHostReg64(ram_ptr);
+  const Xbyak::Reg64 offset_reg = GetHostReg64(offset);
+  switch (size)
+  {
+    case OperandSize_8:
+      m_emit.mov(GetHostReg8(dest_value->host_reg), m_emit.byte[ram_ptr_reg + offset_reg]);
+      break;
+    case OperandSize_16:
+      m_emit.mov(GetHostReg16(dest_value->host_reg), m_emit.word[ram_ptr_reg + offset_reg]);
+      break;
+    case OperandSize_32:
+      m_emit.mov(GetHostReg32(dest_value->host_reg), m_emit.dword[ram_ptr_reg + offset_reg]);
+      break;
+    default:
+      UnreachableCode();
+      break;
+  }
+  m_emit.jmp(done_label, CodeEmitter::T_NEAR);
+
+  // The temporaries are dead on both paths now, so there's no need to preserve them across the thunk call.
+  ram_ptr.ReleaseAndClear();
+  offset.ReleaseAndClear();
+  temp.ReleaseAndClear();
+
+  m_emit.L(slow_path_label);
+  EmitLoadSegmentMemoryThunk(dest_value, size, address, segment);
+  m_emit.L(done_label);
+}
+
+void CodeGenerator::StoreSegmentMemory(const Value& value, const Value& address, Segment segment)
+{
+  DebugAssert(address.size == OperandSize_32);
+
+  Value ram_ptr = m_register_cache.AllocateScratch(OperandSize_64);
+  Value offset = m_register_cache.AllocateScratch(OperandSize_64);
+  Value temp = m_register_cache.AllocateScratch(OperandSize_64);
+  Xbyak::Label slow_path_label;
+  Xbyak::Label done_label;
+
+  EmitGuestMemoryLookup(ram_ptr.GetHostRegister(), offset.GetHostRegister(), temp.GetHostRegister(), address, segment,
+                        AccessType::Write, GetOperandSizeInBytes(value.size), slow_path_label);
+
+  const Xbyak::Reg64 ram_ptr_reg = GetHostReg64(ram_ptr);
+  const Xbyak::Reg64 offset_reg = GetHostReg64(offset);
+  switch (value.size)
+  {
+    case OperandSize_8:
+    {
+      if (value.IsConstant())
+        m_emit.mov(m_emit.byte[ram_ptr_reg + offset_reg], Truncate32(value.constant_value & 0xFF));
+      else
+        m_emit.mov(m_emit.byte[ram_ptr_reg + offset_reg], GetHostReg8(value.host_reg));
+    }
+    break;
+    case OperandSize_16:
+    {
+      if (value.IsConstant())
+        m_emit.mov(m_emit.word[ram_ptr_reg + offset_reg], Truncate32(value.constant_value & 0xFFFF));
+      else
+        m_emit.mov(m_emit.word[ram_ptr_reg + offset_reg], GetHostReg16(value.host_reg));
+    }
+    break;
+    case OperandSize_32:
+    {
+      if (value.IsConstant())
+        m_emit.mov(m_emit.dword[ram_ptr_reg + offset_reg], Truncate32(value.constant_value));
+      else
+        m_emit.mov(m_emit.dword[ram_ptr_reg + offset_reg], GetHostReg32(value.host_reg));
+    }
+    break;
+    default:
+      UnreachableCode();
+      break;
+  }
+  m_emit.jmp(done_label, CodeEmitter::T_NEAR);
+
+  // The temporaries are dead on both paths now, so there's no need to preserve them across the thunk call.
+  ram_ptr.ReleaseAndClear();
+  offset.ReleaseAndClear();
+  temp.ReleaseAndClear();
+
+  m_emit.L(slow_path_label);
+  EmitStoreSegmentMemoryThunk(value, address, segment);
+  m_emit.L(done_label);
+}
+
 bool CodeGenerator::Compile_Bitwise_Impl(const Instruction& instruction, CycleCount cycles)
 {
   InstructionPrologue(instruction, cycles);
@@ -1490,13 +1991,13 @@ bool CodeGenerator::Compile_Bitwise_Impl(const Instruction& instruction, CycleCo
       break;
   }
 
-  Value host_flags = ReadFlagsFromHost();
+  const u32 clear_flags_mask = Flag_OF | Flag_CF | Flag_AF;
+  const u32 copy_flags_mask = Flag_SF | Flag_ZF | Flag_PF;
+  Value host_flags = ReadLiveFlagsFromHost(copy_flags_mask);
 
   if (instruction.operation != Operation_TEST)
     WriteOperand(instruction, 0, std::move(lhs));
 
-  const u32 clear_flags_mask = Flag_OF | Flag_CF | Flag_AF;
-  const u32 copy_flags_mask = Flag_SF | Flag_ZF | Flag_PF;
   UpdateEFLAGS(std::move(host_flags), clear_flags_mask, copy_flags_mask, 0);
   return true;
 }
@@ -1695,6 +2196,16 @@ bool CodeGenerator::Compile_AddSub_Impl(const Instruction& instruction, CycleCou
       EmitSub(lhs.GetHostRegister(), rhs);
       break;
 
+    case Operation_ADC:
+      CopyGuestFlagsToHostFlags(Flag_CF);
+      EmitAdc(lhs.GetHostRegister(), rhs);
+      break;
+
+    case Operation_SBB:
+      CopyGuestFlagsToHostFlags(Flag_CF);
+      EmitSbb(lhs.GetHostRegister(), rhs);
+      break;
+
     case Operation_CMP:
       EmitCmp(lhs.GetHostRegister(), rhs);
       break;
@@ -1704,12 +2215,12 @@ bool CodeGenerator::Compile_AddSub_Impl(const Instruction& instruction, CycleCou
       break;
   }
 
-  Value host_flags = ReadFlagsFromHost();
+  const u32 eflags_mask = Flag_OF | Flag_CF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF;
+  Value host_flags = ReadLiveFlagsFromHost(eflags_mask);
 
   if (instruction.operation != Operation_CMP)
     WriteOperand(instruction, 0, std::move(lhs));
 
-  const u32 eflags_mask = Flag_OF | Flag_CF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF;
   UpdateEFLAGS(std::move(host_flags), 0, eflags_mask, 0);
   return true;
 }
@@ -1727,18 +2238,33 @@ bool CodeGenerator::Compile_IncDec_Impl(const Instruction& instruction, CycleCou
   else
     Panic("Unknown operation");
 
-  Value host_flags = ReadFlagsFromHost();
+  const u32 eflags_mask = Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF;
+  Value host_flags = ReadLiveFlagsFromHost(eflags_mask);
   WriteOperand(instruction, 0, std::move(val));
 
-  const u32 eflags_mask = Flag_OF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF;
   UpdateEFLAGS(std::move(host_flags), 0, eflags_mask, 0);
   return true;
 }
 
 bool CodeGenerator::Compile_String(const Instruction& instruction)
 {
-  const CycleCount cycles_base = m_cpu->GetCycles(instruction.IsRep() ? CYCLES_REP_MOVS_BASE : CYCLES_MOVS);
-  const CycleCount cycles_n = m_cpu->GetCycles(CYCLES_REP_MOVS_N) + 1;
+  // The per-element cycles have to match the bulk path, which charges them for each operation.
+  CycleCount cycles_base, cycles_n;
+  switch (instruction.operation)
+  {
+    case Operation_LODS:
+      cycles_base = m_cpu->GetCycles(instruction.IsRep() ? CYCLES_REP_LODS_BASE : CYCLES_LODS);
+      cycles_n = m_cpu->GetCycles(CYCLES_REP_LODS_N) + 1;
+      break;
+    case Operation_STOS:
+      cycles_base = m_cpu->GetCycles(instruction.IsRep() ? CYCLES_REP_STOS_BASE : CYCLES_STOS);
+      cycles_n = m_cpu->GetCycles(CYCLES_REP_STOS_N) + 1;
+      break;
+    default:
+      cycles_base = m_cpu->GetCycles(instruction.IsRep() ? CYCLES_REP_MOVS_BASE : CYCLES_MOVS);
+      cycles_n = m_cpu->GetCycles(CYCLES_REP_MOVS_N) + 1;
+      break;
+  }
   const u32 data_size = GetOperandSizeInBytes(instruction.operands[0].size);
   const OperandSize reg_address_size =
     ((instruction.GetAddressSize() == AddressSize_32) ? OperandSize_32 : OperandSize_16);
@@ -1805,18 +2331,84 @@ bool CodeGenerator::Compile_String(const Instruction& instruction)
          (!needs_edi || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_EDI)) &&
          (!is_rep || m_register_cache.IsGuestRegisterInHostReg(reg_address_size, Reg32_ECX)));
 
-  Xbyak::Label rep_label;
-  Xbyak::Label done_label;
+  // the bulk path works on the guest registers in the cpu struct, so sync them before entering the loop
+  Value bulk_count;
+  auto reload_guest_register = [this](const Value& value, Reg32 guest_reg) {
+    u32 offset;
+    if (value.size == OperandSize_8)
+      offset = CalculateRegisterOffset(static_cast<Reg8>(guest_reg));
+    else if (value.size == OperandSize_16)
+      offset = CalculateRegisterOffset(static_cast<Reg16>(guest_reg));
+    else
+      offset = CalculateRegisterOffset(guest_reg);
+    EmitLoadCPUStructField(value.GetHostRegister(), value.size, offset);
+  };
   if (is_rep)
   {
-    m_emit.L(rep_label);
-
-    // add n cycles
+    bulk_count = m_register_cache.AllocateScratch(OperandSize_32);
+    m_register_cache.FlushGuestRegister(Reg32_EFLAGS, false);
+    if (needs_eax)
+      m_register_cache.FlushGuestRegister(instruction.operands[0].size, Reg32_EAX, false);
+    if (needs_esi)
+      m_register_cache.FlushGuestRegister(reg_address_size, Reg32_ESI, false);
+    if (needs_edi)
+      m_register_cache.FlushGuestRegister(reg_address_size, Reg32_EDI, false);
+    m_register_cache.FlushGuestRegister(reg_address_size, Reg32_ECX, false);
+  }
+
+  Xbyak::Label rep_label;
+  Xbyak::Label done_label;
+  if (is_rep)
+  {
+    m_emit.L(rep_label);
+
+    // add n cycles
     EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(cycles_n));
 
     // compare ecx against zero
     EmitTest(ecx.GetHostRegister(), ecx);
-    m_emit.jz(done_label);
+    m_emit.jz(done_label, CodeEmitter::T_NEAR);
+
+    // copy/fill up to the next page boundary on the host, shared with the interpreter
+    const Value operand_size_value = Value::FromConstantU32(static_cast<u32>(instruction.operands[0].size));
+    const Value address_size_value = Value::FromConstantU32(static_cast<u32>(instruction.GetAddressSize()));
+    const Value segment_value = Value::FromConstantU32(static_cast<u32>(instruction.GetMemorySegment()));
+    switch (instruction.operation)
+    {
+      case Operation_MOVS:
+        EmitFunctionCall(&bulk_count, &Thunks::BulkMOVS, m_register_cache.GetCPUPtr(), operand_size_value,
+                         address_size_value, segment_value);
+        break;
+      case Operation_STOS:
+        EmitFunctionCall(&bulk_count, &Thunks::BulkSTOS, m_register_cache.GetCPUPtr(), operand_size_value,
+                         address_size_value);
+        break;
+      case Operation_LODS:
+        EmitFunctionCall(&bulk_count, &Thunks::BulkLODS, m_register_cache.GetCPUPtr(), operand_size_value,
+                         address_size_value, segment_value);
+        break;
+      default:
+        UnreachableCode();
+        break;
+    }
+
+    // if anything was done, pick up the new register values and go around again
+    Xbyak::Label element_label;
+    EmitTest(bulk_count.GetHostRegister(), bulk_count);
+    m_emit.jz(element_label);
+    if (needs_eax)
+      reload_guest_register(eax, Reg32_EAX);
+    if (needs_esi)
+      reload_guest_register(esi, Reg32_ESI);
+    if (needs_edi)
+      reload_guest_register(edi, Reg32_EDI);
+    reload_guest_register(ecx, Reg32_ECX);
+
+    // the cycles at rep_label are for the next element, so only go around if there is one
+    EmitTest(ecx.GetHostRegister(), ecx);
+    m_emit.jnz(rep_label);
+    m_emit.jmp(done_label, CodeEmitter::T_NEAR);
+    m_emit.L(element_label);
   }
 
   switch (instruction.operation)
@@ -1900,10 +2492,9 @@ bool CodeGenerator::Compile_String(const Instruction& instruction)
       m_register_cache.FlushGuestRegister(reg_address_size, Reg32_EDI, false);
     m_register_cache.FlushGuestRegister(reg_address_size, Reg32_ECX, false);
 
-    // jump if at the end with condition, the flushes shouldn't change the flags
-    // m_emit.jz(done_label);
-
-    m_emit.jmp(rep_label);
+    // go around again if there are elements left, the cycles for the next one are added at rep_label
+    EmitTest(ecx.GetHostRegister(), ecx);
+    m_emit.jnz(rep_label);
   }
 
   m_emit.L(done_label);
@@ -1913,13 +2504,18 @@ bool CodeGenerator::Compile_String(const Instruction& instruction)
 bool CodeGenerator::Compile_Jcc_Impl(const Instruction& instruction, CycleCount cycles, CycleCount cycles_not_taken)
 {
   const JumpCondition cc = instruction.operands[0].jump_condition;
-  if (cc == JumpCondition_CXZero)
-    return Compile_Fallback(instruction);
-
   InstructionPrologue(instruction, 0, true);
   CalculateEffectiveAddress(instruction);
   Value target = CalculateJumpTarget(instruction, 1);
 
+  // Branches before the end of a trace continue with the next instruction when they go the way the trace does, and
+  // leave the block when they don't. The exit code can be too long for a short jump.
+  const bool is_side_exit = (&instruction != (m_block_end - 1));
+  const u32 fallthrough_eip =
+    (instruction.address + instruction.length) & (m_block->Is32BitCode() ? 0xFFFFFFFFu : 0xFFFFu);
+  const bool trace_taken = is_side_exit && ((&instruction)[1].address != fallthrough_eip);
+  const CodeEmitter::LabelType jump_type = is_side_exit ? CodeEmitter::T_NEAR : CodeEmitter::T_AUTO;
+
   // test the actual condition
   Xbyak::Label take_jump_label, done_label;
 
@@ -1930,7 +2526,7 @@ bool CodeGenerator::Compile_Jcc_Impl(const Instruction& instruction, CycleCount
   {                                                                                                                    \
     Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);                                       \
     m_emit.test(GetHostReg32(eflags), (flag));                                                                         \
-    m_emit.jnz(take_jump_label);                                                                                       \
+    m_emit.jnz(take_jump_label, jump_type);                                                                            \
   }                                                                                                                    \
   break;
 
@@ -1939,7 +2535,7 @@ bool CodeGenerator::Compile_Jcc_Impl(const Instruction& instruction, CycleCount
   {                                                                                                                    \
     Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);                                       \
     m_emit.test(GetHostReg32(eflags), (flag));                                                                         \
-    m_emit.jz(take_jump_label);                                                                                        \
+    m_emit.jz(take_jump_label, jump_type);                                                                             \
   }                                                                                                                    \
   break;
 
@@ -1961,51 +2557,723 @@ bool CodeGenerator::Compile_Jcc_Impl(const Instruction& instruction, CycleCount
 
     case JumpCondition_BelowOrEqual:
       CopyGuestFlagsToHostFlags(Flag_CF | Flag_ZF);
-      m_emit.jbe(take_jump_label);
+      m_emit.jbe(take_jump_label, jump_type);
       break;
 
     case JumpCondition_Above:
       CopyGuestFlagsToHostFlags(Flag_CF | Flag_ZF);
-      m_emit.ja(take_jump_label);
+      m_emit.ja(take_jump_label, jump_type);
       break;
 
     case JumpCondition_Less:
       CopyGuestFlagsToHostFlags(Flag_SF | Flag_OF);
-      m_emit.jl(take_jump_label);
+      m_emit.jl(take_jump_label, jump_type);
       break;
 
     case JumpCondition_GreaterOrEqual:
       CopyGuestFlagsToHostFlags(Flag_SF | Flag_OF);
-      m_emit.jge(take_jump_label);
+      m_emit.jge(take_jump_label, jump_type);
       break;
 
     case JumpCondition_LessOrEqual:
       CopyGuestFlagsToHostFlags(Flag_ZF | Flag_SF | Flag_OF);
-      m_emit.jle(take_jump_label);
+      m_emit.jle(take_jump_label, jump_type);
       break;
 
     case JumpCondition_Greater:
       CopyGuestFlagsToHostFlags(Flag_ZF | Flag_SF | Flag_OF);
-      m_emit.jg(take_jump_label);
+      m_emit.jg(take_jump_label, jump_type);
       break;
 
+    case JumpCondition_CXZero:
+    {
+      // JCXZ uses the address size to pick between CX and ECX.
+      const OperandSize count_size =
+        (instruction.GetAddressSize() == AddressSize_32) ? OperandSize_32 : OperandSize_16;
+      Value count = m_register_cache.ReadGuestRegister(count_size, static_cast<u8>(Reg32_ECX), true, true);
+      EmitTest(count.GetHostRegister(), count);
+      m_emit.jz(take_jump_label, jump_type);
+    }
+    break;
+
     default:
       Panic("Unhandled condition");
       break;
   }
 
-  // branch not taken
-  EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(static_cast<u64>(cycles_not_taken)));
-  m_emit.jmp(done_label);
+  if (trace_taken)
+  {
+    // branch not taken, EIP already points to the fallthrough
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(static_cast<u64>(cycles_not_taken)));
+    EmitSideExit();
+
+    // branch taken, the trace continues at the target so EIP can be caught up with the next update
+    m_emit.L(take_jump_label);
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(static_cast<u64>(cycles)));
+    const u32 skipped_length = GetRelativeBranchTarget(instruction) - fallthrough_eip;
+    m_delayed_eip_add += skipped_length;
+    m_delayed_current_eip_add += skipped_length;
+  }
+  else
+  {
+    // branch not taken
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(static_cast<u64>(cycles_not_taken)));
+    m_emit.jmp(done_label, jump_type);
+
+    // branch taken
+    m_emit.L(take_jump_label);
+    EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(static_cast<u64>(cycles)));
+    EmitFunctionCall(nullptr, static_cast<void (*)(CPU*, u32)>(&CPU::BranchTo), m_register_cache.GetCPUPtr(), target);
+    if (is_side_exit)
+      EmitSideExit();
+
+    m_emit.L(done_label);
+  }
+
+  if (is_side_exit)
+    EmitAddInstructionsExecuted(GetTraceSegmentLength(&instruction + 1));
+
+  return true;
+}
+
+bool CodeGenerator::Compile_NEG_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  const OperandSize size = instruction.operands[0].size;
+  Value value = ReadOperand(instruction, 0, size, false, true);
+  EmitNeg(value.GetHostRegister(), size);
+
+  const u32 eflags_mask = Flag_OF | Flag_CF | Flag_AF | Flag_SF | Flag_ZF | Flag_PF;
+  Value host_flags = ReadLiveFlagsFromHost(eflags_mask);
+  WriteOperand(instruction, 0, std::move(value));
+
+  UpdateEFLAGS(std::move(host_flags), 0, eflags_mask, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_MUL_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  const bool is_signed = (instruction.operation == Operation_IMUL);
+  const bool is_one_operand = (instruction.operands[1].mode == OperandMode_None);
+  const bool is_three_operand = (instruction.operands[2].mode != OperandMode_None);
+  const OperandSize size = instruction.operands[0].size;
+  const u32 bits = GetOperandSizeInBytes(size) * 8;
+
+  // Every form is done as a 64-bit multiply of the extended operands, which gives us the full double-width result.
+  Value result = m_register_cache.AllocateScratch(OperandSize_64);
+  Value temp = m_register_cache.AllocateScratch(OperandSize_64);
+  const Xbyak::Reg64 result_reg = GetHostReg64(result);
+  const Xbyak::Reg64 temp_reg = GetHostReg64(temp);
+
+  auto ExtendTo64 = [this, is_signed](HostReg to_reg, const Value& value) {
+    if (value.IsConstant())
+      EmitCopyValue(to_reg, ConvertValueSize(value, OperandSize_64, is_signed));
+    else if (is_signed)
+      EmitSignExtend(to_reg, OperandSize_64, value.GetHostRegister(), value.size);
+    else
+      EmitZeroExtend(to_reg, OperandSize_64, value.GetHostRegister(), value.size);
+  };
+
+  if (is_one_operand)
+  {
+    // The r/m operand can be memory, so read it before the accumulator.
+    Value rhs = ReadOperand(instruction, 0, size, false);
+    Value lhs = m_register_cache.ReadGuestRegister(size, static_cast<u8>(Reg32_EAX));
+    ExtendTo64(result.host_reg, lhs);
+    ExtendTo64(temp.host_reg, rhs);
+  }
+  else
+  {
+    const size_t lhs_index = is_three_operand ? 1 : 0;
+    const size_t rhs_index = is_three_operand ? 2 : 1;
+    Value rhs = ReadOperand(instruction, rhs_index, size, true);
+    Value lhs = ReadOperand(instruction, lhs_index, size, false);
+    ExtendTo64(result.host_reg, lhs);
+    ExtendTo64(temp.host_reg, rhs);
+  }
+
+  m_emit.imul(result_reg, temp_reg);
+
+  // CF and OF are set when the upper half of the result is significant.
+  if (is_signed)
+  {
+    EmitSignExtend(temp.host_reg, OperandSize_64, result.host_reg, size);
+    m_emit.cmp(temp_reg, result_reg);
+  }
+  else
+  {
+    m_emit.mov(temp_reg, result_reg);
+    m_emit.shr(temp_reg, bits);
+  }
+  m_emit.setnz(temp_reg.cvt8());
+  m_emit.movzx(temp_reg.cvt32(), temp_reg.cvt8());
+  m_emit.imul(temp_reg.cvt32(), temp_reg.cvt32(), Flag_CF | Flag_OF);
+
+  // SF/ZF/PF are undefined, but match the interpreter which computes them from the low part of the result.
+  EmitTest(result.host_reg, Value::FromHostReg(&m_register_cache, result.host_reg, size));
+  Value host_flags = ReadFlagsFromHost();
+  m_emit.and_(GetHostReg32(host_flags), Flag_SF | Flag_ZF | Flag_PF);
+  m_emit.or_(GetHostReg32(host_flags), temp_reg.cvt32());
+
+  if (is_one_operand)
+  {
+    switch (size)
+    {
+      case OperandSize_8:
+      {
+        result.size = OperandSize_16;
+        m_register_cache.WriteGuestRegister(Reg16_AX, std::move(result));
+      }
+      break;
+
+      case OperandSize_16:
+      {
+        m_emit.mov(temp_reg, result_reg);
+        m_emit.shr(temp_reg, 16);
+        temp.size = OperandSize_16;
+        result.size = OperandSize_16;
+        m_register_cache.WriteGuestRegister(Reg16_AX, std::move(result));
+        m_register_cache.WriteGuestRegister(Reg16_DX, std::move(temp));
+      }
+      break;
+
+      case OperandSize_32:
+      {
+        m_emit.mov(temp_reg, result_reg);
+        m_emit.shr(temp_reg, 32);
+        temp.size = OperandSize_32;
+        result.size = OperandSize_32;
+        m_register_cache.WriteGuestRegister(Reg32_EAX, std::move(result));
+        m_register_cache.WriteGuestRegister(Reg32_EDX, std::move(temp));
+      }
+      break;
+
+      default:
+        UnreachableCode();
+        break;
+    }
+  }
+  else
+  {
+    ConvertValueSizeInPlace(&result, size, false);
+    WriteOperand(instruction, 0, std::move(result));
+  }
+
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_CF | Flag_OF | Flag_SF | Flag_ZF | Flag_PF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_DIV_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  constexpr auto rax = Xbyak::Operand::RAX;
+  constexpr auto rdx = Xbyak::Operand::RDX;
+
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  const bool is_signed = (instruction.operation == Operation_IDIV);
+  const OperandSize size = instruction.operands[0].size;
+
+  // Read the divisor first. Memory operands can call out to a thunk, which returns in rax.
+  Value divisor = m_register_cache.AllocateScratch(OperandSize_64);
+  const Xbyak::Reg64 divisor_reg = GetHostReg64(divisor);
+  {
+    Value value = ReadOperand(instruction, 0, size, false);
+    if (value.IsConstant())
+      EmitCopyValue(divisor.host_reg, ConvertValueSize(value, OperandSize_64, is_signed));
+    else if (is_signed)
+      EmitSignExtend(divisor.host_reg, OperandSize_64, value.GetHostRegister(), size);
+    else
+      EmitZeroExtend(divisor.host_reg, OperandSize_64, value.GetHostRegister(), size);
+  }
+
+  // The host divide is hardwired to rdx:rax. Grab everything we need up front, there's branches below.
+  m_register_cache.EnsureHostRegFree(rax);
+  m_register_cache.EnsureHostRegFree(rdx);
+  Value dividend = m_register_cache.AllocateScratch(OperandSize_64, rax);
+  Value remainder = m_register_cache.AllocateScratch(OperandSize_64, rdx);
+  Value quotient_out = m_register_cache.AllocateScratch((size == OperandSize_8) ? OperandSize_16 : size);
+  Value remainder_out = m_register_cache.AllocateScratch(size);
+
+  // Build the full dividend in rax, we use a 64-bit divide for every size so the host never faults.
+  switch (size)
+  {
+    case OperandSize_8:
+    {
+      Value ax = m_register_cache.ReadGuestRegister(Reg16_AX, true, true);
+      if (is_signed)
+        m_emit.movsx(m_emit.rax, GetHostReg16(ax));
+      else
+        m_emit.movzx(m_emit.eax, GetHostReg16(ax));
+    }
+    break;
+
+    case OperandSize_16:
+    {
+      Value ax = m_register_cache.ReadGuestRegister(Reg16_AX, true, true);
+      Value dx = m_register_cache.ReadGuestRegister(Reg16_DX, true, true);
+      m_emit.movzx(m_emit.eax, GetHostReg16(ax));
+      m_emit.movzx(m_emit.edx, GetHostReg16(dx));
+      m_emit.shl(m_emit.edx, 16);
+      m_emit.or_(m_emit.eax, m_emit.edx);
+      if (is_signed)
+        m_emit.movsxd(m_emit.rax, m_emit.eax);
+    }
+    break;
+
+    case OperandSize_32:
+    {
+      Value eax = m_register_cache.ReadGuestRegister(Reg32_EAX, true, true);
+      Value edx = m_register_cache.ReadGuestRegister(Reg32_EDX, true, true);
+      m_emit.mov(m_emit.eax, GetHostReg32(eax));
+      m_emit.mov(m_emit.edx, GetHostReg32(edx));
+      m_emit.shl(m_emit.rdx, 32);
+      m_emit.or_(m_emit.rax, m_emit.rdx);
+    }
+    break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+
+  Xbyak::Label divide_error_label, done_label;
+  m_emit.test(divisor_reg, divisor_reg);
+  m_emit.jz(divide_error_label, CodeEmitter::T_NEAR);
+
+  if (!is_signed)
+  {
+    m_emit.xor_(m_emit.edx, m_emit.edx);
+    m_emit.div(divisor_reg);
+
+    // The quotient has to fit in the destination.
+    if (size == OperandSize_32)
+    {
+      m_emit.mov(divisor_reg, m_emit.rax);
+      m_emit.shr(divisor_reg, 32);
+      m_emit.jnz(divide_error_label, CodeEmitter::T_NEAR);
+    }
+    else
+    {
+      m_emit.cmp(m_emit.rax, (size == OperandSize_8) ? 0xFF : 0xFFFF);
+      m_emit.ja(divide_error_label, CodeEmitter::T_NEAR);
+    }
+  }
+  else
+  {
+    Xbyak::Label divide_label, check_label;
+    if (size == OperandSize_32)
+    {
+      // INT64_MIN / -1 faults on the host. Negating gives the same result for every other dividend, and INT64_MIN
+      // doesn't fit in 32 bits anyway, so the range check below still raises the exception.
+      m_emit.cmp(divisor_reg, -1);
+      m_emit.jne(divide_label);
+      m_emit.neg(m_emit.rax);
+      m_emit.xor_(m_emit.edx, m_emit.edx);
+      m_emit.jmp(check_label);
+      m_emit.L(divide_label);
+    }
+
+    m_emit.cqo();
+    m_emit.idiv(divisor_reg);
+
+    // The quotient has to fit in the destination when sign-extended.
+    m_emit.L(check_label);
+    EmitSignExtend(divisor.host_reg, OperandSize_64, rax, size);
+    m_emit.cmp(divisor_reg, m_emit.rax);
+    m_emit.jne(divide_error_label, CodeEmitter::T_NEAR);
+  }
+
+  if (size == OperandSize_8)
+  {
+    // AL <- quotient, AH <- remainder
+    m_emit.movzx(GetHostReg32(quotient_out), m_emit.al);
+    m_emit.shl(m_emit.edx, 8);
+    m_emit.or_(GetHostReg32(quotient_out), m_emit.edx);
+    m_register_cache.WriteGuestRegister(Reg16_AX, std::move(quotient_out));
+  }
+  else
+  {
+    EmitCopyValue(quotient_out.host_reg, Value::FromHostReg(&m_register_cache, rax, size));
+    EmitCopyValue(remainder_out.host_reg, Value::FromHostReg(&m_register_cache, rdx, size));
+    m_register_cache.WriteGuestRegister(size, static_cast<u8>(Reg32_EAX), std::move(quotient_out));
+    m_register_cache.WriteGuestRegister(size, static_cast<u8>(Reg32_EDX), std::move(remainder_out));
+  }
+  m_emit.jmp(done_label, CodeEmitter::T_NEAR);
+
+  m_emit.L(divide_error_label);
+  RaiseException(Interrupt_DivideError);
 
-  // branch taken
-  m_emit.L(take_jump_label);
-  EmitAddCPUStructField(offsetof(CPU, m_pending_cycles), Value::FromConstantU64(static_cast<u64>(cycles)));
-  EmitFunctionCall(nullptr, static_cast<void (*)(CPU*, u32)>(&CPU::BranchTo), m_register_cache.GetCPUPtr(), target);
   m_emit.L(done_label);
   return true;
 }
 
+bool CodeGenerator::Compile_SETcc_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  Value value = m_register_cache.AllocateScratch(OperandSize_8);
+  const Xbyak::Reg8 value_reg = GetHostReg8(value);
+
+  switch (instruction.operands[0].jump_condition)
+  {
+#define FLAG_SET(cc, flag)                                                                                             \
+  case (cc):                                                                                                           \
+  {                                                                                                                    \
+    Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);                                       \
+    m_emit.test(GetHostReg32(eflags), (flag));                                                                         \
+    m_emit.setnz(value_reg);                                                                                           \
+  }                                                                                                                    \
+  break;
+
+#define FLAG_NOT_SET(cc, flag)                                                                                         \
+  case (cc):                                                                                                           \
+  {                                                                                                                    \
+    Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);                                       \
+    m_emit.test(GetHostReg32(eflags), (flag));                                                                         \
+    m_emit.setz(value_reg);                                                                                            \
+  }                                                                                                                    \
+  break;
+
+    FLAG_SET(JumpCondition_Overflow, Flag_OF);
+    FLAG_NOT_SET(JumpCondition_NotOverflow, Flag_OF);
+    FLAG_SET(JumpCondition_Sign, Flag_SF);
+    FLAG_NOT_SET(JumpCondition_NotSign, Flag_SF);
+    FLAG_SET(JumpCondition_Equal, Flag_ZF);
+    FLAG_NOT_SET(JumpCondition_NotEqual, Flag_ZF);
+    FLAG_SET(JumpCondition_Below, Flag_CF);
+    FLAG_NOT_SET(JumpCondition_AboveOrEqual, Flag_CF);
+    FLAG_SET(JumpCondition_Parity, Flag_PF);
+    FLAG_NOT_SET(JumpCondition_NotParity, Flag_PF);
+
+#undef FLAG_SET
+#undef FLAG_NOT_SET
+
+    case JumpCondition_BelowOrEqual:
+      CopyGuestFlagsToHostFlags(Flag_CF | Flag_ZF);
+      m_emit.setbe(value_reg);
+      break;
+
+    case JumpCondition_Above:
+      CopyGuestFlagsToHostFlags(Flag_CF | Flag_ZF);
+      m_emit.seta(value_reg);
+      break;
+
+    case JumpCondition_Less:
+      CopyGuestFlagsToHostFlags(Flag_SF | Flag_OF);
+      m_emit.setl(value_reg);
+      break;
+
+    case JumpCondition_GreaterOrEqual:
+      CopyGuestFlagsToHostFlags(Flag_SF | Flag_OF);
+      m_emit.setge(value_reg);
+      break;
+
+    case JumpCondition_LessOrEqual:
+      CopyGuestFlagsToHostFlags(Flag_ZF | Flag_SF | Flag_OF);
+      m_emit.setle(value_reg);
+      break;
+
+    case JumpCondition_Greater:
+      CopyGuestFlagsToHostFlags(Flag_ZF | Flag_SF | Flag_OF);
+      m_emit.setg(value_reg);
+      break;
+
+    default:
+      Panic("Unhandled condition");
+      break;
+  }
+
+  WriteOperand(instruction, 1, std::move(value));
+  return true;
+}
+
+bool CodeGenerator::Compile_BTx_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  const OperandSize size = instruction.operands[0].size;
+  const u32 bit_mask = (size == OperandSize_16) ? 0xF : 0x1F;
+
+  // With a memory operand, the bit offset can address outside of the operand. Only offsets which stay within the
+  // operand are handled inline.
+  if (!instruction.ModRM_RM_IsReg() && (instruction.operands[1].mode != OperandMode_Immediate ||
+                                        (ZeroExtend32(instruction.data.imm8) & ~bit_mask) != 0))
+  {
+    return Compile_Fallback(instruction);
+  }
+
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  Value value = ReadOperand(instruction, 0, size, false, true);
+  Value bit = ReadOperand(instruction, 1, size, false);
+  const Xbyak::Reg value_reg = GetHostReg(value);
+
+  if (bit.IsConstant())
+  {
+    const u8 bit_index = Truncate8(bit.constant_value & bit_mask);
+    switch (instruction.operation)
+    {
+      case Operation_BT:
+        m_emit.bt(value_reg, bit_index);
+        break;
+      case Operation_BTS:
+        m_emit.bts(value_reg, bit_index);
+        break;
+      case Operation_BTR:
+        m_emit.btr(value_reg, bit_index);
+        break;
+      case Operation_BTC:
+        m_emit.btc(value_reg, bit_index);
+        break;
+      default:
+        UnreachableCode();
+        break;
+    }
+  }
+  else
+  {
+    // The host masks the bit offset for register operands, same as the guest.
+    const Xbyak::Reg bit_reg = GetHostReg(bit);
+    switch (instruction.operation)
+    {
+      case Operation_BT:
+        m_emit.bt(value_reg, bit_reg);
+        break;
+      case Operation_BTS:
+        m_emit.bts(value_reg, bit_reg);
+        break;
+      case Operation_BTR:
+        m_emit.btr(value_reg, bit_reg);
+        break;
+      case Operation_BTC:
+        m_emit.btc(value_reg, bit_reg);
+        break;
+      default:
+        UnreachableCode();
+        break;
+    }
+  }
+
+  Value host_flags = ReadFlagsFromHost();
+  if (instruction.operation != Operation_BT)
+    WriteOperand(instruction, 0, std::move(value));
+
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_CF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_BitScan_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  const OperandSize size = instruction.operands[0].size;
+  Value index = m_register_cache.AllocateScratch(size);
+  Value source = ReadOperand(instruction, 1, size, false, true);
+  Value dest = ReadOperand(instruction, 0, size, false, true);
+
+  if (instruction.operation == Operation_BSF)
+    m_emit.bsf(GetHostReg(index), GetHostReg(source));
+  else
+    m_emit.bsr(GetHostReg(index), GetHostReg(source));
+
+  // The destination is left unchanged when the source is zero, and ZF is the only defined flag.
+  if (size == OperandSize_16)
+    m_emit.cmovnz(GetHostReg16(dest), GetHostReg16(index));
+  else
+    m_emit.cmovnz(GetHostReg32(dest), GetHostReg32(index));
+
+  Value host_flags = ReadFlagsFromHost();
+  WriteOperand(instruction, 0, std::move(dest));
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_ZF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_Rotate_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  constexpr auto rcx = Xbyak::Operand::RCX;
+
+  const Operation operation = instruction.operation;
+  const bool through_carry = (operation == Operation_RCL || operation == Operation_RCR);
+  const bool is_constant_count = (instruction.operands[1].mode != OperandMode_Register);
+
+  // Rotating through carry by a variable count is rare, and the modulo rules differ per size, so leave it alone.
+  if (through_carry && !is_constant_count)
+    return Compile_Fallback(instruction);
+
+  InstructionPrologue(instruction, cycles);
+  CalculateEffectiveAddress(instruction);
+
+  const OperandSize size = instruction.operands[0].size;
+  const u32 bits = GetOperandSizeInBytes(size) * 8;
+
+  u8 constant_count = 0;
+  if (is_constant_count)
+  {
+    // Apply the count masking at compile time, a zero count leaves both the operand and the flags alone.
+    Value count = ReadOperand(instruction, 1, OperandSize_8, false);
+    u32 masked_count = Truncate32(count.constant_value) & 0x1F;
+    if (through_carry && size != OperandSize_32)
+      masked_count %= (bits + 1);
+    if (masked_count == 0)
+      return true;
+
+    constant_count = Truncate8(masked_count);
+  }
+
+  Value value = ReadOperand(instruction, 0, size, false, true);
+  Value host_flags = m_register_cache.AllocateScratch(OperandSize_32);
+  Value temp = m_register_cache.AllocateScratch(OperandSize_32);
+  Value eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
+  const Xbyak::Reg value_reg = GetHostReg(value);
+  const Xbyak::Reg32 flags_reg = GetHostReg32(host_flags);
+  const Xbyak::Reg32 temp_reg = GetHostReg32(temp);
+
+  Value count;
+  if (!is_constant_count)
+  {
+    m_register_cache.EnsureHostRegFree(rcx);
+    count = m_register_cache.AllocateScratch(OperandSize_8, rcx);
+    EmitCopyValue(rcx, ReadOperand(instruction, 1, OperandSize_8, false));
+    m_emit.and_(m_emit.cl, 0x1F);
+  }
+
+  if (through_carry)
+    CopyGuestFlagsToHostFlags(Flag_CF);
+
+  switch (operation)
+  {
+    case Operation_ROL:
+      if (is_constant_count)
+        m_emit.rol(value_reg, constant_count);
+      else
+        m_emit.rol(value_reg, m_emit.cl);
+      break;
+
+    case Operation_ROR:
+      if (is_constant_count)
+        m_emit.ror(value_reg, constant_count);
+      else
+        m_emit.ror(value_reg, m_emit.cl);
+      break;
+
+    case Operation_RCL:
+      m_emit.rcl(value_reg, constant_count);
+      break;
+
+    case Operation_RCR:
+      m_emit.rcr(value_reg, constant_count);
+      break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+
+  // The host only defines OF for single-bit rotates, so compute both flags from the result.
+  if (through_carry)
+  {
+    m_emit.setc(flags_reg.cvt8());
+    m_emit.movzx(flags_reg, flags_reg.cvt8());
+  }
+  if (size == OperandSize_32)
+    m_emit.mov(temp_reg, value_reg);
+  else
+    m_emit.movzx(temp_reg, value_reg);
+
+  switch (operation)
+  {
+    case Operation_ROL:
+    case Operation_RCL:
+    {
+      // ROL: CF = bit 0. OF = MSB ^ CF.
+      if (operation == Operation_ROL)
+      {
+        m_emit.mov(flags_reg, temp_reg);
+        m_emit.and_(flags_reg, Flag_CF);
+      }
+      m_emit.shr(temp_reg, bits - 1);
+      m_emit.xor_(temp_reg, flags_reg);
+      m_emit.shl(temp_reg, 11); // Flag_OF
+    }
+    break;
+
+    case Operation_ROR:
+    case Operation_RCR:
+    {
+      // ROR: CF = MSB. OF = MSB ^ (MSB - 1), the two top bits are 01 or 10 exactly when bit 1 of (top bits + 1) is set.
+      if (operation == Operation_ROR)
+      {
+        m_emit.mov(flags_reg, temp_reg);
+        m_emit.shr(flags_reg, bits - 1);
+      }
+      m_emit.shr(temp_reg, bits - 2);
+      m_emit.inc(temp_reg);
+      m_emit.and_(temp_reg, 2);
+      m_emit.shl(temp_reg, 10); // Flag_OF
+    }
+    break;
+
+    default:
+      UnreachableCode();
+      break;
+  }
+  m_emit.or_(flags_reg, temp_reg);
+
+  // A zero count after masking leaves the value alone, and the flags unchanged.
+  if (!is_constant_count)
+  {
+    m_emit.test(m_emit.cl, m_emit.cl);
+    m_emit.cmovz(flags_reg, GetHostReg32(eflags));
+  }
+
+  WriteOperand(instruction, 0, std::move(value));
+  UpdateEFLAGS(std::move(host_flags), 0, Flag_CF | Flag_OF, 0);
+  return true;
+}
+
+bool CodeGenerator::Compile_LOOP_Impl(const Instruction& instruction, CycleCount cycles)
+{
+  InstructionPrologue(instruction, cycles, true);
+  CalculateEffectiveAddress(instruction);
+  Value target = CalculateJumpTarget(instruction, 1);
+
+  // Read everything before the branch, so the register cache state matches on both paths.
+  const JumpCondition condition = instruction.operands[0].jump_condition;
+  Value eflags;
+  if (condition != JumpCondition_Always)
+    eflags = m_register_cache.ReadGuestRegister(Reg32_EFLAGS, true, true);
+
+  const OperandSize count_size = (instruction.GetAddressSize() == AddressSize_32) ? OperandSize_32 : OperandSize_16;
+  Value count = m_register_cache.ReadGuestRegister(count_size, static_cast<u8>(Reg32_ECX), true, true);
+  EmitDec(count.GetHostRegister(), count_size);
+  m_register_cache.WriteGuestRegister(count_size, static_cast<u8>(Reg32_ECX), std::move(count));
+
+  Xbyak::Label not_taken_label;
+  m_emit.jz(not_taken_label);
+
+  if (condition == JumpCondition_Equal)
+  {
+    m_emit.test(GetHostReg32(eflags), Flag_ZF);
+    m_emit.jz(not_taken_label);
+  }
+  else if (condition == JumpCondition_NotEqual)
+  {
+    m_emit.test(GetHostReg32(eflags), Flag_ZF);
+    m_emit.jnz(not_taken_label);
+  }
+
+  EmitFunctionCall(nullptr, static_cast<void (*)(CPU*, u32)>(&CPU::BranchTo), m_register_cache.GetCPUPtr(), target);
+  m_emit.L(not_taken_label);
+  return true;
+}
+
 class ThunkGenerator
 {
 public:
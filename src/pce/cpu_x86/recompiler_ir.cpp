@@ -0,0 +1,516 @@
+#include "recompiler_ir.h"
+#include "YBaseLib/Log.h"
+#include "YBaseLib/String.h"
+#include "decoder.h"
+Log_SetChannel(CPU_X86::Recompiler);
+
+namespace CPU_X86::Recompiler {
+
+static u32 GetSizeMask(OperandSize size)
+{
+  switch (size)
+  {
+    case OperandSize_8:
+      return UINT32_C(0xFF);
+    case OperandSize_16:
+      return UINT32_C(0xFFFF);
+    default:
+      return UINT32_C(0xFFFFFFFF);
+  }
+}
+
+// Determines which status flags an instruction reads, and which it always overwrites. Anything which isn't known is
+// treated as reading all flags and writing none. Only flags which both the generated code and the interpreter fallback
+// always write are listed. Shifts and rotates are left out, as a zero count leaves the flags untouched.
+static void GetInstructionFlagUsage(const Instruction& instruction, u32* read_flags, u32* written_flags)
+{
+  switch (instruction.operation)
+  {
+    case Operation_NOP:
+    case Operation_LEA:
+    case Operation_MOV:
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+    case Operation_XCHG:
+    case Operation_NOT:
+    case Operation_PUSH:
+    case Operation_POP:
+      *read_flags = 0;
+      *written_flags = 0;
+      break;
+
+    case Operation_ADD:
+    case Operation_SUB:
+    case Operation_CMP:
+    case Operation_NEG:
+    case Operation_AND:
+    case Operation_OR:
+    case Operation_XOR:
+    case Operation_TEST:
+      *read_flags = 0;
+      *written_flags = IRBlock::StatusFlagsMask;
+      break;
+
+    case Operation_ADC:
+    case Operation_SBB:
+      *read_flags = Flag_CF;
+      *written_flags = IRBlock::StatusFlagsMask;
+      break;
+
+    case Operation_INC:
+    case Operation_DEC:
+      *read_flags = 0;
+      *written_flags = IRBlock::StatusFlagsMask & ~Flag_CF;
+      break;
+
+    case Operation_CLC:
+    case Operation_STC:
+      *read_flags = 0;
+      *written_flags = Flag_CF;
+      break;
+
+    default:
+      *read_flags = IRBlock::StatusFlagsMask;
+      *written_flags = 0;
+      break;
+  }
+}
+
+// Determines the register lanes an instruction reads and writes. Returns false if the instruction isn't known, in which
+// case it may read or write anything. Writes are exact. Reads are only exact for instructions which can't fault, since
+// anything which can fault has to see every register anyway.
+static bool GetInstructionRegisterUsage(const Instruction& instruction, u32* read_mask, u32* write_mask)
+{
+  *read_mask = 0;
+  *write_mask = 0;
+
+  const u32 esp_mask = GetRegisterLaneMask(OperandSize_32, Reg32_ESP);
+  auto AddOperandRead = [&](u32 index) {
+    const std::optional<u8> reg = GetOperandRegister(instruction, index);
+    if (reg)
+      *read_mask |= GetRegisterLaneMask(instruction.operands[index].size, *reg);
+    else if (instruction.operands[index].mode != OperandMode_Immediate)
+      *read_mask = IRBlock::AllRegistersMask;
+  };
+  auto AddOperandWrite = [&](u32 index) {
+    const std::optional<u8> reg = GetOperandRegister(instruction, index);
+    if (reg)
+      *write_mask |= GetRegisterLaneMask(instruction.operands[index].size, *reg);
+  };
+
+  switch (instruction.operation)
+  {
+    case Operation_NOP:
+    case Operation_CLC:
+    case Operation_STC:
+    case Operation_CLD:
+    case Operation_STD:
+      return true;
+
+    case Operation_Jcc:
+      // Conditional branches in the middle of a trace are side exits, where every register is visible.
+      *read_mask = IRBlock::AllRegistersMask;
+      return true;
+
+    case Operation_MOV:
+      AddOperandRead(1);
+      AddOperandWrite(0);
+      return true;
+
+    case Operation_ADD:
+    case Operation_SUB:
+    case Operation_ADC:
+    case Operation_SBB:
+    case Operation_AND:
+    case Operation_OR:
+    case Operation_XOR:
+      AddOperandRead(0);
+      AddOperandRead(1);
+      AddOperandWrite(0);
+      return true;
+
+    case Operation_CMP:
+    case Operation_TEST:
+      AddOperandRead(0);
+      AddOperandRead(1);
+      return true;
+
+    case Operation_INC:
+    case Operation_DEC:
+    case Operation_NOT:
+    case Operation_NEG:
+      AddOperandRead(0);
+      AddOperandWrite(0);
+      return true;
+
+    case Operation_LEA:
+    case Operation_MOVZX:
+    case Operation_MOVSX:
+      // The address registers aren't decoded, so these are treated as reading everything.
+      *read_mask = IRBlock::AllRegistersMask;
+      AddOperandWrite(0);
+      return true;
+
+    case Operation_PUSH:
+      *read_mask = IRBlock::AllRegistersMask;
+      *write_mask = esp_mask;
+      return true;
+
+    case Operation_POP:
+      *read_mask = IRBlock::AllRegistersMask;
+      *write_mask = esp_mask;
+      AddOperandWrite(0);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// Returns true for instructions whose codegen checks for folded and dead results.
+static bool CanFoldInstruction(const Instruction& instruction)
+{
+  switch (instruction.operation)
+  {
+    case Operation_MOV:
+    case Operation_LEA:
+    case Operation_ADD:
+    case Operation_SUB:
+    case Operation_ADC:
+    case Operation_SBB:
+    case Operation_CMP:
+    case Operation_AND:
+    case Operation_OR:
+    case Operation_XOR:
+    case Operation_TEST:
+    case Operation_INC:
+    case Operation_DEC:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// Known register values, tracked per byte lane in the same layout as the liveness masks.
+struct KnownRegisters
+{
+  u32 values[8] = {};
+  u32 known_mask = 0;
+
+  bool Get(OperandSize size, u8 reg, u32* value) const
+  {
+    const u32 lanes = GetRegisterLaneMask(size, reg);
+    if ((known_mask & lanes) != lanes)
+      return false;
+
+    if (size == OperandSize_8)
+      *value = (reg < 4) ? (values[reg] & 0xFF) : ((values[reg - 4] >> 8) & 0xFF);
+    else
+      *value = values[reg] & GetSizeMask(size);
+
+    return true;
+  }
+
+  void Set(OperandSize size, u8 reg, u32 value)
+  {
+    if (size == OperandSize_8)
+    {
+      if (reg < 4)
+        values[reg] = (values[reg] & ~UINT32_C(0xFF)) | value;
+      else
+        values[reg - 4] = (values[reg - 4] & ~UINT32_C(0xFF00)) | (value << 8);
+    }
+    else
+    {
+      const u32 mask = GetSizeMask(size);
+      values[reg] = (values[reg] & ~mask) | (value & mask);
+    }
+
+    known_mask |= GetRegisterLaneMask(size, reg);
+  }
+};
+
+// Reads a source operand if its value is known at compile time. Immediates smaller than the destination are
+// sign-extended, as in the code generator.
+static bool GetKnownOperandValue(const Instruction& instruction, u32 index, const KnownRegisters& known, u32* value)
+{
+  const Instruction::Operand& operand = instruction.operands[index];
+  const OperandSize dest_size = instruction.operands[0].size;
+  if (operand.mode == OperandMode_Immediate)
+  {
+    switch (operand.size)
+    {
+      case OperandSize_8:
+        *value = SignExtend32(instruction.data.imm8);
+        break;
+      case OperandSize_16:
+        *value = SignExtend32(instruction.data.imm16);
+        break;
+      default:
+        *value = instruction.data.imm32;
+        break;
+    }
+
+    *value &= GetSizeMask(dest_size);
+    return true;
+  }
+
+  const std::optional<u8> reg = GetOperandRegister(instruction, index);
+  return reg && operand.size == dest_size && known.Get(operand.size, *reg, value);
+}
+
+IRBlock::IRBlock() = default;
+
+IRBlock::~IRBlock() = default;
+
+void IRBlock::Build(const Instruction* instructions, size_t count)
+{
+  m_instructions.clear();
+  m_instructions.resize(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    IRInstruction& ir = m_instructions[i];
+    ir.instruction = &instructions[i];
+    ir.live_flags_after = StatusFlagsMask;
+    ir.live_registers_after = AllRegistersMask;
+  }
+}
+
+void IRBlock::Optimize()
+{
+  ComputeFlagLiveness();
+  PropagateConstants();
+  EliminateDeadRegisterWrites();
+  MergeStackOperations();
+}
+
+void IRBlock::ComputeFlagLiveness()
+{
+  u32 live_flags = StatusFlagsMask;
+  for (size_t i = m_instructions.size(); i > 0; i--)
+  {
+    IRInstruction& ir = m_instructions[i - 1];
+    const Instruction& instruction = *ir.instruction;
+    ir.live_flags_after = live_flags;
+
+    if (IsInvalidInstruction(instruction) || CanInstructionFault(&instruction))
+    {
+      live_flags = StatusFlagsMask;
+      continue;
+    }
+
+    u32 read_flags, written_flags;
+    GetInstructionFlagUsage(instruction, &read_flags, &written_flags);
+    live_flags = (live_flags & ~written_flags) | read_flags;
+  }
+}
+
+void IRBlock::PropagateConstants()
+{
+  KnownRegisters known;
+  for (IRInstruction& ir : m_instructions)
+  {
+    const Instruction& instruction = *ir.instruction;
+    u32 read_mask, write_mask;
+    if (IsInvalidInstruction(instruction) || !GetInstructionRegisterUsage(instruction, &read_mask, &write_mask))
+    {
+      known.known_mask = 0;
+      continue;
+    }
+
+    const Operation operation = instruction.operation;
+    const OperandSize size = instruction.operands[0].size;
+    const std::optional<u8> dest_reg = GetOperandRegister(instruction, 0);
+
+    // Register sources with a known value can be used as an immediate instead. xor/sub reg, reg are left alone, they
+    // already have a special case which doesn't read the register.
+    const std::optional<u8> source_reg = GetOperandRegister(instruction, 1);
+    u32 source_value;
+    const bool has_source_value = GetKnownOperandValue(instruction, 1, known, &source_value);
+    if (source_reg && has_source_value && !OperandRegistersMatch(instruction, 0, 1) &&
+        (operation == Operation_MOV || operation == Operation_ADD || operation == Operation_SUB ||
+         operation == Operation_ADC || operation == Operation_SBB || operation == Operation_CMP ||
+         operation == Operation_AND || operation == Operation_OR || operation == Operation_XOR ||
+         operation == Operation_TEST))
+    {
+      ir.flags |= IRFlags::ConstantSource;
+      ir.source_value = source_value;
+    }
+
+    std::optional<u32> result;
+    u32 dest_value;
+    const bool has_dest_value = dest_reg && known.Get(size, *dest_reg, &dest_value);
+    switch (operation)
+    {
+      case Operation_MOV:
+        if (has_source_value)
+          result = source_value;
+        break;
+
+      case Operation_SUB:
+      case Operation_XOR:
+        if (OperandRegistersMatch(instruction, 0, 1))
+          result = 0;
+        else if (has_dest_value && has_source_value)
+          result = (operation == Operation_SUB) ? (dest_value - source_value) : (dest_value ^ source_value);
+        break;
+
+      case Operation_ADD:
+        if (has_dest_value && has_source_value)
+          result = dest_value + source_value;
+        break;
+
+      case Operation_AND:
+        if (has_dest_value && has_source_value)
+          result = dest_value & source_value;
+        break;
+
+      case Operation_OR:
+        if (has_dest_value && has_source_value)
+          result = dest_value | source_value;
+        break;
+
+      case Operation_INC:
+      case Operation_DEC:
+        if (has_dest_value)
+          result = (operation == Operation_INC) ? (dest_value + 1) : (dest_value - 1);
+        break;
+
+      default:
+        break;
+    }
+
+    // Everything written is unknown, unless the result was computed.
+    known.known_mask &= ~write_mask;
+    if (!dest_reg || !result)
+      continue;
+
+    *result &= GetSizeMask(size);
+    known.Set(size, *dest_reg, *result);
+
+    // Results are only folded when none of the flags they would write are needed. MOV doesn't need folding, a known
+    // source is already a constant.
+    u32 read_flags, written_flags;
+    GetInstructionFlagUsage(instruction, &read_flags, &written_flags);
+    if (operation != Operation_MOV && (ir.live_flags_after & written_flags) == 0)
+    {
+      ir.flags |= IRFlags::ConstantResult;
+      ir.result_value = *result;
+    }
+  }
+}
+
+void IRBlock::EliminateDeadRegisterWrites()
+{
+  u32 live_registers = AllRegistersMask;
+  for (size_t i = m_instructions.size(); i > 0; i--)
+  {
+    IRInstruction& ir = m_instructions[i - 1];
+    const Instruction& instruction = *ir.instruction;
+    ir.live_registers_after = live_registers;
+
+    u32 read_mask, write_mask;
+    if (IsInvalidInstruction(instruction) || CanInstructionFault(&instruction) ||
+        !GetInstructionRegisterUsage(instruction, &read_mask, &write_mask))
+    {
+      live_registers = AllRegistersMask;
+      continue;
+    }
+
+    // ESP writes also update the exception state, so they're always kept.
+    u32 read_flags, written_flags;
+    GetInstructionFlagUsage(instruction, &read_flags, &written_flags);
+    if (CanFoldInstruction(instruction) && !OperandIsESP(instruction, 0) && (write_mask & live_registers) == 0 &&
+        (written_flags & ir.live_flags_after) == 0)
+    {
+      // Nothing it does is needed, so it doesn't read anything either.
+      ir.flags |= IRFlags::DeadResult;
+      continue;
+    }
+
+    live_registers = (live_registers & ~write_mask) | read_mask;
+  }
+}
+
+void IRBlock::MergeStackOperations()
+{
+  auto IsStackRunInstruction = [](const Instruction& instruction, const Instruction& first) {
+    if (instruction.operation != first.operation || instruction.operands[0].mode != OperandMode_Register ||
+        instruction.operands[0].size != first.operands[0].size || instruction.length != first.length ||
+        IsInvalidInstruction(instruction))
+    {
+      return false;
+    }
+
+    // PUSH/POP ESP use the value of ESP from before/after the operation, so they're left to the regular path.
+    return (instruction.operands[0].reg32 != Reg32_ESP);
+  };
+
+  const size_t count = m_instructions.size();
+  for (size_t start = 0; start < count;)
+  {
+    const Instruction& first = *m_instructions[start].instruction;
+    if ((first.operation != Operation_PUSH && first.operation != Operation_POP) || !IsStackRunInstruction(first, first))
+    {
+      start++;
+      continue;
+    }
+
+    size_t end = start + 1;
+    while (end < count && (end - start) < MaxStackRunLength &&
+           IsStackRunInstruction(*m_instructions[end].instruction, first))
+    {
+      end++;
+    }
+
+    const u32 run_length = static_cast<u32>(end - start);
+    if (run_length < 2)
+    {
+      start++;
+      continue;
+    }
+
+    u32 registers = 0;
+    for (u32 i = 0; i < run_length; i++)
+    {
+      registers |= static_cast<u32>(m_instructions[start + i].instruction->operands[0].reg32) << (i * 3);
+      if (i > 0)
+        m_instructions[start + i].flags |= IRFlags::StackRunMember;
+    }
+
+    m_instructions[start].flags |= IRFlags::StackRunStart;
+    m_instructions[start].stack_run = EncodeStackRun(registers, run_length, first.length);
+    start = end;
+  }
+}
+
+void IRBlock::Dump(const char* title) const
+{
+  Log_InfoPrintf("-- IR %s (%zu instructions) --", title, m_instructions.size());
+
+  for (const IRInstruction& ir : m_instructions)
+  {
+    SmallString disasm;
+    Decoder::DisassembleToString(ir.instruction, &disasm);
+
+    SmallString annotations;
+    if (ir.HasConstantSource())
+      annotations.AppendFormattedString(" src=%X", ir.source_value);
+    if (ir.HasConstantResult())
+      annotations.AppendFormattedString(" result=%X", ir.result_value);
+    if (ir.IsDeadResult())
+      annotations.AppendString(" dead");
+    if (ir.IsStackRunStart())
+      annotations.AppendFormattedString(" stackrun=%u", GetStackRunCount(ir.stack_run));
+    if (ir.IsStackRunMember())
+      annotations.AppendString(" inrun");
+
+    Log_InfoPrintf("  %08x: %-32s flags=%03X regs=%08X%s", ir.instruction->address, disasm.GetCharArray(),
+                   ir.live_flags_after, ir.live_registers_after, annotations.GetCharArray());
+  }
+
+  Log_InfoPrintf("-- END IR --");
+}
+
+} // namespace CPU_X86::Recompiler
@@ -0,0 +1,92 @@
+#pragma once
+#include "pce/cpu_x86/code_cache_types.h"
+#include "pce/cpu_x86/instruction.h"
+#include "pce/types.h"
+
+#include <vector>
+
+namespace CPU_X86::Recompiler {
+
+enum class IRFlags : u8
+{
+  None = 0,
+  ConstantSource = (1 << 0), // Source operand is a register whose value is known, and is read as source_value.
+  ConstantResult = (1 << 1), // Destination register always receives result_value, and no written flag is live.
+  DeadResult = (1 << 2),     // Nothing the instruction writes is read before being overwritten, and it can't fault.
+  StackRunStart = (1 << 3),  // First of a run of register PUSHes/POPs which execute as a single thunk call.
+  StackRunMember = (1 << 4), // Executed by the start of its run, generates no code itself.
+};
+IMPLEMENT_ENUM_CLASS_BITWISE_OPERATORS(IRFlags);
+
+// A guest instruction along with everything the passes have worked out about it. Values are truncated to the size of
+// the operand they belong to.
+struct IRInstruction
+{
+  const Instruction* instruction = nullptr;
+  u32 live_flags_after = 0;
+  u32 live_registers_after = 0;
+  u32 source_value = 0;
+  u32 result_value = 0;
+  u32 stack_run = 0;
+  IRFlags flags = IRFlags::None;
+
+  bool HasConstantSource() const { return (flags & IRFlags::ConstantSource) != IRFlags::None; }
+  bool HasConstantResult() const { return (flags & IRFlags::ConstantResult) != IRFlags::None; }
+  bool IsDeadResult() const { return (flags & IRFlags::DeadResult) != IRFlags::None; }
+  bool IsStackRunStart() const { return (flags & IRFlags::StackRunStart) != IRFlags::None; }
+  bool IsStackRunMember() const { return (flags & IRFlags::StackRunMember) != IRFlags::None; }
+};
+
+// Stack runs are packed into a single value which is passed to the thunk. Registers take three bits each from the
+// bottom, followed by the number of instructions and the length of each instruction.
+constexpr u32 MaxStackRunLength = 8;
+constexpr u32 EncodeStackRun(u32 registers, u32 count, u32 length) { return registers | (count << 24) | (length << 28); }
+constexpr u32 GetStackRunRegister(u32 run, u32 index) { return (run >> (index * 3)) & 7; }
+constexpr u32 GetStackRunCount(u32 run) { return (run >> 24) & 0xF; }
+constexpr u32 GetStackRunInstructionLength(u32 run) { return run >> 28; }
+
+// Analysis of a block between decoding and code generation. The decoded instructions are kept as the operations, and
+// the passes annotate them, so the code generator still works per instruction but can skip or simplify work.
+class IRBlock
+{
+public:
+  static constexpr u32 StatusFlagsMask = Flag_CF | Flag_PF | Flag_AF | Flag_ZF | Flag_SF | Flag_OF;
+
+  /// Registers are tracked per byte lane, four bits for each 32-bit register.
+  static constexpr u32 AllRegistersMask = UINT32_C(0xFFFFFFFF);
+
+  IRBlock();
+  ~IRBlock();
+
+  /// Creates an unoptimized IR for the instructions. Everything is assumed to be live.
+  void Build(const Instruction* instructions, size_t count);
+
+  /// Runs all passes.
+  void Optimize();
+
+  /// Logs the IR, one instruction per line with its annotations.
+  void Dump(const char* title) const;
+
+  size_t GetSize() const { return m_instructions.size(); }
+  const IRInstruction* begin() const { return m_instructions.data(); }
+  const IRInstruction* end() const { return m_instructions.data() + m_instructions.size(); }
+
+private:
+  /// Computes the status flags live after each instruction, walking backwards from the block end where all flags are
+  /// live. Instructions which can fault read all flags, so exceptions always see the precise state.
+  void ComputeFlagLiveness();
+
+  /// Tracks known values of the guest registers through the block. Register sources with known values become
+  /// constants, and register results which are known and don't need their flags are folded.
+  void PropagateConstants();
+
+  /// Computes register liveness, and removes register writes which are overwritten before being read.
+  void EliminateDeadRegisterWrites();
+
+  /// Merges consecutive PUSH/POP reg instructions so they execute through a single call.
+  void MergeStackOperations();
+
+  std::vector<IRInstruction> m_instructions;
+};
+
+} // namespace CPU_X86::Recompiler
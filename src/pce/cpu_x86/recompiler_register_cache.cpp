@@ -316,7 +316,7 @@ u32 RegisterCache::PopCallerSavedRegisters() const
   return count;
 }
 
-u32 RegisterCache::PopCalleeSavedRegisters()
+u32 RegisterCache::PopCalleeSavedRegisters(bool commit /* = true */)
 {
   if (m_host_register_callee_saved_order_count == 0)
     return 0;
@@ -330,7 +330,8 @@ u32 RegisterCache::PopCalleeSavedRegisters()
                 (HostRegState::CalleeSaved | HostRegState::CalleeSavedAllocated));
 
     m_code_generator.EmitPopHostReg(reg);
-    m_host_register_state[reg] &= ~HostRegState::CalleeSavedAllocated;
+    if (commit)
+      m_host_register_state[reg] &= ~HostRegState::CalleeSavedAllocated;
     count++;
     i--;
   } while (i > 0);
@@ -176,8 +176,9 @@ public:
   u32 PushCallerSavedRegisters() const;
   u32 PopCallerSavedRegisters() const;
 
-  /// Restore callee-saved registers. Call at the end of the function.
-  u32 PopCalleeSavedRegisters();
+  /// Restore callee-saved registers. Call at the end of the function. Exits in the middle of the function pass false
+  /// for commit, so the registers stay allocated for the code which follows.
+  u32 PopCalleeSavedRegisters(bool commit = true);
 
   //////////////////////////////////////////////////////////////////////////
   // Scratch Register Allocation
@@ -1,4 +1,5 @@
 #include "recompiler_thunks.h"
+#include "recompiler_ir.h"
 
 namespace CPU_X86::Recompiler {
 
@@ -81,4 +82,63 @@ void Thunks::BranchTo(CPU* cpu, u32 address)
   cpu->BranchTo(address);
 }
 
-} // namespace CPU_X86::Recompiler
\ No newline at end of file
+u32 Thunks::BulkMOVS(CPU* cpu, u32 operand_size, u32 address_size, u32 src_segment)
+{
+  return cpu->ExecuteBulkStringOperation(Operation_MOVS, static_cast<OperandSize>(operand_size),
+                                         static_cast<AddressSize>(address_size), static_cast<Segment>(src_segment));
+}
+
+u32 Thunks::BulkSTOS(CPU* cpu, u32 operand_size, u32 address_size)
+{
+  return cpu->ExecuteBulkStringOperation(Operation_STOS, static_cast<OperandSize>(operand_size),
+                                         static_cast<AddressSize>(address_size), Segment_ES);
+}
+
+u32 Thunks::BulkLODS(CPU* cpu, u32 operand_size, u32 address_size, u32 src_segment)
+{
+  return cpu->ExecuteBulkStringOperation(Operation_LODS, static_cast<OperandSize>(operand_size),
+                                         static_cast<AddressSize>(address_size), static_cast<Segment>(src_segment));
+}
+
+void Thunks::PushRegisterRun(CPU* cpu, u32 run, u32 operand_size)
+{
+  const u32 count = GetStackRunCount(run);
+  for (u32 i = 0; i < count; i++)
+  {
+    if (i > 0)
+      BeginStackRunInstruction(cpu, run, CYCLES_PUSH_REG);
+
+    const u32 reg = GetStackRunRegister(run, i);
+    if (operand_size == OperandSize_16)
+      cpu->PushWord(cpu->m_registers.reg16[reg]);
+    else
+      cpu->PushDWord(cpu->m_registers.reg32[reg]);
+  }
+}
+
+void Thunks::PopRegisterRun(CPU* cpu, u32 run, u32 operand_size)
+{
+  const u32 count = GetStackRunCount(run);
+  for (u32 i = 0; i < count; i++)
+  {
+    if (i > 0)
+      BeginStackRunInstruction(cpu, run, CYCLES_POP_REG);
+
+    const u32 reg = GetStackRunRegister(run, i);
+    if (operand_size == OperandSize_16)
+      cpu->m_registers.reg16[reg] = cpu->PopWord();
+    else
+      cpu->m_registers.reg32[reg] = cpu->PopDWord();
+  }
+}
+
+void Thunks::BeginStackRunInstruction(CPU* cpu, u32 run, CYCLE_GROUP cycles)
+{
+  // Same as the prologue the generated code would have emitted for the instruction.
+  cpu->m_current_EIP = cpu->m_registers.EIP;
+  cpu->m_registers.EIP = (cpu->m_registers.EIP + GetStackRunInstructionLength(run)) & cpu->m_EIP_mask;
+  cpu->m_current_ESP = cpu->m_registers.ESP;
+  cpu->AddCycles(cycles);
+}
+
+} // namespace CPU_X86::Recompiler
@@ -25,6 +25,17 @@ public:
   static u16 PopWord(CPU* cpu);
   static u32 PopDWord(CPU* cpu);
   static void BranchTo(CPU* cpu, u32 address);
+  static u32 BulkMOVS(CPU* cpu, u32 operand_size, u32 address_size, u32 src_segment);
+  static u32 BulkSTOS(CPU* cpu, u32 operand_size, u32 address_size);
+  static u32 BulkLODS(CPU* cpu, u32 operand_size, u32 address_size, u32 src_segment);
+
+  /// Executes a run of PUSH/POP reg instructions, encoded by EncodeStackRun. The generated code has already set up
+  /// the first instruction.
+  static void PushRegisterRun(CPU* cpu, u32 run, u32 operand_size);
+  static void PopRegisterRun(CPU* cpu, u32 run, u32 operand_size);
+
+private:
+  static void BeginStackRunInstruction(CPU* cpu, u32 run, CYCLE_GROUP cycles);
 };
 
 class ASMFunctions
@@ -33,4 +33,25 @@ constexpr OperandSize HostPointerSize = OperandSize_64;
 
 using BlockFunctionType = void (*)(CPU*);
 
+// Number of times each operation has been executed through the interpreter fallback. Incremented by the generated code,
+// so this reflects what the guest is actually running, not just what was compiled.
+using FallbackOperationCounts = std::array<u64, Operation_Count>;
+
+// Maximum number of successors a block can jump to directly, one for each static target of the exit instruction.
+constexpr u32 MaxBlockLinkSlots = 2;
+
+// A patchable jump at the end of a block. When linked, execution continues directly in the successor's code if
+// EIP and the CS base match, and no event/interrupt is pending. Otherwise, the jump goes back to the dispatcher.
+struct BlockLinkSlot
+{
+  u8* eip_immediate = nullptr;
+  u8* cs_base_immediate = nullptr;
+  u8* jump_displacement = nullptr;
+  const void* unlinked_target = nullptr;
+  BlockBase* linked_block = nullptr;
+
+  // EIP of the exit target the slot was emitted for.
+  u32 target_eip = 0;
+};
+
 } // namespace CPU_X86::Recompiler
\ No newline at end of file
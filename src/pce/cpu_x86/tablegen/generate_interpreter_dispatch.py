@@ -6,6 +6,17 @@ import sys
 
 MODULE = None
 DISPATCH_FUNCTION_NAME = ""
+LAZY_FLAGS = False
+
+# Operations whose status flags the x86 dispatcher records lazily, and which evaluate conditions from the record.
+LAZY_FLAG_OPERATIONS = {Operation.ADD, Operation.SUB, Operation.CMP, Operation.AND, Operation.OR, Operation.XOR,
+                        Operation.TEST, Operation.INC, Operation.DEC, Operation.Jcc, Operation.SETcc}
+
+# Operations which neither read nor write the status flags, so can run with flags still pending. Everything else writes
+# them out first.
+FLAG_NEUTRAL_OPERATIONS = {Operation.MOV, Operation.MOVZX, Operation.MOVSX, Operation.LEA, Operation.XCHG,
+                           Operation.PUSH, Operation.POP, Operation.NOP, Operation.JMP_Near, Operation.CALL_Near,
+                           Operation.RET_Near}
 
 def gen_dispatch(writer):
     writer.write("void %s(CPU* cpu)" % DISPATCH_FUNCTION_NAME)
@@ -96,10 +107,16 @@ def gen_opcode(writer, opcode, modrm_fetched, prefix):
             line += (", " if count > 0 else "<") + opcode.operands[i].template_value()
             count += 1
 
+        lazy = LAZY_FLAGS and opcode.operation in LAZY_FLAG_OPERATIONS
+        if lazy:
+            line += ", true"
+
         if count > 0:
             line += ">"
 
         line += "(cpu);"
+        if LAZY_FLAGS and not lazy and opcode.operation not in FLAG_NEUTRAL_OPERATIONS:
+            writer.write("cpu->SyncLazyFlags();")
         writer.write(line)
         writer.write("return;")
         writer.deindent()
@@ -221,6 +238,7 @@ if __name__ == "__main__":
     elif sys.argv[1] == "x86":
         MODULE = opcodes_x86
         DISPATCH_FUNCTION_NAME = "CPU_X86::Interpreter::Dispatch"
+        LAZY_FLAGS = True
         gen_dispatch(writer)
         gen_handler_table(writer, "CPU_X86::Interpreter", "s_handler_functions")
     
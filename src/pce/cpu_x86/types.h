@@ -1116,9 +1116,11 @@ union PAGE_DIRECTORY_ENTRY
   BitField<u32, bool, 3, 1> write_through;
   BitField<u32, bool, 4, 1> cache_disabled;
   BitField<u32, bool, 5, 1> accessed;
+  BitField<u32, bool, 6, 1> dirty; // 4MB pages only
   BitField<u32, bool, 7, 1> page_size;
-  // BitField<uint32, bool, 8, 1> ignored;
+  BitField<u32, bool, 8, 1> global; // 4MB pages only
   BitField<u32, u32, 12, 20> page_table_address;
+  BitField<u32, u32, 22, 10> large_page_address;
 };
 
 union PAGE_TABLE_ENTRY
@@ -335,6 +335,7 @@ void HostInterface::OnSystemReset()
   m_speed_elapsed_real_time.Reset();
   m_speed_elapsed_simulation_time = m_system->GetSimulationTime();
   m_system->GetCPU()->GetExecutionStats(&m_last_cpu_execution_stats);
+  m_last_events_dispatched = m_system->GetEventsDispatched();
   GetAudioMixer()->ClearBuffers();
   ReportFormattedMessage("System reset.");
   Log_InfoPrintf("System reset.");
@@ -350,6 +351,7 @@ void HostInterface::OnSystemStateLoaded()
   m_speed_elapsed_kernel_time = 0;
   m_speed_elapsed_user_time = 0;
   m_system->GetCPU()->GetExecutionStats(&m_last_cpu_execution_stats);
+  m_last_events_dispatched = m_system->GetEventsDispatched();
   GetAudioMixer()->ClearBuffers();
 }
 
@@ -617,6 +619,17 @@ void HostInterface::UpdateExecutionSpeed()
     stats.cpu_stats.code_cache_blocks_executed - m_last_cpu_execution_stats.code_cache_blocks_executed;
   stats.cpu_delta_code_cache_instructions_executed =
     stats.cpu_stats.code_cache_instructions_executed - m_last_cpu_execution_stats.code_cache_instructions_executed;
+  stats.cpu_delta_cached_interpreter_instructions_executed =
+    stats.cpu_stats.cached_interpreter_instructions_executed -
+    m_last_cpu_execution_stats.cached_interpreter_instructions_executed;
+  stats.cpu_delta_recompiled_instructions_executed =
+    stats.cpu_stats.recompiled_instructions_executed - m_last_cpu_execution_stats.recompiled_instructions_executed;
+
+  const u64 events_dispatched = m_system->GetEventsDispatched();
+  stats.events_dispatched_per_second =
+    static_cast<float>(static_cast<double>(events_dispatched - m_last_events_dispatched) * 1000000000.0 /
+                       static_cast<double>(elapsed_sim_time));
+  m_last_events_dispatched = events_dispatched;
 
   u64 elapsed_kernel_time_ns = 0;
   u64 elapsed_user_time_ns = 0;
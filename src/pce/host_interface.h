@@ -155,6 +155,11 @@ protected:
     u64 cpu_delata_interrupts_serviced;
     u64 cpu_delta_code_cache_blocks_executed;
     u64 cpu_delta_code_cache_instructions_executed;
+    u64 cpu_delta_cached_interpreter_instructions_executed;
+    u64 cpu_delta_recompiled_instructions_executed;
+
+    // Event callbacks run per simulated second.
+    float events_dispatched_per_second;
 
     // TODO: Frames
   };
@@ -236,4 +241,5 @@ private:
 
   // Stats tracking
   CPU::ExecutionStats m_last_cpu_execution_stats = {};
+  u64 m_last_events_dispatched = 0;
 };
@@ -234,6 +234,31 @@ void ATADevice::WriteDataPort(const void* buffer, u32 size)
   }
 }
 
+u32 ATADevice::ReadDataPortBlock(void* buffer, u32 size, u32 count)
+{
+  if (!m_buffer.valid || m_buffer.is_write || m_buffer.is_dma)
+    return 0;
+
+  // The next buffer may not be ready straight away, so the transfer stops at the end of this one.
+  const u32 transfer_count = std::min(count, (m_buffer.size - m_buffer.position) / size);
+  if (transfer_count > 0)
+    ReadDataPort(buffer, transfer_count * size);
+
+  return transfer_count;
+}
+
+u32 ATADevice::WriteDataPortBlock(const void* buffer, u32 size, u32 count)
+{
+  if (!m_buffer.valid || !m_buffer.is_write || m_buffer.is_dma)
+    return 0;
+
+  const u32 transfer_count = std::min(count, (m_buffer.size - m_buffer.position) / size);
+  if (transfer_count > 0)
+    WriteDataPort(buffer, transfer_count * size);
+
+  return transfer_count;
+}
+
 void ATADevice::SetupBuffer(u32 size, bool is_write, bool dma)
 {
   m_buffer.size = size;
@@ -241,6 +241,10 @@ public:
   void ReadDataPort(void* buffer, u32 size);
   void WriteDataPort(const void* buffer, u32 size);
 
+  // Transfers up to count elements of size bytes, stopping at the end of the buffer. Returns the number transferred.
+  u32 ReadDataPortBlock(void* buffer, u32 size, u32 count);
+  u32 WriteDataPortBlock(const void* buffer, u32 size, u32 count);
+
 protected:
   static constexpr u32 SERIALIZATION_ID = MakeSerializationID('A', 'T', 'A', 'D');
 
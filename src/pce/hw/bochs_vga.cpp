@@ -232,6 +232,12 @@ void BochsVGA::UpdateVGAMemoryMapping()
       handlers.write_dword = [this](u32 offset, u32 value) {
         std::memcpy(&m_vram[ZeroExtend32(m_vbe_bank) * VBE_DISPI_BANK_SIZE + offset], &value, sizeof(value));
       };
+      handlers.read_block = [this](u32 offset, u32 length, void* destination) {
+        std::memcpy(destination, &m_vram[ZeroExtend32(m_vbe_bank) * VBE_DISPI_BANK_SIZE + offset], length);
+      };
+      handlers.write_block = [this](u32 offset, u32 length, const void* source) {
+        std::memcpy(&m_vram[ZeroExtend32(m_vbe_bank) * VBE_DISPI_BANK_SIZE + offset], source, length);
+      };
     }
 
     // VBE banked modes are always mapped to A0000 and 64KB in size.
@@ -245,8 +251,10 @@ void BochsVGA::UpdateVGAMemoryMapping()
     GetVGAMemoryMapping(&start_address, &size);
 
     MMIO::Handlers handlers;
-    handlers.read_byte = [this](u32 offset) { return HandleVGAVRAMRead(0, offset); };
-    handlers.write_byte = [this](u32 offset, u8 value) { HandleVGAVRAMWrite(0, offset, value); };
+    handlers.Bind<&BochsVGA::HandleVGAVRAMReadByte>(this);
+    handlers.Bind<&BochsVGA::HandleVGAVRAMWriteByte>(this);
+    handlers.Bind<&BochsVGA::HandleVGAVRAMReadBlock>(this);
+    handlers.Bind<&BochsVGA::HandleVGAVRAMWriteBlock>(this);
 
     m_vga_mmio = MMIO::CreateComplex(start_address, size, std::move(handlers), false);
     BaseClass::m_bus->ConnectMMIO(m_vga_mmio);
@@ -232,6 +232,12 @@ void HDC::ConnectIOPorts(Bus* bus, u32 channel, u16 BAR0, u16 BAR1, u8 irq)
                               std::bind(&HDC::IOWriteDataRegisterWord, this, channel, std::placeholders::_2));
   bus->ConnectIOPortWriteDWord(BAR0 + 0, this,
                                std::bind(&HDC::IOWriteDataRegisterDWord, this, channel, std::placeholders::_2));
+  bus->ConnectIOPortReadBlock(BAR0 + 0, this,
+                              std::bind(&HDC::IOReadDataRegisterBlock, this, channel, std::placeholders::_2,
+                                        std::placeholders::_3, std::placeholders::_4));
+  bus->ConnectIOPortWriteBlock(BAR0 + 0, this,
+                               std::bind(&HDC::IOWriteDataRegisterBlock, this, channel, std::placeholders::_2,
+                                         std::placeholders::_3, std::placeholders::_4));
 
   // 01F1 - Status register (R)
   // 01F1	w	WPC/4  (Write Precompensation Cylinder divided by 4)
@@ -430,6 +436,18 @@ void HDC::IOWriteDataRegisterDWord(u32 channel, u32 value)
     device->WriteDataPort(&value, sizeof(value));
 }
 
+u32 HDC::IOReadDataRegisterBlock(u32 channel, u32 size, u32 count, void* destination)
+{
+  ATADevice* device = GetCurrentDevice(channel);
+  return device ? device->ReadDataPortBlock(destination, size, count) : 0;
+}
+
+u32 HDC::IOWriteDataRegisterBlock(u32 channel, u32 size, u32 count, const void* source)
+{
+  ATADevice* device = GetCurrentDevice(channel);
+  return device ? device->WriteDataPortBlock(source, size, count) : 0;
+}
+
 u8 HDC::IOReadCommandBlockSectorCount(u32 channel)
 {
   const ATADevice* device = GetCurrentDevice(channel);
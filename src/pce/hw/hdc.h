@@ -108,6 +108,8 @@ protected:
   void IOWriteDataRegisterByte(u32 channel, u8 value);
   void IOWriteDataRegisterWord(u32 channel, u16 value);
   void IOWriteDataRegisterDWord(u32 channel, u32 value);
+  u32 IOReadDataRegisterBlock(u32 channel, u32 size, u32 count, void* destination);
+  u32 IOWriteDataRegisterBlock(u32 channel, u32 size, u32 count, const void* source);
 
   u8 IOReadCommandBlockSectorCount(u32 channel);
   u8 IOReadCommandBlockSectorNumber(u32 channel);
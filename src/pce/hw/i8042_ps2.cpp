@@ -48,6 +48,10 @@ bool i8042_PS2::Initialize(System* system, Bus* bus)
   bus->ConnectIOPortRead(0x64, this, std::bind(&i8042_PS2::IOReadStatusRegister, this));
   bus->ConnectIOPortWrite(0x64, this, std::bind(&i8042_PS2::IOWriteCommandRegister, this, std::placeholders::_2));
 
+  // Data and status only change on command/transfer events, so keyboard polling loops can be skipped.
+  bus->MarkIOPortReadEventDriven(0x60, this);
+  bus->MarkIOPortReadEventDriven(0x64, this);
+
   m_system->GetHostInterface()->AddKeyboardCallback(
     this, std::bind(&i8042_PS2::OnHostKeyboardEvent, this, std::placeholders::_1, std::placeholders::_2));
   m_system->GetHostInterface()->AddMousePositionChangeCallback(
@@ -173,9 +173,11 @@ bool i8253_PIT::GetChannelOutputState(size_t channel_index)
   return m_channels[channel_index].output_state;
 }
 
-void i8253_PIT::SetChannelOutputChangeCallback(size_t channel_index, ChannelOutputChangeCallback callback)
+void i8253_PIT::SetChannelOutputChangeCallback(size_t channel_index, ChannelOutputChangeCallback callback,
+                                               bool wake_on_falling_edge /* = true */)
 {
   m_channels[channel_index].change_callback = std::move(callback);
+  m_channels[channel_index].wake_on_falling_edge = wake_on_falling_edge;
 }
 
 void i8253_PIT::ConnectIOPorts(Bus* bus)
@@ -202,12 +204,9 @@ CycleCount i8253_PIT::GetDowncount() const
       downcount = (downcount != 0) ? std::min(downcount, channel.downcount) : channel.downcount;
   }
 
-  // Just use some stupidly high number of cycles, since we don't need to force sync.
+  // No edges are pending, and everything else is caught up on access.
   if (downcount == 0)
-  {
-    // Every 100ms should do..
-    downcount = CycleCount(CLOCK_FREQUENCY / 10);
-  }
+    downcount = IDLE_DOWNCOUNT;
 
   return downcount;
 }
@@ -614,6 +613,7 @@ void i8253_PIT::SimulateChannel(size_t channel_index, CycleCount cycles)
         // The current count will wrap around to 0xFFFF (or 0x9999 in BCD mode) and continue to decrement until the
         // mode/command register or the reload register are set, however this will not effect the output pin state.
         channel->count = channel->bcd_mode ? 0x9999 : 0xFFFF;
+        cycles %= channel->count;
       }
 
       channel->count -= cycles;
@@ -638,6 +638,7 @@ void i8253_PIT::SimulateChannel(size_t channel_index, CycleCount cycles)
         // The current count will wrap around to 0xFFFF (or 0x9999 in BCD mode) and continue to decrement until the
         // mode/command register or the reload register are set, however this will not effect the output pin state.
         channel->count = channel->bcd_mode ? 0x9999 : 0xFFFF;
+        cycles %= channel->count;
       }
 
       channel->count -= cycles;
@@ -669,6 +670,10 @@ void i8253_PIT::SimulateChannel(size_t channel_index, CycleCount cycles)
           cycles--;
           channel->count = GetFrequencyFromReloadValue(channel);
           SetChannelOutputState(channel_index, true);
+
+          // Without a callback nothing sees the edges in between, so skip over whole periods.
+          if (!channel->HasCallback())
+            cycles %= channel->count;
         }
       }
 
@@ -722,6 +727,10 @@ void i8253_PIT::SimulateChannel(size_t channel_index, CycleCount cycles)
           if (channel->square_wave_flip_flop)
             channel->count++;
         }
+
+        // A full period is both halves, rounded down to even, plus the delayed reload for odd values.
+        if (!channel->HasCallback())
+          cycles %= (GetFrequencyFromReloadValue(channel) & ~CycleCount(1)) * 2 + (channel->reload_value % 2);
       }
 
       channel->count -= cycles;
@@ -749,6 +758,9 @@ void i8253_PIT::SimulateChannel(size_t channel_index, CycleCount cycles)
         // In real-time, this happens early, but in cycles it'll be correct.
         SetChannelOutputState(channel_index, true);
         channel->count++;
+
+        if (!channel->HasCallback())
+          cycles %= channel->count;
       }
 
       channel->count -= cycles;
@@ -786,19 +798,26 @@ CycleCount i8253_PIT::UpdateChannelDowncount(size_t channel_index)
 
     case ChannelOperatingModeRateGenerator:
     {
-      if (!channel->waiting_for_reload && channel->gate_input && channel->HasCallback())
+      // The output goes low one cycle before the count is reloaded, and high again on the reload.
+      if (channel->waiting_for_reload || !channel->gate_input || !channel->HasCallback())
+        channel->downcount = 0;
+      else if (channel->wake_on_falling_edge)
         channel->downcount = std::max(channel->count - 1, CycleCount(1));
       else
-        channel->downcount = 0;
+        channel->downcount = std::max(channel->count, CycleCount(1));
     }
     break;
 
     case ChannelOperatingModeSquareWaveGenerator:
     {
-      if (!channel->waiting_for_reload && channel->gate_input && channel->HasCallback())
-        channel->downcount = std::max(channel->count / 2, CycleCount(1));
-      else
+      // The count decrements by two each cycle. When the output is high, the next rising edge is after the low half.
+      if (channel->waiting_for_reload || !channel->gate_input || !channel->HasCallback())
         channel->downcount = 0;
+      else if (channel->wake_on_falling_edge || !channel->square_wave_flip_flop)
+        channel->downcount = std::max((channel->count + 1) / 2, CycleCount(1));
+      else
+        channel->downcount =
+          std::max((channel->count + (GetFrequencyFromReloadValue(channel) & ~CycleCount(1)) + 1) / 2, CycleCount(1));
     }
     break;
 
@@ -38,8 +38,11 @@ public:
   void SetChannelGateInput(size_t channel_index, bool value);
 
   // Sets up a callback for a channel. If not set, the channel will only be readable via IO.
+  // Clearing wake_on_falling_edge lets falling edges be delivered late, just before the following rising edge, which
+  // halves the number of events for inputs which only act on rising edges, such as the edge-triggered IRQ 0.
   using ChannelOutputChangeCallback = std::function<void(bool)>;
-  void SetChannelOutputChangeCallback(size_t channel_index, ChannelOutputChangeCallback callback);
+  void SetChannelOutputChangeCallback(size_t channel_index, ChannelOutputChangeCallback callback,
+                                      bool wake_on_falling_edge = true);
 
 private:
   static constexpr u32 SERIALIZATION_ID = MakeSerializationID('8', '2', '5', '3');
@@ -49,6 +52,10 @@ private:
   static constexpr u32 IOPORT_CHANNEL_2_DATA = 0x42;
   static constexpr u32 IOPORT_COMMAND_REGISTER = 0x43;
 
+  // Counters are caught up when accessed, so the tick event only has to run for output edges. Without any pending,
+  // it still runs occasionally to keep the number of cycles to catch up bounded.
+  static constexpr CycleCount IDLE_DOWNCOUNT = CycleCount(CLOCK_FREQUENCY) * 60;
+
   enum ChannelAccessMode : u8
   {
     ChannelAccessModeMSB,
@@ -92,6 +99,7 @@ private:
     bool square_wave_flip_flop = false;
 
     ChannelOutputChangeCallback change_callback;
+    bool wake_on_falling_edge = true;
 
     bool HasCallback() const { return static_cast<bool>(change_callback); }
   };
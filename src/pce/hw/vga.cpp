@@ -95,8 +95,10 @@ void VGA::UpdateVGAMemoryMapping()
   }
 
   MMIO::Handlers handlers;
-  handlers.read_byte = [this](u32 offset) { return HandleVGAVRAMRead(0, offset); };
-  handlers.write_byte = [this](u32 offset, u8 value) { HandleVGAVRAMWrite(0, offset, value); };
+  handlers.Bind<&VGA::HandleVGAVRAMReadByte>(this);
+  handlers.Bind<&VGA::HandleVGAVRAMWriteByte>(this);
+  handlers.Bind<&VGA::HandleVGAVRAMReadBlock>(this);
+  handlers.Bind<&VGA::HandleVGAVRAMWriteBlock>(this);
 
   m_vram_mmio = MMIO::CreateComplex(start_address, size, std::move(handlers), false);
   m_bus->ConnectMMIO(m_vram_mmio);
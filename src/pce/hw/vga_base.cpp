@@ -652,6 +652,30 @@ void VGABase::HandleVGAVRAMWrite(u32 segment_base, u32 offset, u8 value)
   }
 }
 
+u8 VGABase::HandleVGAVRAMReadByte(u32 offset)
+{
+  return HandleVGAVRAMRead(0, offset);
+}
+
+void VGABase::HandleVGAVRAMWriteByte(u32 offset, u8 value)
+{
+  HandleVGAVRAMWrite(0, offset, value);
+}
+
+void VGABase::HandleVGAVRAMReadBlock(u32 offset, u32 length, void* destination)
+{
+  u8* destination_ptr = static_cast<u8*>(destination);
+  for (u32 i = 0; i < length; i++)
+    destination_ptr[i] = HandleVGAVRAMRead(0, offset + i);
+}
+
+void VGABase::HandleVGAVRAMWriteBlock(u32 offset, u32 length, const void* source)
+{
+  const u8* source_ptr = static_cast<const u8*>(source);
+  for (u32 i = 0; i < length; i++)
+    HandleVGAVRAMWrite(0, offset + i, source_ptr[i]);
+}
+
 void VGABase::GetVGAMemoryMapping(PhysicalMemoryAddress* base_address, u32* size)
 {
   switch (m_graphics_registers.memory_map_select)
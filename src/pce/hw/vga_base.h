@@ -397,6 +397,12 @@ protected:
   u8 HandleVGAVRAMRead(u32 segment_base, u32 offset);
   void HandleVGAVRAMWrite(u32 segment_base, u32 offset, u8 value);
 
+  // MMIO handlers for the legacy VRAM window. Blocks go through the latches one byte at a time, as the CPU would.
+  u8 HandleVGAVRAMReadByte(u32 offset);
+  void HandleVGAVRAMWriteByte(u32 offset, u8 value);
+  void HandleVGAVRAMReadBlock(u32 offset, u32 length, void* destination);
+  void HandleVGAVRAMWriteBlock(u32 offset, u32 length, const void* source);
+
   void GetVGAMemoryMapping(PhysicalMemoryAddress* base_address, u32* size);
   virtual void UpdateVGAMemoryMapping();
 
@@ -236,15 +236,12 @@ void Voodoo::OnMemoryRegionChanged(u8 function, MemoryRegion region, bool active
         // 32-bit MMIO. TODO: Handle other widths.
         static constexpr u32 OFFSET_MASK = (MEMORY_REGION_SIZE / 4) - 1;
         MMIO::Handlers handlers;
-        handlers.read_byte = std::bind(&Voodoo::HandleBusByteRead, this, std::placeholders::_1);
-        handlers.read_word = std::bind(&Voodoo::HandleBusWordRead, this, std::placeholders::_1);
-        handlers.read_dword = std::bind(&Voodoo::HandleBusDWordRead, this, std::placeholders::_1);
-        handlers.write_byte =
-          std::bind(&Voodoo::HandleBusByteWrite, this, std::placeholders::_1, std::placeholders::_2);
-        handlers.write_word =
-          std::bind(&Voodoo::HandleBusWordWrite, this, std::placeholders::_1, std::placeholders::_2);
-        handlers.write_dword =
-          std::bind(&Voodoo::HandleBusDWordWrite, this, std::placeholders::_1, std::placeholders::_2);
+        handlers.Bind<&Voodoo::HandleBusByteRead>(this);
+        handlers.Bind<&Voodoo::HandleBusWordRead>(this);
+        handlers.Bind<&Voodoo::HandleBusDWordRead>(this);
+        handlers.Bind<&Voodoo::HandleBusByteWrite>(this);
+        handlers.Bind<&Voodoo::HandleBusWordWrite>(this);
+        handlers.Bind<&Voodoo::HandleBusDWordWrite>(this);
         m_mmio_mapping = MMIO::CreateComplex(base_address, MEMORY_REGION_SIZE, std::move(handlers), false);
         m_bus->ConnectMMIO(m_mmio_mapping);
       }
@@ -79,6 +79,15 @@ void XT_IDE::ConnectIOPorts(Bus* bus)
   bus->ConnectIOPortWrite(Truncate16(m_io_base + 0x0), this,
                           [this](u16, u8 value) { IOWriteDataRegisterByte(0, value); });
 
+  // Only byte transfers, as the port next to the data register isn't connected.
+  bus->ConnectIOPortReadBlock(Truncate16(m_io_base + 0x0), this, [this](u16, u32 size, u32 count, void* destination) {
+    return (size == sizeof(u8)) ? IOReadDataRegisterBlock(0, size, count, destination) : 0;
+  });
+  bus->ConnectIOPortWriteBlock(Truncate16(m_io_base + 0x0), this,
+                               [this](u16, u32 size, u32 count, const void* source) {
+                                 return (size == sizeof(u8)) ? IOWriteDataRegisterBlock(0, size, count, source) : 0;
+                               });
+
   bus->ConnectIOPortRead(Truncate16(m_io_base + 0x2), this, [this](u16) { return IOReadErrorRegister(0); });
   bus->ConnectIOPortWrite(Truncate16(m_io_base + 0x2), this,
                           [this](u16, u8 value) { IOWriteCommandBlockFeatures(0, value); });
@@ -1,46 +1,108 @@
 #include "pce/mmio.h"
 #include <cstring>
 
+namespace {
+template<typename T>
+T ReadFunctionThunk(void* context, u32 offset_from_base)
+{
+  return (*static_cast<const std::function<T(u32)>*>(context))(offset_from_base);
+}
+
+template<typename T>
+void WriteFunctionThunk(void* context, u32 offset_from_base, T value)
+{
+  (*static_cast<const std::function<void(u32, T)>*>(context))(offset_from_base, value);
+}
+
+void ReadBlockFunctionThunk(void* context, u32 offset_from_base, u32 length, void* destination)
+{
+  (*static_cast<const MMIO::Handlers::ReadBlockHandler*>(context))(offset_from_base, length, destination);
+}
+
+void WriteBlockFunctionThunk(void* context, u32 offset_from_base, u32 length, const void* source)
+{
+  (*static_cast<const MMIO::Handlers::WriteBlockHandler*>(context))(offset_from_base, length, source);
+}
+
+template<typename T>
+T ReadDirectThunk(void* context, u32 offset_from_base)
+{
+  T value;
+  std::memcpy(&value, static_cast<const char*>(context) + offset_from_base, sizeof(value));
+  return value;
+}
+
+template<typename T>
+void WriteDirectThunk(void* context, u32 offset_from_base, T value)
+{
+  std::memcpy(static_cast<char*>(context) + offset_from_base, &value, sizeof(value));
+}
+
+void ReadBlockDirectThunk(void* context, u32 offset_from_base, u32 length, void* destination)
+{
+  std::memcpy(destination, static_cast<const char*>(context) + offset_from_base, length);
+}
+
+void WriteBlockDirectThunk(void* context, u32 offset_from_base, u32 length, const void* source)
+{
+  std::memcpy(static_cast<char*>(context) + offset_from_base, source, length);
+}
+
+template<typename Entry, typename Function, typename Thunk>
+void ResolveEntry(Entry* entry, const Entry& bound, const Function& function, Thunk thunk)
+{
+  if (bound.fn)
+    *entry = bound;
+  else if (function)
+    *entry = {thunk, const_cast<Function*>(&function)};
+  else
+    *entry = {};
+}
+} // namespace
+
 MMIO::MMIO(PhysicalMemoryAddress start_address, u32 size, Handlers&& handlers, bool cacheable)
-  : m_start_address(start_address), m_end_address(start_address + (size - 1)), m_size(size), m_handlers(handlers),
-    m_cachable(cacheable)
+  : m_start_address(start_address), m_end_address(start_address + (size - 1)), m_size(size),
+    m_handlers(std::move(handlers)), m_cachable(cacheable)
 {
+  ResolveDispatch();
+  m_has_read_block_handler = (m_dispatch.read_block.fn != nullptr);
+  m_has_write_block_handler = (m_dispatch.write_block.fn != nullptr);
 }
 
 MMIO::~MMIO() {}
 
+void MMIO::ResolveDispatch()
+{
+  ResolveEntry(&m_dispatch.read_byte, m_handlers.bound.read_byte, m_handlers.read_byte, &ReadFunctionThunk<u8>);
+  ResolveEntry(&m_dispatch.read_word, m_handlers.bound.read_word, m_handlers.read_word, &ReadFunctionThunk<u16>);
+  ResolveEntry(&m_dispatch.read_dword, m_handlers.bound.read_dword, m_handlers.read_dword, &ReadFunctionThunk<u32>);
+  ResolveEntry(&m_dispatch.read_qword, m_handlers.bound.read_qword, m_handlers.read_qword, &ReadFunctionThunk<u64>);
+  ResolveEntry(&m_dispatch.write_byte, m_handlers.bound.write_byte, m_handlers.write_byte, &WriteFunctionThunk<u8>);
+  ResolveEntry(&m_dispatch.write_word, m_handlers.bound.write_word, m_handlers.write_word, &WriteFunctionThunk<u16>);
+  ResolveEntry(&m_dispatch.write_dword, m_handlers.bound.write_dword, m_handlers.write_dword,
+               &WriteFunctionThunk<u32>);
+  ResolveEntry(&m_dispatch.write_qword, m_handlers.bound.write_qword, m_handlers.write_qword,
+               &WriteFunctionThunk<u64>);
+  ResolveEntry(&m_dispatch.read_block, m_handlers.bound.read_block, m_handlers.read_block, &ReadBlockFunctionThunk);
+  ResolveEntry(&m_dispatch.write_block, m_handlers.bound.write_block, m_handlers.write_block,
+               &WriteBlockFunctionThunk);
+}
+
 MMIO* MMIO::CreateDirect(PhysicalMemoryAddress start_address, u32 size, void* data, bool allow_read, bool allow_write,
                          bool cacheable)
 {
   char* data_base = reinterpret_cast<char*>(data);
   DebugAssert(size > 0);
 
+  // Accesses go straight to the memory, without a std::function in between.
   Handlers handlers;
   if (allow_read)
   {
-    handlers.read_byte = [data_base](u32 offset_from_base) {
-      u8 value;
-      std::memcpy(&value, data_base + offset_from_base, sizeof(value));
-      return value;
-    };
-    handlers.read_word = [data_base](u32 offset_from_base) {
-      u16 value;
-      std::memcpy(&value, data_base + offset_from_base, sizeof(value));
-      return value;
-    };
-    handlers.read_dword = [data_base](u32 offset_from_base) {
-      u32 value;
-      std::memcpy(&value, data_base + offset_from_base, sizeof(value));
-      return value;
-    };
-    handlers.read_qword = [data_base](u32 offset_from_base) {
-      u64 value;
-      std::memcpy(&value, data_base + offset_from_base, sizeof(value));
-      return value;
-    };
-    handlers.read_block = [data_base](u32 offset_from_base, u32 length, void* destination) {
-      std::memcpy(destination, data_base + offset_from_base, length);
-    };
+    handlers.bound.read_byte = {&ReadDirectThunk<u8>, data_base};
+    handlers.bound.read_word = {&ReadDirectThunk<u16>, data_base};
+    handlers.bound.read_dword = {&ReadDirectThunk<u32>, data_base};
+    handlers.bound.read_qword = {&ReadDirectThunk<u64>, data_base};
+    handlers.bound.read_block = {&ReadBlockDirectThunk, data_base};
   }
   else
   {
@@ -49,21 +111,11 @@ MMIO* MMIO::CreateDirect(PhysicalMemoryAddress start_address, u32 size, void* da
 
   if (allow_write)
   {
-    handlers.write_byte = [data_base](u32 offset_from_base, u8 value) {
-      std::memcpy(data_base + offset_from_base, &value, sizeof(u8));
-    };
-    handlers.write_word = [data_base](u32 offset_from_base, u16 value) {
-      std::memcpy(data_base + offset_from_base, &value, sizeof(u16));
-    };
-    handlers.write_dword = [data_base](u32 offset_from_base, u32 value) {
-      std::memcpy(data_base + offset_from_base, &value, sizeof(u32));
-    };
-    handlers.write_qword = [data_base](u32 offset_from_base, u64 value) {
-      std::memcpy(data_base + offset_from_base, &value, sizeof(u64));
-    };
-    handlers.write_block = [data_base](u32 offset_from_base, u32 length, const void* source) {
-      std::memcpy(data_base + offset_from_base, source, length);
-    };
+    handlers.bound.write_byte = {&WriteDirectThunk<u8>, data_base};
+    handlers.bound.write_word = {&WriteDirectThunk<u16>, data_base};
+    handlers.bound.write_dword = {&WriteDirectThunk<u32>, data_base};
+    handlers.bound.write_qword = {&WriteDirectThunk<u64>, data_base};
+    handlers.bound.write_block = {&WriteBlockDirectThunk, data_base};
   }
   else
   {
@@ -80,27 +132,23 @@ MMIO* MMIO::CreateComplex(PhysicalMemoryAddress start_address, u32 size, Handler
   MMIO* mmio = new MMIO(start_address, size, std::move(handlers), cacheable);
 
   // Hook up unregistered width reads/writes.
-  if (!mmio->m_handlers.read_word)
-    mmio->m_handlers.read_word = std::bind(&MMIO::DefaultReadWordHandler, mmio, std::placeholders::_1);
-  if (!mmio->m_handlers.read_dword)
-    mmio->m_handlers.read_dword = std::bind(&MMIO::DefaultReadDWordHandler, mmio, std::placeholders::_1);
-  if (!mmio->m_handlers.read_qword)
-    mmio->m_handlers.read_qword = std::bind(&MMIO::DefaultReadQWordHandler, mmio, std::placeholders::_1);
-  if (!mmio->m_handlers.read_block)
-    mmio->m_handlers.read_block = std::bind(&MMIO::DefaultReadBlockHandler, mmio, std::placeholders::_1,
-                                            std::placeholders::_2, std::placeholders::_3);
-  if (!mmio->m_handlers.write_word)
-    mmio->m_handlers.write_word =
-      std::bind(&MMIO::DefaultWriteWordHandler, mmio, std::placeholders::_1, std::placeholders::_2);
-  if (!mmio->m_handlers.write_dword)
-    mmio->m_handlers.write_dword =
-      std::bind(&MMIO::DefaultWriteDWordHandler, mmio, std::placeholders::_1, std::placeholders::_2);
-  if (!mmio->m_handlers.write_qword)
-    mmio->m_handlers.write_qword =
-      std::bind(&MMIO::DefaultWriteQWordHandler, mmio, std::placeholders::_1, std::placeholders::_2);
-  if (!mmio->m_handlers.write_block)
-    mmio->m_handlers.write_block = std::bind(&MMIO::DefaultWriteBlockHandler, mmio, std::placeholders::_1,
-                                             std::placeholders::_2, std::placeholders::_3);
+  Dispatch& dispatch = mmio->m_dispatch;
+  if (!dispatch.read_word.fn)
+    dispatch.read_word = {&CallMember<&MMIO::DefaultReadWordHandler, MMIO, u16, u32>, mmio};
+  if (!dispatch.read_dword.fn)
+    dispatch.read_dword = {&CallMember<&MMIO::DefaultReadDWordHandler, MMIO, u32, u32>, mmio};
+  if (!dispatch.read_qword.fn)
+    dispatch.read_qword = {&CallMember<&MMIO::DefaultReadQWordHandler, MMIO, u64, u32>, mmio};
+  if (!dispatch.read_block.fn)
+    dispatch.read_block = {&CallMember<&MMIO::DefaultReadBlockHandler, MMIO, void, u32, u32, void*>, mmio};
+  if (!dispatch.write_word.fn)
+    dispatch.write_word = {&CallMember<&MMIO::DefaultWriteWordHandler, MMIO, void, u32, u16>, mmio};
+  if (!dispatch.write_dword.fn)
+    dispatch.write_dword = {&CallMember<&MMIO::DefaultWriteDWordHandler, MMIO, void, u32, u32>, mmio};
+  if (!dispatch.write_qword.fn)
+    dispatch.write_qword = {&CallMember<&MMIO::DefaultWriteQWordHandler, MMIO, void, u32, u64>, mmio};
+  if (!dispatch.write_block.fn)
+    dispatch.write_block = {&CallMember<&MMIO::DefaultWriteBlockHandler, MMIO, void, u32, u32, const void*>, mmio};
 
   return mmio;
 }
@@ -110,20 +158,32 @@ MMIO* MMIO::CreateMirror(PhysicalMemoryAddress start_address, u32 size, const MM
   DebugAssert(size <= existing_handler->m_size);
 
   // Create copies of handler functions.
-  Handlers handlers;
-  handlers.read_byte = existing_handler->m_handlers.read_byte;
-  handlers.read_word = existing_handler->m_handlers.read_word;
-  handlers.read_dword = existing_handler->m_handlers.read_dword;
-  handlers.read_qword = existing_handler->m_handlers.read_qword;
-  handlers.read_block = existing_handler->m_handlers.read_block;
-  handlers.write_byte = existing_handler->m_handlers.write_byte;
-  handlers.write_word = existing_handler->m_handlers.write_word;
-  handlers.write_dword = existing_handler->m_handlers.write_dword;
-  handlers.write_qword = existing_handler->m_handlers.write_qword;
-  handlers.write_block = existing_handler->m_handlers.write_block;
+  Handlers handlers(existing_handler->m_handlers);
 
   // Use the same properties, just a different start address.
-  return new MMIO(start_address, size, std::move(handlers), existing_handler->m_cachable);
+  MMIO* mmio = new MMIO(start_address, size, std::move(handlers), existing_handler->m_cachable);
+
+  // Widths which were split by the existing handler are split by it for the mirror too.
+  const Dispatch& existing_dispatch = existing_handler->m_dispatch;
+  Dispatch& dispatch = mmio->m_dispatch;
+  if (!dispatch.read_word.fn)
+    dispatch.read_word = existing_dispatch.read_word;
+  if (!dispatch.read_dword.fn)
+    dispatch.read_dword = existing_dispatch.read_dword;
+  if (!dispatch.read_qword.fn)
+    dispatch.read_qword = existing_dispatch.read_qword;
+  if (!dispatch.read_block.fn)
+    dispatch.read_block = existing_dispatch.read_block;
+  if (!dispatch.write_word.fn)
+    dispatch.write_word = existing_dispatch.write_word;
+  if (!dispatch.write_dword.fn)
+    dispatch.write_dword = existing_dispatch.write_dword;
+  if (!dispatch.write_qword.fn)
+    dispatch.write_qword = existing_dispatch.write_qword;
+  if (!dispatch.write_block.fn)
+    dispatch.write_block = existing_dispatch.write_block;
+
+  return mmio;
 }
 
 void MMIO::Handlers::IgnoreReads()
@@ -182,22 +242,22 @@ void MMIO::IgnoreWriteBlockHandler(u32 offset_from_base, u32 length, const void*
 
 u16 MMIO::DefaultReadWordHandler(u32 offset_from_base)
 {
-  const u8 b0 = m_handlers.read_byte(offset_from_base + 0);
-  const u8 b1 = m_handlers.read_byte(offset_from_base + 1);
+  const u8 b0 = m_dispatch.read_byte(offset_from_base + 0);
+  const u8 b1 = m_dispatch.read_byte(offset_from_base + 1);
   return ZeroExtend16(b0) | (ZeroExtend16(b1) << 8);
 }
 
 u32 MMIO::DefaultReadDWordHandler(u32 offset_from_base)
 {
-  const u16 w0 = m_handlers.read_word(offset_from_base + 0);
-  const u16 w1 = m_handlers.read_word(offset_from_base + 2);
+  const u16 w0 = m_dispatch.read_word(offset_from_base + 0);
+  const u16 w1 = m_dispatch.read_word(offset_from_base + 2);
   return ZeroExtend32(w0) | (ZeroExtend32(w1) << 16);
 }
 
 u64 MMIO::DefaultReadQWordHandler(u32 offset_from_base)
 {
-  const u32 w0 = m_handlers.read_dword(offset_from_base + 0);
-  const u32 w1 = m_handlers.read_dword(offset_from_base + 4);
+  const u32 w0 = m_dispatch.read_dword(offset_from_base + 0);
+  const u32 w1 = m_dispatch.read_dword(offset_from_base + 4);
   return ZeroExtend64(w0) | (ZeroExtend64(w1) << 32);
 }
 
@@ -208,14 +268,14 @@ void MMIO::DefaultReadBlockHandler(u32 offset_from_base, u32 length, void* desti
   // Align to DWORD.
   while ((offset_from_base & 3) != 0 && length > 0)
   {
-    *(destination_ptr++) = m_handlers.read_byte(offset_from_base++);
+    *(destination_ptr++) = m_dispatch.read_byte(offset_from_base++);
     length--;
   }
 
   // Issue DWORD reads.
   while (length > sizeof(u32))
   {
-    const u32 value = m_handlers.read_dword(offset_from_base);
+    const u32 value = m_dispatch.read_dword(offset_from_base);
     std::memcpy(destination_ptr, &value, sizeof(value));
     destination_ptr += sizeof(value);
     offset_from_base += sizeof(value);
@@ -225,27 +285,27 @@ void MMIO::DefaultReadBlockHandler(u32 offset_from_base, u32 length, void* desti
   // Issue byte reads until the end.
   while (length > 0)
   {
-    *(destination_ptr++) = m_handlers.read_byte(offset_from_base++);
+    *(destination_ptr++) = m_dispatch.read_byte(offset_from_base++);
     length--;
   }
 }
 
 void MMIO::DefaultWriteWordHandler(u32 offset_from_base, u16 value)
 {
-  m_handlers.write_byte(offset_from_base + 0, Truncate8(value));
-  m_handlers.write_byte(offset_from_base + 1, Truncate8(value >> 8));
+  m_dispatch.write_byte(offset_from_base + 0, Truncate8(value));
+  m_dispatch.write_byte(offset_from_base + 1, Truncate8(value >> 8));
 }
 
 void MMIO::DefaultWriteDWordHandler(u32 offset_from_base, u32 value)
 {
-  m_handlers.write_word(offset_from_base + 0, Truncate16(value));
-  m_handlers.write_word(offset_from_base + 2, Truncate16(value >> 16));
+  m_dispatch.write_word(offset_from_base + 0, Truncate16(value));
+  m_dispatch.write_word(offset_from_base + 2, Truncate16(value >> 16));
 }
 
 void MMIO::DefaultWriteQWordHandler(u32 offset_from_base, u64 value)
 {
-  m_handlers.write_qword(offset_from_base + 0, Truncate32(value));
-  m_handlers.write_qword(offset_from_base + 4, Truncate32(value >> 32));
+  m_dispatch.write_dword(offset_from_base + 0, Truncate32(value));
+  m_dispatch.write_dword(offset_from_base + 4, Truncate32(value >> 32));
 }
 
 void MMIO::DefaultWriteBlockHandler(u32 offset_from_base, u32 length, const void* source)
@@ -255,7 +315,7 @@ void MMIO::DefaultWriteBlockHandler(u32 offset_from_base, u32 length, const void
   // Align to DWORD.
   while ((offset_from_base & 3) != 0 && length > 0)
   {
-    m_handlers.write_byte(offset_from_base++, *(source_ptr++));
+    m_dispatch.write_byte(offset_from_base++, *(source_ptr++));
     length--;
   }
 
@@ -264,7 +324,7 @@ void MMIO::DefaultWriteBlockHandler(u32 offset_from_base, u32 length, const void
   {
     u32 value;
     std::memcpy(&value, source_ptr, sizeof(value));
-    m_handlers.write_dword(offset_from_base, value);
+    m_dispatch.write_dword(offset_from_base, value);
     source_ptr += sizeof(value);
     offset_from_base += sizeof(value);
     length -= sizeof(value);
@@ -273,7 +333,7 @@ void MMIO::DefaultWriteBlockHandler(u32 offset_from_base, u32 length, const void
   // Issue byte writes until the end.
   while (length > 0)
   {
-    m_handlers.write_byte(offset_from_base++, *(source_ptr++));
+    m_dispatch.write_byte(offset_from_base++, *(source_ptr++));
     length--;
   }
 }
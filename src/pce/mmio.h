@@ -1,10 +1,78 @@
 #pragma once
 #include "YBaseLib/ReferenceCounted.h"
 #include "pce/system.h"
+#include <type_traits>
 
 class MMIO : public ReferenceCounted
 {
+private:
+  template<typename M>
+  struct MemberFunctionClass;
+  template<typename C, typename R, typename... Args>
+  struct MemberFunctionClass<R (C::*)(Args...)>
+  {
+    using type = C;
+  };
+
+  template<auto method, typename C, typename R, typename... Args>
+  static R CallMember(void* context, Args... args)
+  {
+    return (static_cast<C*>(context)->*method)(args...);
+  }
+
 public:
+  // Dispatch table entries, which the accessors call through. The context is the device for bound member functions,
+  // the std::function for the others, or the MMIO itself for accesses split into narrower ones.
+  template<typename T>
+  struct ReadEntry
+  {
+    T operator()(u32 offset_from_base) const { return fn(context, offset_from_base); }
+
+    T (*fn)(void* context, u32 offset_from_base);
+    void* context;
+  };
+  template<typename T>
+  struct WriteEntry
+  {
+    void operator()(u32 offset_from_base, T value) const { fn(context, offset_from_base, value); }
+
+    void (*fn)(void* context, u32 offset_from_base, T value);
+    void* context;
+  };
+  struct ReadBlockEntry
+  {
+    void operator()(u32 offset_from_base, u32 length, void* destination) const
+    {
+      fn(context, offset_from_base, length, destination);
+    }
+
+    void (*fn)(void* context, u32 offset_from_base, u32 length, void* destination);
+    void* context;
+  };
+  struct WriteBlockEntry
+  {
+    void operator()(u32 offset_from_base, u32 length, const void* source) const
+    {
+      fn(context, offset_from_base, length, source);
+    }
+
+    void (*fn)(void* context, u32 offset_from_base, u32 length, const void* source);
+    void* context;
+  };
+  struct Dispatch
+  {
+    ReadEntry<u8> read_byte;
+    ReadEntry<u16> read_word;
+    ReadEntry<u32> read_dword;
+    ReadEntry<u64> read_qword;
+    WriteEntry<u8> write_byte;
+    WriteEntry<u16> write_word;
+    WriteEntry<u32> write_dword;
+    WriteEntry<u64> write_qword;
+    ReadBlockEntry read_block;
+    WriteBlockEntry write_block;
+  };
+
   struct Handlers
   {
     using ReadByteHandler = std::function<u8(u32 offset_from_base)>;
@@ -21,6 +89,12 @@ public:
     void IgnoreReads();
     void IgnoreWrites();
 
+    // Binds a handler to a member function of a device, which is called directly instead of through a
+    // std::function. The handler is picked from the signature, e.g. u8 (T::*)(u32) is read_byte, and
+    // void (T::*)(u32, u32, void*) is read_block. Takes precedence over the std::function for the same handler.
+    template<auto method>
+    void Bind(typename MemberFunctionClass<decltype(method)>::type* object);
+
     ReadByteHandler read_byte;
     ReadWordHandler read_word;
     ReadDWordHandler read_dword;
@@ -32,6 +106,8 @@ public:
 
     ReadBlockHandler read_block;
     WriteBlockHandler write_block;
+
+    Dispatch bound = {};
   };
 
 public:
@@ -43,30 +119,63 @@ public:
   u32 GetSize() const { return m_size; }
   bool IsCachable() const { return m_cachable; }
 
-  u8 ReadByte(PhysicalMemoryAddress address) { return m_handlers.read_byte(address - m_start_address); }
-  u16 ReadWord(PhysicalMemoryAddress address) { return m_handlers.read_word(address - m_start_address); }
-  u32 ReadDWord(PhysicalMemoryAddress address) { return m_handlers.read_dword(address - m_start_address); }
-  u64 ReadQWord(PhysicalMemoryAddress address) { return m_handlers.read_qword(address - m_start_address); }
-  void WriteByte(PhysicalMemoryAddress address, u8 source) { m_handlers.write_byte(address - m_start_address, source); }
-  void WriteWord(PhysicalMemoryAddress address, u16 source)
+  // Block accesses are only used for CPU string operations when the region handles them itself, rather than
+  // splitting them into dword and byte accesses, which a device with registers could see differently.
+  bool HasReadBlockHandler() const { return m_has_read_block_handler; }
+  bool HasWriteBlockHandler() const { return m_has_write_block_handler; }
+
+  // Number of accesses to the region since it was created, for profiling. Block accesses count once.
+  u64 GetAccessCount() const { return m_access_count; }
+
+  u8 ReadByte(PhysicalMemoryAddress address)
   {
-    m_handlers.write_word(address - m_start_address, source);
+    m_access_count++;
+    return m_dispatch.read_byte(address - m_start_address);
   }
-  void WriteDWord(PhysicalMemoryAddress address, u32 source)
+  u16 ReadWord(PhysicalMemoryAddress address)
   {
-    m_handlers.write_dword(address - m_start_address, source);
+    m_access_count++;
+    return m_dispatch.read_word(address - m_start_address);
   }
-  void WriteQWord(PhysicalMemoryAddress address, u64 source)
+  u32 ReadDWord(PhysicalMemoryAddress address)
   {
-    m_handlers.write_qword(address - m_start_address, source);
+    m_access_count++;
+    return m_dispatch.read_dword(address - m_start_address);
+  }
+  u64 ReadQWord(PhysicalMemoryAddress address)
+  {
+    m_access_count++;
+    return m_dispatch.read_qword(address - m_start_address);
   }
   void ReadBlock(PhysicalMemoryAddress address, u32 length, void* destination)
   {
-    m_handlers.read_block(address - m_start_address, length, destination);
+    m_access_count++;
+    m_dispatch.read_block(address - m_start_address, length, destination);
+  }
+  void WriteByte(PhysicalMemoryAddress address, u8 source)
+  {
+    m_access_count++;
+    m_dispatch.write_byte(address - m_start_address, source);
+  }
+  void WriteWord(PhysicalMemoryAddress address, u16 source)
+  {
+    m_access_count++;
+    m_dispatch.write_word(address - m_start_address, source);
+  }
+  void WriteDWord(PhysicalMemoryAddress address, u32 source)
+  {
+    m_access_count++;
+    m_dispatch.write_dword(address - m_start_address, source);
+  }
+  void WriteQWord(PhysicalMemoryAddress address, u64 source)
+  {
+    m_access_count++;
+    m_dispatch.write_qword(address - m_start_address, source);
   }
   void WriteBlock(PhysicalMemoryAddress address, u32 length, const void* source)
   {
-    m_handlers.write_block(address - m_start_address, length, source);
+    m_access_count++;
+    m_dispatch.write_block(address - m_start_address, length, source);
   }
 
   // Factory methods
@@ -77,6 +186,9 @@ public:
   static MMIO* CreateMirror(PhysicalMemoryAddress start_address, u32 size, const MMIO* existing_handler);
 
 private:
+  // Fills in the dispatch table from the handlers, leaving entries without a handler empty.
+  void ResolveDispatch();
+
   static u8 IgnoreReadByteHandler(u32 offset_from_base);
   static u16 IgnoreReadWordHandler(u32 offset_from_base);
   static u32 IgnoreReadDWordHandler(u32 offset_from_base);
@@ -101,5 +213,38 @@ private:
   u32 m_size;
 
   Handlers m_handlers;
+  Dispatch m_dispatch = {};
+  u64 m_access_count = 0;
   bool m_cachable;
-};
\ No newline at end of file
+  bool m_has_read_block_handler = false;
+  bool m_has_write_block_handler = false;
+};
+
+template<auto method>
+void MMIO::Handlers::Bind(typename MemberFunctionClass<decltype(method)>::type* object)
+{
+  using M = decltype(method);
+  using C = typename MemberFunctionClass<M>::type;
+  if constexpr (std::is_same_v<M, u8 (C::*)(u32)>)
+    bound.read_byte = {&CallMember<method, C, u8, u32>, object};
+  else if constexpr (std::is_same_v<M, u16 (C::*)(u32)>)
+    bound.read_word = {&CallMember<method, C, u16, u32>, object};
+  else if constexpr (std::is_same_v<M, u32 (C::*)(u32)>)
+    bound.read_dword = {&CallMember<method, C, u32, u32>, object};
+  else if constexpr (std::is_same_v<M, u64 (C::*)(u32)>)
+    bound.read_qword = {&CallMember<method, C, u64, u32>, object};
+  else if constexpr (std::is_same_v<M, void (C::*)(u32, u8)>)
+    bound.write_byte = {&CallMember<method, C, void, u32, u8>, object};
+  else if constexpr (std::is_same_v<M, void (C::*)(u32, u16)>)
+    bound.write_word = {&CallMember<method, C, void, u32, u16>, object};
+  else if constexpr (std::is_same_v<M, void (C::*)(u32, u32)>)
+    bound.write_dword = {&CallMember<method, C, void, u32, u32>, object};
+  else if constexpr (std::is_same_v<M, void (C::*)(u32, u64)>)
+    bound.write_qword = {&CallMember<method, C, void, u32, u64>, object};
+  else if constexpr (std::is_same_v<M, void (C::*)(u32, u32, void*)>)
+    bound.read_block = {&CallMember<method, C, void, u32, u32, void*>, object};
+  else if constexpr (std::is_same_v<M, void (C::*)(u32, u32, const void*)>)
+    bound.write_block = {&CallMember<method, C, void, u32, u32, const void*>, object};
+  else
+    static_assert(!std::is_same_v<M, M>, "member function does not match any MMIO handler");
+}
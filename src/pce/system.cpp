@@ -59,7 +59,10 @@ void System::Reset()
 {
   m_simulation_time = 0;
   m_last_event_run_time = 0;
-  for (TimingEvent* ev : m_events)
+
+  // Resetting an event moves it in the heap, so iterate over a copy.
+  const std::vector<TimingEvent*> events(m_events);
+  for (TimingEvent* ev : events)
     ev->Reset();
 
   m_bus->Reset();
@@ -269,44 +272,46 @@ std::unique_ptr<TimingEvent> System::CreateNanosecondEvent(const char* name, Cyc
   return evt;
 }
 
-static bool CompareEvents(const TimingEvent* lhs, const TimingEvent* rhs)
-{
-  return lhs->GetDownCount() > rhs->GetDownCount();
-}
-
 void System::AddActiveEvent(TimingEvent* event)
 {
+  event->m_heap_index = static_cast<u32>(m_events.size());
   m_events.push_back(event);
+  SiftEventUp(event->m_heap_index);
   if (!m_running_events)
-  {
-    std::push_heap(m_events.begin(), m_events.end(), CompareEvents);
     UpdateCPUDowncount();
-  }
-  else
-  {
-    m_events_need_sorting = true;
-  }
 }
 
 void System::RemoveActiveEvent(TimingEvent* event)
 {
-  auto iter = std::find_if(m_events.begin(), m_events.end(), [event](const auto& it) { return event == it; });
-  if (iter == m_events.end())
+  const u32 index = event->m_heap_index;
+  if (index >= m_events.size() || m_events[index] != event)
   {
     Panic("Attempt to remove inactive event");
     return;
   }
 
-  m_events.erase(iter);
-  if (!m_running_events)
+  // Fill the hole with the last event, which can belong either above or below it.
+  TimingEvent* last_event = m_events.back();
+  m_events.pop_back();
+  if (last_event != event)
   {
-    std::make_heap(m_events.begin(), m_events.end(), CompareEvents);
-    UpdateCPUDowncount();
-  }
-  else
-  {
-    m_events_need_sorting = true;
+    m_events[index] = last_event;
+    last_event->m_heap_index = index;
+    SiftEventUp(index);
+    SiftEventDown(last_event->m_heap_index);
   }
+
+  if (!m_running_events)
+    UpdateCPUDowncount();
+}
+
+void System::UpdateActiveEvent(TimingEvent* event)
+{
+  DebugAssert(m_events[event->m_heap_index] == event);
+  SiftEventUp(event->m_heap_index);
+  SiftEventDown(event->m_heap_index);
+  if (!m_running_events)
+    UpdateCPUDowncount();
 }
 
 TimingEvent* System::FindActiveEvent(const char* name)
@@ -318,15 +323,61 @@ TimingEvent* System::FindActiveEvent(const char* name)
 
 void System::SortEvents()
 {
+  const u32 count = static_cast<u32>(m_events.size());
+  for (u32 i = 0; i < count; i++)
+    m_events[i]->m_heap_index = i;
+  for (u32 i = count / 2; i > 0; i--)
+    SiftEventDown(i - 1);
+
   if (!m_running_events)
-  {
-    std::make_heap(m_events.begin(), m_events.end(), CompareEvents);
     UpdateCPUDowncount();
+}
+
+void System::SiftEventUp(u32 index)
+{
+  TimingEvent* event = m_events[index];
+  while (index > 0)
+  {
+    const u32 parent_index = (index - 1) / 2;
+    TimingEvent* parent = m_events[parent_index];
+    if (parent->m_next_run_time <= event->m_next_run_time)
+      break;
+
+    m_events[index] = parent;
+    parent->m_heap_index = index;
+    index = parent_index;
   }
-  else
+
+  m_events[index] = event;
+  event->m_heap_index = index;
+}
+
+void System::SiftEventDown(u32 index)
+{
+  const u32 count = static_cast<u32>(m_events.size());
+  TimingEvent* event = m_events[index];
+  for (;;)
   {
-    m_events_need_sorting = true;
+    u32 child_index = (index * 2) + 1;
+    if (child_index >= count)
+      break;
+    if ((child_index + 1) < count &&
+        m_events[child_index + 1]->m_next_run_time < m_events[child_index]->m_next_run_time)
+    {
+      child_index++;
+    }
+
+    TimingEvent* child = m_events[child_index];
+    if (event->m_next_run_time <= child->m_next_run_time)
+      break;
+
+    m_events[index] = child;
+    child->m_heap_index = index;
+    index = child_index;
   }
+
+  m_events[index] = event;
+  event->m_heap_index = index;
 }
 
 void System::RunEvents()
@@ -339,69 +390,53 @@ void System::RunEvents()
     return;
   }
 
-  SimulationTime remaining_time = GetSimulationTimeSince(m_last_event_run_time);
-  if (remaining_time < m_events.front()->GetDownCount())
+  if (m_simulation_time < m_events.front()->m_next_run_time)
   {
     // no need to run events yet.
-    m_cpu->SetExecutionDowncount(m_events.front()->GetDownCount() - remaining_time);
+    m_cpu->SetExecutionDowncount(m_events.front()->m_next_run_time - m_simulation_time);
     return;
   }
 
   m_running_events = true;
 
-  while (remaining_time > 0)
+  while (m_last_event_run_time < m_simulation_time)
   {
     // To avoid issues where two events are related to each other from becoming desynced,
     // we run at a slice that is the length of the lowest next event time.
-    SimulationTime time = std::min(remaining_time, m_events.front()->GetDownCount());
-    remaining_time -= time;
-    m_last_event_run_time += time;
-
-    // Apply downcount to all events.
-    // This will result in a negative downcount for those events which are late.
-    for (TimingEvent* evt : m_events)
+    if (!m_events.empty())
     {
-      evt->m_downcount = evt->m_downcount - time;
-      evt->m_time_since_last_run += time;
+      m_last_event_run_time = std::max(m_last_event_run_time,
+                                       std::min(m_simulation_time, m_events.front()->m_next_run_time));
+    }
+    else
+    {
+      m_last_event_run_time = m_simulation_time;
     }
 
-    // Now we can actually run the callbacks.
-    while (!m_events.empty() && m_events.front()->GetDownCount() <= 0)
+    // Now we can actually run the callbacks. Events which are due have a next run time in the past, i.e. are late.
+    while (!m_events.empty() && m_events.front()->m_next_run_time <= m_last_event_run_time)
     {
       TimingEvent* evt = m_events.front();
-      SimulationTime time_late = -evt->m_downcount;
-      std::pop_heap(m_events.begin(), m_events.end(), CompareEvents);
+      const SimulationTime time_late = m_last_event_run_time - evt->m_next_run_time;
 
       // Don't include overrun cycles in the execution.
       // If the late time is greater than (period * interval), we'll re-place us at the front (or near)
       // the front of the queue again, and submit the next iteration then. This should reduce issues where
       // multiple events are dependent on one another, that may be caused if all cycles were executed at once.
-      CycleCount cycles_to_execute = (evt->m_time_since_last_run - time_late) / evt->m_cycle_period;
+      const CycleCount cycles_to_execute = (evt->m_next_run_time - evt->m_last_run_time) / evt->m_cycle_period;
       DebugAssert(cycles_to_execute >= 0);
 
-      // Calculate and set the new downcount for periodic events, taking into account late time.
-      CycleCount cycles_late = time_late / evt->m_cycle_period;
+      // Calculate and set the next run time for periodic events, taking into account late time.
+      const CycleCount cycles_late = time_late / evt->m_cycle_period;
+      evt->m_next_run_time += (evt->m_cycle_period * evt->m_interval);
+      evt->m_last_run_time += cycles_to_execute * evt->m_cycle_period;
 
-      // Factor late time into the time for the next invocation.
-      evt->m_downcount += (evt->m_cycle_period * evt->m_interval);
-      evt->m_time_since_last_run -= cycles_to_execute * evt->m_cycle_period;
+      // Place it in the appropriate position in the queue before the callback, which may reschedule it again.
+      SiftEventDown(0);
 
       // The cycles_late is only an indicator, it doesn't modify the cycles to execute.
       evt->m_callback(evt, cycles_to_execute, cycles_late);
-
-      // Place it in the appropriate position in the queue.
-      if (m_events_need_sorting)
-      {
-        // Another event may have been changed by this event, or the interval/downcount changed.
-        std::make_heap(m_events.begin(), m_events.end(), CompareEvents);
-        m_events_need_sorting = false;
-      }
-      else
-      {
-        // Keep the event list in a heap. The event we just serviced will be in the last place,
-        // so we can use push_here instead of make_heap, which should be faster.
-        std::push_heap(m_events.begin(), m_events.end(), CompareEvents);
-      }
+      m_events_dispatched++;
     }
 
     // Run until next event, or 100ms.
@@ -414,9 +449,9 @@ void System::RunEvents()
 
 void System::UpdateCPUDowncount()
 {
-  SimulationTime next_event_time = m_events.empty() ? POLL_FREQUENCY : m_events.front()->GetDownCount();
-  next_event_time -= GetSimulationTimeSince(m_last_event_run_time);
-  m_cpu->SetExecutionDowncount(std::max(next_event_time, SimulationTime(0)));
+  const SimulationTime next_event_time =
+    m_events.empty() ? (m_last_event_run_time + POLL_FREQUENCY) : m_events.front()->m_next_run_time;
+  m_cpu->SetExecutionDowncount(std::max(next_event_time - m_simulation_time, SimulationTime(0)));
 }
 
 bool System::DoEventsState(StateWrapper& sw)
@@ -452,12 +487,12 @@ bool System::DoEventsState(StateWrapper& sw)
         continue;
       }
 
-      // Using reschedule is safe here since we call sort afterwards.
+      // Times are stored relative to the last event run, which has already been loaded. The heap is rebuilt after.
       event->m_frequency = frequency;
       event->m_cycle_period = cycle_period;
       event->m_interval = interval;
-      event->m_downcount = downcount;
-      event->m_time_since_last_run = time_since_last_run;
+      event->m_next_run_time = m_last_event_run_time + downcount;
+      event->m_last_run_time = m_last_event_run_time - time_since_last_run;
     }
 
     Log_DevPrintf("Loaded %u events from save state.", event_count);
@@ -474,8 +509,10 @@ bool System::DoEventsState(StateWrapper& sw)
       sw.Do(&evt->m_frequency);
       sw.Do(&evt->m_cycle_period);
       sw.Do(&evt->m_interval);
-      sw.Do(&evt->m_downcount);
-      sw.Do(&evt->m_time_since_last_run);
+      SimulationTime downcount = evt->m_next_run_time - m_last_event_run_time;
+      SimulationTime time_since_last_run = m_last_event_run_time - evt->m_last_run_time;
+      sw.Do(&downcount);
+      sw.Do(&time_since_last_run);
     }
 
     Log_DevPrintf("Wrote %u events to save state.", event_count);
@@ -120,6 +120,9 @@ public:
   // Updates the downcount of the CPU (event scheduling).
   void UpdateCPUDowncount();
 
+  // Number of event callbacks run by RunEvents since the system was created.
+  u64 GetEventsDispatched() const { return m_events_dispatched; }
+
   // Create an event which runs at a clock frequency, occuring every N cycles on the rising edge.
   std::unique_ptr<TimingEvent> CreateClockedEvent(const char* name, float frequency, CycleCount interval,
                                                   TimingEventCallback callback, bool activate);
@@ -159,10 +162,14 @@ private:
   bool DoComponentsState(StateWrapper& sw);
   bool DoEventsState(StateWrapper& sw);
 
-  // Active event management
+  // Active event management. Active events are kept in a binary min-heap ordered by their next run time, and each
+  // event knows its position, so changing or removing one doesn't search or rebuild the heap.
   void AddActiveEvent(TimingEvent* event);
   void RemoveActiveEvent(TimingEvent* event);
+  void UpdateActiveEvent(TimingEvent* event);
   void SortEvents();
+  void SiftEventUp(u32 index);
+  void SiftEventDown(u32 index);
 
   // Event lookup, use with care.
   // If you modify an event, call SortEvents afterwards.
@@ -185,8 +192,8 @@ private:
   std::vector<TimingEvent*> m_events;
   SimulationTime m_simulation_time = 0;
   SimulationTime m_last_event_run_time = 0;
+  u64 m_events_dispatched = 0;
   bool m_running_events = false;
-  bool m_events_need_sorting = false;
 };
 
 template<typename T, typename... Args>
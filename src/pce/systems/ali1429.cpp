@@ -238,9 +238,9 @@ void ALi1429::AddComponents()
   m_fdd_controller = CreateComponent<HW::FDC>("FDC", HW::FDC::Model_8272);
   m_hdd_controller = CreateComponent<HW::HDC>("HDC", 1);
 
-  // Connect channel 0 of the PIT to the interrupt controller
-  m_timer->SetChannelOutputChangeCallback(0,
-                                          [this](bool value) { m_interrupt_controller->SetInterruptState(0, value); });
+  // Connect channel 0 of the PIT to the interrupt controller. IRQ 0 is edge-triggered, so falling edges can be late.
+  m_timer->SetChannelOutputChangeCallback(
+    0, [this](bool value) { m_interrupt_controller->SetInterruptState(0, value); }, false);
 
   // Connect channel 2 of the PIT to the speaker
   m_timer->SetChannelOutputChangeCallback(2, [this](bool value) { m_speaker->SetLevel(value); });
@@ -5,7 +5,7 @@
 TimingEvent::TimingEvent(System* system, const char* name, float frequency, SimulationTime cycle_period,
                          CycleCount interval, TimingEventCallback callback)
   : m_system(system), m_name(name), m_frequency(frequency), m_cycle_period(cycle_period), m_interval(interval),
-    m_downcount(m_cycle_period * interval), m_time_since_last_run(0), m_callback(std::move(callback)), m_active(false)
+    m_next_run_time(m_cycle_period * interval), m_last_run_time(0), m_callback(std::move(callback)), m_active(false)
 {
   Assert(m_cycle_period > 0);
 }
@@ -16,14 +16,19 @@ TimingEvent::~TimingEvent()
     m_system->RemoveActiveEvent(this);
 }
 
+SimulationTime TimingEvent::GetDownCount() const
+{
+  return m_next_run_time - m_system->m_last_event_run_time;
+}
+
 SimulationTime TimingEvent::GetTimeSinceLastExecution() const
 {
-  return m_system->GetPendingEventTime() + m_time_since_last_run;
+  return m_system->GetSimulationTime() - m_last_run_time;
 }
 
 SimulationTime TimingEvent::GetTimeUntilNextExecution() const
 {
-  return std::max(m_downcount - m_system->GetPendingEventTime(), static_cast<SimulationTime>(0));
+  return std::max(m_next_run_time - m_system->GetSimulationTime(), static_cast<SimulationTime>(0));
 }
 
 CycleCount TimingEvent::GetCyclesSinceLastExecution() const
@@ -37,27 +42,27 @@ void TimingEvent::Reschedule(CycleCount cycles)
   DebugAssert(m_active);
 
   // We should really be up to date already in terms of cycles, so only take the partial cycles.
-  CycleCount partial_cycles_nodiv = m_time_since_last_run % m_cycle_period;
+  const SimulationTime event_time = m_system->m_last_event_run_time;
+  const SimulationTime partial_time = (event_time - m_last_run_time) % m_cycle_period;
 
-  // Update the interval and new downcount, subtracting any partial cycles.
+  // Update the interval and next run time, subtracting any partial cycles.
   m_interval = cycles;
-  m_downcount = ((cycles * m_cycle_period) - partial_cycles_nodiv);
+  m_next_run_time = event_time + (cycles * m_cycle_period) - partial_time;
 
   // Factor in partial time if this was rescheduled outside of an event handler. Say, an MMIO write.
   if (!m_system->m_running_events)
-    m_downcount += m_system->GetPendingEventTime();
+    m_next_run_time += m_system->GetPendingEventTime();
 
-  // If this is a call from an IO handler for example, re-sort the event queue.
-  m_system->SortEvents();
+  m_system->UpdateActiveEvent(this);
 }
 
 void TimingEvent::Reset()
 {
   if (m_active)
   {
-    m_downcount = m_interval * m_cycle_period;
-    m_time_since_last_run = 0;
-    m_system->SortEvents();
+    m_last_run_time = m_system->m_last_event_run_time;
+    m_next_run_time = m_last_run_time + (m_interval * m_cycle_period);
+    m_system->UpdateActiveEvent(this);
   }
 }
 
@@ -66,44 +71,35 @@ void TimingEvent::InvokeEarly(bool force /* = false */)
   if (!m_active)
     return;
 
-  // Remove the pending time, since we want this to be included in the cycles we pass through.
-  // We could just force an event sync here, but this would mean that InvokeEarly could be
-  // called recursively, which would be a bad thing.
-  const u64 pending_time = m_system->m_running_events ? 0 : m_system->GetPendingEventTime();
-  m_downcount -= pending_time;
-  m_time_since_last_run += pending_time;
+  // Include the pending time in the cycles we pass through. We could just force an event sync here, but this would
+  // mean that InvokeEarly could be called recursively, which would be a bad thing.
+  const SimulationTime current_time =
+    m_system->m_last_event_run_time + (m_system->m_running_events ? 0 : m_system->GetPendingEventTime());
 
   // Try to maintain partial cycles as best as possible.
-  CycleCount cycles_to_execute = m_time_since_last_run / m_cycle_period;
-  CycleCount partial_time = m_time_since_last_run % m_cycle_period;
-  m_downcount = (m_interval * m_cycle_period) - partial_time;
-  m_time_since_last_run = partial_time;
+  const SimulationTime time_since_last_run = current_time - m_last_run_time;
+  const CycleCount cycles_to_execute = time_since_last_run / m_cycle_period;
+  const SimulationTime partial_time = time_since_last_run % m_cycle_period;
+  m_last_run_time = current_time - partial_time;
+
+  // Since we're re-scheduling, we want the event to occur after the current time.
+  m_next_run_time = current_time + (m_interval * m_cycle_period) - partial_time;
+  m_system->UpdateActiveEvent(this);
 
   // Run any pending cycles.
   if (force || cycles_to_execute > 0)
     m_callback(this, cycles_to_execute, 0);
-
-  // Re-add the pending time. Since we're re-scheduling, we want the event to occur after
-  // the current time (which includes pending time).
-  m_downcount += pending_time;
-  m_time_since_last_run -= pending_time;
-
-  // Since we've changed the downcount, we need to re-sort the events.
-  m_system->SortEvents();
 }
 
 void TimingEvent::Activate()
 {
   Assert(!m_active);
-  m_downcount = m_interval * m_cycle_period;
-  m_time_since_last_run = 0;
-  m_active = true;
 
   // Since we can be running behind, if we want to trigger this event on the correct
   // number of cycles, not immediately (and many times).
-  const u64 pending_time = m_system->GetPendingEventTime();
-  m_downcount += pending_time;
-  m_time_since_last_run -= pending_time;
+  m_last_run_time = m_system->GetSimulationTime();
+  m_next_run_time = m_last_run_time + (m_interval * m_cycle_period);
+  m_active = true;
 
   m_system->AddActiveEvent(this);
 }
@@ -126,16 +122,17 @@ void TimingEvent::SetFrequency(float new_frequency, u32 interval /* = 1 */)
 {
   SimulationTime new_cycle_period = SimulationTime(double(1000000000.0) / double(new_frequency));
 
-  // Adjust downcount if active.
+  m_frequency = new_frequency;
+  m_interval = interval;
+
+  // Adjust the next run time if active.
+  const SimulationTime diff = new_cycle_period - m_cycle_period;
+  m_cycle_period = new_cycle_period;
   if (m_active)
   {
-    SimulationTime diff = new_cycle_period - m_cycle_period;
-    m_downcount += diff;
+    m_next_run_time += diff;
+    m_system->UpdateActiveEvent(this);
   }
-
-  m_frequency = new_frequency;
-  m_cycle_period = new_cycle_period;
-  m_interval = interval;
 }
 
 void TimingEvent::SetActive(bool active)
@@ -157,8 +154,8 @@ void TimingEvent::SetDowncount(SimulationTime downcount)
   if (!m_active)
     Activate();
 
-  m_downcount = downcount + m_system->GetPendingEventTime();
-  m_system->SortEvents();
+  m_next_run_time = m_system->GetSimulationTime() + downcount;
+  m_system->UpdateActiveEvent(this);
 }
 
 void TimingEvent::SetInterval(CycleCount interval)
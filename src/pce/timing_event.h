@@ -34,7 +34,11 @@ public:
   // Returns the number of cycles between each event.
   CycleCount GetInterval() const { return m_interval; }
 
-  SimulationTime GetDownCount() const { return m_downcount; }
+  // Time until the next invocation, relative to when events were last run.
+  SimulationTime GetDownCount() const;
+
+  // Absolute simulation time of the next invocation.
+  SimulationTime GetNextRunTime() const { return m_next_run_time; }
 
   // Includes pending time.
   SimulationTime GetTimeSinceLastExecution() const;
@@ -79,8 +83,12 @@ private:
   SimulationTime m_cycle_period;
   CycleCount m_interval;
 
-  SimulationTime m_downcount;
-  SimulationTime m_time_since_last_run;
+  // Absolute simulation times of the next invocation, and of the last cycle boundary the callback has seen.
+  SimulationTime m_next_run_time;
+  SimulationTime m_last_run_time;
+
+  // Position in the system's event heap, while active.
+  u32 m_heap_index = 0;
 
   TimingEventCallback m_callback;
   bool m_active;